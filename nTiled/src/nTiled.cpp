@@ -2,6 +2,9 @@
 //  Libraries
 // ----------------------------------------------------------------------------
 #include "main\Controller.h"
+#include "state\LightFile.h"
+#include "state\LightGenerator.h"
+#include "camera\CameraPath.h"
 #include <iostream>
 
 // ----------------------------------------------------------------------------
@@ -13,8 +16,55 @@
 //  Main
 // ----------------------------------------------------------------------------
 int main(int argc, char** argv) {
+  // Convert light files between the json and binary light formats
+  if (argc > 1 && std::string(argv[1]) == "--convert-lights") {
+    if (argc != 4) {
+      std::cerr << "Usage: " << argv[0] << " --convert-lights <input> <output>" << std::endl;
+      return -1;
+    }
+    std::size_t n_lights = nTiled::state::convertLights(argv[2], argv[3]);
+    std::cout << "Converted " << n_lights << " lights to " << argv[3] << std::endl;
+    return 0;
+  }
+
+  // Generate synthetic lights as specified by a light generator json file
+  if (argc > 1 && std::string(argv[1]) == "--generate-lights") {
+    if (argc != 4) {
+      std::cerr << "Usage: " << argv[0] << " --generate-lights <generator.json> <output>" << std::endl;
+      return -1;
+    }
+    std::size_t n_lights = nTiled::state::generateLightFile(argv[2], argv[3]);
+    std::cout << "Generated " << n_lights << " lights to " << argv[3] << std::endl;
+    return 0;
+  }
+
+  // Convert camera path json files to the binary camera path format
+  if (argc > 1 && std::string(argv[1]) == "--convert-camera-path") {
+    bool is_matrix = (argc == 5 && std::string(argv[4]) == "--matrices");
+    if (argc != 4 && !is_matrix) {
+      std::cerr << "Usage: " << argv[0] << " --convert-camera-path <input.json> <output> [--matrices]" << std::endl;
+      return -1;
+    }
+    std::size_t n_frames = nTiled::camera::convertCameraPath(
+      argv[2], argv[3],
+      is_matrix ? nTiled::camera::CameraPathFormat::Matrix :
+                  nTiled::camera::CameraPathFormat::LookAt);
+    std::cout << "Converted " << n_frames << " frames to " << argv[3] << std::endl;
+    return 0;
+  }
+
+  // Render offscreen without a visible window, e.g. on a server
+  bool is_headless = false;
+  if (argc > 1 && std::string(argv[argc - 1]) == "--headless") {
+    is_headless = true;
+    argc--;
+  }
+
   if (argc > 2) {
-    std::cerr << "Usage: " << argv[0] << "<path_to_scene_def.json" << std::endl;
+    std::cerr << "Usage: " << argv[0] << "<path_to_scene_def.json [--headless]" << std::endl;
+    std::cerr << "       " << argv[0] << " --convert-lights <input> <output>" << std::endl;
+    std::cerr << "       " << argv[0] << " --generate-lights <generator.json> <output>" << std::endl;
+    std::cerr << "       " << argv[0] << " --convert-camera-path <input.json> <output> [--matrices]" << std::endl;
     return -1;
   }
 
@@ -26,7 +76,7 @@ int main(int argc, char** argv) {
     scene_def_path = SCENE_PATH;
   }
 
-  nTiled::Controller controller = nTiled::Controller(scene_def_path);
+  nTiled::Controller controller = nTiled::Controller(scene_def_path, is_headless);
   controller.initialise();
   controller.render();
 
@@ -0,0 +1,29 @@
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include "main\BenchmarkRunner.h"
+#include <iostream>
+#include <stdexcept>
+
+
+// ----------------------------------------------------------------------------
+//  Main
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <path_to_benchmark_def.json>" << std::endl;
+    return -1;
+  }
+
+  try {
+    nTiled::main::BenchmarkRunner runner(argv[1]);
+    runner.init();
+    runner.execute();
+    runner.exportResults();
+  } catch (const std::runtime_error& e) {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
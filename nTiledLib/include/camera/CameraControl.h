@@ -19,6 +19,7 @@
 //  nTiled headers
 // ----------------------------------------------------------------------------
 #include "camera\CameraData.h"
+#include "camera\CameraPath.h"
 
 
 namespace nTiled {
@@ -44,6 +45,11 @@ public:
   /*! @brief Activate this CameraControl given the current input. */
   virtual void activate(const ImGuiIO& io) = 0;
 
+  /*! @brief Restart this CameraControl, such as at the first frame of its
+   *         path. Does nothing by default.
+   */
+  virtual void restart() {}
+
   /*! @brief Whether this CameraControl is user controlled or not. */
   virtual inline bool isUserControlled() = 0;
 };
@@ -107,19 +113,23 @@ class AutomaticRotateCameraControl : public CameraControl {
 
 /*! @brief PathCameraControl implements a CameraControl which follows a 
  *         a specified path (series of look at matrices). 
+ *
+ * The frames are read lazily with a CameraPathReader, one per update.
  */
 class PathCameraControl : public CameraControl {
 public: 
   // --------------------------------------------------------------------------
   //  Constructors
   // --------------------------------------------------------------------------
-  /*! @brief Construct a new PathCameraControl with the specified series of 
-   *         look at matrices defined in frames.
+  /*! @brief Construct a new PathCameraControl following the camera path
+   *         file at the specified path.
    *
-   *  @param frames A series of look at matrices specifying the path of this
-   *                new PathCameraControl.
+   *  @param path Path to the camera path file, either a camera path json
+   *              file or a binary camera path file.
+   *
+   *  @throws std::runtime_error If the camera path file is invalid.
    */
-  PathCameraControl(std::vector<glm::mat4> frames);
+  PathCameraControl(const std::string& path);
 
   // --------------------------------------------------------------------------
   //  Member functions
@@ -128,12 +138,13 @@ public:
               CameraData& data);
   void activate(const ImGuiIO& io);
 
+  /*! @brief Restart this PathCameraControl at the first frame. */
+  void restart() override;
+
   inline bool isUserControlled() { return false; }
  private:
-   /*! @brief The frames of this PathCameraControl. */
-   const std::vector<glm::mat4> frames;
-   /*! @brief Current frame of this PathCameraControl. */
-   int current_frame = 0;
+   /*! @brief The reader of the frames of this PathCameraControl. */
+   CameraPathReader reader;
 };
 
 } // camera
@@ -0,0 +1,188 @@
+/*! @file CameraPath.h
+ *  @brief CameraPath.h contains the definition of the binary camera path
+ *         format and of CameraPathReader, which reads the frames of a camera
+ *         path one at a time.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <glm\glm.hpp>
+
+
+namespace nTiled {
+namespace camera {
+
+/*! @brief CameraPathFormat specifies how the frames of a binary camera path
+ *         file are stored.
+ */
+enum class CameraPathFormat : std::uint32_t {
+  /*! @brief Each frame is a CameraFrame, its look at matrix is computed
+   *         when the frame is read.
+   */
+  LookAt = 0,
+  /*! @brief Each frame is a precomputed glm::mat4 look at matrix. */
+  Matrix = 1,
+};
+
+/*! @brief CameraFrame holds the eye, center and up vectors of a single frame
+ *         of a camera path.
+ */
+struct CameraFrame {
+  /*! @brief Position of the camera in world coordinates. */
+  glm::vec3 eye;
+  /*! @brief Point the camera looks at in world coordinates. */
+  glm::vec3 center;
+  /*! @brief Up direction of the camera. */
+  glm::vec3 up;
+};
+
+/*! @brief CameraPathHeader is the header of a binary camera path file.
+ *
+ * The header is directly followed by n_frames tightly packed frames, either
+ * CameraFrames or glm::mat4 look at matrices as specified by format, such
+ * that the file can be memory mapped or streamed and the frames used in
+ * place.
+ */
+struct CameraPathHeader {
+  /*! @brief Magic identifying a binary camera path file, "NTCP". */
+  char magic[4];
+  /*! @brief Version of the binary camera path format. */
+  std::uint32_t version;
+  /*! @brief The CameraPathFormat of the frames following this header. */
+  CameraPathFormat format;
+  /*! @brief Reserved, always 0. */
+  std::uint32_t reserved;
+  /*! @brief Number of frames following this header. */
+  std::uint64_t n_frames;
+};
+
+
+/*! @brief CameraPathReader reads the look at matrices of a camera path file
+ *         in order.
+ *
+ * Binary camera path files are streamed in fixed size chunks, such that
+ * only a small window of the path is resident at any time. Camera path json
+ * files are parsed completely on construction, into CameraFrames whose look
+ * at matrices are computed when read.
+ */
+class CameraPathReader {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new CameraPathReader reading the camera path file at
+   *         the specified path. The format of the file is detected from its
+   *         contents.
+   *
+   * @param path Path to the camera path file.
+   *
+   * @throws std::runtime_error If the file can not be opened or is invalid.
+   */
+  CameraPathReader(const std::string& path);
+
+  // --------------------------------------------------------------------------
+  //  Read
+  // --------------------------------------------------------------------------
+  /*! @brief Read the look at matrix of the next frame.
+   *
+   * @param look_at The matrix to which the look at matrix is written.
+   *
+   * @return Whether a frame was read, false if all frames have been read.
+   *
+   * @throws std::runtime_error If the file is truncated.
+   */
+  bool next(glm::mat4& look_at);
+
+  /*! @brief Rewind this CameraPathReader to the first frame. */
+  void rewind();
+
+  // --------------------------------------------------------------------------
+  //  Getters
+  // --------------------------------------------------------------------------
+  /*! @brief Get the total number of frames of the camera path. */
+  std::uint64_t getNFrames() const { return this->n_frames; }
+
+  /*! @brief Get whether the camera path is streamed from a binary file. */
+  bool isStreamed() const { return this->is_streamed; }
+
+private:
+  /*! @brief Read the next chunk of frames of the binary file into the
+   *         buffers.
+   */
+  void readChunk();
+
+  /*! @brief Path to the camera path file. */
+  const std::string path;
+  /*! @brief Stream of the binary file, only open if is_streamed. */
+  std::ifstream ifs;
+  /*! @brief Whether the frames are streamed from a binary file. */
+  bool is_streamed;
+  /*! @brief The CameraPathFormat of the buffered frames. */
+  CameraPathFormat format;
+
+  /*! @brief Total number of frames of the camera path. */
+  std::uint64_t n_frames;
+  /*! @brief Number of frames read into the buffers so far. */
+  std::uint64_t n_buffered;
+
+  /*! @brief Buffered frames, if format is LookAt. */
+  std::vector<CameraFrame> frame_buffer;
+  /*! @brief Buffered matrices, if format is Matrix. */
+  std::vector<glm::mat4> matrix_buffer;
+  /*! @brief Index of the next frame in the buffers. */
+  std::size_t buffer_index;
+};
+
+
+// ----------------------------------------------------------------------------
+//  Camera path file functions
+// ----------------------------------------------------------------------------
+/*! @brief Get whether the file at path is a binary camera path file.
+ *
+ * @param path Path to the camera path file.
+ */
+bool isBinaryCameraPath(const std::string& path);
+
+/*! @brief Read the frames of the specified camera path json file with a
+ *         streaming parser, without constructing a document of the whole
+ *         file.
+ *
+ * @param path Path to the camera_path.json file.
+ * @param frames Vector to which the read frames are appended.
+ *
+ * @throws std::runtime_error If the file can not be opened, parsed or does
+ *                            not contain any frames.
+ */
+void readCameraPathJson(const std::string& path,
+                        std::vector<CameraFrame>& frames);
+
+/*! @brief Write the specified frames as a binary camera path file.
+ *
+ * @param path Path to the binary camera path file.
+ * @param frames The frames to write.
+ * @param format The CameraPathFormat in which the frames are stored.
+ *
+ * @throws std::runtime_error If the file can not be written.
+ */
+void writeCameraPathBinary(const std::string& path,
+                           const std::vector<CameraFrame>& frames,
+                           CameraPathFormat format);
+
+/*! @brief Convert the camera path json file at input_path to a binary
+ *         camera path file at output_path.
+ *
+ * @return The number of converted frames.
+ */
+std::size_t convertCameraPath(const std::string& input_path,
+                              const std::string& output_path,
+                              CameraPathFormat format);
+
+} // camera
+} // nTiled
@@ -50,6 +50,12 @@ public:
    */
   void update();
 
+  /*! @brief Update the state of this nTiled application without user
+   *         input and without drawing the gui, as when rendering headless.
+   *         Only cameras which are not user controlled move.
+   */
+  void updateHeadless();
+
   /*! @brief Render the gui managed by this GuiManager to the screen
    */
   void render();
@@ -0,0 +1,174 @@
+/*! @file GpuTimer.h
+ *  @brief GpuTimer.h contains the definition of GpuTimer, which measures
+ *         the GPU execution time of pipeline stages with timestamp queries.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glad\glad.h>
+
+#include <cstdint>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "log\Profiler.h"
+
+
+namespace nTiled {
+namespace logged {
+
+/*! @brief GpuTimer measures the GPU execution time of stages with
+ *         GL_TIMESTAMP queries and adds them as spans to a Profiler.
+ *
+ * Each frame records its queries into its own pool of a ring of n_frames
+ * pools. The results of a frame are read once its last query is available,
+ * which is checked without waiting at every frame boundary, so the results
+ * of a frame are usually added n_frames - 1 frames later. A frame whose
+ * results are still unavailable when its pool is reused is dropped rather
+ * than waited for. Timestamps are used instead of GL_TIME_ELAPSED queries
+ * such that stages may be nested.
+ *
+ * Spans are named after the timed scope with " (GPU)" appended, and are
+ * attributed to Profiler::gpu_thread and the frame in which they were
+ * recorded. If the openGL context does not support timer queries, the
+ * GpuTimer does nothing.
+ */
+class GpuTimer {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor | Destructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new GpuTimer adding its spans to profiler. Requires
+   *         a current openGL context.
+   *
+   * @param profiler The Profiler to which the measured spans are added.
+   * @param n_frames The number of frames in flight, the number of pools.
+   * @param max_queries_per_frame The number of queries of each pool, stages
+   *                              exceeding it within a frame are dropped.
+   */
+  GpuTimer(Profiler& profiler,
+           unsigned int n_frames = 3,
+           unsigned int max_queries_per_frame = 128);
+
+  /*! @brief Destruct this GpuTimer, deleting its queries without reading
+   *         any outstanding results, call flush first.
+   */
+  ~GpuTimer();
+
+  GpuTimer(const GpuTimer&) = delete;
+  GpuTimer& operator=(const GpuTimer&) = delete;
+
+  // --------------------------------------------------------------------------
+  //  Timing
+  // --------------------------------------------------------------------------
+  /*! @brief Begin timing the stage with the specified ScopeId. */
+  void begin(ScopeId scope);
+
+  /*! @brief End timing the most recently begun stage, which must have the
+   *         specified ScopeId.
+   */
+  void end(ScopeId scope);
+
+  /*! @brief End the current frame, add the results of all frames whose
+   *         queries are available to the Profiler and start recording the
+   *         specified frame.
+   */
+  void nextFrame(std::uint32_t frame);
+
+  /*! @brief Wait for the results of all recorded frames and add them to
+   *         the Profiler.
+   */
+  void flush();
+
+  // --------------------------------------------------------------------------
+  //  Getters
+  // --------------------------------------------------------------------------
+  /*! @brief Get whether timer queries are supported by the current openGL
+   *         context.
+   */
+  static bool isSupported();
+
+  /*! @brief Get the number of stages dropped, because their pool was full
+   *         or their results were not available in time.
+   */
+  std::uint64_t getNDropped() const { return this->n_dropped; }
+
+private:
+  /*! @brief Interval is a single timed stage within a FramePool. */
+  struct Interval {
+    /*! @brief ScopeId of the GPU span of the stage. */
+    ScopeId scope;
+    /*! @brief Index of the query at the start of the stage. */
+    unsigned int begin_query;
+    /*! @brief Index of the query at the end of the stage, or n_queries if
+     *         the stage has not ended.
+     */
+    unsigned int end_query;
+    /*! @brief Number of stages enclosing this stage. */
+    std::uint32_t depth;
+  };
+
+  /*! @brief FramePool holds the queries of a single frame. */
+  struct FramePool {
+    /*! @brief The timestamp queries of this pool. */
+    std::vector<GLuint> queries;
+    /*! @brief Number of queries issued this frame. */
+    unsigned int n_used;
+    /*! @brief The stages timed this frame. */
+    std::vector<Interval> intervals;
+    /*! @brief The frame recorded in this pool. */
+    std::uint32_t frame;
+    /*! @brief Whether the results of this pool have not been read yet. */
+    bool is_pending;
+  };
+
+  /*! @brief Get the ScopeId of the GPU span of the specified scope. */
+  ScopeId getGpuScope(ScopeId scope);
+
+  /*! @brief Read the results of pool and add them to the Profiler.
+   *
+   * @param is_waiting Whether to wait for the results if they are not yet
+   *                   available.
+   *
+   * @return Whether the results were read.
+   */
+  bool resolve(FramePool& pool, bool is_waiting);
+
+  /*! @brief Issue a timestamp query in the current pool.
+   *
+   * @return Index of the query, or n_queries if the pool is full.
+   */
+  unsigned int issueQuery();
+
+  /*! @brief The Profiler to which the spans are added. */
+  Profiler& profiler;
+  /*! @brief Whether timer queries are supported. */
+  const bool is_supported;
+  /*! @brief Number of queries of each pool. */
+  const unsigned int n_queries;
+
+  /*! @brief The ring of pools. */
+  std::vector<FramePool> pools;
+  /*! @brief Index of the pool of the current frame. */
+  unsigned int current_pool;
+  /*! @brief Indices into the intervals of the current pool of the stages
+   *         which have begun but not ended.
+   */
+  std::vector<unsigned int> open_intervals;
+
+  /*! @brief GPU timestamp minus Profiler time in nanoseconds. */
+  std::int64_t gpu_offset;
+  /*! @brief ScopeId of the GPU span per timed ScopeId, or -1 if not yet
+   *         interned.
+   */
+  std::vector<std::int64_t> gpu_scopes;
+  /*! @brief Number of dropped stages. */
+  std::uint64_t n_dropped;
+};
+
+} // logged
+} // nTiled
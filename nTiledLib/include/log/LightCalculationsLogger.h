@@ -4,6 +4,10 @@
 //  Libraries
 // ----------------------------------------------------------------------------
 #include <glad\glad.h>
+#include <glm\glm.hpp>
+
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -16,14 +20,32 @@
 namespace nTiled {
 namespace logged {
 
+/*! @brief LightCalculationsLogger counts the number of light calculations
+ *         per pixel of the counted pipelines and logs their sum per frame.
+ *
+ * The calculation texture is summed per tile on the GPU by a compute shader,
+ * only the tile sums are read back, a few frames later, without stalling
+ * the pipeline. If compute shaders are not supported the texture is read
+ * back and summed on the CPU by all hardware threads instead. The time
+ * spent in extractCalculations is logged as overhead next to the frame
+ * time, to be compared against the frame times of an uncounted run.
+ */
 class LightCalculationsLogger {
 public:
-  /*! @brief Construct a new LightCalculationsLogger 
+  /*! @brief Construct a new LightCalculationsLogger
+   *
+   * @param clock The Clock of the logged frames.
+   * @param output_path Path of the exported json file.
+   * @param width Width of the viewport in pixels.
+   * @param height Height of the viewport in pixels.
+   * @param is_exporting_tiles Whether the number of light calculations of
+   *                           every tile is exported as well.
    */
   LightCalculationsLogger(const Clock& clock,
                           std::string output_path,
                           unsigned int width,
-                          unsigned int height);
+                          unsigned int height,
+                          bool is_exporting_tiles = false);
 
   /*! @brief Destruct this LightCalculationsLogger*/
   ~LightCalculationsLogger();
@@ -53,18 +75,93 @@ public:
    */
   void postRender();
 
-  /*! @brief Extract the calculated number of calculations per pixel and
-   *         write to disk.
+  /*! @brief Start summing the number of calculations per pixel of the
+   *         current frame, and collect the sums of previous frames which
+   *         are ready.
    */
   void extractCalculations();
 
-  /*! @brief Export the number of calculations to a json file
+  /*! @brief Wait for and collect the sums of all frames still being
+   *         summed on the GPU.
+   */
+  void flush();
+
+  /*! @brief Export the number of calculations to a json file of the form
+   *         { "frames": [ { "frame", "n_calc", "frame_ms", "overhead_ms"
+   *                       , "tiles": [ ... ] } ]
+   *         , "summary": { "n_frames", "mean_frame_ms", "mean_overhead_ms"
+   *                      , "overhead_ratio" }
+   *         }
+   *         where tiles, the row major number of calculations per tile, is
+   *         only present if tiles are exported.
    */
   void exportLog();
 
+  /*! @brief Get the number of logged frames, excluding frames still being
+   *         summed on the GPU.
+   */
+  std::size_t getNLoggedFrames() const { return this->n_light_calc_data.size(); }
+
+  /*! @brief Get the total number of light calculations over all logged
+   *         frames.
+   */
+  std::uint64_t getNCalculations() const;
+
+  /*! @brief Get whether the calculations are summed on the GPU. */
+  bool isReducingOnGPU() const { return this->is_reducing_on_gpu; }
+
+  /*! @brief Get whether compute shaders are available to sum the
+   *         calculations on the GPU.
+   */
+  static bool isGPUReductionSupported();
+
 private:
+  /*! @brief FrameCalculations holds the logged data of a single frame. */
+  struct FrameCalculations {
+    unsigned long frame;
+    std::uint64_t n_calc;
+    /*! @brief Time since the end of the previous extraction in
+     *         milliseconds, 0.0 for the first frame.
+     */
+    double frame_ms;
+    /*! @brief Time spent in extractCalculations in milliseconds. */
+    double overhead_ms;
+    /*! @brief Number of calculations per tile, if tiles are exported. */
+    std::vector<GLuint> tiles;
+  };
+
+  /*! @brief ReductionSlot is a single tile sum buffer of the ring. */
+  struct ReductionSlot {
+    GLuint ssbo;
+    /*! @brief Fence of the reduction, 0 if the slot holds no frame. */
+    GLsync fence;
+    FrameCalculations calculations;
+  };
+
+  /*! @brief Load and compile the reduction compute shader. */
+  void loadReduceShader();
+
+  /*! @brief Dispatch the reduction of the calculation texture into slot. */
+  void reduceOnGPU(ReductionSlot& slot);
+
+  /*! @brief Read back and sum the calculation texture on the CPU into the
+   *         specified calculations.
+   */
+  void reduceOnCPU(FrameCalculations& calculations);
+
+  /*! @brief Wait for the reduction of slot and collect its tile sums. */
+  void retire(ReductionSlot& slot);
+
+  /*! @brief Sum the tile sums into calculations and log it. */
+  void addCalculations(FrameCalculations& calculations);
+
   bool is_active;
 
+  /*! @brief Whether the number of calculations per tile is exported. */
+  const bool is_exporting_tiles;
+  /*! @brief Whether the calculations are summed by a compute shader. */
+  const bool is_reducing_on_gpu;
+
   //  output properties
   // --------------------------------------------------------------------------
   /*! @brief The Clock of this LightCalculationsLogger. */
@@ -72,7 +169,12 @@ private:
   /*! @brief The output path of this LightCalculationsLogger. */
   const std::string output_path;
 
-  std::vector<std::pair<unsigned long, unsigned long>> n_light_calc_data;
+  /*! @brief The logged data of every frame, in order. */
+  std::vector<FrameCalculations> n_light_calc_data;
+  /*! @brief Time of the previous extraction. */
+  std::chrono::steady_clock::time_point last_extraction;
+  /*! @brief Whether a previous extraction took place. */
+  bool has_last_extraction;
 
   // GBuffer attributes
   // --------------------------------------------------------------------------
@@ -89,6 +191,17 @@ private:
   /*! @brief Pointer to the calc texture of this LightCalculationsLogger.*/
   GLuint p_calc_texture;
   GLuint p_depth_texture;
+
+  //  Reduction properties
+  // --------------------------------------------------------------------------
+  /*! @brief The number of tiles in x and y. */
+  glm::uvec2 n_tiles;
+  /*! @brief The reduction compute shader, 0 if summed on the CPU. */
+  GLuint reduce_shader;
+  /*! @brief The ring of tile sum buffers, read back n_slots frames later. */
+  std::vector<ReductionSlot> slots;
+  /*! @brief Index of the ReductionSlot used by the next extraction. */
+  unsigned int next_slot;
 };
 
 }
@@ -9,13 +9,12 @@
 //  System Headers
 // ----------------------------------------------------------------------------
 #include <string>
-#include <map>
 #include <vector>
 
-// TODO windows dependency, add alternative for UNIX 
-#include <Windows.h>
-
 #include "main/Clock.h"
+#include "log/Profiler.h"
+#include "log/GpuTimer.h"
+#include "log/ProfileStream.h"
 
 namespace nTiled {
 namespace logged {
@@ -23,9 +22,17 @@ namespace logged {
 /*! @brief Global Logger to be created by the main function to keep track of the 
            different functions execution times.
 
-    It supports the starting and ending of logs.
+    It supports the starting and ending of logs, which may be nested and
+    repeated within a frame. Timing is done by a Profiler, which this
+    ExecutionTimeLogger makes the active Profiler while it is active, such
+    that ProfileScopes anywhere in nTiled are recorded as well. Stages
+    logged with startStageLog are additionally timed on the GPU by a
+    GpuTimer, their GPU time is logged as "<function_id> (GPU)" in the
+    frame in which the stage was executed.
+
     The data can be exported to a json file, and will have the following 
-    structure:
+    structure, where the timing of a function is the sum of all its calls
+    within the frame:
 
     @code{.js}
     { frames: [ { "<function_id 1>" : <function_id 1 timing> 
@@ -40,6 +47,10 @@ namespace logged {
              ]
     }
     @endcode
+
+    For long runs the spans and values can instead be streamed to storage
+    as frames complete with streamTo, in which case only the statistics of
+    every function, including percentiles, are kept in memory.
  */
 class ExecutionTimeLogger {
 public:
@@ -58,24 +69,65 @@ public:
                       unsigned int frame_start,
                       unsigned int frame_end);
 
+  /*! @brief Destruct this ExecutionTimeLogger. */
+  ~ExecutionTimeLogger();
+
   // --------------------------------------------------------------------------
   //  Member functions
   // --------------------------------------------------------------------------
   /*! @brief Start a logging time attributed to the given function_id
    * 
-   *  @param function_id The id of the function to be logged
+   *  @param function_id The interned id of the function to be logged
+   */
+  void startLog(ScopeId function_id);
+
+  /*! @brief End timing the function with the given function_id, which must
+   *         be the most recently started function that has not ended.
+   *
+   *  @param function_id The interned id of the function being logged
+   */
+  void endLog(ScopeId function_id);
+
+  /*! @brief Start logging the CPU and GPU time of the pipeline stage
+   *         with the given function_id. Requires a current openGL context.
+   *
+   *  @param function_id The interned id of the stage to be logged
    */
-  void startLog(std::string function_id);
+  void startStageLog(ScopeId function_id);
 
-  /*! @brief End timing the current function.
+  /*! @brief End logging the CPU and GPU time of the pipeline stage with
+   *         the given function_id.
+   *
+   *  @param function_id The interned id of the stage being logged
    */
-  void endLog();
+  void endStageLog(ScopeId function_id);
+
+  /*! @brief Record a value that is not a timing, such as an object count,
+   *         attributed to the given value_id in the current frame.
+   *
+   *  @param value_id The interned id of the value to be logged
+   *  @param value The value to be logged
+   */
+  void logValue(ScopeId value_id, double value);
 
   /*! @brief Increment the current frame of this ExecutionTimeLogger
    */
   void incrementFrame();
 
-  /*! @brief Export the collected data to the json file specified with path
+  /*! @brief Stream all subsequently logged spans and values to the
+   *         specified path instead of keeping them in memory, see
+   *         ProfileStreamWriter. Should be called before activation.
+   *
+   * @param path Path of the stream file, written as csv if it ends in
+   *             ".csv" and as binary records otherwise.
+   */
+  void streamTo(const std::string& path);
+
+  /*! @brief Export the collected data to the json file specified with path.
+   *         Additionally a Chrome trace of every logged call is written to
+   *         <path stem>.trace.json and the statistics of every function
+   *         over all frames to <path stem>.summary.json. If streaming, only
+   *         the statistics are written, and the stream is closed.
    *
    * @param path Reference to the path of the json file
    */
@@ -86,29 +138,31 @@ public:
   /*! @brief Deactivate this ExecutionTimeLogger. */
   void deactivate();
 
+  /*! @brief Get the Profiler of this ExecutionTimeLogger. */
+  Profiler& getProfiler() { return this->profiler; }
+
 private:
   // --------------------------------------------------------------------------
   //  Data Members
   // --------------------------------------------------------------------------
-  /*! @brief Collected Data Per frame.*/
-  std::vector<std::pair<unsigned long,
-                        std::map<std::string, double>>> time_data;
+  /*! @brief Profiler recording the logged functions and values. */
+  Profiler profiler;
+  /*! @brief GpuTimer timing the stages, constructed at the first stage
+   *         logged while active and destructed on deactivation.
+   */
+  GpuTimer* p_gpu_timer;
+  /*! @brief ProfileStreamWriter receiving the spans and values, nullptr if
+   *         they are kept in memory.
+   */
+  ProfileStreamWriter* p_stream;
+  /*! @brief The frames which have been logged, in order. */
+  std::vector<unsigned long> logged_frames;
 
   // --------------------------------------------------------------------------
   //  Measurement Members
   // --------------------------------------------------------------------------
-  /*! @brief Whether this ExecutionTimeLogger is logging a function. */
-  bool is_running;
   /*! @brief Whether this ExecutionTimeLogger is active*/
   bool is_active;
-  /*! @brief Function_id of function that is currently being tracked*/
-  std::string current_function_id;
-  /*! @brief Frequency at start of the measurement */
-  LARGE_INTEGER frequency;
-  /*! @brief Time at start of the measurement */
-  LARGE_INTEGER start_time;
-  /*! @brief Time at end of the measurement */
-  LARGE_INTEGER end_time;
 
   /*! @brief The first frame that is logged. */
   unsigned int frame_start;
@@ -120,4 +174,4 @@ private:
 };
 
 } // log
-} // nTiled
\ No newline at end of file
+} // nTiled
\ No newline at end of file
@@ -0,0 +1,143 @@
+/*! @file ProfileStream.h
+ *  @brief ProfileStream.h contains the definition of ProfileStreamWriter,
+ *         which streams the spans and values of a Profiler to storage as
+ *         frames complete, as csv or binary records.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "log\Profiler.h"
+
+
+namespace nTiled {
+namespace logged {
+
+/*! @brief ProfileStreamFormat specifies the file format of a profile
+ *         stream.
+ */
+enum class ProfileStreamFormat {
+  /*! @brief One line per record:
+   *         record,frame,thread,depth,name,start_ms,value
+   *         with value the duration in milliseconds for spans.
+   */
+  CSV,
+  /*! @brief A ProfileStreamHeader followed by ProfileRecords. */
+  Binary,
+};
+
+/*! @brief ProfileRecordType specifies the type of a ProfileRecord. */
+enum class ProfileRecordType : std::uint32_t {
+  Span = 0,
+  Value = 1,
+  /*! @brief Names scope, followed by name_length bytes of the name. Written
+   *         before the first record of the scope.
+   */
+  Name = 2,
+};
+
+/*! @brief ProfileStreamHeader is the header of a binary profile stream. */
+struct ProfileStreamHeader {
+  /*! @brief "NTPS" */
+  char magic[4];
+  std::uint32_t version;
+};
+
+/*! @brief ProfileRecord is a single record of a binary profile stream. */
+struct ProfileRecord {
+  /*! @brief Start or time in nanoseconds since the Profiler epoch. */
+  std::int64_t time;
+  /*! @brief Duration in milliseconds for spans, the value for values. */
+  double value;
+  ProfileRecordType type;
+  ScopeId scope;
+  std::uint32_t frame;
+  std::uint32_t thread;
+  std::uint32_t depth;
+  /*! @brief Length of the name following a Name record, 0 otherwise. */
+  std::uint32_t name_length;
+};
+
+
+/*! @brief ProfileStreamWriter is a ProfileSink appending every span and value
+ *         to a file, flushed at every drain of the Profiler, such that a
+ *         profile of any length can be recorded in bounded memory.
+ */
+class ProfileStreamWriter : public ProfileSink {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor | Destructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new ProfileStreamWriter writing to the specified
+   *         path.
+   *
+   * @param path Path of the stream file.
+   * @param format The ProfileStreamFormat of the stream file.
+   *
+   * @throws std::runtime_error If the file could not be opened.
+   */
+  ProfileStreamWriter(const std::string& path, ProfileStreamFormat format);
+
+  /*! @brief Construct a new ProfileStreamWriter writing to the specified
+   *         path, in binary unless its extension is ".csv".
+   */
+  ProfileStreamWriter(const std::string& path);
+
+  /*! @brief Destruct this ProfileStreamWriter, closing its file. */
+  ~ProfileStreamWriter();
+
+  ProfileStreamWriter(const ProfileStreamWriter&) = delete;
+  ProfileStreamWriter& operator=(const ProfileStreamWriter&) = delete;
+
+  // --------------------------------------------------------------------------
+  //  ProfileSink
+  // --------------------------------------------------------------------------
+  void addSpan(const ProfileSpan& span) override;
+  void addValue(const ProfileValue& value) override;
+  void flush() override;
+
+  /*! @brief Get the number of records written, excluding Name records. */
+  std::uint64_t getNRecords() const { return this->n_records; }
+
+private:
+  /*! @brief Open the stream file and write its header. */
+  void open();
+
+  /*! @brief Write a Name record for scope if it has not been named yet. */
+  void nameScope(ScopeId scope);
+
+  /*! @brief Write a single record. */
+  void write(ProfileRecordType type,
+             std::int64_t time,
+             double value,
+             ScopeId scope,
+             std::uint32_t frame,
+             std::uint32_t thread,
+             std::uint32_t depth);
+
+  /*! @brief Path of the stream file. */
+  const std::string path;
+  /*! @brief The ProfileStreamFormat of the stream file. */
+  const ProfileStreamFormat format;
+
+  /*! @brief The stream file. */
+  std::ofstream ofs;
+  /*! @brief Write buffer of ofs. */
+  std::vector<char> buffer;
+  /*! @brief Whether each ScopeId has been named in a binary stream. */
+  std::vector<bool> is_named;
+  /*! @brief Number of records written. */
+  std::uint64_t n_records;
+};
+
+} // logged
+} // nTiled
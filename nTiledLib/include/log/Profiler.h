@@ -0,0 +1,412 @@
+/*! @file Profiler.h
+ *  @brief Profiler.h contains the definition of Profiler, a portable
+ *         profiler for nested and repeated scopes on any number of threads,
+ *         and of ProfileScope which times a single scope.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "log\QuantileSketch.h"
+
+
+namespace nTiled {
+namespace logged {
+
+/*! @brief Identifier of an interned scope or value name. */
+typedef std::uint32_t ScopeId;
+
+/*! @brief Get the ScopeId of the specified name, interning it if it has not
+ *         been interned before. Thread safe, but takes a lock, so intern once
+ *         and store the resulting ScopeId, e.g. in a static local.
+ *
+ * @param name The name of the scope or value, e.g. "Class::method".
+ */
+ScopeId internScope(const std::string& name);
+
+/*! @brief Get the name of the specified interned ScopeId. */
+const std::string& getScopeName(ScopeId id);
+
+/*! @brief Get the number of interned scopes. */
+std::size_t getNScopes();
+
+
+/*! @brief ProfileEventType specifies the type of a recorded ProfileEvent. */
+enum class ProfileEventType : std::uint32_t {
+  Begin = 0,
+  End = 1,
+  Value = 2,
+};
+
+/*! @brief ProfileEvent is a single event recorded by a thread. */
+struct ProfileEvent {
+  /*! @brief Time of the event in nanoseconds since the Profiler epoch. */
+  std::int64_t time;
+  /*! @brief The recorded value, if type is Value. */
+  double value;
+  /*! @brief The ScopeId of the scope or value. */
+  ScopeId scope;
+  /*! @brief The frame in which the event was recorded. */
+  std::uint32_t frame;
+  /*! @brief The type of the event. */
+  ProfileEventType type;
+};
+
+/*! @brief ProfileSpan is a completed scope. */
+struct ProfileSpan {
+  /*! @brief Start of the scope in nanoseconds since the Profiler epoch. */
+  std::int64_t start;
+  /*! @brief Duration of the scope in nanoseconds. */
+  std::int64_t duration;
+  /*! @brief The ScopeId of the scope. */
+  ScopeId scope;
+  /*! @brief Index of the thread that executed the scope. */
+  std::uint32_t thread;
+  /*! @brief The frame in which the scope started. */
+  std::uint32_t frame;
+  /*! @brief Number of scopes enclosing this scope on its thread. */
+  std::uint32_t depth;
+};
+
+/*! @brief ProfileValue is a recorded value, such as an object count. */
+struct ProfileValue {
+  /*! @brief Time of the value in nanoseconds since the Profiler epoch. */
+  std::int64_t time;
+  /*! @brief The value. */
+  double value;
+  /*! @brief The ScopeId of the value. */
+  ScopeId scope;
+  /*! @brief Index of the thread that recorded the value. */
+  std::uint32_t thread;
+  /*! @brief The frame in which the value was recorded. */
+  std::uint32_t frame;
+};
+
+/*! @brief ScopeStats holds the aggregate statistics of a single scope or
+ *         value over all its spans or values.
+ */
+struct ScopeStats {
+  /*! @brief Number of spans or values. */
+  std::uint64_t count;
+  /*! @brief Sum of the durations in milliseconds, or of the values. */
+  double total;
+  /*! @brief Minimum duration in milliseconds, or minimum value. */
+  double min;
+  /*! @brief Maximum duration in milliseconds, or maximum value. */
+  double max;
+  /*! @brief Sketch of the distribution of the durations in milliseconds, or
+   *         of the values, from which percentiles are estimated.
+   */
+  QuantileSketch sketch;
+};
+
+
+/*! @brief ProfileSink receives the spans and values of a Profiler as they are
+ *         drained, such as to stream them to storage.
+ */
+class ProfileSink {
+public:
+  virtual ~ProfileSink() {}
+
+  /*! @brief Receive a completed span. */
+  virtual void addSpan(const ProfileSpan& span) = 0;
+  /*! @brief Receive a recorded value. */
+  virtual void addValue(const ProfileValue& value) = 0;
+  /*! @brief Called at the end of every drain. */
+  virtual void flush() {}
+};
+
+
+/*! @brief Profiler collects the scopes and values recorded by all threads
+ *         while it is the active Profiler.
+ *
+ * Each thread records its events into its own fixed capacity ring buffer,
+ * without locking. The rings are drained into spans, values and per scope
+ * statistics by drain, which is called by setFrame and deactivate; events
+ * recorded while a ring is full are dropped and counted. Scopes may be
+ * nested and repeated arbitrarily.
+ *
+ * At most one Profiler is active at a time. When no Profiler is active,
+ * recording a scope costs a single atomic load.
+ */
+class Profiler {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor | Destructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new inactive Profiler.
+   *
+   * @param ring_capacity The number of events each thread can record
+   *                      between two drains, rounded up to a power of two.
+   */
+  Profiler(std::size_t ring_capacity = 65536);
+
+  /*! @brief Destruct this Profiler, deactivating it if it is active. No
+   *         thread may be recording into it anymore.
+   */
+  ~Profiler();
+
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+
+  // --------------------------------------------------------------------------
+  //  Activation
+  // --------------------------------------------------------------------------
+  /*! @brief Make this Profiler the active Profiler.
+   *
+   * @throws std::runtime_error If another Profiler is already active.
+   */
+  void activate();
+
+  /*! @brief Stop this Profiler being the active Profiler and drain all
+   *         recorded events.
+   */
+  void deactivate();
+
+  /*! @brief Get whether this Profiler is the active Profiler. */
+  bool isActive() const { return Profiler::getActive() == this; }
+
+  /*! @brief Get the active Profiler, nullptr if no Profiler is active. */
+  static Profiler* getActive() {
+    return Profiler::p_active.load(std::memory_order_acquire);
+  }
+
+  // --------------------------------------------------------------------------
+  //  Recording
+  // --------------------------------------------------------------------------
+  /*! @brief Record an event on the calling thread.
+   *
+   * @param scope The ScopeId of the scope or value.
+   * @param type The type of the event.
+   * @param value The recorded value, if type is Value.
+   */
+  void record(ScopeId scope, ProfileEventType type, double value = 0.0);
+
+  /*! @brief Add a span measured elsewhere, such as on the GPU, directly to
+   *         the drained spans and statistics.
+   *
+   * @param span The span, with start in nanoseconds since the Profiler
+   *             epoch.
+   */
+  void addSpan(const ProfileSpan& span);
+
+  /*! @brief Get the current time in nanoseconds since the Profiler epoch. */
+  std::int64_t getTime() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - this->epoch).count();
+  }
+
+  /*! @brief Get the frame of subsequently recorded events. */
+  std::uint32_t getFrame() const {
+    return this->frame.load(std::memory_order_relaxed);
+  }
+
+  /*! @brief Thread index of spans executed on the GPU. */
+  static const std::uint32_t gpu_thread = 0xFFFFFFFFu;
+
+  /*! @brief Drain the events of all threads and set the frame of all
+   *         subsequently recorded events. Should be called by the thread
+   *         driving the frames, at frame boundaries.
+   */
+  void setFrame(std::uint32_t frame);
+
+  /*! @brief Drain the events recorded by all threads into the spans, values
+   *         and statistics of this Profiler. Scopes which have not ended yet
+   *         stay open until a subsequent drain.
+   */
+  void drain();
+
+  /*! @brief Set the ProfileSink receiving all subsequently drained spans and
+   *         values. Statistics are kept regardless.
+   *
+   * @param p_sink The ProfileSink, nullptr for none. Not owned by this
+   *               Profiler, it must outlive its use.
+   * @param is_retaining Whether the spans and values are also retained by
+   *                     this Profiler. If not, its memory use is bounded by
+   *                     the number of scopes instead of the number of frames.
+   */
+  void setSink(ProfileSink* p_sink, bool is_retaining = true);
+
+  // --------------------------------------------------------------------------
+  //  Results
+  // --------------------------------------------------------------------------
+  /*! @brief Get the completed spans, in the order in which they ended per
+   *         thread.
+   */
+  const std::vector<ProfileSpan>& getSpans() const { return this->spans; }
+
+  /*! @brief Get the recorded values. */
+  const std::vector<ProfileValue>& getValues() const { return this->values; }
+
+  /*! @brief Get the statistics of the specified scope or value. */
+  ScopeStats getStats(ScopeId scope) const;
+
+  /*! @brief Get the number of events dropped because a ring was full. */
+  std::uint64_t getNDropped() const;
+
+  /*! @brief Discard all drained spans, values and statistics. */
+  void clear();
+
+  /*! @brief Export all spans and values as a Chrome trace json file, which
+   *         can be loaded in chrome://tracing or Perfetto.
+   *
+   * @param path Path to the trace file.
+   */
+  void exportTrace(const std::string& path) const;
+
+  /*! @brief Export the statistics of every recorded scope and value to a
+   *         json file of the form
+   *         { "scopes": [ { "name", "count", "total", "mean", "min", "max"
+   *                       , "p50", "p95", "p99"
+   *                       , "histogram": [ { "upper", "count" } ] } ]
+   *         , "values": [ ... ]
+   *         , "n_dropped": n, "n_unmatched": n }
+   *         with durations in milliseconds. Percentiles are estimated within
+   *         1% and the histogram has power of two bins.
+   *
+   * @param path Path to the summary file.
+   */
+  void exportSummary(const std::string& path) const;
+
+private:
+  /*! @brief ThreadRing is the single producer ring buffer of one thread. */
+  struct ThreadRing {
+    /*! @brief The recorded events, capacity is a power of two. */
+    std::vector<ProfileEvent> events;
+    /*! @brief Number of events recorded, written by the producer. */
+    std::atomic<std::uint64_t> head;
+    /*! @brief Number of events drained, written by the consumer. */
+    std::atomic<std::uint64_t> tail;
+    /*! @brief Number of events dropped because the ring was full. */
+    std::atomic<std::uint64_t> n_dropped;
+    /*! @brief The thread recording into this ring. */
+    std::thread::id thread_id;
+    /*! @brief Index of the thread in this Profiler. */
+    std::uint32_t thread_index;
+    /*! @brief Events of the scopes which have begun but not ended yet. */
+    std::vector<ProfileEvent> open_scopes;
+  };
+
+  /*! @brief Get the ThreadRing of the calling thread, constructing it on
+   *         first use.
+   */
+  ThreadRing& getThreadRing();
+
+  /*! @brief Drain the events of a single ring. drain_mutex must be held. */
+  void drainRing(ThreadRing& ring);
+
+  /*! @brief Pass a span to the sink and retain it. drain_mutex must be
+   *         held.
+   */
+  void emitSpan(const ProfileSpan& span);
+
+  /*! @brief Pass a value to the sink and retain it. drain_mutex must be
+   *         held.
+   */
+  void emitValue(const ProfileValue& value);
+
+  /*! @brief Add a sample to the statistics of the specified scope. */
+  static void addSample(std::vector<ScopeStats>& stats,
+                        ScopeId scope,
+                        double sample);
+
+  /*! @brief The active Profiler. */
+  static std::atomic<Profiler*> p_active;
+
+  /*! @brief Unique id of this Profiler, distinguishes it from Profilers
+   *         previously constructed at the same address.
+   */
+  const std::uint64_t id;
+  /*! @brief Mask mapping event counts onto ring indices. */
+  const std::uint64_t ring_mask;
+  /*! @brief Time point from which event times are measured. */
+  const std::chrono::steady_clock::time_point epoch;
+
+  /*! @brief The frame of subsequently recorded events. */
+  std::atomic<std::uint32_t> frame;
+
+  /*! @brief The rings of all threads which recorded into this Profiler. */
+  std::vector<ThreadRing*> rings;
+  /*! @brief Mutex guarding rings. */
+  mutable std::mutex rings_mutex;
+  /*! @brief Mutex guarding the drained results. */
+  std::mutex drain_mutex;
+
+  /*! @brief The completed spans. */
+  std::vector<ProfileSpan> spans;
+  /*! @brief The recorded values. */
+  std::vector<ProfileValue> values;
+  /*! @brief Statistics of the spans per ScopeId. */
+  std::vector<ScopeStats> span_stats;
+  /*! @brief Statistics of the values per ScopeId. */
+  std::vector<ScopeStats> value_stats;
+  /*! @brief Number of End events without a matching Begin event. */
+  std::uint64_t n_unmatched;
+
+  /*! @brief The ProfileSink receiving drained spans and values, if any. */
+  ProfileSink* p_sink;
+  /*! @brief Whether drained spans and values are retained. */
+  bool is_retaining;
+};
+
+
+/*! @brief ProfileScope records the lifetime of a scope in the active
+ *         Profiler, if any.
+ *
+ * @code{.cpp}
+ * static const logged::ScopeId scope_id = logged::internScope("Class::method");
+ * logged::ProfileScope profile_scope(scope_id);
+ * @endcode
+ */
+class ProfileScope {
+public:
+  /*! @brief Begin the specified scope in the active Profiler. */
+  explicit ProfileScope(ScopeId scope) :
+      p_profiler(Profiler::getActive()),
+      scope(scope) {
+    if (this->p_profiler) {
+      this->p_profiler->record(this->scope, ProfileEventType::Begin);
+    }
+  }
+
+  /*! @brief End the scope in the Profiler it began in. */
+  ~ProfileScope() {
+    if (this->p_profiler) {
+      this->p_profiler->record(this->scope, ProfileEventType::End);
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  /*! @brief The Profiler this scope began in, nullptr if none. */
+  Profiler* const p_profiler;
+  /*! @brief The ScopeId of this scope. */
+  const ScopeId scope;
+};
+
+/*! @brief Record a value, such as an object count, in the active Profiler,
+ *         if any.
+ */
+inline void profileValue(ScopeId scope, double value) {
+  Profiler* p_profiler = Profiler::getActive();
+  if (p_profiler) {
+    p_profiler->record(scope, ProfileEventType::Value, value);
+  }
+}
+
+} // logged
+} // nTiled
@@ -0,0 +1,95 @@
+/*! @file QuantileSketch.h
+ *  @brief QuantileSketch.h contains the definition of QuantileSketch, a
+ *         mergeable sketch of a distribution from which quantiles can be
+ *         estimated with bounded relative error.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace nTiled {
+namespace logged {
+
+/*! @brief QuantileSketch counts values in logarithmically sized buckets,
+ *         such that any quantile can be estimated within the relative
+ *         accuracy of the sketch, in memory logarithmic in the range of the
+ *         values rather than linear in their number.
+ *
+ * Bucket i holds the values in (gamma^(i-1), gamma^i], with
+ * gamma = (1 + relative_accuracy) / (1 - relative_accuracy). Values not
+ * greater than 1e-9 are counted in a separate zero bucket, which bounds the
+ * number of buckets. Sketches
+ * with the same relative accuracy can be merged by adding their buckets.
+ */
+class QuantileSketch {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new empty QuantileSketch.
+   *
+   * @param relative_accuracy The maximum relative error of the estimated
+   *                          quantiles, in (0, 1).
+   */
+  QuantileSketch(double relative_accuracy = 0.01);
+
+  // --------------------------------------------------------------------------
+  //  Member functions
+  // --------------------------------------------------------------------------
+  /*! @brief Add the specified value to this QuantileSketch. */
+  void add(double value);
+
+  /*! @brief Add all values of the specified QuantileSketch to this one.
+   *
+   * @throws std::runtime_error If the relative accuracies differ.
+   */
+  void merge(const QuantileSketch& other);
+
+  /*! @brief Estimate the specified quantile of the added values.
+   *
+   * @param q The quantile, in [0, 1], e.g. 0.95 for the 95th percentile.
+   *
+   * @return The estimated quantile, 0.0 if no values were added.
+   */
+  double getQuantile(double q) const;
+
+  /*! @brief Get a histogram of the added values with power of two bins.
+   *
+   * @return Pairs of the exclusive upper bound of each non-empty bin and
+   *         the number of values in it, in ascending order. Values in the
+   *         zero bucket have an upper bound of 0.0.
+   */
+  std::vector<std::pair<double, std::uint64_t>> getHistogram() const;
+
+  /*! @brief Get the number of added values. */
+  std::uint64_t getCount() const { return this->count; }
+
+  /*! @brief Get the relative accuracy of this QuantileSketch. */
+  double getRelativeAccuracy() const { return this->relative_accuracy; }
+
+private:
+  /*! @brief Get the value representing all values in bucket index. */
+  double getBucketValue(int index) const;
+
+  /*! @brief The relative accuracy of this QuantileSketch. */
+  double relative_accuracy;
+  /*! @brief Natural logarithm of gamma, the ratio between bucket bounds. */
+  double log_gamma;
+
+  /*! @brief Number of values per bucket index, only non-empty buckets. */
+  std::map<int, std::uint64_t> buckets;
+  /*! @brief Number of values not greater than 1e-9. */
+  std::uint64_t n_zero;
+  /*! @brief Total number of added values. */
+  std::uint64_t count;
+};
+
+} // logged
+} // nTiled
@@ -0,0 +1,209 @@
+/*! @file BenchmarkRunner.h
+ *  @brief BenchmarkRunner.h contains the definition of the BenchmarkRunner,
+ *         which renders a matrix of scenes and light assignment
+ *         configurations headless and writes the timings of all of them to
+ *         a single results table.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  System Libraries
+// ----------------------------------------------------------------------------
+#include <glad\glad.h>
+#include <GLFW\glfw3.h>
+#include <glm\glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "state\State.h"
+#include "camera\Camera.h"
+#include "main\OffscreenBuffer.h"
+#include "pipeline\deferred\shaders\DeferredShaderId.h"
+#include "pipeline\light-management\hashed\HashedConfig.h"
+
+
+namespace nTiled {
+namespace main {
+
+/*! @brief BenchmarkRunner renders every scene of a benchmark configuration
+ *         with every combination of light assignment algorithm, tile size
+ *         and HashedConfig, and writes the per stage timings and light
+ *         calculation counts of all runs to a single csv file.
+ *
+ * The benchmark configuration is a json file of the form
+ *
+ * @code{.js}
+ * { "scenes": [ "<path to scene.json>", ... ]
+ * , "algorithms": [ "attenuated", "tiled", "clustered", "hashed" ]
+ * , "tile_sizes": [ [ 32, 32 ], ... ]
+ * , "hashed_configs": [ { "node_size", "starting_depth", "r_increase_ratio"
+ *                       , "max_attempts", "seed", "build_method"
+ *                       , "dense_occupancy_threshold", "table_layout"
+ *                       , "release_host_tables", "pow2_tables", "backend"
+ *                       , "portfolio_size", "auto_tune", "memory_budget" }
+ *                     , ... ]
+ * , "warmup_frames": 30
+ * , "frames": 300
+ * , "is_counting_calculations": true
+ * , "output_path": "<path to results.csv>"
+ * }
+ * @endcode
+ *
+ * where tile_sizes and hashed_configs default to those of the scene. Tile
+ * sizes only apply to the tiled and clustered algorithms and hashed configs
+ * only to the hashed algorithm, such that no identical run is rendered
+ * twice.
+ *
+ * All runs share a single hidden window and openGL context, the geometry
+ * and textures of a scene are loaded once for all its runs. Every run
+ * starts at the first frame of the camera path of the scene, renders
+ * warmup_frames unlogged frames and then logs frames frames. Runs are
+ * always rendered with the deferred pipeline, since forward shading
+ * assigns a shader per object.
+ */
+class BenchmarkRunner {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor | Destructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new BenchmarkRunner for the specified benchmark
+   *         configuration file.
+   */
+  BenchmarkRunner(const std::string& config_path);
+
+  /*! @brief Destruct this BenchmarkRunner, closing its window. */
+  ~BenchmarkRunner();
+
+  // --------------------------------------------------------------------------
+  //  Execution
+  // --------------------------------------------------------------------------
+  /*! @brief Parse the benchmark configuration and create the hidden window
+   *         and openGL context shared by all runs.
+   */
+  void init();
+
+  /*! @brief Render all runs of all scenes. */
+  void execute();
+
+  /*! @brief Export the results of all runs to the csv file at output_path,
+   *         with a row per logged stage or value of every run of the form
+   *         scene,algorithm,tile_size,hashed_config,n_frames,scope,unit,
+   *         count,total,mean,per_frame,p50,p95,p99,max
+   *         where unit is ms for timings, count for values and bytes for
+   *         memory. The number of light calculations is reported as the
+   *         value light_calculations, the resident memory once the shaders
+   *         of a run are initialised as resident_memory and the growth of
+   *         the peak resident memory during the run, over the resident
+   *         memory at its start, as peak_resident_memory_growth. Where the
+   *         peak can not be reset, as on Windows, the growth is measured 
+   *         against the peak since the process started and is an upper 
+   *         bound.
+   */
+  void exportResults();
+
+private:
+  /*! @brief Run is a single configuration of the light assignment. */
+  struct Run {
+    pipeline::DeferredShaderId algorithm;
+    glm::uvec2 tile_size;
+    pipeline::hashed::HashedConfig hashed_config;
+  };
+
+  /*! @brief Result is the statistics of a single stage or value of a Run. */
+  struct Result {
+    std::string scene;
+    std::string algorithm;
+    std::string tile_size;
+    std::string hashed_config;
+    unsigned int n_frames;
+    std::string scope;
+    std::string unit;
+    std::uint64_t count;
+    double total;
+    double p50;
+    double p95;
+    double p99;
+    double max;
+  };
+
+  /*! @brief Render all runs of the scene at the specified path. */
+  void executeScene(const std::string& scene_path);
+
+  /*! @brief Get the runs of the specified scene, without duplicates. */
+  std::vector<Run> getRuns(const state::State& state) const;
+
+  /*! @brief Render the specified run with a DeferredPipelineLogged and
+   *         add the statistics of all its stages and values.
+   */
+  void executeTimed(state::State& state,
+                    const Run& run,
+                    const std::string& scene_path);
+
+  /*! @brief Render the specified run with a DeferredPipelineCounted and
+   *         add its number of light calculations.
+   */
+  void executeCounted(state::State& state,
+                      const Run& run,
+                      const std::string& scene_path);
+
+  /*! @brief Set the state to the specified run and move its camera to the
+   *         first frame of its path.
+   */
+  void prepareRun(state::State& state, const Run& run) const;
+
+  /*! @brief Construct a Result of the specified run, without statistics. */
+  Result constructResult(const Run& run,
+                         const std::string& scene_path) const;
+
+  // --------------------------------------------------------------------------
+  //  Configuration
+  // --------------------------------------------------------------------------
+  /*! @brief Path to the benchmark configuration file. */
+  const std::string config_path;
+  /*! @brief Paths to the scene.json files. */
+  std::vector<std::string> scene_paths;
+  /*! @brief The benchmarked light assignment algorithms. */
+  std::vector<pipeline::DeferredShaderId> algorithms;
+  /*! @brief The benchmarked tile sizes, the tile size of the scene if
+   *         empty.
+   */
+  std::vector<glm::uvec2> tile_sizes;
+  /*! @brief The benchmarked HashedConfigs, the HashedConfig of the scene if
+   *         empty.
+   */
+  std::vector<pipeline::hashed::HashedConfig> hashed_configs;
+  /*! @brief Number of unlogged frames rendered before every run. */
+  unsigned int n_warmup_frames;
+  /*! @brief Number of logged frames of every run. */
+  unsigned int n_frames;
+  /*! @brief Whether every run is rendered a second time to count its light
+   *         calculations.
+   */
+  bool is_counting_calculations;
+  /*! @brief Path of the exported csv file. */
+  std::string output_path;
+
+  // --------------------------------------------------------------------------
+  //  Execution
+  // --------------------------------------------------------------------------
+  /*! @brief The hidden window shared by all runs, NULL before init. */
+  GLFWwindow* p_window;
+  /*! @brief The OffscreenBuffer all runs of the current scene render to,
+   *         NULL outside of executeScene.
+   */
+  OffscreenBuffer* p_offscreen_buffer;
+  /*! @brief The camera of the current scene at construction, to which every
+   *         run is reset.
+   */
+  camera::Camera initial_camera;
+  /*! @brief The results of all rendered runs. */
+  std::vector<Result> results;
+};
+
+} // main
+} // nTiled
@@ -25,6 +25,7 @@
 #include "world\World.h"
 #include "state\State.h"
 #include "pipeline\Pipeline.h"
+#include "main\OffscreenBuffer.h"
 
 #include "log\Logger.h"
 #include "log\LightCalculationsLogger.h"
@@ -48,8 +49,12 @@ public:
    *
    * @param scene_path Path to the scene configuration json this nTiled execution 
    *                   should run.
+   * @param is_headless Whether to render headless, regardless of the scene
+   *                    configuration. A headless execution renders offscreen
+   *                    without gui or buffer swaps, and stops once all frame
+   *                    events have been executed.
    */
-  Controller(const std::string& scene_path);
+  Controller(const std::string& scene_path, bool is_headless = false);
 
   /*! @brief Destruct this Controller. */
   ~Controller();
@@ -94,6 +99,16 @@ public:
    */
   void exit();
 
+  /*! @brief Create the hidden window of a headless execution, falling back
+   *         on an OSMesa or EGL context without a display, such as Mesa's
+   *         software rasterizer on a server. Initialises GLFW.
+   *
+   * @param viewport The dimensions of the default framebuffer in pixels.
+   *
+   * @return The hidden window, NULL if no context could be created.
+   */
+  static GLFWwindow* createHeadlessWindow(glm::uvec2 viewport);
+
 private:
   // --------------------------------------------------------------------------
   //  Initialise methods
@@ -106,6 +121,7 @@ private:
    */
   void initialiseOpenGL();
 
+
   /*! @brief Initialise all components of nTiled. 
    */
   void initialiseNTiledComponents();
@@ -138,6 +154,11 @@ private:
   /*! @brief Pointer to the GuiManager of this Controller. */
   gui::GuiManager* p_gui_manager;
 
+  /*! @brief Pointer to the OffscreenBuffer headless executions render to,
+   *         nullptr if this Controller renders to its window.
+   */
+  OffscreenBuffer* p_offscreen_buffer;
+
   /*! @brief Clock object of this Controller. */
   Clock clock;
 
@@ -158,6 +179,9 @@ private:
   /*! @brief Scene path of this controller*/
   const std::string scene_path;
 
+  /*! @brief Whether headless rendering is forced, regardless of the scene. */
+  const bool is_forced_headless;
+
   /*! @brief Pointer to the current DrawMethod of this controller. */
   DrawMethod* current_draw_method;
  
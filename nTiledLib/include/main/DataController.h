@@ -1,5 +1,11 @@
 #pragma once
 
+// ----------------------------------------------------------------------------
+//  System Libraries
+// ----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 //  nTiled Headers
 // ----------------------------------------------------------------------------
@@ -9,6 +15,50 @@
 namespace nTiled {
 namespace main {
 
+/*! @brief DataController constructs the LinklessOctree of the lights of a
+ *         config file and logs its construction time and memory usage.
+ *
+ * If the config file contains a "sweep" section, the LinklessOctree is
+ * instead constructed repeatedly for every combination of the listed
+ * HashedConfig parameters, and the statistics of every combination are
+ * exported to a single csv file:
+ *
+ * @code{.js}
+ * "sweep": { "node_size": [ ... ]
+ *          , "starting_depth": [ ... ]
+ *          , "r_increase_ratio": [ ... ]
+ *          , "max_attempts": [ ... ]
+ *          , "seed": [ ... ]
+ *          , "build_method": [ "top_down", "morton" ]
+ *          , "dense_occupancy_threshold": [ ... ]
+ *          , "table_layout": [ "textures", "packed" ]
+ *          , "pow2_tables": [ false, true ]
+ *          , "backend": [ "perfect_spatial", "displacement" ]
+ *          , "portfolio_size": [ 1, 4 ]
+ *          , "auto_tune": [ false, true ]
+ *          , "memory_budget": [ ... ]
+ *          , "repetitions": 10
+ *          , "output_path": "<path to sweep.csv>"
+ *          }
+ * @endcode
+ *
+ * where parameters which are not listed are taken from "hashed_config".
+ * After every successful construction the lights are retrieved on a grid of
+ * 64^3 points over the LinklessOctree, which is logged as the lookup stage.
+ * The construction of every single SpatialHashFunction is logged as a stage
+ * of its backend, such that sweeping the seed exposes the tail latency of
+ * the construction across seeds.
+ * Points which auto tune replace the node size, starting depth and r 
+ * increase ratio by those chosen for their memory budget, which are 
+ * exported alongside the predicted and actual bytes in the table layout 
+ * of the point and the predicted mean fetches per query.
+ * The peak memory growth of every point is the peak resident memory of the
+ * process during the point minus its resident memory at the start of the
+ * point. Where the peak can not be reset, as on Windows, it is measured
+ * against the peak since the process started instead, such that points
+ * after a more memory intensive point report too much growth and build 
+ * methods are best compared in separate sweeps.
+ */
 class DataController {
 public:
   DataController(const std::string& config_path);
@@ -19,6 +69,43 @@ public:
   void exportData();
 
 private:
+  /*! @brief SweepResult holds the statistics of a single point of a sweep. */
+  struct SweepResult {
+    /*! @brief The HashedConfig of this point. */
+    pipeline::hashed::HashedConfig hashed_config;
+    /*! @brief Number of repetitions in which the construction failed. */
+    unsigned int n_failed;
+    /*! @brief Statistics of the construction and each of its stages. */
+    std::vector<logged::ScopeStats> stage_stats;
+    /*! @brief Statistics of the number of retries per hash function. */
+    logged::ScopeStats retry_stats;
+    /*! @brief Memory usage of the last successful repetition. */
+    pipeline::hashed::HashedMemoryUsage memory_usage;
+    /*! @brief Growth of the peak resident memory of the process over its
+     *         resident memory at the start of this point in bytes.
+     */
+    std::size_t peak_memory_growth;
+    /*! @brief The HashedTuning of the last successful repetition. */
+    pipeline::hashed::HashedTuning tuning;
+    /*! @brief Whether tuning holds the HashedTuning of a repetition. */
+    bool has_tuned;
+  };
+
+  /*! @brief Construct the LinklessOctree repeatedly for every point of the
+   *         sweep.
+   */
+  void executeSweep();
+
+  /*! @brief Construct the LinklessOctree n_repetitions times with the
+   *         specified HashedConfig.
+   */
+  SweepResult executeSweepPoint(const pipeline::hashed::HashedConfig& hashed_config);
+
+  /*! @brief Export the results of the sweep as a csv file with a row per
+   *         point to sweep_output_path.
+   */
+  void exportSweep();
+
   bool has_init;
 
   const std::string config_path;
@@ -30,6 +117,20 @@ private:
   logged::ExecutionTimeLogger logger;
   pipeline::hashed::HashedLightManagerLogged* p_logged_manager;
   world::World* p_world;
+
+  // --------------------------------------------------------------------------
+  //  Sweep
+  // --------------------------------------------------------------------------
+  /*! @brief Whether the config file specifies a sweep. */
+  bool is_sweeping;
+  /*! @brief The HashedConfig of every point of the sweep. */
+  std::vector<pipeline::hashed::HashedConfig> sweep_configs;
+  /*! @brief Number of constructions per point of the sweep. */
+  unsigned int n_repetitions;
+  /*! @brief Path of the exported sweep csv file. */
+  std::string sweep_output_path;
+  /*! @brief The results of every executed point of the sweep. */
+  std::vector<SweepResult> sweep_results;
 };
 
 }
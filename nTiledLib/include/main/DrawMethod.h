@@ -4,10 +4,15 @@
  */
 #pragma once
 
+#include <chrono>
+#include <vector>
+
 #include "pipeline\Pipeline.h"
 #include "gui\GuiManager.h"
 
 #include "Clock.h"
+#include "FrameCapture.h"
+#include "OffscreenBuffer.h"
 
 namespace nTiled {
 
@@ -20,7 +25,7 @@ namespace nTiled {
 class DrawMethod {
 public:
   /*! @brief Destruct this DrawMethod. */
-  ~DrawMethod() {}
+  virtual ~DrawMethod() {}
   /*! @brief Draw the current frame with the given parameters.
    */
   virtual void draw(GLFWwindow* window,
@@ -28,6 +33,12 @@ public:
                     gui::GuiManager* gui_manager,
                     state::View& view,
                     const Clock& clock) const = 0;
+
+  /*! @brief Finish all work of this DrawMethod. Called when this DrawMethod
+   *         stops being the active DrawMethod, while the openGL context 
+   *         still exists.
+   */
+  virtual void finish() {}
 };
 
 
@@ -39,15 +50,23 @@ public:
   /*! @brief Construct a new DrawToMemory with the given parameters.
    * 
    * @param path Path to the directory where each image should be saved.
-   * @param view Reference to the View this DrawMethod uses.
+   * @param view Reference to the View this DrawMethod uses, if it is
+   *             headless the gui is not updated and buffers are not
+   *             swapped.
+   * @param p_offscreen_buffer Pointer to the OffscreenBuffer frames are
+   *                           drawn to and read from, nullptr to use the
+   *                           default framebuffer.
    */
   DrawToMemory(std::string path,
-               state::View& view);
+               state::View& view,
+               const OffscreenBuffer* p_offscreen_buffer = nullptr);
 
   ~DrawToMemory();
 
   /*! @brief Draw the current frame on the screen and write the result to 
-   *         memory.
+   *         memory. If the ViewOutput of the view is an asynchronous capture
+   *         the frame is written by a FrameCapture, otherwise it is read
+   *         back and written before this method returns.
    * 
    * @param window  pointer to the openGL window
    * @param p_pipeline pointer to the pipeline
@@ -61,14 +80,35 @@ public:
                     state::View& view,
                     const Clock& clock) const override;
 
+  /*! @brief Write all outstanding frames and report the capture throughput.
+   */
+  virtual void finish() override;
+
 private:
   /*! @brief Path to the directory this DrawMethod saves frames to. */
   const std::string path;
+  /*! @brief The CaptureFormat frames are written in. */
+  const state::CaptureFormat format;
+  /*! @brief Whether frames are rendered headless. */
+  const bool is_headless;
+  /*! @brief Pointer to the OffscreenBuffer frames are drawn to, nullptr if
+   *         they are drawn to the default framebuffer.
+   */
+  const OffscreenBuffer* p_offscreen_buffer;
+
+  /*! @brief Pointer to the FrameCapture used for asynchronous capture, 
+   *         nullptr if frames are captured synchronously.
+   */
+  FrameCapture* p_capture;
+  /*! @brief Pixels of the last synchronously captured frame. */
+  mutable std::vector<unsigned char> pixels;
 
-  /*! @brief pointer to the array of raw pixel values. */
-  GLubyte* p_raw_pixel_buffer;
-  /*! @brief pointer to the array of the output buffer. */
-  GLubyte* p_output_buffer;
+  /*! @brief Number of frames captured since the last finish. */
+  mutable unsigned int n_captured_frames;
+  /*! @brief Time at which the first frame since the last finish was 
+   *         captured.
+   */
+  mutable std::chrono::steady_clock::time_point capture_start;
 };
 
 
@@ -91,4 +131,49 @@ public:
                     const Clock& clock) const override;
 };
 
+
+/*! @brief DrawMethod to draw the frame to an OffscreenBuffer, without gui
+ *         or buffer swaps, as when rendering headless. The pipeline should
+ *         output to the same OffscreenBuffer. At most max_frames_in_flight
+ *         frames are queued on the GPU, such that frame times are not
+ *         hidden by an ever growing command queue.
+ */
+class DrawOffscreen : public DrawMethod {
+public:
+  /*! @brief Construct a new DrawOffscreen.
+   *
+   * @param offscreen_buffer Reference to the OffscreenBuffer frames are
+   *                         drawn to.
+   * @param max_frames_in_flight The maximum number of frames submitted but
+   *                             not yet completed by the GPU.
+   */
+  DrawOffscreen(const OffscreenBuffer& offscreen_buffer,
+                unsigned int max_frames_in_flight = 2);
+
+  /*! @brief Draw the current frame offscreen
+   *
+   * @param window  pointer to the openGL window
+   * @param p_pipeline pointer to the pipeline
+   * @param gui_manager the gui, only used to update the camera
+   * @param view Reference to the View 
+   * @param clock Clock object this DrawMethod observes.
+   */
+  virtual void draw(GLFWwindow* window,
+                    pipeline::Pipeline* p_pipeline,
+                    gui::GuiManager* gui_manager,
+                    state::View& view,
+                    const Clock& clock) const override;
+
+  /*! @brief Wait until all drawn frames are completed. */
+  virtual void finish() override;
+
+private:
+  /*! @brief The OffscreenBuffer frames are drawn to. */
+  const OffscreenBuffer& offscreen_buffer;
+  /*! @brief Fences of the frames in flight, 0 for unused entries. */
+  mutable std::vector<GLsync> fences;
+  /*! @brief Index of the fence of the next frame. */
+  mutable unsigned int next_fence;
+};
+
 } // nTiled
@@ -0,0 +1,167 @@
+/*! @file FrameCapture.h
+ *  @brief FrameCapture.h contains the definition of FrameCapture, which reads
+ *         back rendered frames asynchronously and writes them to storage on
+ *         a pool of worker threads.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glad\glad.h>
+#include <glm\glm.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "state\StateView.h"
+
+
+namespace nTiled {
+
+/*! @brief Get the openGL pixel format in which frames of the specified
+ *         CaptureFormat are read back.
+ */
+GLenum getCaptureReadFormat(state::CaptureFormat format);
+
+/*! @brief Write the specified frame to storage in the specified
+ *         CaptureFormat.
+ *
+ * @param path Path of the image file, including its extension.
+ * @param pixels The pixels of the frame as read back with
+ *               getCaptureReadFormat, bottom row first.
+ * @param width Width of the frame in pixels.
+ * @param height Height of the frame in pixels.
+ * @param format The CaptureFormat of the image file.
+ *
+ * @return Whether the frame was written.
+ */
+bool writeFrame(const std::string& path,
+                const std::vector<unsigned char>& pixels,
+                unsigned int width,
+                unsigned int height,
+                state::CaptureFormat format);
+
+/*! @brief Get the file extension of the specified CaptureFormat. */
+std::string getCaptureExtension(state::CaptureFormat format);
+
+
+/*! @brief FrameCapture reads back frames through a ring of pixel pack
+ *         buffers and writes them to storage on worker threads.
+ *
+ * The read back of a frame is started with capture, and completed when its
+ * pixel pack buffer is reused n_buffers frames later, by which time its
+ * fence has usually been signalled, such that the render thread does not
+ * wait for the GPU. The completed frames are queued for the worker threads,
+ * the queue holds at most max_queue_depth frames, capture blocks while the
+ * queue is full.
+ */
+class FrameCapture {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor | Destructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new FrameCapture.
+   *
+   * @param viewport The dimensions of the captured frames in pixels.
+   * @param format The CaptureFormat frames are written in.
+   * @param n_buffers The number of pixel pack buffers in the ring.
+   * @param n_threads The number of worker threads, if 0 the number of
+   *                  hardware threads is used.
+   * @param max_queue_depth The maximum number of frames waiting for a
+   *                        worker thread.
+   */
+  FrameCapture(glm::uvec2 viewport,
+               state::CaptureFormat format,
+               unsigned int n_buffers = 3,
+               unsigned int n_threads = 0,
+               unsigned int max_queue_depth = 8);
+
+  /*! @brief Destruct this FrameCapture, writing all queued frames and
+   *         deleting the fences and pixel buffers of its slots. Frames
+   *         which are still being read back are lost, call flush first.
+   */
+  ~FrameCapture();
+
+  // --------------------------------------------------------------------------
+  //  Capture
+  // --------------------------------------------------------------------------
+  /*! @brief Start reading back the current read buffer, to be written to
+   *         the specified path.
+   *
+   * @param path Path of the image file, including its extension.
+   */
+  void capture(const std::string& path);
+
+  /*! @brief Complete all read backs and wait until all captured frames are
+   *         written.
+   */
+  void flush();
+
+  /*! @brief Get the number of frames written by this FrameCapture. */
+  unsigned int getNFramesWritten() const { return this->n_frames_written; }
+
+private:
+  /*! @brief Slot is a single pixel pack buffer of the ring. */
+  struct Slot {
+    GLuint pbo;
+    GLsync fence;
+    std::string path;
+  };
+
+  /*! @brief Job is a frame waiting to be written by a worker thread. */
+  struct Job {
+    std::string path;
+    std::vector<unsigned char> pixels;
+  };
+
+  /*! @brief Wait for the read back of slot, copy its pixels and queue them
+   *         for the worker threads.
+   */
+  void retire(Slot& slot);
+
+  /*! @brief Main loop of a worker thread. */
+  void work();
+
+  /*! @brief The dimensions of the captured frames in pixels. */
+  const glm::uvec2 viewport;
+  /*! @brief The CaptureFormat frames are written in. */
+  const state::CaptureFormat format;
+  /*! @brief Size in bytes of a single frame. */
+  const GLsizeiptr frame_size;
+  /*! @brief Maximum number of frames waiting for a worker thread. */
+  const unsigned int max_queue_depth;
+
+  /*! @brief The ring of pixel pack buffers. */
+  std::vector<Slot> slots;
+  /*! @brief Index of the Slot used by the next capture. */
+  unsigned int next_slot;
+
+  /*! @brief Frames waiting for a worker thread. */
+  std::deque<Job> queue;
+  /*! @brief Number of frames taken from queue and not yet written. */
+  unsigned int n_active_jobs;
+  /*! @brief Whether the worker threads should stop once queue is empty. */
+  bool is_stopping;
+  /*! @brief Mutex guarding queue, n_active_jobs and is_stopping. */
+  std::mutex queue_mutex;
+  /*! @brief Signalled when a frame is added to queue or on stopping. */
+  std::condition_variable queue_filled;
+  /*! @brief Signalled when a frame is taken from queue or written. */
+  std::condition_variable queue_drained;
+
+  /*! @brief The worker threads. */
+  std::vector<std::thread> workers;
+  /*! @brief Number of frames written. */
+  std::atomic<unsigned int> n_frames_written;
+};
+
+} // nTiled
@@ -0,0 +1,59 @@
+/*! @file OffscreenBuffer.h
+ *  @brief OffscreenBuffer.h contains the definition of the OffscreenBuffer
+ *         headless executions render to instead of a window.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glad\glad.h>
+#include <glm\glm.hpp>
+
+namespace nTiled {
+
+/*! @brief OffscreenBuffer is a framebuffer object with a colour and a depth
+ *         attachment. Headless executions render to it rather than to the
+ *         default framebuffer of their hidden window, which is not
+ *         guaranteed to hold any pixels.
+ */
+class OffscreenBuffer {
+public:
+  /*! @brief Construct a new OffscreenBuffer with the given dimensions.
+   *
+   * @param viewport The dimensions of the attachments of this new
+   *                 OffscreenBuffer.
+   *
+   * @throws std::runtime_error If the framebuffer object is not complete.
+   */
+  OffscreenBuffer(glm::uvec2 viewport);
+
+  /*! @brief Destruct this OffscreenBuffer. */
+  ~OffscreenBuffer();
+
+  /*! @brief Bind this OffscreenBuffer such that values will be written to
+   *         it.
+   */
+  void bindForWriting() const;
+
+  /*! @brief Bind this OffscreenBuffer such that its colour attachment is
+   *         read by glReadPixels.
+   */
+  void bindForReading() const;
+
+  /*! @brief Get the openGL pointer to the Frame Buffer Object (FBO)
+   *
+   * @return openGL pointer to the FBO.
+   */
+  GLuint getPointerFBO() const { return this->p_fbo; }
+
+private:
+  /*! @brief Framebuffer object pointer */
+  GLuint p_fbo;
+  /*! @brief Pointer to the colour renderbuffer of this OffscreenBuffer */
+  GLuint p_colour_buffer;
+  /*! @brief Pointer to the depth renderbuffer of this OffscreenBuffer */
+  GLuint p_depth_buffer;
+};
+
+} // nTiled
@@ -0,0 +1,80 @@
+/*! @file morton.h
+ *  @brief morton.h contains the functions to convert between 3d integer
+ *         coordinates and their Morton codes.
+ *
+ * A Morton code interleaves the bits of the x, y and z coordinates, with x in
+ * the least significant bit of every group of three bits. Ordering the nodes
+ * of a single octree level by their Morton code lists the children of every
+ * node consecutively, in the order of their child index x + 2y + 4z.
+ */
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace nTiled {
+namespace math {
+
+/*! @brief The maximum number of bits per coordinate of a Morton code. */
+constexpr unsigned int kMortonBitsPerDim = 21;
+
+/*! @brief Spread the lower 21 bits of x such that two zero bits lie between
+ *         every pair of consecutive bits.
+ *
+ * @param x The value of which the bits are spread.
+ *
+ * @return The spread bits of x.
+ */
+inline std::uint64_t spreadBits3(std::uint64_t x) {
+  x &= 0x1fffff;
+  x = (x | (x << 32)) & 0x1f00000000ffff;
+  x = (x | (x << 16)) & 0x1f0000ff0000ff;
+  x = (x | (x << 8))  & 0x100f00f00f00f00f;
+  x = (x | (x << 4))  & 0x10c30c30c30c30c3;
+  x = (x | (x << 2))  & 0x1249249249249249;
+  return x;
+}
+
+/*! @brief Compact every third bit of x, the inverse of spreadBits3.
+ *
+ * @param x The value of which the bits are compacted.
+ *
+ * @return The compacted bits of x.
+ */
+inline std::uint64_t compactBits3(std::uint64_t x) {
+  x &= 0x1249249249249249;
+  x = (x | (x >> 2))  & 0x10c30c30c30c30c3;
+  x = (x | (x >> 4))  & 0x100f00f00f00f00f;
+  x = (x | (x >> 8))  & 0x1f0000ff0000ff;
+  x = (x | (x >> 16)) & 0x1f00000000ffff;
+  x = (x | (x >> 32)) & 0x1fffff;
+  return x;
+}
+
+/*! @brief Encode the point p as a Morton code.
+ *
+ * @param p The point to be encoded, of which every coordinate is smaller
+ *          than 2^kMortonBitsPerDim.
+ *
+ * @return The Morton code of p.
+ */
+inline std::uint64_t encodeMorton(glm::uvec3 p) {
+  return (spreadBits3(p.x) |
+          (spreadBits3(p.y) << 1) |
+          (spreadBits3(p.z) << 2));
+}
+
+/*! @brief Decode the Morton code into its point.
+ *
+ * @param code The Morton code to be decoded.
+ *
+ * @return The point of which code is the Morton code.
+ */
+inline glm::uvec3 decodeMorton(std::uint64_t code) {
+  return glm::uvec3(unsigned int(compactBits3(code)),
+                    unsigned int(compactBits3(code >> 1)),
+                    unsigned int(compactBits3(code >> 2)));
+}
+
+}
+}
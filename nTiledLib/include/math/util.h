@@ -45,6 +45,30 @@ inline unsigned int getNextPow2(unsigned int x) {
   return x;
 }
 
+/*! @brief Check whether the given unsigned int is a power of 2.
+ *
+ * @param x the input unsigned integer.
+ *
+ * @return True if x is a power of 2, False otherwise.
+ */
+inline bool isPow2(unsigned int x) {
+  return (x != 0) && ((x & (x - 1)) == 0);
+}
+
+/*! @brief Wrap value into [0, dim), with a mask if is_pow2 and a modulo 
+ *         otherwise. is_pow2 is a template parameter such that callers 
+ *         which wrap many values with the same dim branch once.
+ *
+ * @param value The value to be wrapped.
+ * @param dim The dimension to wrap to, a power of 2 if is_pow2.
+ *
+ * @return value % dim
+ */
+template <bool is_pow2>
+inline unsigned int wrap(unsigned int value, unsigned int dim) {
+  return is_pow2 ? (value & (dim - 1)) : (value % dim);
+}
+
 inline unsigned int gcd(unsigned int a, unsigned int b) {
   unsigned int t;
   while (b != 0) {
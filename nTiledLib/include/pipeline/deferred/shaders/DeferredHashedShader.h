@@ -58,6 +58,9 @@ private:
   /*! @brief Pointer to the HashedLightManager of this DeferredHashedShader. */
   hashed::HashedLightManager* p_light_manager;
 
+  /*! @brief Uniform location of inv_camera_matrix in the light pass. */
+  GLint p_inv_camera_matrix;
+
 
 };
 
@@ -19,6 +19,7 @@
 
 #include "pipeline\PipelineObject.h"
 #include "pipeline\PipelineLight.h"
+#include "pipeline\pipeline-util\DrawSubmission.h"
 
 #include "pipeline\deferred\GBuffer.h"
 
@@ -162,6 +163,11 @@ protected:
   // --------------------------------------------------------------------------
   //  Render subfunctions
   // --------------------------------------------------------------------------
+  /*! @brief Determine the objects of this DeferredShader within the camera
+   *         frustum, which are the only objects drawn this frame.
+   */
+  virtual void cullObjects();
+
   /*! @brief Render the geometry (first) pass of this DeferredShader
    *
    * Render all the attributes needed for the light (second) pass
@@ -213,6 +219,11 @@ protected:
    */
   std::vector<PipelineObject*> ps_obj;
 
+  /*! @brief DrawSubmission submitting the geometry pass draw calls of all
+   *         PipelineObjects of this DeferredShader.
+   */
+  DrawSubmission* p_draw_submission;
+
   /*! Vector containing all PipelineLights of this DeferredShader. */
   std::vector<PipelineLight> lights;
 
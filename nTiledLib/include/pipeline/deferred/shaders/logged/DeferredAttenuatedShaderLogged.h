@@ -21,6 +21,7 @@ public:
     logged::ExecutionTimeLogger& logger);
 
 protected:
+  virtual void cullObjects() override;
   virtual void renderGeometryPassObjects() override;
   virtual void renderLightPassObjects() override;
 
@@ -14,6 +14,7 @@
 
 #include "pipeline\PipelineObject.h"
 #include "pipeline\PipelineLight.h"
+#include "pipeline\pipeline-util\DrawSubmission.h"
 
 namespace nTiled {
 namespace pipeline {
@@ -80,13 +81,6 @@ public:
     this->p_output_buffer = p_output_buffer; 
   }
 
-  /*! @brief Functionality executed before rendering an object in renderObjects
-   *         which can be extended by child classes.
-   *
-   * @param p_obj pointer to the PipelineObject which will be rendered.
-   */
-  virtual void preObjectRendering(PipelineObject* p_obj) { }
-
 protected:
   // --------------------------------------------------------------------------
   //  glsl management
@@ -133,6 +127,11 @@ protected:
   // --------------------------------------------------------------------------
   //  Render subfunctions
   // --------------------------------------------------------------------------
+  /*! @brief Determine the objects of this ForwardShader within the camera
+   *         frustum, which are the only objects drawn this frame.
+   */
+  virtual void cullObjects();
+
   /*! @brief render all objects in this ForwardShader. */
   virtual void renderObjects();
 
@@ -156,6 +155,11 @@ protected:
    */
   std::vector<PipelineObject*> ps_obj;
 
+  /*! @brief DrawSubmission submitting the draw calls of all PipelineObjects
+   *         of this ForwardShader.
+   */
+  DrawSubmission* p_draw_submission;
+
   /*! Vector containing all PipelineLights of this ForwardShader. */
   std::vector<PipelineLight> lights;
 
@@ -30,6 +30,7 @@ public:
     logged::ExecutionTimeLogger& logger);
 
 protected:
+  virtual void cullObjects() override;
   virtual void renderObjects() override;
 
   /*! @brief Reference to the ExecutionTimeLogger object which logs
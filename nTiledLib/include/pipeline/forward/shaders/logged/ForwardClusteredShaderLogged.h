@@ -32,6 +32,7 @@ public:
     logged::ExecutionTimeLogger& logger);
 
 protected:
+  virtual void cullObjects() override;
   virtual void renderObjects() override;
   virtual void depthPass() override;
   virtual void loadLightClustering() override;
@@ -39,6 +39,7 @@ public:
                             logged::ExecutionTimeLogger& logger);
 
 protected:
+  virtual void cullObjects() override;
   virtual void renderObjects() override;
 
 private:
@@ -25,6 +25,12 @@ class HashedShadingInvalidStartingDepthException : public HashedShadingException
   }
 };
 
+class HashedShadingDepthException : public HashedShadingException {
+  virtual const char* what() const throw() {
+    return "The depth of the octree exceeds the depth supported by Morton codes.";
+  }
+};
+
 }
 }
 }
\ No newline at end of file
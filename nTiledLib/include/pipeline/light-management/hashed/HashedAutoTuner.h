@@ -0,0 +1,138 @@
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstddef>
+#include <vector>
+#include <glm\glm.hpp>
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "world\PointLight.h"
+#include "HashedConfig.h"
+
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+/*! @brief HashedTuning describes a single set of hashed shading parameters,
+ *         and the memory and lookup cost predicted for them.
+ */
+struct HashedTuning {
+  /*! @brief The minimum node size of the LightOctree. */
+  double minimum_node_size;
+  /*! @brief The depth of the first level of the LinklessOctree. */
+  unsigned int starting_depth;
+  /*! @brief The ratio with which a table grows per failed attempt. */
+  double r_increase_ratio;
+  /*! @brief The depth of the LightOctree fitting all lights. */
+  unsigned int light_octree_depth;
+  /*! @brief Predicted size in bytes of the light indices and tables in the 
+   *         table layout, if every table is built in its first attempt.
+   */
+  std::size_t predicted_bytes;
+  /*! @brief Predicted size in bytes of the light indices and tables in the 
+   *         table layout, if every table is built in its second attempt.
+   */
+  std::size_t predicted_retry_bytes;
+  /*! @brief Predicted mean number of table fetches per query, as
+   *         LinklessOctree::getMeanNFetches.
+   */
+  double predicted_fetches;
+  /*! @brief Whether predicted_bytes meets the memory budget. */
+  bool meets_budget;
+};
+
+
+/*! @brief HashedAutoTuner chooses the minimum node size, starting depth and
+ *         r increase ratio of hashed shading for a set of lights.
+ *
+ * Candidate node sizes halve from the radius of the smallest lights, and
+ * for each every starting depth within the LightOctree is considered. The
+ * nodes of all lights are sorted once per node size by a 
+ * MortonOctreeBuilder, of which the nodes of every level are counted in a 
+ * single pass without building any hash function. The entries of the 
+ * levels of each starting depth follow from these counts, and the table
+ * sizes from the HashFunctionBuilder of the backend and the table layout, 
+ * such that the predicted memory is exact if every table is built in its 
+ * first attempt.
+ *
+ * The finest node size of which a candidate meets the memory budget is
+ * chosen, as it culls the lights of a fragment most precisely, and of its
+ * candidates the starting depth with the fewest predicted fetches per 
+ * query. The r increase ratio is the largest for which the tables still 
+ * meet the budget if each needs a second attempt. If no candidate meets 
+ * the budget, the smallest candidate is chosen.
+ */
+class HashedAutoTuner {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new HashedAutoTuner for the given lights, with the
+   *         dense occupancy threshold, table dimensions, table layout, 
+   *         backend and memory budget of the given HashedConfig.
+   *
+   * @param p_lights The lights for which parameters are chosen
+   * @param hashed_config The HashedConfig of the tuned HashedLightManager
+   */
+  HashedAutoTuner(const std::vector<world::PointLight*>& p_lights,
+                  const HashedConfig& hashed_config);
+
+  // --------------------------------------------------------------------------
+  //  Tuning
+  // --------------------------------------------------------------------------
+  /*! @brief Choose the parameters for the lights of this HashedAutoTuner.
+   *
+   * @returns The chosen HashedTuning.
+   * @throws HashedShadingNoLightException If there are no lights.
+   * @throws HashedShadingInvalidStartingDepthException If no node size 
+   *         yields a LightOctree of at least two levels.
+   */
+  HashedTuning tune() const;
+
+  /*! @brief Predict the memory and lookup cost of the given parameters.
+   *
+   * @throws HashedShadingInvalidStartingDepthException If the starting 
+   *         depth is not within the LightOctree.
+   * @throws HashedShadingDepthException If the depth of the LightOctree 
+   *         exceeds the depth supported by Morton codes.
+   */
+  HashedTuning predict(double minimum_node_size,
+                       unsigned int starting_depth,
+                       double r_increase_ratio) const;
+
+  /*! @brief Calculate the origin and depth of the LightOctree with the 
+   *         given minimum node size which contains the given lights.
+   *
+   * @param p_lights The lights contained in the LightOctree
+   * @param minimum_node_size The minimum node size of the LightOctree
+   * @param origin The origin of the LightOctree
+   * @param depth The depth of the LightOctree
+   */
+  static void calculateLightOctreeBounds(const std::vector<world::PointLight*>& p_lights,
+                                         double minimum_node_size,
+                                         glm::vec3& origin,
+                                         unsigned int& depth);
+
+private:
+  /*! @brief The lights for which parameters are chosen. */
+  const std::vector<world::PointLight*>& p_lights;
+  /*! @brief The dense occupancy threshold of the tuned LinklessOctree. */
+  double dense_occupancy_threshold;
+  /*! @brief Whether the hash tables have a power of two dimension. */
+  bool pow2_tables;
+  /*! @brief The layout in which the tables are stored on the GPU. */
+  HashedTableLayout table_layout;
+  /*! @brief The backend constructing the SpatialHashFunctions. */
+  HashedBackend backend;
+  /*! @brief The memory budget in bytes. */
+  std::size_t memory_budget;
+};
+
+}
+}
+}
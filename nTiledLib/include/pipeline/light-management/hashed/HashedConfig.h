@@ -1,9 +1,92 @@
 #pragma once
 
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstddef>
+#include <string>
+
+#include <rapidjson\document.h>
+
 namespace nTiled {
 namespace pipeline {
 namespace hashed {
 
+/*! @brief HashedBuildMethod specifies how the LinklessOctree is constructed. */
+enum class HashedBuildMethod {
+  /*! @brief Insert a SingleLightTree per light into a LightOctree and
+   *         traverse it level by level.
+   */
+  TopDown,
+  /*! @brief Sort the classified nodes of every light by Morton code and
+   *         group them directly into levels, without a LightOctree.
+   */
+  Morton,
+};
+
+/*! @brief Parse the HashedBuildMethod with the given name, either "top_down"
+ *         or "morton".
+ *
+ * @throws std::runtime_error If name is not a HashedBuildMethod.
+ */
+HashedBuildMethod parseHashedBuildMethod(const std::string& name);
+
+/*! @brief Get the name of the HashedBuildMethod as parsed by
+ *         parseHashedBuildMethod.
+ */
+std::string getHashedBuildMethodName(HashedBuildMethod method);
+
+/*! @brief HashedTableLayout specifies how the tables of the LinklessOctree
+ *         are stored on the GPU.
+ */
+enum class HashedTableLayout {
+  /*! @brief Store every table of every level as a separate 3d texture. */
+  Textures,
+  /*! @brief Pack the tables of all levels into shader storage buffers at
+   *         their exact width.
+   */
+  Packed,
+};
+
+/*! @brief Parse the HashedTableLayout with the given name, either "textures"
+ *         or "packed".
+ *
+ * @throws std::runtime_error If name is not a HashedTableLayout.
+ */
+HashedTableLayout parseHashedTableLayout(const std::string& name);
+
+/*! @brief Get the name of the HashedTableLayout as parsed by
+ *         parseHashedTableLayout.
+ */
+std::string getHashedTableLayoutName(HashedTableLayout layout);
+
+/*! @brief HashedBackend specifies how the SpatialHashFunctions of the
+ *         levels of the LinklessOctree are constructed.
+ */
+enum class HashedBackend {
+  /*! @brief Perfect Spatial Hashing with the SpatialHashFunctionBuilder,
+   *         which grows the offset table until construction succeeds.
+   */
+  PerfectSpatial,
+  /*! @brief Bucketed displacement with the 
+   *         DisplacementHashFunctionBuilder, which probes a bounded number 
+   *         of offsets per bucket and grows the hash table on failure.
+   */
+  Displacement,
+};
+
+/*! @brief Parse the HashedBackend with the given name, either 
+ *         "perfect_spatial" or "displacement".
+ *
+ * @throws std::runtime_error If name is not a HashedBackend.
+ */
+HashedBackend parseHashedBackend(const std::string& name);
+
+/*! @brief Get the name of the HashedBackend as parsed by 
+ *         parseHashedBackend.
+ */
+std::string getHashedBackendName(HashedBackend backend);
+
 struct HashedConfig {
   HashedConfig();
   HashedConfig(float minimum_node_size,
@@ -21,8 +104,60 @@ struct HashedConfig {
   double r_increase_ratio;
   unsigned int max_attempts;
   unsigned int seed;
+  HashedBuildMethod build_method;
+  /*! @brief The minimal fraction of the nodes of a LinklessOctree level
+   *         which should be defined to store the level as a dense grid
+   *         instead of a spatial hash function. Values above 1 disable
+   *         dense levels.
+   */
+  double dense_occupancy_threshold;
+  HashedTableLayout table_layout;
+  /*! @brief Whether the host copies of the tables of the LinklessOctree are
+   *         released once they are loaded to a shader, which disables 
+   *         retrieving lights on the CPU.
+   */
+  bool release_host_tables;
+  /*! @brief Whether the hash tables of the LinklessOctree get a power of two
+   *         dimension m and an odd offset table dimension r, such that 
+   *         lookups wrap with a mask instead of a modulo at the cost of
+   *         larger hash tables.
+   */
+  bool pow2_tables;
+  HashedBackend backend;
+  /*! @brief The number of HashFunctionBuilders, each with its own seed, 
+   *         which race to construct every SpatialHashFunction. Values
+   *         below 2 construct with a single HashFunctionBuilder.
+   */
+  unsigned int portfolio_size;
+  /*! @brief Whether the minimum node size, starting depth and r increase 
+   *         ratio are chosen by a HashedAutoTuner from the lights of the 
+   *         world, instead of taken from this HashedConfig.
+   */
+  bool auto_tune;
+  /*! @brief The budget in bytes of the light indices and the tables in 
+   *         table_layout of the LinklessOctree, which auto tuning aims to 
+   *         meet.
+   */
+  std::size_t memory_budget;
 };
 
+/*! @brief Parse the HashedConfig of the given json object, of the form
+ *
+ * @code
+ * { "node_size", "starting_depth", "r_increase_ratio", "max_attempts"
+ * , "seed", "build_method", "dense_occupancy_threshold", "table_layout"
+ * , "release_host_tables", "pow2_tables", "backend", "portfolio_size"
+ * , "auto_tune", "memory_budget"
+ * }
+ * @endcode
+ *
+ * where every member from "seed" onwards is optional.
+ *
+ * @throws std::runtime_error If the build method, table layout or backend
+ *         is unknown.
+ */
+HashedConfig parseHashedConfig(const rapidjson::Value& hashed_config_json);
+
 }
 }
 }
\ No newline at end of file
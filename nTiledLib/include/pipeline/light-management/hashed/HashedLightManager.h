@@ -7,6 +7,7 @@
 #include "light-octree\LightOctree.h"
 #include "linkless-octree\LinklessOctree.h"
 #include "HashedConfig.h"
+#include "HashedAutoTuner.h"
 
 
 namespace nTiled {
@@ -37,7 +38,8 @@ public:
   HashedLightManager(const world::World& world,
                      double minimal_node_size);
 
-  /*! @brief Destruct this HashedLightManager.
+  /*! @brief Destruct this HashedLightManager, together with its 
+   *         LightOctree, SingleLightTrees and LinklessOctree.
    */
   ~HashedLightManager();
 
@@ -73,6 +75,88 @@ public:
    */
   unsigned int getMaxNAttempts() const { return this->max_attempts; }
 
+  /*! @brief Get the method with which the LinklessOctree of this
+   *         HashedLightManager is constructed.
+   *
+   * @return The HashedBuildMethod of this HashedLightManager
+   */
+  HashedBuildMethod getBuildMethod() const { return this->build_method; }
+
+  /*! @brief Get the minimal occupancy with which a level of the 
+   *         LinklessOctree of this HashedLightManager is stored densely.
+   *
+   * @return The dense occupancy threshold of this HashedLightManager
+   */
+  double getDenseOccupancyThreshold() const { return this->dense_occupancy_threshold; }
+
+  /*! @brief Get the layout with which the tables of the LinklessOctree of
+   *         this HashedLightManager are stored on the GPU.
+   *
+   * @return The HashedTableLayout of this HashedLightManager
+   */
+  HashedTableLayout getTableLayout() const { return this->table_layout; }
+
+  /*! @brief Get whether the host tables of the LinklessOctree of this
+   *         HashedLightManager are released once loaded to a shader.
+   *
+   * @return True if the host tables are released, False otherwise
+   */
+  bool releasesHostTables() const { return this->release_host_tables; }
+
+  /*! @brief Get whether the hash tables of the LinklessOctree of this
+   *         HashedLightManager have a power of two dimension.
+   *
+   * @return True if the hash tables are wrapped with a mask, False otherwise
+   */
+  bool hasPow2Tables() const { return this->pow2_tables; }
+
+  /*! @brief Get the backend with which the SpatialHashFunctions of the 
+   *         LinklessOctree of this HashedLightManager are constructed.
+   *
+   * @return The HashedBackend of this HashedLightManager
+   */
+  HashedBackend getBackend() const { return this->backend; }
+
+  /*! @brief Get the number of HashFunctionBuilders racing to construct
+   *         every SpatialHashFunction of the LinklessOctree of this
+   *         HashedLightManager.
+   *
+   * @return The portfolio size of this HashedLightManager
+   */
+  unsigned int getPortfolioSize() const { return this->portfolio_size; }
+
+  /*! @brief Get whether this HashedLightManager chooses its minimal node 
+   *         size, starting depth and r increase ratio with a 
+   *         HashedAutoTuner on init.
+   *
+   * @return True if this HashedLightManager auto tunes, False otherwise
+   */
+  bool isAutoTuning() const { return this->auto_tune; }
+
+  /*! @brief Get the memory budget in bytes of the LinklessOctree of this
+   *         HashedLightManager when auto tuning.
+   *
+   * @return The memory budget of this HashedLightManager
+   */
+  std::size_t getMemoryBudget() const { return this->memory_budget; }
+
+  /*! @brief Get the HashedConfig of the current parameters of this 
+   *         HashedLightManager, which after auto tuning hold the chosen
+   *         minimal node size, starting depth and r increase ratio.
+   *
+   * @return The HashedConfig of this HashedLightManager
+   */
+  HashedConfig getHashedConfig() const;
+
+  /*! @brief Get whether this HashedLightManager has been auto tuned. */
+  bool hasTuned() const { return this->has_tuned; }
+
+  /*! @brief Get the HashedTuning chosen by the last call to autoTune.
+   *
+   * @pre hasTuned()
+   */
+  const HashedTuning& getTuning() const { return this->tuning; }
+
   /*! @brief Get the reference to the world of this HashedLightManager. 
    *
    * @returns The world this HashedLightManager depicts
@@ -102,10 +186,18 @@ public:
   //  LightOctree Construction methods
   // --------------------------------------------------------------------------
   /*! @brief Initialise this HashedLightmanager by building all relevant 
-   *         datastructures.
+   *         datastructures, with the HashedBuildMethod of this
+   *         HashedLightManager, auto tuning it first if it auto tunes.
    */
   void init();
 
+  /*! @brief Choose the minimal node size, starting depth and r increase 
+   *         ratio of this HashedLightManager for the lights in its world 
+   *         with a HashedAutoTuner, such that the predicted size of the 
+   *         LinklessOctree meets the memory budget.
+   */
+  virtual void autoTune();
+
   //TODO keep track whether this is called for memory management purposes
   /*! @brief Construct a new LightOctree based on the lights in the world 
    *         associated with this HashedLightManager. 
@@ -139,6 +231,27 @@ public:
    */
   virtual void constructLinklessOctree();
 
+  /*! @brief Construct a new LinklessOctree based on the lights in the world
+   *         associated with this HashedLightManager, by sorting the
+   *         classified nodes of all lights with a MortonOctreeBuilder 
+   *         instead of adding SingleLightTrees to the LightOctree.
+   *
+   * @pre constructEmptyLightOctree has been called, the constructed
+   *      LightOctree only provides the origin and depth.
+   */
+  virtual void constructLinklessOctreeMorton();
+
+  // --------------------------------------------------------------------------
+  //  openGL methods
+  // --------------------------------------------------------------------------
+  /*! @brief Load the LinklessOctree of this HashedLightManager to the 
+   *         specified shader with its HashedTableLayout, releasing its host
+   *         tables afterwards if this HashedLightManager releases them.
+   *
+   * @param shader The shader to which the LinklessOctree is loaded
+   */
+  void loadToShader(GLuint shader);
+
 private:
   // --------------------------------------------------------------------------
   //  general variables
@@ -184,6 +297,36 @@ private:
 
   /*! @brief The seed used in the random number generator constructed hashfunctions. */
   unsigned int hash_builder_seed;
+  /*! @brief The method with which the LinklessOctree is constructed. */
+  HashedBuildMethod build_method;
+  /*! @brief The minimal occupancy of a level to be stored densely. */
+  double dense_occupancy_threshold;
+  /*! @brief The layout of the tables of the LinklessOctree on the GPU. */
+  HashedTableLayout table_layout;
+  /*! @brief Whether the host tables of the LinklessOctree are released once
+   *         loaded to a shader.
+   */
+  bool release_host_tables;
+  /*! @brief Whether the hash tables of the LinklessOctree have a power of
+   *         two dimension.
+   */
+  bool pow2_tables;
+  /*! @brief The backend constructing the SpatialHashFunctions. */
+  HashedBackend backend;
+  /*! @brief The number of HashFunctionBuilders racing per SpatialHashFunction. */
+  unsigned int portfolio_size;
+
+  // --------------------------------------------------------------------------
+  //  Tuning variables
+  // --------------------------------------------------------------------------
+  /*! @brief Whether the parameters are chosen by a HashedAutoTuner on init. */
+  bool auto_tune;
+  /*! @brief The memory budget in bytes of the LinklessOctree. */
+  std::size_t memory_budget;
+  /*! @brief The HashedTuning chosen by the last call to autoTune. */
+  HashedTuning tuning;
+  /*! @brief Whether this HashedLightManager has been auto tuned. */
+  bool has_tuned;
 };
 
 
@@ -12,6 +12,41 @@ namespace nTiled {
 namespace pipeline {
 namespace hashed {
 
+/*! @brief HashedMemoryUsage describes the size of a constructed 
+ *         LinklessOctree and its LightOctree.
+ */
+struct HashedMemoryUsage {
+  /*! @brief Number of light indices referenced by the leaves. */
+  std::size_t n_light_indices;
+  /*! @brief Depth of the LightOctree. */
+  unsigned int light_octree_depth;
+  /*! @brief Number of levels of the LinklessOctree. */
+  unsigned int n_levels;
+  /*! @brief Number of levels with a data hash table. */
+  unsigned int n_data_tables;
+  /*! @brief Number of octree and data tables stored as a dense grid. */
+  unsigned int n_dense_tables;
+  /*! @brief Summed number of entries of the octree hash tables. */
+  std::size_t n_octree_hash_entries;
+  /*! @brief Summed number of entries of the octree offset tables. */
+  std::size_t n_octree_offset_entries;
+  /*! @brief Summed number of entries of the data hash tables. */
+  std::size_t n_data_hash_entries;
+  /*! @brief Summed number of entries of the data offset tables. */
+  std::size_t n_data_offset_entries;
+  /*! @brief Size in bytes of the light indices and all tables. */
+  std::size_t n_bytes;
+  /*! @brief Size in bytes of all tables on the GPU loaded as textures. */
+  std::size_t n_gpu_texture_bytes;
+  /*! @brief Size in bytes of all tables on the GPU loaded as packed buffers. */
+  std::size_t n_gpu_packed_bytes;
+  /*! @brief Mean number of table fetches of a light lookup within the 
+   *         LinklessOctree. 
+   */
+  double mean_fetches_per_query;
+};
+
+
 class HashedLightManagerLogged : public HashedLightManager {
 public:
   /*! @brief Constructa new HashedLightmanagerLogged, acting as a 
@@ -31,9 +66,14 @@ public:
   virtual void constructEmptyLightOctree() override;
   virtual void constructSLTs() override;
   virtual void constructLinklessOctree() override;
+  virtual void constructLinklessOctreeMorton() override;
+  virtual void autoTune() override;
 
   void exportMemoryUsageData(const std::string& path);
 
+  /*! @brief Get the HashedMemoryUsage of the constructed LinklessOctree. */
+  HashedMemoryUsage getMemoryUsage();
+
 private:
   logged::ExecutionTimeLogger& logger;
 };
@@ -87,6 +87,15 @@ public:
    */
   unsigned int getMaxNNodesSLT(const world::PointLight& light) const;
 
+  /*! @brief Get the origin of the SingleLightTree of the specified light
+   *
+   * @param light The light of which the origin of its SLT is calculated.
+   *
+   * @returns The origin of the SLT constructed for the specified light,
+   *          aligned to the nodes of the octree.
+   */
+  glm::vec3 getOriginSLT(const world::PointLight& light) const;
+
   /*! @brief Determine the NodeType of the provided node dimensions
    *
    * @param node_origin The origin of the node of which the NodeType should be
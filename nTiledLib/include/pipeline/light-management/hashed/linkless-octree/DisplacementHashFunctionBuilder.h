@@ -0,0 +1,123 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+//  Libraries
+// ---------------------------------------------------------------------------
+#include <vector>
+#include <glm\glm.hpp>
+#include <random>
+
+
+// ---------------------------------------------------------------------------
+//  nTiled headers
+// ---------------------------------------------------------------------------
+#include "HashFunctionBuilder.h"
+#include "SpatialHashFunction.h"
+#include "Table.h"
+
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+/*! @brief The DisplacementHashFunctionBuilder constructs SpatialHashFunctions
+ *         with a bounded number of probes, in the style of compress, hash
+ *         and displace.
+ *
+ * The entries are grouped into small buckets by h_1(p), and the buckets are
+ * placed largest first, each trying at most n_max_probes displacements
+ * before the attempt fails. The hash table H is sized for a fixed load
+ * factor and grown on failure, rather than the offset table Phi, such that
+ * later attempts become easier. The construction therefore costs at most
+ * max_attempts * n_max_probes probes per bucket, at the cost of a larger
+ * hash table H than the SpatialHashFunctionBuilder.
+ */
+template <class R>
+class DisplacementHashFunctionBuilder : public HashFunctionBuilder<R> {
+public:
+  /*! @brief A Bucket holds all entries of a single h_1 value, as pairs of
+   *         their h_0 value and data.
+   */
+  struct Bucket {
+    /*! @brief The h_1 value of this Bucket. */
+    glm::uvec3 hash_1;
+    /*! @brief The h_0 value and data of every entry of this Bucket. */
+    std::vector<std::pair<glm::uvec3, R>> elements;
+  };
+
+  // --------------------------------------------------------------------------
+  //  Constructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new DisplacementHashFunctionBuilder. */
+  DisplacementHashFunctionBuilder();
+
+  /*! @brief Construct a new DisplacementHashFunctionBuilder drawing its
+   *         displacements with the given seed.
+   */
+  DisplacementHashFunctionBuilder(unsigned int seed);
+
+  // --------------------------------------------------------------------------
+  //  SpatialHashFunction construction method
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new SpatialHashFunction containing the given 
+   *         entries, growing the hash table H by ratio each time a build 
+   *         attempt fails.
+   */
+  SpatialHashFunction<R>* constructHashFunction(
+    const std::vector<std::pair<glm::uvec3, R>>& entries,
+    unsigned int max_attempts,
+    float ratio,
+    bool has_pow2_m = false) override;
+
+  /*! @brief Get the dimensions of the hash table H and offset table Phi
+   *         with which a SpatialHashFunction of n_entries entries is 
+   *         attempted after n_retries failed attempts.
+   */
+  glm::uvec2 getTableDims(std::size_t n_entries,
+                          float ratio,
+                          unsigned int n_retries,
+                          bool has_pow2_m = false) const override;
+
+  // --------------------------------------------------------------------------
+  //  Construction supporting methods
+  // --------------------------------------------------------------------------
+  /*! @brief Group the entries into the buckets of an offset table of r_dim,
+   *         sorted by decreasing size.
+   *
+   * @returns True if no two entries with different data share both their
+   *          h_0 and h_1 value, False otherwise.
+   */
+  bool mapBuckets(const std::vector<std::pair<glm::uvec3, R>>& entries,
+                  unsigned int m_dim,
+                  unsigned int r_dim,
+                  std::vector<Bucket>& buckets) const;
+
+  /*! @brief Place the buckets in the hash table H, setting their 
+   *         displacements in the offset table Phi.
+   *
+   * @returns True if every bucket was placed within n_max_probes, False
+   *          otherwise.
+   */
+  bool placeBuckets(const std::vector<Bucket>& buckets,
+                    Table<R>& hash_table,
+                    Table<glm::u16vec3>& offset_table);
+
+  /*! @brief Maximum number of displacements tried per bucket. */
+  static const unsigned int n_max_probes = 1024;
+
+private:
+  /*! @brief Place the buckets as placeBuckets, wrapping into H with a mask
+   *         if has_pow2_m.
+   */
+  template <bool has_pow2_m>
+  bool placeBucketsWrapped(const std::vector<Bucket>& buckets,
+                           Table<R>& hash_table,
+                           Table<glm::u16vec3>& offset_table);
+
+  /*! @brief mt19937 random generator of this builder. */
+  std::mt19937 gen;
+};
+
+}
+}
+}
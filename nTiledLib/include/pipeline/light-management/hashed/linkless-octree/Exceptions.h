@@ -36,6 +36,13 @@ class SpatialHashFunctionConstructionExhaustedException : public SpatialHashFunc
 };
 
 
+class SpatialHashFunctionConstructionCancelledException : public SpatialHashFunctionException {
+  virtual const char* what() const throw() {
+    return "SpatialHashFunction construction was cancelled.";
+  }
+};
+
+
 class SpatialHashFunctionConstructionIllegalAccessTableException : public SpatialHashFunctionException {
   virtual const char* what() const throw() {
     return "Table point accessed an undefined point";
@@ -57,6 +64,20 @@ class SpatialHashFunctionIllegalAccessException : public SpatialHashFunctionExce
 };
 
 
+class SpatialHashFunctionReleasedException : public SpatialHashFunctionException {
+  virtual const char* what() const throw() {
+    return "Hashfunction accessed after its tables were released.";
+  }
+};
+
+
+class LinklessOctreeDenseLevelsException : public std::exception {
+  virtual const char* what() const throw() {
+    return "LinklessOctree has more than 32 levels, which do not fit in the dense level bit masks of the shader.";
+  }
+};
+
+
 }
 }
 }
@@ -0,0 +1,154 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+//  Libraries
+// ---------------------------------------------------------------------------
+#include <vector>
+#include <glm\glm.hpp>
+
+
+// ---------------------------------------------------------------------------
+//  nTiled headers
+// ---------------------------------------------------------------------------
+#include "SpatialHashFunction.h"
+
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+/*! @brief ConstructionControl is notified of every offset probed by a
+ *         HashFunctionBuilder, and may pause or cancel its construction.
+ */
+class ConstructionControl {
+public:
+  /*! @brief Destruct this ConstructionControl. */
+  virtual ~ConstructionControl() {}
+
+  /*! @brief Notify this ConstructionControl that a single offset has been
+   *         probed. May block until the construction is allowed to continue.
+   *
+   * @returns False if the construction should be cancelled, True otherwise.
+   */
+  virtual bool onProbe() = 0;
+};
+
+
+/*! @brief HashFunctionBuilder is the interface of the backends which 
+ *         construct the SpatialHashFunction of a single level of a 
+ *         LinklessOctree. 
+ *
+ * Every backend produces a hash table H and offset table Phi with
+ *   h(p) = h_0(p) + Phi(h_1(p))
+ * such that the LinklessOctree uploads and queries the maps of all 
+ * backends identically, and only differs in how the offsets are found.
+ */
+template <class R>
+class HashFunctionBuilder {
+public:
+  /*! @brief Construct a new HashFunctionBuilder without ConstructionControl. */
+  HashFunctionBuilder() : p_control(nullptr), is_cancelled(false) {}
+
+  /*! @brief Destruct this HashFunctionBuilder. */
+  virtual ~HashFunctionBuilder() {}
+
+  /*! @brief Construct a new SpatialHashFunction containing the given 
+   *         entries.
+   *
+   * @param entries A vector containing the set of points and associated data
+   * @param max_attempts The maximum number of attempts to be tried building 
+   *                     the new SpatialHashFunction.
+   * @param ratio The ratio with which the size of a table is increased, each
+   *              time a build attempt fails.
+   * @param has_pow2_m Whether the size of the hash table H is a power of two.
+   *
+   * @returns A pointer to the newly constructed SpatialHashFunction containing
+   *          all given entries, and no other data elements.
+   *          | FORALL e IN entries: (new this)->getData(e.first) == e.second
+   *
+   * @throws SpatialHashFunctionConstructionException If entries is empty.
+   * @throws SpatialHashFunctionConstructionExhaustedException If no
+   *         SpatialHashFunction could be built within max_attempts.
+   * @throws SpatialHashFunctionConstructionCancelledException If the 
+   *         ConstructionControl of this HashFunctionBuilder cancelled the
+   *         construction.
+   */
+  virtual SpatialHashFunction<R>* constructHashFunction(
+    const std::vector<std::pair<glm::uvec3, R>>& entries,
+    unsigned int max_attempts,
+    float ratio,
+    bool has_pow2_m = false) = 0;
+
+  /*! @brief Get the dimensions of the hash table H and offset table Phi
+   *         with which a SpatialHashFunction of n_entries entries is 
+   *         attempted after n_retries failed attempts.
+   *
+   * @param n_entries The number of entries of the SpatialHashFunction
+   * @param ratio The ratio with which a table grows per failed attempt
+   * @param n_retries The number of failed attempts
+   * @param has_pow2_m Whether the size of the hash table H is a power of two.
+   *
+   * @returns The dimension m of H as x, and r of Phi as y.
+   */
+  virtual glm::uvec2 getTableDims(std::size_t n_entries,
+                                  float ratio,
+                                  unsigned int n_retries,
+                                  bool has_pow2_m = false) const = 0;
+
+  /*! @brief Construct a new dense SpatialHashFunction containing the given
+   *         entries, of which every point lies within a grid of n_nodes 
+   *         in each dimension.
+   *
+   * @param entries A vector containing the set of points and associated data
+   * @param n_nodes The size of a single dimension of the grid
+   *
+   * @returns A pointer to the newly constructed dense SpatialHashFunction 
+   *          with a hash table of n_nodes in each dimension, and a single 
+   *          zero offset.
+   *          | FORALL e IN entries: (new this)->getData(e.first) == e.second
+   */
+  SpatialHashFunction<R>* constructDenseFunction(
+    const std::vector<std::pair<glm::uvec3, R>>& entries,
+    unsigned int n_nodes);
+
+  /*! @brief Set the ConstructionControl notified of every offset probed by 
+   *         this HashFunctionBuilder, and clear any earlier cancellation.
+   *
+   * @param p_control Pointer to the ConstructionControl, nullptr to 
+   *                  construct without control.
+   */
+  void setConstructionControl(ConstructionControl* p_control) {
+    this->p_control = p_control;
+    this->is_cancelled = false;
+  }
+
+  /*! @brief Get whether the construction of this HashFunctionBuilder has
+   *         been cancelled by its ConstructionControl.
+   */
+  bool isCancelled() const { return this->is_cancelled; }
+
+protected:
+  /*! @brief Notify the ConstructionControl of this HashFunctionBuilder 
+   *         that a single offset is probed.
+   *
+   * @returns False if the construction has been cancelled, True otherwise.
+   */
+  inline bool continueConstruction() {
+    if (this->p_control != nullptr && !this->is_cancelled) {
+      this->is_cancelled = !this->p_control->onProbe();
+    }
+    return !this->is_cancelled;
+  }
+
+private:
+  /*! @brief The ConstructionControl of this HashFunctionBuilder, nullptr
+   *         if it has none. 
+   */
+  ConstructionControl* p_control;
+  /*! @brief Whether the construction has been cancelled. */
+  bool is_cancelled;
+};
+
+}
+}
+}
@@ -105,6 +105,20 @@ public:
     return this->getTotalNNodes() * this->getMinimumNodeSize(); 
   }
 
+  /*! @brief Get the number of light indices of this LinklessOctree, which
+   *         remains available after its host tables are released.
+   *
+   * @returns The number of light indices of this LinklessOctree.
+   */
+  std::size_t getNLightIndices() const { return this->n_light_indices; }
+
+  /*! @brief Get whether the tables and light indices of this LinklessOctree
+   *         are still held in host memory.
+   *
+   * @returns False if releaseHostTables has been called, True otherwise.
+   */
+  bool hasHostTables() const { return this->has_host_tables; }
+
   // --------------------------------------------------------------------------
   std::vector<GLuint>* getLightIndices() const { return this->p_light_indices; }
   
@@ -126,20 +140,91 @@ public:
    * @param point The point of which the light indices should be retrieved
    *
    * @returns Indices of all lights that potentially effect this point.
+   * @throws SpatialHashFunctionReleasedException If the host tables of this
+   *         LinklessOctree have been released.
    */
   std::vector<GLuint> retrieveLights(glm::vec3 point) const;
 
+  /*! @brief Get the mean number of table fetches of retrieving the lights of
+   *         a point uniformly distributed within this LinklessOctree. A dense
+   *         level costs a single fetch, a hashed level two.
+   *
+   * @returns The mean number of table fetches per query.
+   */
+  double getMeanNFetches() const;
+
+  /*! @brief Get the GPU memory in bytes of the tables of the specified level
+   *         when loaded with loadToShader.
+   *
+   * @param level The level of which the memory is calculated
+   *
+   * @returns The size in bytes of the textures of the level.
+   */
+  std::size_t getLevelTextureBytes(unsigned int level) const;
+
+  /*! @brief Get the GPU memory in bytes of the tables of the specified level
+   *         when loaded with loadToShaderPacked.
+   *
+   * @param level The level of which the memory is calculated
+   *
+   * @returns The size in bytes of the packed tables of the level.
+   */
+  std::size_t getLevelPackedBytes(unsigned int level) const;
+
   // --------------------------------------------------------------------------
   //  openGL methods
   // --------------------------------------------------------------------------
   /*! @brief Load this linkless octree to the openGLshader specified with
    *         shader_id
+   *
+   * Bit i of the uniforms octree_dense_levels and light_dense_levels is set
+   * if the octree table respectively light table of level i is dense. Offset
+   * tables are loaded as RGBA8UI textures, or RGBA16UI if m of their table
+   * exceeds 256.
    * 
    * @param shader_id The shader to which this octree should be added
+   *
+   * @throws LinklessOctreeDenseLevelsException If this LinklessOctree has
+   *         more than 32 levels.
    */
   void loadToShader(GLuint shader_id);
 
+  /*! @brief Load this linkless octree to the openGL shader specified with
+   *         shader_id, with the tables of all levels packed into three 
+   *         shader storage buffers instead of textures.
+   *
+   * The octree tables are bound to binding 3 as pairs of bytes packed two
+   * per uint, the light tables to binding 4 as uvec2 and the offset tables
+   * of both to binding 5 as the lower three bytes of a uint, or as 16 bits
+   * per dimension in two uints if m of the table exceeds 256. Element i of 
+   * the uniforms octree_table_layouts and light_table_layouts holds the 
+   * first entry and dimension m of the table of level i, followed by the 
+   * first entry and dimension r of its offset table. Bit i of the uniforms
+   * octree_dense_levels and light_dense_levels is set as in loadToShader.
+   *
+   * @param shader_id The shader to which this octree should be added
+   *
+   * @throws LinklessOctreeDenseLevelsException If this LinklessOctree has
+   *         more than 32 levels.
+   */
+  void loadToShaderPacked(GLuint shader_id);
+
+  /*! @brief Release the hash tables, offset tables and light indices of this
+   *         LinklessOctree from host memory once they are loaded to a shader.
+   *
+   * The dimensions and number of entries of every table remain available,
+   * such that its memory usage can still be reported, but this 
+   * LinklessOctree can no longer retrieve lights nor be loaded to another 
+   * shader.
+   */
+  void releaseHostTables();
+
 private:
+  /*! @brief Load the light indices, the dimensions of this LinklessOctree 
+   *         and its dense levels to the specified shader.
+   */
+  void loadLightIndicesAndUniforms(GLuint shader_id);
+
   // --------------------------------------------------------------------------
   //  Octree Attributes
   // --------------------------------------------------------------------------
@@ -182,27 +267,14 @@ private:
   /*! @brief The light indices associated with this LinklessOctree. */
   std::vector<GLuint>* p_light_indices;
 
-  // --------------------------------------------------------------------------
-  //  openGL specific data
-  // --------------------------------------------------------------------------
-  // TODO: Integrate this with other datastructures
+  /*! @brief The number of light indices associated with this LinklessOctree. */
+  std::size_t n_light_indices;
 
-  /*! @brief The openGL representation of the data tables of p_octree_hash_maps. */
-  //GLubyte** p_octree_hash_maps_data_opengl;
-  std::vector<std::vector<GLubyte>> gl_octree_data;
-
-  /*! @brief The openGL representation of the offset tables of p_octree_hash_maps. */
-  //GLubyte** p_octree_hash_maps_offset_opengl;
-  std::vector<std::vector<GLubyte>> gl_octree_offset;
-
-  /*! @brief The openGL representation of the data table of p_data_hash_maps. */
-  //GLuint** p_data_hash_maps_data_opengl;
-  std::vector<std::vector<GLuint>> gl_light_data;
-
-  /*! @brief The openGL representation of the offset tables of p_data_hash_maps. */
-  //GLubyte** p_data_hash_maps_offset_opengl;
-  std::vector<std::vector<GLubyte>> gl_light_offset;
+  /*! @brief Whether the tables and light indices are held in host memory. */
+  bool has_host_tables;
 
+  // --------------------------------------------------------------------------
+  //  openGL specific data
   // --------------------------------------------------------------------------
   /*! @brief Array of openGL pointers to the textures used to store p_octree_hash_maps_data_opengl. */
   GLuint* ps_gfx_octree_node_tables;
@@ -218,6 +290,21 @@ private:
 
   /*! @brief OpenGL pointer to the array storing p_light_indices. */
   GLuint p_gfx_light_indices;
+
+  /*! @brief Whether the tables are loaded as textures. */
+  bool is_loaded_textures;
+
+  /*! @brief Whether the tables are loaded as packed buffers. */
+  bool is_loaded_packed;
+
+  /*! @brief OpenGL pointer to the buffer storing the packed octree tables. */
+  GLuint p_gfx_packed_octree_tables;
+
+  /*! @brief OpenGL pointer to the buffer storing the packed light tables. */
+  GLuint p_gfx_packed_light_tables;
+
+  /*! @brief OpenGL pointer to the buffer storing the packed offset tables. */
+  GLuint p_gfx_packed_offset_tables;
 };
 
 }
@@ -0,0 +1,204 @@
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+#include <glad\glad.h>
+#include <glm\glm.hpp>
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "world\PointLight.h"
+#include "math\octree.h"
+#include "pipeline\light-management\hashed\light-octree\slt\SingleLightTreeBuilder.h"
+
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+/*! @brief The MortonOctreeBuilder constructs the levels of a LinklessOctree
+ *         bottom up, without constructing SingleLightTrees or a LightOctree.
+ *
+ * Every added light is classified with the SingleLightTreeBuilder, and each
+ * of its partial and filled nodes is stored as an entry of its level, Morton
+ * code and light index. After all entries are radix sorted, the levels are
+ * constructed one at a time by walking the sorted entries alongside the
+ * branches of the previous level. The resulting octree and light data
+ * describe the same octree as the LightOctree with all SingleLightTrees
+ * added, ordered by Morton code instead.
+ */
+class MortonOctreeBuilder {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new MortonOctreeBuilder of an octree with the given
+   *         origin, depth and minimal node size.
+   *
+   * @param origin The origin of the octree
+   * @param depth The depth of the octree
+   * @param minimal_node_size The minimal node size of the octree
+   * @param starting_depth The depth of the first level of the LinklessOctree
+   *
+   * @throws HashedShadingDepthException If the depth exceeds the depth
+   *                                     supported by 64 bit Morton codes.
+   */
+  MortonOctreeBuilder(glm::vec3 origin,
+                      unsigned int depth,
+                      double minimal_node_size,
+                      unsigned int starting_depth);
+
+  // --------------------------------------------------------------------------
+  //  Get methods
+  // --------------------------------------------------------------------------
+  /*! @brief Get the depth of the octree of this MortonOctreeBuilder. */
+  unsigned int getDepth() const { return this->depth; }
+
+  /*! @brief Get the starting depth of the LinklessOctree of this
+   *         MortonOctreeBuilder.
+   */
+  unsigned int getStartingDepth() const { return this->starting_depth; }
+
+  /*! @brief Get the width of the octree of this MortonOctreeBuilder. */
+  double getWidth() const {
+    return math::calculateNNodes(this->getDepth() - 1) * this->minimal_node_size;
+  }
+
+  /*! @brief Get the number of entries of all added lights. */
+  std::size_t getNEntries() const { return this->entries.size(); }
+
+  // --------------------------------------------------------------------------
+  //  Construction methods
+  // --------------------------------------------------------------------------
+  /*! @brief Classify the nodes of the specified light and add them as
+   *         entries of this MortonOctreeBuilder.
+   *
+   * @param light The light which is added
+   * @param index The index of the light
+   *
+   * @pre Lights are added in increasing order of index.
+   */
+  void addLight(const world::PointLight& light, GLuint index);
+
+  /*! @brief Sort the entries of all added lights by level and Morton code.
+   *
+   * @post The light indices of entries with equal level and Morton code are
+   *       in the order in which they were added.
+   */
+  void sortEntries();
+
+  /*! @brief Restart the construction of the levels at the specified 
+   *         starting depth, reusing the sorted entries of all added lights.
+   *
+   * @param starting_depth The depth of the first level of the 
+   *                       LinklessOctree
+   *
+   * @pre sortEntries has been called after the last light was added.
+   * @pre starting_depth is at least the starting depth with which this
+   *      MortonOctreeBuilder was constructed, as the entries of branches at
+   *      or above that depth were omitted.
+   */
+  void restartLevels(unsigned int starting_depth);
+
+  /*! @brief Construct the octree data and light data of the next level of the
+   *         LinklessOctree, appending the light indices of its leaves to
+   *         light_indices.
+   *
+   * @param octree_data The vector to which the octree data of the branches
+   *                    of the next level are written
+   * @param light_data The vector to which the light data of the non empty
+   *                   leaves of the next level are written
+   * @param light_indices The vector to which the light indices of the non
+   *                      empty leaves of the next level are appended
+   *
+   * @returns True if a level has been constructed, False if no levels remain
+   *
+   * @pre sortEntries has been called after the last light was added.
+   */
+  bool constructNextLevel(std::vector<std::pair<glm::uvec3, glm::u8vec2>>& octree_data,
+                          std::vector<std::pair<glm::uvec3, glm::uvec2>>& light_data,
+                          std::vector<GLuint>& light_indices);
+
+private:
+  /*! @brief Entry describes a single classified node of a light. */
+  struct Entry {
+    /*! @brief The level of the node in the upper bits, and its Morton code
+     *         in the lower kLevelShift bits.
+     */
+    std::uint64_t key;
+    /*! @brief The index of the light filling the node, or kBranchIndex if
+     *         the node is partially filled.
+     */
+    GLuint light_index;
+  };
+
+  /*! @brief LevelBranch describes a single branch of the current level. */
+  struct LevelBranch {
+    /*! @brief The Morton code of the branch. */
+    std::uint64_t code;
+    /*! @brief Offset of the lights of the branch in its light vector. */
+    std::size_t lights_begin;
+    /*! @brief Number of lights filling the branch. */
+    std::size_t n_lights;
+  };
+
+  /*! @brief Light index of the entries of partially filled nodes. */
+  static const GLuint kBranchIndex = 0xFFFFFFFF;
+  /*! @brief Position of the level within the key of an Entry. */
+  static const unsigned int kLevelShift = 57;
+
+  /*! @brief Add a new entry of the node at the specified level and position.
+   *         Entries of branches at or above the starting depth are omitted,
+   *         as every node at the starting depth is a branch.
+   */
+  void addEntry(unsigned int level, glm::uvec3 position, GLuint light_index);
+
+  /*! @brief Construct the branches at the starting depth, with the lights
+   *         of all entries at or above it.
+   */
+  void constructStartingLevel();
+
+  // --------------------------------------------------------------------------
+  //  Octree attributes
+  // --------------------------------------------------------------------------
+  /*! @brief The origin of the octree. */
+  glm::vec3 origin;
+  /*! @brief The depth of the octree. */
+  unsigned int depth;
+  /*! @brief The minimal node size of the octree. */
+  double minimal_node_size;
+  /*! @brief The depth of the first level of the LinklessOctree. */
+  unsigned int starting_depth;
+  /*! @brief The builder classifying the nodes of every light. */
+  SingleLightTreeBuilder slt_builder;
+
+  // --------------------------------------------------------------------------
+  //  Construction state
+  // --------------------------------------------------------------------------
+  /*! @brief The entries of all added lights. */
+  std::vector<Entry> entries;
+  /*! @brief Index of the first entry not yet consumed by a level. */
+  std::size_t entry_i;
+  /*! @brief Whether the branches at the starting depth are constructed. */
+  bool has_constructed_starting_level;
+  /*! @brief The level of the current branches. */
+  unsigned int current_level;
+  /*! @brief The branches of the current level, in Morton order. */
+  std::vector<LevelBranch> branches;
+  /*! @brief The lights of the branches of the current level. */
+  std::vector<GLuint> branch_lights;
+  /*! @brief The branches of the next level, in Morton order. */
+  std::vector<LevelBranch> branches_next;
+  /*! @brief The lights of the branches of the next level. */
+  std::vector<GLuint> branch_lights_next;
+  /*! @brief The lights of the entries of a single child node. */
+  std::vector<GLuint> child_lights;
+};
+
+} // hashed
+} // pipeline
+} // nTiled
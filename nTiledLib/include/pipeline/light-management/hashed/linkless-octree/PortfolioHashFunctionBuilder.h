@@ -0,0 +1,116 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+//  Libraries
+// ---------------------------------------------------------------------------
+#include <vector>
+#include <glm\glm.hpp>
+
+
+// ---------------------------------------------------------------------------
+//  nTiled headers
+// ---------------------------------------------------------------------------
+#include "HashFunctionBuilder.h"
+#include "SpatialHashFunction.h"
+
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+/*! @brief The PortfolioHashFunctionBuilder races a portfolio of 
+ *         HashFunctionBuilders, each with its own seed, on separate threads
+ *         and keeps the SpatialHashFunction of a single one of them.
+ *
+ * The candidates advance in rounds of n_round_probes probed offsets, and
+ * wait for each other at the end of every round. Once one or more 
+ * candidates have finished within a round, the remaining candidates are 
+ * cancelled and the SpatialHashFunction of the finished candidate with the
+ * lowest index is kept. Since rounds are counted in probes rather than 
+ * time, the kept SpatialHashFunction is independent of the scheduling of
+ * the threads, while the construction takes only as long as the luckiest 
+ * candidate, up to the length of a single round.
+ *
+ * Every candidate constructs its own tables, such that the construction
+ * temporarily uses up to n_candidates times the memory of a single 
+ * HashFunctionBuilder.
+ *
+ * The candidates run on threads shared by all PortfolioHashFunctionBuilders,
+ * which persist across constructions.
+ */
+template <class R>
+class PortfolioHashFunctionBuilder : public HashFunctionBuilder<R> {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor | Destructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new PortfolioHashFunctionBuilder racing the given
+   *         candidates, in order of preference.
+   *
+   * @param p_candidates The HashFunctionBuilders raced by this 
+   *                     PortfolioHashFunctionBuilder, of which it takes
+   *                     ownership.
+   * @param n_round_probes The number of offsets each candidate probes 
+   *                       before waiting for the other candidates.
+   */
+  PortfolioHashFunctionBuilder(
+    const std::vector<HashFunctionBuilder<R>*>& p_candidates,
+    unsigned int n_round_probes = 16384);
+
+  /*! @brief Destruct this PortfolioHashFunctionBuilder and its candidates. */
+  ~PortfolioHashFunctionBuilder();
+
+  // --------------------------------------------------------------------------
+  //  SpatialHashFunction construction method
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new SpatialHashFunction containing the given
+   *         entries with every candidate concurrently, and keep the one of
+   *         the first candidate to finish, by round and then by index.
+   *
+   * @throws SpatialHashFunctionConstructionExhaustedException If none of 
+   *         the candidates could build a SpatialHashFunction within 
+   *         max_attempts.
+   * @throws Any other exception thrown by a candidate, after cancelling the
+   *         remaining candidates.
+   */
+  SpatialHashFunction<R>* constructHashFunction(
+    const std::vector<std::pair<glm::uvec3, R>>& entries,
+    unsigned int max_attempts,
+    float ratio,
+    bool has_pow2_m = false) override;
+
+  /*! @brief Get the dimensions of the tables with which the first 
+   *         candidate attempts a SpatialHashFunction of n_entries entries 
+   *         after n_retries failed attempts.
+   */
+  glm::uvec2 getTableDims(std::size_t n_entries,
+                          float ratio,
+                          unsigned int n_retries,
+                          bool has_pow2_m = false) const override;
+
+  // --------------------------------------------------------------------------
+  //  Getters
+  // --------------------------------------------------------------------------
+  /*! @brief Get the number of candidates of this PortfolioHashFunctionBuilder. */
+  unsigned int getNCandidates() const { return this->p_candidates.size(); }
+
+  /*! @brief Get the number of offsets probed per round. */
+  unsigned int getNRoundProbes() const { return this->n_round_probes; }
+
+  /*! @brief Get the index of the candidate of which the last constructed 
+   *         SpatialHashFunction was kept.
+   */
+  unsigned int getLastWinner() const { return this->last_winner; }
+
+private:
+  /*! @brief The raced HashFunctionBuilders, in order of preference. */
+  std::vector<HashFunctionBuilder<R>*> p_candidates;
+  /*! @brief The number of offsets each candidate probes per round. */
+  unsigned int n_round_probes;
+  /*! @brief The index of the candidate kept by the last construction. */
+  unsigned int last_winner;
+};
+
+}
+}
+}
@@ -22,10 +22,19 @@ namespace hashed {
  * 
  *  The hash function is build with both a hashtable H and an offset table
  *  Phi. Hash table H contains data of type R, while the offset table is
- *  defined as elements of glm::u8vec3.
+ *  constructed as elements of glm::u16vec3. Offsets are below 256 unless 
+ *  the hash table H exceeds 256 in a single dimension, in which case Phi is
+ *  stored as glm::u16vec3, and as glm::u8vec3 otherwise.
  * 
  *  The spatial Hash function is defined as:
  *    h(p) = h_0(p) + Phi(h_1(p))
+ *
+ *  If the dimension m of H is a power of two, h(p) wraps into H with a mask
+ *  rather than a modulo.
+ *
+ *  A dense SpatialHashFunction stores every point p at H[p], with a single
+ *  zero offset in Phi, such that its data is obtained without reading the
+ *  offset table.
  */
 template <class R>
 class SpatialHashFunction {
@@ -38,7 +47,15 @@ public:
    *
    */
   SpatialHashFunction(Table<R>* p_hash_table,
-                      Table<glm::u8vec3>* p_offset_table);
+                      Table<glm::u16vec3>* p_offset_table);
+
+  /*! @brief Construct a new SpatialHashFunction with the given hash table H
+   *         and offset table Phi, which is dense if is_dense is true
+   *
+   */
+  SpatialHashFunction(Table<R>* p_hash_table,
+                      Table<glm::u16vec3>* p_offset_table,
+                      bool is_dense);
 
   /*! @brief Destruct this SpatialHashFunction
    */
@@ -53,17 +70,39 @@ public:
    */
   const std::vector<R>& getHashTable() const { return this->p_hash_table->getDataVector(); }
 
-  /*! @brief Get the offset table of this sPatialHashfunction
+  /*! @brief Get the offset table of this SpatialHashFunction
+   *
+   * @return A copy of the offset table of this SpatialHashFunction, 
+   *         widened to 16 bits per dimension if it is stored in 8 bits.
+   */
+  std::vector<glm::u16vec3> getOffsetTable() const;
+
+  /*! @brief Get the offset at index i of the offset table of this 
+   *         SpatialHashFunction
+   *
+   * @param i The index of the offset within the offset table.
+   *
+   * @return The offset at index i, widened to 16 bits per dimension.
+   */
+  inline glm::u16vec3 getOffset(std::size_t i) const {
+    if (this->p_wide_offset_table) return this->p_wide_offset_table->getDataVector()[i];
+    else return glm::u16vec3(this->p_narrow_offset_table->getDataVector()[i]);
+  }
+
+  /*! @brief Get the number of bytes the offset table of this 
+   *         SpatialHashFunction occupies on the host
    *
-   * @return The offset table of this SpatialHashFunction
+   * @return r^3 times the size of a single stored offset.
    */
-  const std::vector<glm::u8vec3>& getOffsetTable() const { return this->p_offset_table->getDataVector(); }
+  std::size_t getOffsetTableBytes() const;
 
   /*! @brief Get the data associated with point p from within this Spatial Hash Function
    * 
    * @param p The point of which the associated data should be returned.
    *
    * @return The data associated with point p
+   * @throws SpatialHashFunctionReleasedException If the tables of this
+   *         SpatialHashFunction have been released.
    */
   R getData(glm::uvec3 p) const;
 
@@ -80,14 +119,85 @@ public:
    * @return The size r in one dimension of this SpatialHashFunction's
    *         offset table.
    */
-  inline unsigned int getR() const { return this->p_offset_table->getDim(); }
+  inline unsigned int getR() const { 
+    if (this->p_wide_offset_table) return this->p_wide_offset_table->getDim();
+    else return this->p_narrow_offset_table->getDim();
+  }
+
+  /*! @brief Get whether the offsets of this SpatialHashFunction require 16
+   *         bits per dimension instead of 8
+   *
+   * @return True if m exceeds 256, False otherwise.
+   */
+  inline bool hasWideOffsets() const { return this->getM() > 256; }
+
+  /*! @brief Get whether the hash table H of this SpatialHashFunction has a
+   *         power of two dimension m
+   *
+   * @return True if points are wrapped into H with a mask, False otherwise.
+   */
+  inline bool hasPow2M() const { return this->has_pow2_m; }
+
+  /*! @brief Get whether this SpatialHashFunction stores its points densely
+   *
+   * @return True if every point p is stored at H[p], False otherwise.
+   */
+  inline bool isDense() const { return this->is_dense; }
+
+  /*! @brief Get the number of points stored in this SpatialHashFunction
+   *
+   * @return The number of defined entries of the hash table H
+   */
+  inline std::size_t getNEntries() const { return this->p_hash_table->getNDefined(); }
+
+  /*! @brief Get whether the tables of this SpatialHashFunction are still
+   *         held in memory
+   *
+   * @return False if releaseTables has been called, True otherwise.
+   */
+  inline bool hasTables() const { return !this->p_hash_table->isReleased(); }
+
+  // --------------------------------------------------------------------------
+  //  Methods
+
+  /*! @brief Release the hash table and offset table of this 
+   *         SpatialHashFunction, keeping only their dimensions and number of
+   *         entries. Afterwards getData throws a 
+   *         SpatialHashFunctionReleasedException.
+   */
+  void releaseTables();
 
 private:
+  /*! @brief Get the data associated with point p from the hash table H of
+   *         this non dense SpatialHashFunction, wrapping into H with a mask
+   *         if has_pow2_m.
+   */
+  template <bool has_pow2_m>
+  R getHashedData(glm::uvec3 p) const;
+
+  /*! @brief Store the constructed offset table, in 8 bits per dimension if
+   *         the offsets are not wide.
+   */
+  void storeOffsetTable(Table<glm::u16vec3>* p_offset_table);
+
   /*! @brief Pointer to the hash table of this SpatialHashFunction. */
   Table<R>* p_hash_table;
 
-  /*! @brief Pointer to the offset table of this SpatialHashFunction. */
-  Table<glm::u8vec3>* p_offset_table;
+  /*! @brief Pointer to the offset table of this SpatialHashFunction if its
+   *         offsets are not wide, nullptr otherwise.
+   */
+  Table<glm::u8vec3>* p_narrow_offset_table;
+
+  /*! @brief Pointer to the offset table of this SpatialHashFunction if its
+   *         offsets are wide, nullptr otherwise.
+   */
+  Table<glm::u16vec3>* p_wide_offset_table;
+
+  /*! @brief Whether every point p is stored at H[p]. */
+  bool is_dense;
+
+  /*! @brief Whether the dimension m of the hash table H is a power of two. */
+  bool has_pow2_m;
 };
 
 }
@@ -12,6 +12,7 @@
 // ---------------------------------------------------------------------------
 //  nTiled headers
 // ---------------------------------------------------------------------------
+#include "HashFunctionBuilder.h"
 #include "SpatialHashFunction.h"
 #include "Table.h"
 
@@ -21,10 +22,13 @@ namespace pipeline {
 namespace hashed {
 
 /*! @brief The SpatialHashFunctionBuilder is responsible for constructing 
- *         new SpatialHashFunctions. 
+ *         new SpatialHashFunctions as described in Perfect Spatial Hashing.
+ *
+ * Offsets are searched among the neighbouring offsets and then randomly,
+ * and the offset table Phi is grown each time a build attempt fails.
  */
 template <class R>
-class SpatialHashFunctionBuilder {
+class SpatialHashFunctionBuilder : public HashFunctionBuilder<R> {
 public:
 
   // ----------------------------------------------------------------------------
@@ -114,6 +118,10 @@ public:
      *                     the new SpatialhashFunction.
      * @param ratio The ratio with which the size of the offset table Phi is 
      *              increased, each time a build attempt fails.
+     * @param has_pow2_m Whether the size of the hash table H is rounded up 
+     *                   to a power of two instead of an odd number, such 
+     *                   that it is wrapped with a mask. The size of Phi 
+     *                   remains odd, keeping m and r coprime.
      *              
      * @returns A pointer to the newly constructed SpatialHashFunction containing
      *          all given entries, and no other data elements.
@@ -122,7 +130,17 @@ public:
   SpatialHashFunction<R>* constructHashFunction(
     const std::vector<std::pair<glm::uvec3, R>>& entries,
     unsigned int max_attempts,
-    float ratio);
+    float ratio,
+    bool has_pow2_m = false) override;
+
+  /*! @brief Get the dimensions of the hash table H and offset table Phi
+   *         with which a SpatialHashFunction of n_entries entries is 
+   *         attempted after n_retries failed attempts.
+   */
+  glm::uvec2 getTableDims(std::size_t n_entries,
+                          float ratio,
+                          unsigned int n_retries,
+                          bool has_pow2_m = false) const override;
 
   // --------------------------------------------------------------------------
   //  Construction supporting methods
@@ -143,7 +161,7 @@ public:
    */
   bool buildTables(const std::vector<ConstructionElement>& entry_vector,
                    Table<R>& hash_table,
-                   Table<glm::u8vec3>& offset_table);
+                   Table<glm::u16vec3>& offset_table);
 
   /*! @brief map entries to result_entry_set, preparing the data to be used in
    *         build tables.
@@ -171,7 +189,7 @@ public:
    * @returns True if the parameters are acceptable, False otherwise.
    */
   bool isAcceptableParameters(unsigned int m,
-                              unsigned int r);
+                              unsigned int r) const;
 
   /*! @brief Retrieve the neighbouring values within the offset table Phi
    *         around point p, and store them in candidate_vector.
@@ -187,8 +205,8 @@ public:
    * @post FORALL p_i: next_to(p_i, p) -> Phi[p_i] IN candidate_vector
    */
   void retrieveCandidates(glm::uvec3 p,
-                          const Table<glm::u8vec3>& offset_table,
-                          std::vector<glm::u8vec3>& candidate_vector);
+                          const Table<glm::u16vec3>& offset_table,
+                          std::vector<glm::u16vec3>& candidate_vector);
 
   /*! @brief Check whether the candidate offset value is a valid offset
    *         given the elements and the currently defined hash table.
@@ -202,12 +220,28 @@ public:
    *
    * @returns True if candidate is a valid offset value, False otherwise
    */
-  bool isValidCandidate(glm::u8vec3 candidate,
+  bool isValidCandidate(glm::u16vec3 candidate,
                         const std::vector<EntryElement>& elements,
                         const Table<R>& hash_table);
 
 
 private:
+  /*! @brief Build the hash table H and offset table Phi as buildTables,
+   *         wrapping into H with a mask if has_pow2_m.
+   */
+  template <bool has_pow2_m>
+  bool buildTablesWrapped(const std::vector<ConstructionElement>& entry_vector,
+                          Table<R>& hash_table,
+                          Table<glm::u16vec3>& offset_table);
+
+  /*! @brief Check whether the candidate offset value is a valid offset as
+   *         isValidCandidate, wrapping into H with a mask if has_pow2_m.
+   */
+  template <bool has_pow2_m>
+  bool isValidCandidateWrapped(glm::u16vec3 candidate,
+                               const std::vector<EntryElement>& elements,
+                               const Table<R>& hash_table);
+
   /*! @brief mt19937 random generator of this SpatialHashFunctionBuilder. */
   std::mt19937 gen;
   /*! @brief Uniform unsigned short distribution. */
@@ -73,6 +73,23 @@ public:
    */
   inline unsigned int getDim() const { return this->t_dim; }
 
+  /*! @brief Get the number of defined points of this Table
+   *
+   * @return the number of points p for which this->isDefined(p)
+   */
+  std::size_t getNDefined() const { return this->n_defined; }
+
+  /*! @brief Release the data of this Table, after which only its dimension
+   *         and number of defined points remain available.
+   */
+  void release();
+
+  /*! @brief Get whether the data of this Table has been released
+   *
+   * @return True if release has been called, false otherwise.
+   */
+  inline bool isReleased() const { return this->is_released; }
+
 private:
   /*! @brief Vector containing whether points in data are defined. */
   std::vector<bool> is_def;
@@ -80,6 +97,10 @@ private:
   std::vector<R> data;
   /*! @brief The size of a dimension of this table. */
   unsigned int t_dim;
+  /*! @brief The number of defined points in this Table. */
+  std::size_t n_defined;
+  /*! @brief Whether the data of this Table has been released. */
+  bool is_released;
 };
 
 
@@ -0,0 +1,199 @@
+/*! @file DrawSubmission.h
+ *  @brief DrawSubmission.h contains the definition of DrawSubmission which
+ *         batches and submits the draw calls of the PipelineObjects of a
+ *         single shader program.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glad\glad.h>
+#include <glm\glm.hpp>
+
+#include <vector>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "pipeline\PipelineObject.h"
+#include "pipeline\pipeline-util\ObjectBVH.h"
+
+
+namespace nTiled {
+namespace pipeline {
+
+/*! @brief ObjectMatrices holds the matrices of a single PipelineObject as
+ *         they are stored in the object matrix buffer. Its layout matches
+ *         the std430 ObjectMatrixBuffer declared in the vertex shaders.
+ */
+struct ObjectMatrices {
+  /*! @brief Transformation from model to camera coordinates. */
+  glm::mat4 model_to_camera;
+  /*! @brief Inverse transpose of model_to_camera, used for normals. */
+  glm::mat4 inv_transpose_model_to_camera;
+  /*! @brief Transformation from model to world coordinates. */
+  glm::mat4 model_to_world;
+};
+
+
+/*! @brief DrawSubmission is responsible for submitting the draw calls of a
+ *         set of PipelineObjects rendered with the same shader program.
+ *
+ * PipelineObjects are sorted by Vertex Array Object and element buffer,
+ * such that each is bound once per frame. The matrices of all
+ * PipelineObjects are uploaded in a single Shader Storage Buffer Object per
+ * frame, which the vertex shader indexes with the object_index attribute.
+ * Where glMultiDrawElementsIndirect is available every batch of
+ * PipelineObjects sharing a Vertex Array Object is drawn with a single
+ * call, otherwise every PipelineObject is drawn with
+ * glDrawElementsInstancedBaseInstance.
+ *
+ * An ObjectBVH over the world space bounds of the PipelineObjects is used
+ * to cull PipelineObjects outside the camera frustum. The PipelineObjects
+ * are assumed to be static once the DrawSubmission is finalised.
+ */
+class DrawSubmission {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new empty DrawSubmission. */
+  DrawSubmission();
+
+  // --------------------------------------------------------------------------
+  //  Construction
+  // --------------------------------------------------------------------------
+  /*! @brief Add the specified PipelineObject to this DrawSubmission.
+   *
+   * @param p_obj Pointer to the PipelineObject to be added.
+   * @param bounds The world space AABB of the PipelineObject.
+   *
+   * @throws std::runtime_error If this DrawSubmission is already finalised.
+   */
+  void addObject(PipelineObject* p_obj, const AABB& bounds);
+
+  /*! @brief Sort the PipelineObjects of this DrawSubmission and construct
+   *         the openGL buffers used to submit them. No PipelineObjects can
+   *         be added after finalising.
+   */
+  void finalise();
+
+  // --------------------------------------------------------------------------
+  //  Render methods
+  // --------------------------------------------------------------------------
+  /*! @brief Determine the PipelineObjects within the frustum of the
+   *         specified world to clip matrix. Only these are drawn by
+   *         subsequent calls to submit, until cull is called again.
+   *
+   * @param world_to_clip The combined perspective and look at matrix of
+   *                      the current frame.
+   *
+   * @return The number of visible PipelineObjects.
+   */
+  GLuint cull(const glm::mat4& world_to_clip);
+
+  /*! @brief Upload the object matrices with the specified look at matrix
+   *         and draw all PipelineObjects of this DrawSubmission with the
+   *         currently active shader program.
+   *
+   * @param look_at The world to camera matrix of the current frame.
+   */
+  void submit(const glm::mat4& look_at);
+
+  // --------------------------------------------------------------------------
+  //  Getters
+  // --------------------------------------------------------------------------
+  /*! @brief Get the number of PipelineObjects of this DrawSubmission. */
+  GLuint getNObjects() const { return GLuint(this->ps_obj.size()); }
+
+  /*! @brief Get the number of PipelineObjects of this DrawSubmission
+   *         that were visible at the last call to cull.
+   */
+  GLuint getNVisibleObjects() const { return this->n_visible_objects; }
+
+  /*! @brief Get the number of Vertex Array Object batches of this
+   *         DrawSubmission.
+   */
+  GLuint getNBatches() const { return GLuint(this->batches.size()); }
+
+  /*! @brief Get whether this DrawSubmission draws with
+   *         glMultiDrawElementsIndirect.
+   */
+  bool isIndirect() const { return this->is_indirect; }
+
+private:
+  /*! @brief Batch describes a consecutive range of sorted PipelineObjects
+   *         sharing the same Vertex Array Object and element buffer.
+   */
+  struct Batch {
+    GLuint vao;
+    GLuint element_buffer;
+    GLuint first_object;
+    GLuint n_objects;
+  };
+
+  /*! @brief DrawElementsIndirectCommand as defined by openGL for
+   *         glMultiDrawElementsIndirect.
+   */
+  struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instance_count;
+    GLuint first_index;
+    GLint base_vertex;
+    GLuint base_instance;
+  };
+
+  /*! @brief Update the object matrix buffer with the specified look at
+   *         matrix.
+   *
+   * @param look_at The world to camera matrix of the current frame.
+   */
+  void updateMatrices(const glm::mat4& look_at);
+
+  /*! @brief Issue the draw calls of all batches. */
+  void draw();
+
+  /*! @brief PipelineObjects of this DrawSubmission, sorted after
+   *         finalising.
+   */
+  std::vector<PipelineObject*> ps_obj;
+  /*! @brief World space AABB of each PipelineObject, in the order of ps_obj.
+   */
+  std::vector<AABB> object_bounds;
+  /*! @brief Whether each PipelineObject is visible, in the order of ps_obj.
+   */
+  std::vector<bool> is_visible;
+  /*! @brief Number of visible PipelineObjects. */
+  GLuint n_visible_objects;
+  /*! @brief Inverse transpose of the transformation matrix of each
+   *         PipelineObject, in the order of ps_obj.
+   */
+  std::vector<glm::mat4> inv_transpose_transformations;
+  /*! @brief Batches of this DrawSubmission. */
+  std::vector<Batch> batches;
+  /*! @brief Client side copy of the indirect draw command buffer. */
+  std::vector<DrawElementsIndirectCommand> commands;
+  /*! @brief Client side copy of the object matrix buffer. */
+  std::vector<ObjectMatrices> matrix_data;
+
+  /*! @brief GLuint pointer to the Shader Storage Buffer Object holding the
+   *         ObjectMatrices.
+   */
+  GLuint matrix_buffer;
+  /*! @brief GLuint pointer to the instanced object_index attribute buffer. */
+  GLuint object_index_buffer;
+  /*! @brief GLuint pointer to the indirect draw command buffer. */
+  GLuint indirect_buffer;
+
+  /*! @brief ObjectBVH over object_bounds. */
+  ObjectBVH* p_bvh;
+
+  /*! @brief Whether glMultiDrawElementsIndirect is used. */
+  bool is_indirect;
+  /*! @brief Whether this DrawSubmission is finalised. */
+  bool is_finalised;
+};
+
+} // pipeline
+} // nTiled
@@ -0,0 +1,61 @@
+/*! @file MeshBuffers.h
+ *  @brief MeshBuffers.h contains the functions to upload the vertex and
+ *         element data of a Mesh into openGL buffers.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glad\glad.h>
+#include <glm\glm.hpp>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "world\Mesh.h"
+#include "pipeline\pipeline-util\VertexFormat.h"
+
+
+namespace nTiled {
+namespace pipeline {
+
+/*! @brief PackedVertex is a single vertex of the VertexFormat::Packed
+ *         layout.
+ */
+struct PackedVertex {
+  /*! @brief Position in model space. */
+  glm::vec3 position;
+  /*! @brief Normal packed as 10:10:10:2 signed normalised integers. */
+  glm::uint32 normal;
+  /*! @brief UV coordinates packed as two half-floats. */
+  glm::uint32 uv;
+};
+
+/*! @brief MeshBuffers holds the openGL buffers of a single uploaded Mesh.
+ */
+struct MeshBuffers {
+  /*! @brief GLuint pointer to the Vertex Array Object of the Mesh. */
+  GLuint vao;
+  /*! @brief GLuint pointer to the element buffer of the Mesh. */
+  GLuint element_buffer;
+  /*! @brief Size in bytes of the vertex data of the Mesh. */
+  GLsizeiptr vertex_size;
+};
+
+/*! @brief Upload the specified Mesh in the specified VertexFormat and
+ *         construct a Vertex Array Object for it.
+ *
+ * Either layout is read by the same vertex shader inputs: position at
+ * location 0, normal at location 1 and uv at location 2.
+ *
+ * @param mesh The Mesh to upload.
+ * @param vertex_format The VertexFormat of the vertex data.
+ *
+ * @return The MeshBuffers of the uploaded Mesh.
+ */
+MeshBuffers constructMeshBuffers(const world::Mesh& mesh,
+                                 VertexFormat vertex_format);
+
+} // pipeline
+} // nTiled
@@ -0,0 +1,149 @@
+/*! @file ObjectBVH.h
+ *  @brief ObjectBVH.h contains the definition of the ObjectBVH, a bounding
+ *         volume hierarchy over the world space bounds of PipelineObjects,
+ *         together with the bounding box and frustum utilities it uses.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glad\glad.h>
+#include <glm\glm.hpp>
+
+#include <vector>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "world\Mesh.h"
+
+
+namespace nTiled {
+namespace pipeline {
+
+// ----------------------------------------------------------------------------
+//  Bounds
+// ----------------------------------------------------------------------------
+/*! @brief AABB describes an axis aligned bounding box. */
+struct AABB {
+  /*! @brief Lower corner of this AABB. */
+  glm::vec3 lower;
+  /*! @brief Upper corner of this AABB. */
+  glm::vec3 upper;
+};
+
+/*! @brief Compute the world space AABB of the specified Mesh transformed
+ *         with the specified transformation matrix.
+ *
+ * @param mesh The Mesh of which the bounds are computed.
+ * @param transformation_matrix The model to world matrix of the Mesh.
+ *
+ * @return The world space AABB enclosing the transformed Mesh.
+ */
+AABB computeWorldBounds(const world::Mesh& mesh,
+                        const glm::mat4& transformation_matrix);
+
+/*! @brief Frustum describes the six planes of a view frustum, each stored
+ *         as (normal, distance) with the normal pointing inwards.
+ */
+struct Frustum {
+  glm::vec4 planes[6];
+};
+
+/*! @brief Extract the Frustum of the specified world to clip matrix.
+ *
+ * @param world_to_clip The combined perspective and look at matrix.
+ *
+ * @return The world space Frustum of world_to_clip.
+ */
+Frustum extractFrustum(const glm::mat4& world_to_clip);
+
+
+/*! @brief FrustumTest describes the result of testing an AABB against a
+ *         Frustum.
+ */
+enum class FrustumTest {
+  Outside,
+  Intersecting,
+  Inside
+};
+
+/*! @brief Test the specified AABB against the specified Frustum.
+ *
+ * @param frustum The Frustum to test against.
+ * @param bounds The AABB to test.
+ *
+ * @return Whether bounds is outside, intersecting or inside frustum.
+ */
+FrustumTest testFrustum(const Frustum& frustum, const AABB& bounds);
+
+
+// ----------------------------------------------------------------------------
+//  ObjectBVH
+// ----------------------------------------------------------------------------
+/*! @brief ObjectBVH is a bounding volume hierarchy over a static set of
+ *         object bounds, used to determine the objects within a Frustum.
+ *
+ * The hierarchy is built top down by splitting at the median centroid
+ * along the longest axis, and stored as a flat array of nodes.
+ */
+class ObjectBVH {
+public:
+  /*! @brief Construct a new ObjectBVH over the specified bounds.
+   *
+   * @param bounds World space AABB of every object, objects are identified
+   *               by their index in bounds.
+   * @param max_leaf_size The maximum number of objects in a single leaf.
+   */
+  ObjectBVH(const std::vector<AABB>& bounds,
+            GLuint max_leaf_size = 4);
+
+  /*! @brief Determine which objects of this ObjectBVH are within the
+   *         specified Frustum.
+   *
+   * @param frustum The Frustum to query.
+   * @param is_visible Vector which is set, per object index, to whether
+   *                   that object is within frustum.
+   *
+   * @return The number of objects within frustum.
+   */
+  GLuint query(const Frustum& frustum,
+               std::vector<bool>& is_visible) const;
+
+  /*! @brief Get the number of objects in this ObjectBVH. */
+  GLuint getNObjects() const { return GLuint(this->object_indices.size()); }
+
+  /*! @brief Get the number of nodes in this ObjectBVH. */
+  GLuint getNNodes() const { return GLuint(this->nodes.size()); }
+
+private:
+  /*! @brief Node of the ObjectBVH. A leaf references n_objects entries of
+   *         object_indices starting at first, a branch has its children
+   *         at first and first + 1.
+   */
+  struct Node {
+    AABB bounds;
+    GLuint first;
+    GLuint n_objects;
+  };
+
+  /*! @brief Recursively build the node at node_index over the objects in
+   *         object_indices[begin, end).
+   */
+  void build(const std::vector<AABB>& bounds,
+             GLuint node_index,
+             GLuint begin,
+             GLuint end,
+             GLuint max_leaf_size);
+
+  /*! @brief World space AABB of every object. */
+  std::vector<AABB> object_bounds;
+  /*! @brief Nodes of this ObjectBVH, the root is at index 0. */
+  std::vector<Node> nodes;
+  /*! @brief Object indices ordered such that every leaf is a range. */
+  std::vector<GLuint> object_indices;
+};
+
+} // pipeline
+} // nTiled
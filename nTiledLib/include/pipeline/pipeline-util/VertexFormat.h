@@ -0,0 +1,24 @@
+/*! @file VertexFormat.h
+ *  @brief VertexFormat.h contains the definition of all possible layouts of
+ *         the vertex data of Meshes on the GPU, specified through the enum
+ *         class VertexFormat.
+ */
+#pragma once
+
+namespace nTiled {
+namespace pipeline {
+
+/*! @brief VertexFormat specifies all possible vertex data layouts. */
+enum class VertexFormat {
+  /*! @brief Positions as vec4, normals and uvs as vec3, each of 32-bit
+   *         floats and in a separate buffer.
+   */
+  Separate,
+  /*! @brief A single interleaved buffer with per vertex a float3 position,
+   *         a 10:10:10:2 signed normalised normal and half-float uvs.
+   */
+  Packed,
+};
+
+} // pipeline
+} // nTiled
@@ -37,9 +37,27 @@ std::stringstream readShader(const std::string& path);
  */
 std::stringstream readShaderWithLights(const std::string& path, int n_lights);
 
+/*! @brief Read the glsl shader at the given path and return as stringstream
+ *         where NUM_LIGHTS, OCTREE_DEPTH, PACKED_TABLES and POW2_TABLES 
+ *         have been replaced with the provided values.
+ *
+ * @param path The path to the openGL file to be read.
+ * @param n_lights The value with which NUM_LIGHTS should be replaced.
+ * @param n_octree_maps The value with which OCTREE_DEPTH should be replaced.
+ * @param is_packed_tables Whether the tables of the LinklessOctree are 
+ *                         loaded as packed buffers instead of textures.
+ * @param is_pow2_tables Whether the hash tables of the LinklessOctree have
+ *                       a power of two dimension, such that they are 
+ *                       wrapped with a mask instead of a modulo.
+ *
+ * @return A std::stringstream containing the read glsl file with the 
+ *         defines replaced.
+ */
 std::stringstream readShaderWithLightsAndOctreeMaps(const std::string& path,
                                                     unsigned int n_lights,
-                                                    unsigned int n_octree_maps);
+                                                    unsigned int n_octree_maps,
+                                                    bool is_packed_tables = false,
+                                                    bool is_pow2_tables = false);
 
 /*! @brief Compile the given shader with the given shadertype into video memory
  *
@@ -7,7 +7,9 @@
 // ----------------------------------------------------------------------------
 // Libraries
 // ----------------------------------------------------------------------------
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <glad\glad.h>
 
 #include "lodepng.h"
@@ -15,6 +17,79 @@
 namespace nTiled {
 namespace pipeline {
 
+/*! @brief TextureImage holds a decoded RGBA8 image, with its rows ordered
+ *         bottom to top as expected by openGL.
+ */
+struct TextureImage {
+  /*! @brief Width of this TextureImage in pixels. */
+  unsigned int width;
+  /*! @brief Height of this TextureImage in pixels. */
+  unsigned int height;
+  /*! @brief The RGBA8 pixels of this TextureImage. */
+  std::vector<unsigned char> pixels;
+};
+
+/*! @brief TextureCacheHeader is the header of a binary texture cache file,
+ *         directly followed by width * height RGBA8 pixels.
+ */
+struct TextureCacheHeader {
+  /*! @brief Magic identifying a texture cache file, "NTTC". */
+  char magic[4];
+  /*! @brief Version of the texture cache format. */
+  std::uint32_t version;
+  /*! @brief Size in bytes of the source file this cache was created from.*/
+  std::uint64_t source_size;
+  /*! @brief Last modification time of the source file this cache was
+   *         created from.
+   */
+  std::int64_t source_time;
+  /*! @brief Width of the texture in pixels. */
+  std::uint32_t width;
+  /*! @brief Height of the texture in pixels. */
+  std::uint32_t height;
+};
+
+/*! @brief Decode the png image at the given file location.
+ *
+ * @param file_path Path to the png image to be decoded.
+ * @param image TextureImage to which the decoded image is written.
+ *
+ * @throws std::runtime_error If the png image could not be decoded.
+ */
+void decodeTexturePNG(const std::string& file_path, TextureImage& image);
+
+/*! @brief Read the texture cache file at cache_path if it is up to date
+ *         with the specified source file.
+ *
+ * @return Whether image was read, false if the cache file does not exist,
+ *         is invalid or is outdated.
+ */
+bool readTextureCache(const std::string& cache_path,
+                      const std::string& source_path,
+                      TextureImage& image);
+
+/*! @brief Write the specified TextureImage to a texture cache file at
+ *         cache_path. Failure to write is not an error, as the cache is
+ *         optional.
+ *
+ * @return Whether the cache file was written.
+ */
+bool writeTextureCache(const std::string& cache_path,
+                       const std::string& source_path,
+                       const TextureImage& image);
+
+/*! @brief Upload the specified TextureImage into immutable texture storage
+ *         with a complete, generated, mipmap chain.
+ *
+ * @param image The TextureImage to upload.
+ * @param p_size If not nullptr, set to the size in bytes of the texture
+ *               storage including all mipmap levels.
+ *
+ * @return openGL pointer to the video memory location of the newly loaded
+ *         texture.
+ */
+GLuint uploadTexture(const TextureImage& image, GLsizeiptr* p_size = nullptr);
+
 /* @brief Load the png image at the given file location into video memory.
  * 
  * @param file_name Path to the png image to be loaded into memory.
@@ -26,4 +101,3 @@ GLuint loadTexturePNG(const std::string& file_name);
 
 } // pipeline
 } // nTiled
-
@@ -0,0 +1,97 @@
+/*! @file LightFile.h
+ *  @brief LightFile.h contains the functions to read and write light files,
+ *         either as lights.json or in the binary light format.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm\glm.hpp>
+
+
+namespace nTiled {
+namespace state {
+
+/*! @brief LightRecord holds the attributes of a single point light as
+ *         stored in a light file.
+ */
+struct LightRecord {
+  /*! @brief Position of the light in world coordinates. */
+  glm::vec3 position;
+  /*! @brief Colour intensity of the light. */
+  glm::vec3 intensity;
+  /*! @brief Influence radius of the light. */
+  float radius;
+};
+
+/*! @brief LightFileHeader is the header of a binary light file.
+ *
+ * The header is directly followed by n_lights tightly packed LightRecords,
+ * such that the file can be memory mapped and the records used in place.
+ */
+struct LightFileHeader {
+  /*! @brief Magic identifying a binary light file, "NTLT". */
+  char magic[4];
+  /*! @brief Version of the binary light format. */
+  std::uint32_t version;
+  /*! @brief Number of LightRecords following this header. */
+  std::uint64_t n_lights;
+};
+
+/*! @brief Get whether the file at path is a binary light file.
+ *
+ * @param path Path to the light file.
+ */
+bool isBinaryLightFile(const std::string& path);
+
+/*! @brief Read the lights of the specified lights.json file with a streaming
+ *         parser, without constructing a document of the whole file.
+ *
+ * @param path Path to the lights.json file.
+ * @param lights Vector to which the read lights are appended.
+ *
+ * @throws std::runtime_error If the file can not be opened or parsed.
+ */
+void readLightsJson(const std::string& path,
+                    std::vector<LightRecord>& lights);
+
+/*! @brief Read the lights of the specified binary light file.
+ *
+ * @param path Path to the binary light file.
+ * @param lights Vector to which the read lights are appended.
+ *
+ * @throws std::runtime_error If the file can not be opened or is invalid.
+ */
+void readLightsBinary(const std::string& path,
+                      std::vector<LightRecord>& lights);
+
+/*! @brief Write the specified lights as a lights.json file.
+ *
+ * @throws std::runtime_error If the file can not be written.
+ */
+void writeLightsJson(const std::string& path,
+                     const std::vector<LightRecord>& lights);
+
+/*! @brief Write the specified lights as a binary light file.
+ *
+ * @throws std::runtime_error If the file can not be written.
+ */
+void writeLightsBinary(const std::string& path,
+                       const std::vector<LightRecord>& lights);
+
+/*! @brief Convert the light file at input_path to the light file at
+ *         output_path. The input format is detected from its contents, the
+ *         output is binary unless output_path ends in ".json".
+ *
+ * @return The number of converted lights.
+ */
+std::size_t convertLights(const std::string& input_path,
+                          const std::string& output_path);
+
+} // state
+} // nTiled
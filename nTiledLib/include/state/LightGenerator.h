@@ -0,0 +1,173 @@
+/*! @file LightGenerator.h
+ *  @brief LightGenerator.h contains the functions to generate synthetic
+ *         sets of point lights, as an alternative to authoring lights.json
+ *         files by hand.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <glm\glm.hpp>
+#include <rapidjson\document.h>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "state\LightFile.h"
+#include "world\World.h"
+#include "world\light-constructor\LightConstructor.h"
+
+
+namespace nTiled {
+namespace state {
+
+/*! @brief LightDistribution specifies how generated lights are placed. */
+enum class LightDistribution {
+  /*! @brief Uniformly distributed within the bounds. */
+  Uniform,
+  /*! @brief Normally distributed around n_clusters uniformly distributed
+   *         cluster centres within the bounds.
+   */
+  Clustered,
+  /*! @brief On the cells of a regular grid spanning the bounds. */
+  Grid,
+  /*! @brief Uniformly distributed over the surfaces of the objects of the
+   *         World, offset along their normals.
+   */
+  Surface,
+};
+
+/*! @brief RadiusDistribution specifies how the radii of generated lights
+ *         are chosen.
+ */
+enum class RadiusDistribution {
+  /*! @brief Every light has radius_mean as radius. */
+  Constant,
+  /*! @brief Uniformly distributed between radius_min and radius_max. */
+  Uniform,
+  /*! @brief Normally distributed with radius_mean and radius_sigma,
+   *         clamped to radius_min and radius_max.
+   */
+  Normal,
+};
+
+/*! @brief LightGeneratorConfig holds the parameters of a generated set of
+ *         lights.
+ */
+struct LightGeneratorConfig {
+  /*! @brief Construct a LightGeneratorConfig of 1024 uniformly distributed
+   *         white lights with radius 5 within [-50, 50]^3.
+   */
+  LightGeneratorConfig();
+
+  /*! @brief Number of generated lights. */
+  std::size_t n_lights;
+  /*! @brief Seed of the random number generator. */
+  unsigned int seed;
+
+  /*! @brief Placement of the lights. */
+  LightDistribution distribution;
+  /*! @brief Minimum corner of the bounds in world coordinates. */
+  glm::vec3 bounds_min;
+  /*! @brief Maximum corner of the bounds in world coordinates. */
+  glm::vec3 bounds_max;
+  /*! @brief Whether the bounds are those of the objects of the World
+   *         instead of bounds_min and bounds_max.
+   */
+  bool is_using_world_bounds;
+  /*! @brief Number of clusters of a Clustered distribution. */
+  unsigned int n_clusters;
+  /*! @brief Standard deviation of the distance to the cluster centre of a
+   *         Clustered distribution.
+   */
+  float cluster_sigma;
+  /*! @brief Offset along the surface normal of a Surface distribution. */
+  float surface_offset;
+
+  /*! @brief Distribution of the radii of the lights. */
+  RadiusDistribution radius_distribution;
+  /*! @brief Minimum radius. */
+  float radius_min;
+  /*! @brief Maximum radius. */
+  float radius_max;
+  /*! @brief Mean radius. */
+  float radius_mean;
+  /*! @brief Standard deviation of the radius. */
+  float radius_sigma;
+
+  /*! @brief Colour intensity of every light. */
+  glm::vec3 intensity;
+  /*! @brief Whether the intensity is chosen uniformly per light instead. */
+  bool is_random_intensity;
+};
+
+/*! @brief Parse a LightGeneratorConfig from a json object of the form
+ *
+ * @code{.js}
+ * { "n_lights": 1024
+ * , "seed": 22
+ * , "distribution": "uniform" | "clustered" | "grid" | "surface"
+ * , "bounds": { "min": { "x", "y", "z" }, "max": { "x", "y", "z" } }
+ *              | "world"
+ * , "n_clusters": 8
+ * , "cluster_sigma": 2.0
+ * , "surface_offset": 0.1
+ * , "radius": { "distribution": "constant" | "uniform" | "normal"
+ *             , "min", "max", "mean", "sigma"
+ *             }
+ * , "intensity": { "r", "g", "b" } | "random"
+ * }
+ * @endcode
+ *
+ * where every member is optional.
+ *
+ * @throws std::runtime_error If a distribution is unknown.
+ */
+LightGeneratorConfig parseLightGeneratorConfig(const rapidjson::Value& config_json);
+
+/*! @brief Generate the lights specified by config.
+ *
+ * @param config The LightGeneratorConfig of the generated lights.
+ * @param world The World whose objects are used by a Surface distribution
+ *              and by world bounds.
+ * @param lights Vector to which the generated lights are appended.
+ *
+ * @throws std::runtime_error If the World has no objects while they are
+ *                            required.
+ */
+void generateLights(const LightGeneratorConfig& config,
+                    const world::World& world,
+                    std::vector<LightRecord>& lights);
+
+/*! @brief Generate the lights specified by config and add them to the World
+ *         of constructor, without writing them to storage.
+ *
+ * @param config The LightGeneratorConfig of the generated lights.
+ * @param world The World whose objects are used by a Surface distribution
+ *              and by world bounds.
+ * @param constructor The LightConstructor adding the lights to its World.
+ *
+ * @return The number of added lights.
+ */
+std::size_t addGeneratedLights(const LightGeneratorConfig& config,
+                               const world::World& world,
+                               world::LightConstructor& constructor);
+
+/*! @brief Generate the lights specified by the generator json file at
+ *         config_path and write them to the light file at output_path, as
+ *         a lights.json file if output_path ends in ".json" and as a binary
+ *         light file otherwise. The generator json file may list geometry
+ *         files under "geometry" for Surface distributions and world bounds.
+ *
+ * @return The number of generated lights.
+ */
+std::size_t generateLightFile(const std::string& config_path,
+                              const std::string& output_path);
+
+} // state
+} // nTiled
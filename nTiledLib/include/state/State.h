@@ -182,7 +182,10 @@ void parseGeometry(const std::string& path,
 
 /*! @brief Parse the camera lookAt matrix per frame for the PathCamera 
  *
- * @param path  Path to the camera_path.json file
+ * The PathCamera itself reads its frames lazily with a
+ * camera::CameraPathReader, this reads all frames at once.
+ *
+ * @param path  Path to the camera_path.json or binary camera path file
  */
 std::vector<glm::mat4> readCameraFrames(const std::string& path);
 
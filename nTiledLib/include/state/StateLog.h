@@ -63,6 +63,15 @@ struct Log {
   /*! @brief The path to where the logged calculation data should be written. */
   std::string path_calculations;
 
+  /*! @brief Whether the number of calculations per tile is logged as well. */
+  bool is_exporting_calculation_tiles;
+
+  /*! @brief The path to which logged timings are streamed as frames
+   *         complete, as csv if it ends in ".csv" and binary otherwise.
+   *         Empty if the timings are not streamed.
+   */
+  std::string stream_path;
+
   /*! @brief The frame at which logging should start. */
   unsigned int frame_start;
   /*! @brief The frame at which logging should cease. */
@@ -78,10 +78,15 @@ struct Shading {
   /*! @brief Whether this run is executed in DebugMode. */
   bool is_debug;
 
-  /*! @brief The tile_size in pixels used in Tiled and Clustered shading. */
-  const glm::uvec2 tile_size;
+  /*! @brief The tile_size in pixels used in Tiled and Clustered shading.
+   *         Read when a pipeline is constructed.
+   */
+  glm::uvec2 tile_size;
 
-  const pipeline::hashed::HashedConfig hashed_config;
+  /*! @brief The HashedConfig used in Hashed shading. Read when a pipeline
+   *         is constructed.
+   */
+  pipeline::hashed::HashedConfig hashed_config;
 };
 
 } // state
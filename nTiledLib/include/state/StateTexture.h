@@ -11,6 +11,11 @@
 
 #include <glad\glad.h>
 
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "pipeline\shader-util\LoadTextures.h"
+
 
 namespace nTiled {
 namespace state {
@@ -44,12 +49,51 @@ public:
    */
   GLuint getTexture(std::string texture_id);
 
+  /*! @brief Load every texture of this TextureCatalog which is not yet in
+   *         video memory. The png images are decoded concurrently, or read
+   *         from their texture cache, and uploaded on the calling thread,
+   *         which should own the openGL context.
+   *
+   * @param use_cache Whether texture cache files are read and written.
+   * @param n_threads The number of decoding threads, if 0 the number of
+   *                  hardware threads is used.
+   */
+  void loadTextures(bool use_cache = true, unsigned int n_threads = 0);
+
+  /*! @brief Get the size in bytes of all loaded textures, including their
+   *         mipmaps.
+   */
+  GLsizeiptr getTextureMemory() const { return this->texture_memory; }
+
+  /*! @brief Get the path of the texture cache file of the specified png
+   *         image.
+   */
+  static std::string getCachePath(const std::string& path);
+
 private:
+  /*! @brief Decode the png image at path into image, either from its
+   *         texture cache file or with lodepng.
+   *
+   * @return Whether image was read from the texture cache file.
+   */
+  static bool decodeTexture(const std::string& path,
+                            bool use_cache,
+                            pipeline::TextureImage& image);
+
+  /*! @brief Upload image and add it to the memory map as texture_id.
+   *
+   * @return openGL pointer to the uploaded texture.
+   */
+  GLuint addTexture(const std::string& texture_id,
+                    const pipeline::TextureImage& image);
+
   // Texture maps
   /*! @brief map containing texture ids to texture file paths. */
   std::map<std::string, std::string> file_map;
   /*! @brief map containing texture ids to memory locations. */
   std::map<std::string, GLuint> memory_map;
+  /*! @brief Size in bytes of all loaded textures. */
+  GLsizeiptr texture_memory;
 };
 
 } // state
@@ -27,6 +27,18 @@ enum class OutputType {
 };
 
 
+/*! @brief The CaptureFormat in which frames are written to memory.
+ *
+ * PNG is a default compressed png, PNGFast a lightly compressed png and
+ * TGA an uncompressed 32-bit targa image.
+ */
+enum class CaptureFormat {
+  PNG,
+  PNGFast,
+  TGA,
+};
+
+
 /*! @brief ViewOutput holds all data regarding the Output of the view.
  */
 struct ViewOutput {
@@ -40,10 +52,15 @@ struct ViewOutput {
    *                        stored.
    * @param frame_start Frame at which nTiled starts writing frames to storage
    * @param frame_end Frame at which nTiled ceases writing frames to storage
+   * @param capture_format The CaptureFormat in which frames are written.
+   * @param is_async_capture Whether frames are read back and written
+   *                         asynchronously.
    */
   ViewOutput(const std::string& image_base_path,
              const unsigned int frame_start,
-             const unsigned int frame_end);
+             const unsigned int frame_end,
+             const CaptureFormat capture_format = CaptureFormat::PNG,
+             const bool is_async_capture = false);
 
   /*! @brief Construct a new ViewOutput with OutputType::Display
    */
@@ -60,6 +77,10 @@ struct ViewOutput {
   const unsigned int frame_start;
   /*! Frame at which nTiled ceases writing frames to storage. */
   const unsigned int frame_end;
+  /*! @brief The CaptureFormat in which frames are written. */
+  const CaptureFormat capture_format;
+  /*! @brief Whether frames are read back and written asynchronously. */
+  const bool is_async_capture;
 };
 
 
@@ -100,6 +121,11 @@ struct View {
   const ViewOutput* output;
 
   bool display_light_calculations;
+
+  /*! @brief Whether this View is rendered offscreen, without a visible
+   *         window, gui or buffer swaps.
+   */
+  bool is_headless;
 };
 
 
@@ -0,0 +1,48 @@
+/*! @file FileStamp.h
+ *  @brief FileStamp.h contains the definition of FileStamp and the file
+ *         functions shared by the binary caches of nTiled.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+
+
+namespace nTiled {
+namespace util {
+
+/*! @brief FileStamp identifies a version of a file by its size and last
+ *         modification time. A cache derived from a file stores the
+ *         FileStamp of that file, such that it can detect the file changed.
+ */
+struct FileStamp {
+  /*! @brief Size of the file in bytes. */
+  std::uint64_t size;
+  /*! @brief Last modification time of the file. */
+  std::int64_t time;
+};
+
+/*! @brief Retrieve the FileStamp of the file at the specified path.
+ *
+ * @param path Path to the file.
+ * @param stamp FileStamp to which the result is written.
+ *
+ * @return Whether the file exists.
+ */
+bool getFileStamp(const std::string& path, FileStamp& stamp);
+
+/*! @brief Replace the file at path with the file at tmp_path. On failure
+ *         the file at tmp_path is removed.
+ *
+ * @param tmp_path Path to the completely written replacement file.
+ * @param path Path to the file to replace.
+ *
+ * @return Whether the file at path was replaced.
+ */
+bool replaceFile(const std::string& tmp_path, const std::string& path);
+
+} // util
+} // nTiled
@@ -0,0 +1,37 @@
+/*! @file MemoryUsage.h
+ *  @brief MemoryUsage.h contains functions to query the memory usage of the
+ *         nTiled process.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstddef>
+
+
+namespace nTiled {
+namespace util {
+
+/*! @brief Get the peak resident memory of this process in bytes, or 0 if it
+ *         can not be determined on this platform. This is the peak since 
+ *         the last resetPeakMemoryUsage, or since the process started.
+ */
+std::size_t getPeakMemoryUsage();
+
+/*! @brief Reset the peak resident memory of this process to its current
+ *         resident memory.
+ *
+ * @returns Whether the peak could be reset on this platform. If not, 
+ *          getPeakMemoryUsage keeps reporting the peak since the process
+ *          started.
+ */
+bool resetPeakMemoryUsage();
+
+/*! @brief Get the current resident memory of this process in bytes, or 0 if
+ *         it can not be determined on this platform.
+ */
+std::size_t getCurrentMemoryUsage();
+
+} // util
+} // nTiled
@@ -0,0 +1,71 @@
+/*! @file ParallelFor.h
+ *  @brief ParallelFor.h contains parallelFor, which distributes independent
+ *         work items over a number of worker threads.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace nTiled {
+namespace util {
+
+/*! @brief Get the default number of worker threads, the number of hardware
+ *         threads.
+ */
+inline unsigned int getDefaultNThreads() {
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/*! @brief Call f(i) for every i in [0, n_items) on at most n_threads threads,
+ *         including the calling thread. Items are handed out one at a time,
+ *         such that items of very different cost are balanced.
+ *
+ * @param n_items The number of work items.
+ * @param n_threads The maximum number of threads, if 0 the default number of
+ *                  threads is used.
+ * @param f The function called for every work item.
+ *
+ * @throws The first exception thrown by f, after all threads finished.
+ */
+template <typename F>
+void parallelFor(unsigned int n_items, unsigned int n_threads, F f) {
+  if (n_threads == 0) n_threads = getDefaultNThreads();
+
+  std::atomic<unsigned int> next_item(0);
+  std::exception_ptr p_error = nullptr;
+  std::mutex error_mutex;
+
+  auto worker = [&]() {
+    for (unsigned int i = next_item++; i < n_items; i = next_item++) {
+      try {
+        f(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!p_error) p_error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned int t = 1; t < std::min(n_threads, n_items); ++t) {
+    workers.push_back(std::thread(worker));
+  }
+  worker();
+  for (std::thread& t : workers) {
+    t.join();
+  }
+
+  if (p_error) std::rethrow_exception(p_error);
+}
+
+} // util
+} // nTiled
@@ -16,6 +16,12 @@
 
 
 namespace nTiled {
+namespace pipeline {
+
+enum class VertexFormat;
+
+}
+
 namespace world {
 
 /*! @brief World contains all objects, meshes and lights of a single run of 
@@ -55,6 +61,12 @@ public:
                       const std::vector<glm::vec3>& uvs,
                       const std::vector<glm::tvec3<glm::u32>> elements);
 
+  /*! @brief Add the specified Mesh to this World, taking over its data.
+   *
+   * @param mesh The Mesh to be moved into this World.
+   */
+  Mesh* constructMesh(Mesh&& mesh);
+
   /*! @brief Construct A new Object with the given parameters and add it to
    *         this World.
    * 
@@ -100,6 +112,11 @@ public:
   std::vector<Object*> p_objects;
   /*! @brief std::vector of pointers to every PointLight of this World */
   std::vector<PointLight*> p_lights;
+
+  /*! @brief The VertexFormat with which the Meshes of this World are
+   *         uploaded by the shaders, Packed by default.
+   */
+  pipeline::VertexFormat vertex_format;
 };
 
 }
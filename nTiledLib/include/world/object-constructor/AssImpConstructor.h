@@ -28,6 +28,16 @@ public:
   AssImpConstructor(const std::string& path,
                     World& world);
 
+  /*! @brief Construct a new Object constructor that modifies the specified
+   *         world by adding objects with the specified, already loaded, mesh.
+   *
+   * @param p_mesh Pointer to a Mesh of world.
+   * @param world World to which this AssImpConstructor should add the
+   *        constructed objects.
+   */
+  AssImpConstructor(Mesh* p_mesh,
+                    World& world);
+
   /*! @brief Add a new object with this AssImpConstructor's Mesh to this 
    *         AssImpConstructor's world
    * 
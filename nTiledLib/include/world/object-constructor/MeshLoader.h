@@ -0,0 +1,167 @@
+/*! @file MeshLoader.h
+ *  @brief MeshLoader.h contains the definition of the MeshLoader which
+ *         imports the Mesh definition files of a scene concurrently and
+ *         caches the processed Meshes in a binary format.
+ */
+#pragma once
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "world\World.h"
+
+
+namespace nTiled {
+namespace world {
+
+/*! @brief MeshCacheHeader is the header of a binary mesh cache file.
+ *
+ * The header is directly followed by the tightly packed vertex, normal, uv
+ * and element blobs of the Mesh, in that order, with n_vertices,
+ * n_normals, n_uvs and n_elements entries respectively. Every blob starts
+ * at a multiple of four bytes, such that the file can be memory mapped and
+ * the blobs used in place.
+ */
+struct MeshCacheHeader {
+  /*! @brief Magic identifying a mesh cache file, "NTMC". */
+  char magic[4];
+  /*! @brief Version of the mesh cache format. */
+  std::uint32_t version;
+  /*! @brief Size in bytes of the source file this cache was created from.*/
+  std::uint64_t source_size;
+  /*! @brief Last modification time of the source file this cache was
+   *         created from.
+   */
+  std::int64_t source_time;
+  /*! @brief Number of glm::vec4 vertices. */
+  std::uint32_t n_vertices;
+  /*! @brief Number of glm::vec3 normals. */
+  std::uint32_t n_normals;
+  /*! @brief Number of glm::vec3 uvs. */
+  std::uint32_t n_uvs;
+  /*! @brief Number of glm::tvec3<glm::u32> elements. */
+  std::uint32_t n_elements;
+};
+
+
+/*! @brief MeshLoader is responsible for loading the Mesh definition files
+ *         of a scene into a World.
+ *
+ * Files are imported concurrently on a pool of worker threads. Each
+ * imported Mesh is written to a cache file next to its source, which is
+ * read instead of the source on subsequent runs as long as the source has
+ * not changed. The Meshes are added to the World on the calling thread.
+ */
+class MeshLoader {
+public:
+  // --------------------------------------------------------------------------
+  //  Constructor
+  // --------------------------------------------------------------------------
+  /*! @brief Construct a new MeshLoader.
+   *
+   * @param use_cache Whether mesh cache files are read and written.
+   * @param n_threads The number of worker threads, if 0 the number of
+   *                  hardware threads is used.
+   */
+  MeshLoader(bool use_cache, unsigned int n_threads = 0);
+
+  // --------------------------------------------------------------------------
+  //  Load
+  // --------------------------------------------------------------------------
+  /*! @brief Load the Mesh definition files at the specified paths and add
+   *         the resulting Meshes to the specified World.
+   *
+   * @param paths Paths to the Mesh definition files.
+   * @param world World to which the loaded Meshes are added.
+   *
+   * @return Pointers to the added Meshes, in the order of paths.
+   *
+   * @throws std::runtime_error If any of the files could not be imported.
+   */
+  std::vector<Mesh*> load(const std::vector<std::string>& paths,
+                          World& world);
+
+  // --------------------------------------------------------------------------
+  //  Getters
+  // --------------------------------------------------------------------------
+  /*! @brief Get the number of Meshes read from a cache file at the last
+   *         call to load.
+   */
+  unsigned int getNCacheHits() const { return this->n_cache_hits; }
+
+  /*! @brief Get the time in milliseconds the last call to load took. */
+  double getLoadTime() const { return this->load_time; }
+
+  /*! @brief Get the path of the cache file of the specified Mesh
+   *         definition file.
+   */
+  static std::string getCachePath(const std::string& path);
+
+private:
+  /*! @brief Load the Mesh definition file at path into mesh, either from
+   *         its cache file or with AssImp.
+   *
+   * @return Whether mesh was read from the cache file.
+   */
+  bool loadMesh(const std::string& path, Mesh& mesh) const;
+
+  /*! @brief Whether mesh cache files are read and written. */
+  bool use_cache;
+  /*! @brief The number of worker threads. */
+  unsigned int n_threads;
+  /*! @brief Number of Meshes read from a cache file at the last load. */
+  unsigned int n_cache_hits;
+  /*! @brief Time in milliseconds of the last load. */
+  double load_time;
+};
+
+
+// ----------------------------------------------------------------------------
+//  Mesh import and cache functions
+// ----------------------------------------------------------------------------
+/*! @brief Import the first mesh of the specified file with AssImp.
+ *
+ * @param path Path to the Mesh definition file.
+ * @param mesh Mesh to which the imported data is written.
+ *
+ * @throws std::runtime_error If the file does not contain any meshes.
+ */
+void importMesh(const std::string& path, Mesh& mesh);
+
+/*! @brief Read the Mesh cache file at cache_path if it is up to date with
+ *         the specified source file.
+ *
+ * @param cache_path Path to the Mesh cache file.
+ * @param source_path Path to the Mesh definition file.
+ * @param mesh Mesh to which the cached data is written.
+ *
+ * @return Whether mesh was read, false if the cache file does not exist,
+ *         is invalid or is outdated.
+ */
+bool readMeshCache(const std::string& cache_path,
+                   const std::string& source_path,
+                   Mesh& mesh);
+
+/*! @brief Write the specified Mesh to a Mesh cache file at cache_path.
+ *         Failure to write is not an error, as the cache is optional.
+ *
+ * @param cache_path Path to the Mesh cache file.
+ * @param source_path Path to the Mesh definition file mesh was imported
+ *                    from.
+ * @param mesh The Mesh to write.
+ *
+ * @return Whether the cache file was written.
+ */
+bool writeMeshCache(const std::string& cache_path,
+                    const std::string& source_path,
+                    const Mesh& mesh);
+
+} // world
+} // nTiled
@@ -81,8 +81,8 @@ void AutomaticRotateCameraControl::activate(const ImGuiIO& io) {
 //  PathCameraControl
 // ----------------------------------------------------------------------------
 // Constructor
-PathCameraControl::PathCameraControl(std::vector<glm::mat4> frames) :
-  frames(frames) {
+PathCameraControl::PathCameraControl(const std::string& path) :
+  reader(path) {
 }
 
 // ----------------------------------------------------------------------------
@@ -90,15 +90,19 @@ PathCameraControl::PathCameraControl(std::vector<glm::mat4> frames) :
 void PathCameraControl::update(const ImGuiIO& io,
                                CameraData& data) {
   // Load the look at matrix of this frame into the data
-  if (current_frame < this->frames.size()) {
-    data.lookAt = frames[this->current_frame];
-    this->current_frame += 1;
+  glm::mat4 look_at;
+  if (this->reader.next(look_at)) {
+    data.lookAt = look_at;
   }
 }
 
 void PathCameraControl::activate(const ImGuiIO& io) { 
 }
 
+void PathCameraControl::restart() {
+  this->reader.rewind();
+}
+
 
 } // camera
 } // pipeline
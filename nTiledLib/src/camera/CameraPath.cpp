@@ -0,0 +1,299 @@
+#include "camera\CameraPath.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glm\gtc\matrix_transform.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+// Json include
+#include <rapidjson\reader.h>
+#include <rapidjson\filereadstream.h>
+
+// ----------------------------------------------------------------------------
+//  Defines
+// ----------------------------------------------------------------------------
+#define CAMERA_PATH_VERSION 1
+// Number of frames read from a binary camera path file at once
+#define CAMERA_PATH_CHUNK_SIZE 1024
+// Size of the read buffer of the json stream
+#define CAMERA_PATH_STREAM_BUFFER_SIZE 65536
+
+
+namespace nTiled {
+namespace camera {
+
+static_assert(sizeof(CameraFrame) == 9 * sizeof(float),
+              "CameraFrame must be tightly packed");
+static_assert(sizeof(glm::mat4) == 16 * sizeof(float),
+              "glm::mat4 must be tightly packed");
+static_assert(sizeof(CameraPathHeader) == 24,
+              "CameraPathHeader must not contain padding");
+
+// ----------------------------------------------------------------------------
+//  Json reader
+// ----------------------------------------------------------------------------
+/*! @brief FramesHandler builds CameraFrames from the events of a streaming
+ *         json reader, for files of the form
+ *         { "frames": [ { "eye": { "x", "y", "z" },
+ *                         "center": { "x", "y", "z" },
+ *                         "up": { "x", "y", "z" } }, ... ] }
+ */
+class FramesHandler :
+    public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, FramesHandler> {
+public:
+  FramesHandler(std::vector<CameraFrame>& frames) :
+      frames(frames),
+      object_depth(0),
+      is_in_frames(false),
+      p_attribute(nullptr),
+      key("") {
+    this->resetFrame();
+  }
+
+  bool StartObject() {
+    this->object_depth++;
+    if (this->object_depth == 3 && this->is_in_frames) {
+      if (this->key == "eye") this->p_attribute = &(this->frame.eye);
+      else if (this->key == "center") this->p_attribute = &(this->frame.center);
+      else if (this->key == "up") this->p_attribute = &(this->frame.up);
+    }
+    return true;
+  }
+
+  bool EndObject(rapidjson::SizeType n_members) {
+    if (this->object_depth == 3) {
+      this->p_attribute = nullptr;
+    } else if (this->object_depth == 2 && this->is_in_frames) {
+      this->frames.push_back(this->frame);
+      this->resetFrame();
+    }
+    this->object_depth--;
+    return true;
+  }
+
+  bool StartArray() {
+    if (this->object_depth == 1 && this->key == "frames") {
+      this->is_in_frames = true;
+    }
+    return true;
+  }
+
+  bool EndArray(rapidjson::SizeType n_elements) {
+    if (this->object_depth == 1) this->is_in_frames = false;
+    return true;
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+    this->key.assign(str, length);
+    return true;
+  }
+
+  bool Double(double d) { return this->number(float(d)); }
+  bool Int(int i) { return this->number(float(i)); }
+  bool Uint(unsigned u) { return this->number(float(u)); }
+  bool Int64(int64_t i) { return this->number(float(i)); }
+  bool Uint64(uint64_t u) { return this->number(float(u)); }
+
+private:
+  bool number(float value) {
+    if (this->object_depth != 3 || !this->p_attribute) return true;
+
+    if (this->key == "x") this->p_attribute->x = value;
+    else if (this->key == "y") this->p_attribute->y = value;
+    else if (this->key == "z") this->p_attribute->z = value;
+    return true;
+  }
+
+  void resetFrame() {
+    this->frame.eye = glm::vec3(0.0f);
+    this->frame.center = glm::vec3(0.0f);
+    this->frame.up = glm::vec3(0.0f, 1.0f, 0.0f);
+  }
+
+  std::vector<CameraFrame>& frames;
+  CameraFrame frame;
+
+  int object_depth;
+  bool is_in_frames;
+  glm::vec3* p_attribute;
+  std::string key;
+};
+
+
+bool isBinaryCameraPath(const std::string& path) {
+  std::ifstream ifs(path, std::ios::binary);
+  char magic[4];
+  return (ifs.read(magic, 4) && std::memcmp(magic, "NTCP", 4) == 0);
+}
+
+
+void readCameraPathJson(const std::string& path,
+                        std::vector<CameraFrame>& frames) {
+  std::FILE* p_file = std::fopen(path.c_str(), "rb");
+  if (!p_file) {
+    throw std::runtime_error(std::string("Could not open camera path file: ") + path);
+  }
+
+  std::size_t n_frames_before = frames.size();
+
+  char buffer[CAMERA_PATH_STREAM_BUFFER_SIZE];
+  rapidjson::FileReadStream stream(p_file, buffer, sizeof(buffer));
+  FramesHandler handler(frames);
+  rapidjson::Reader reader;
+  rapidjson::ParseResult result = reader.Parse(stream, handler);
+  std::fclose(p_file);
+
+  if (!result) {
+    throw std::runtime_error(std::string("Could not parse camera path file: ") + path +
+                             std::string(" at offset ") +
+                             std::to_string(result.Offset()));
+  }
+  if (frames.size() == n_frames_before) {
+    throw std::runtime_error(std::string("No frames found in specified path"));
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+//  Binary writer
+// ----------------------------------------------------------------------------
+void writeCameraPathBinary(const std::string& path,
+                           const std::vector<CameraFrame>& frames,
+                           CameraPathFormat format) {
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+
+  CameraPathHeader header;
+  std::memcpy(header.magic, "NTCP", 4);
+  header.version = CAMERA_PATH_VERSION;
+  header.format = format;
+  header.reserved = 0;
+  header.n_frames = frames.size();
+  ofs.write(reinterpret_cast<const char*>(&header), sizeof(CameraPathHeader));
+
+  if (format == CameraPathFormat::Matrix) {
+    for (const CameraFrame& frame : frames) {
+      glm::mat4 look_at = glm::lookAt(frame.eye, frame.center, frame.up);
+      ofs.write(reinterpret_cast<const char*>(&look_at), sizeof(glm::mat4));
+    }
+  } else if (!frames.empty()) {
+    ofs.write(reinterpret_cast<const char*>(frames.data()),
+              std::streamsize(sizeof(CameraFrame) * frames.size()));
+  }
+
+  if (!ofs) {
+    throw std::runtime_error(std::string("Could not write camera path file: ") + path);
+  }
+}
+
+
+std::size_t convertCameraPath(const std::string& input_path,
+                              const std::string& output_path,
+                              CameraPathFormat format) {
+  std::vector<CameraFrame> frames;
+  readCameraPathJson(input_path, frames);
+  writeCameraPathBinary(output_path, frames, format);
+  return frames.size();
+}
+
+
+// ----------------------------------------------------------------------------
+//  CameraPathReader
+// ----------------------------------------------------------------------------
+CameraPathReader::CameraPathReader(const std::string& path) :
+    path(path),
+    is_streamed(false),
+    format(CameraPathFormat::LookAt),
+    n_frames(0),
+    n_buffered(0),
+    buffer_index(0) {
+  if (!isBinaryCameraPath(path)) {
+    readCameraPathJson(path, this->frame_buffer);
+    this->n_frames = this->frame_buffer.size();
+    this->n_buffered = this->n_frames;
+    return;
+  }
+
+  this->ifs.open(path, std::ios::binary);
+  CameraPathHeader header;
+  if (!this->ifs.read(reinterpret_cast<char*>(&header), sizeof(CameraPathHeader)) ||
+      header.version != CAMERA_PATH_VERSION ||
+      (header.format != CameraPathFormat::LookAt &&
+       header.format != CameraPathFormat::Matrix)) {
+    throw std::runtime_error(std::string("Invalid binary camera path file: ") + path);
+  }
+  if (header.n_frames == 0) {
+    throw std::runtime_error(std::string("No frames found in specified path"));
+  }
+
+  this->is_streamed = true;
+  this->format = header.format;
+  this->n_frames = header.n_frames;
+}
+
+
+void CameraPathReader::readChunk() {
+  std::size_t n_chunk = std::size_t(std::min<std::uint64_t>(
+    CAMERA_PATH_CHUNK_SIZE, this->n_frames - this->n_buffered));
+
+  bool is_read;
+  if (this->format == CameraPathFormat::Matrix) {
+    this->matrix_buffer.resize(n_chunk);
+    is_read = bool(this->ifs.read(
+      reinterpret_cast<char*>(this->matrix_buffer.data()),
+      std::streamsize(sizeof(glm::mat4) * n_chunk)));
+  } else {
+    this->frame_buffer.resize(n_chunk);
+    is_read = bool(this->ifs.read(
+      reinterpret_cast<char*>(this->frame_buffer.data()),
+      std::streamsize(sizeof(CameraFrame) * n_chunk)));
+  }
+
+  if (!is_read) {
+    throw std::runtime_error(std::string("Truncated binary camera path file: ") + this->path);
+  }
+  this->n_buffered += n_chunk;
+  this->buffer_index = 0;
+}
+
+
+bool CameraPathReader::next(glm::mat4& look_at) {
+  std::size_t buffer_size = (this->format == CameraPathFormat::Matrix) ?
+    this->matrix_buffer.size() : this->frame_buffer.size();
+
+  if (this->buffer_index == buffer_size) {
+    if (!this->is_streamed || this->n_buffered == this->n_frames) {
+      return false;
+    }
+    this->readChunk();
+  }
+
+  if (this->format == CameraPathFormat::Matrix) {
+    look_at = this->matrix_buffer[this->buffer_index];
+  } else {
+    const CameraFrame& frame = this->frame_buffer[this->buffer_index];
+    look_at = glm::lookAt(frame.eye, frame.center, frame.up);
+  }
+  this->buffer_index++;
+  return true;
+}
+
+
+void CameraPathReader::rewind() {
+  this->buffer_index = 0;
+  if (!this->is_streamed) return;
+
+  // Drop the buffered chunk, the next frame is read from the first chunk
+  this->ifs.clear();
+  this->ifs.seekg(sizeof(CameraPathHeader), std::ios::beg);
+  this->n_buffered = 0;
+  this->frame_buffer.clear();
+  this->matrix_buffer.clear();
+}
+
+} // camera
+} // nTiled
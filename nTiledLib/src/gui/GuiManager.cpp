@@ -37,6 +37,14 @@ void GuiManager::update() {
   
 }
 
+void GuiManager::updateHeadless() {
+  if (!this->state.view.camera.isUserControlled()) {
+    // an ImGuiIO without any input, no ImGui context is required
+    ImGuiIO io;
+    this->state.view.camera.update(io);
+  }
+}
+
 void GuiManager::render() {
   ImGui::Render();
 }
@@ -0,0 +1,205 @@
+#include "log\GpuTimer.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+namespace nTiled {
+namespace logged {
+
+// ----------------------------------------------------------------------------
+//  Constructor | Destructor
+// ----------------------------------------------------------------------------
+GpuTimer::GpuTimer(Profiler& profiler,
+                   unsigned int n_frames,
+                   unsigned int max_queries_per_frame) :
+    profiler(profiler),
+    is_supported(GpuTimer::isSupported()),
+    n_queries(std::max(max_queries_per_frame, 2u)),
+    current_pool(0),
+    gpu_offset(0),
+    n_dropped(0) {
+  this->pools.resize(std::max(n_frames, 2u));
+  for (FramePool& pool : this->pools) {
+    pool.n_used = 0;
+    pool.frame = profiler.getFrame();
+    pool.is_pending = false;
+    if (this->is_supported) {
+      pool.queries.resize(this->n_queries);
+      glGenQueries(GLsizei(this->n_queries), pool.queries.data());
+    }
+  }
+
+  if (this->is_supported) {
+    // Relate the GPU clock to the Profiler clock, such that GPU spans line
+    // up with the CPU spans in the trace.
+    GLint64 gpu_time;
+    glGetInteger64v(GL_TIMESTAMP, &gpu_time);
+    this->gpu_offset = std::int64_t(gpu_time) - profiler.getTime();
+  }
+}
+
+
+GpuTimer::~GpuTimer() {
+  if (!this->is_supported) return;
+  for (FramePool& pool : this->pools) {
+    glDeleteQueries(GLsizei(pool.queries.size()), pool.queries.data());
+  }
+}
+
+
+bool GpuTimer::isSupported() {
+  return (GLAD_GL_VERSION_3_3 || GLAD_GL_ARB_timer_query) != 0;
+}
+
+
+// ----------------------------------------------------------------------------
+//  Timing
+// ----------------------------------------------------------------------------
+ScopeId GpuTimer::getGpuScope(ScopeId scope) {
+  if (scope >= this->gpu_scopes.size()) {
+    this->gpu_scopes.resize(scope + 1, -1);
+  }
+  if (this->gpu_scopes[scope] < 0) {
+    this->gpu_scopes[scope] = internScope(getScopeName(scope) + " (GPU)");
+  }
+  return ScopeId(this->gpu_scopes[scope]);
+}
+
+
+unsigned int GpuTimer::issueQuery() {
+  FramePool& pool = this->pools[this->current_pool];
+  if (pool.n_used == this->n_queries) return this->n_queries;
+
+  glQueryCounter(pool.queries[pool.n_used], GL_TIMESTAMP);
+  return pool.n_used++;
+}
+
+
+void GpuTimer::begin(ScopeId scope) {
+  if (!this->is_supported) return;
+  FramePool& pool = this->pools[this->current_pool];
+
+  Interval interval;
+  interval.scope = this->getGpuScope(scope);
+  interval.begin_query = this->issueQuery();
+  interval.end_query = this->n_queries;
+  interval.depth = std::uint32_t(this->open_intervals.size());
+
+  this->open_intervals.push_back(static_cast<unsigned int>(pool.intervals.size()));
+  pool.intervals.push_back(interval);
+}
+
+
+void GpuTimer::end(ScopeId scope) {
+  if (!this->is_supported) return;
+  if (this->open_intervals.empty()) {
+    throw std::runtime_error(std::string("GpuTimer was ended without a begun stage."));
+  }
+
+  FramePool& pool = this->pools[this->current_pool];
+  Interval& interval = pool.intervals[this->open_intervals.back()];
+  this->open_intervals.pop_back();
+  if (interval.scope != this->getGpuScope(scope)) {
+    throw std::runtime_error(std::string("GpuTimer ended ") + getScopeName(scope) +
+                             std::string(" which is not the most recently begun stage."));
+  }
+
+  if (interval.begin_query != this->n_queries) {
+    interval.end_query = this->issueQuery();
+  }
+}
+
+
+void GpuTimer::nextFrame(std::uint32_t frame) {
+  if (!this->is_supported) return;
+
+  // Stages still open at the end of the frame are not timed
+  FramePool& current = this->pools[this->current_pool];
+  this->n_dropped += this->open_intervals.size();
+  this->open_intervals.clear();
+  current.is_pending = (current.n_used > 0);
+
+  // Read every pool whose results are available, without waiting
+  for (FramePool& pool : this->pools) {
+    if (pool.is_pending) this->resolve(pool, false);
+  }
+
+  // Reuse the oldest pool, dropping its results if they are still pending
+  this->current_pool = (this->current_pool + 1) % this->pools.size();
+  FramePool& next = this->pools[this->current_pool];
+  if (next.is_pending) {
+    this->n_dropped += next.intervals.size();
+  }
+  next.n_used = 0;
+  next.intervals.clear();
+  next.frame = frame;
+  next.is_pending = false;
+}
+
+
+void GpuTimer::flush() {
+  if (!this->is_supported) return;
+
+  FramePool& current = this->pools[this->current_pool];
+  current.is_pending = (current.n_used > 0);
+
+  // Read in frame order, starting at the oldest pool
+  for (unsigned int i = 1; i <= this->pools.size(); ++i) {
+    FramePool& pool = this->pools[(this->current_pool + i) % this->pools.size()];
+    if (pool.is_pending) this->resolve(pool, true);
+  }
+
+  current.n_used = 0;
+  current.intervals.clear();
+  this->open_intervals.clear();
+}
+
+
+bool GpuTimer::resolve(FramePool& pool, bool is_waiting) {
+  // Timestamps complete in order, the last query is available last
+  if (!is_waiting) {
+    GLuint is_available = GL_FALSE;
+    glGetQueryObjectuiv(pool.queries[pool.n_used - 1],
+                        GL_QUERY_RESULT_AVAILABLE,
+                        &is_available);
+    if (is_available == GL_FALSE) return false;
+  }
+
+  for (const Interval& interval : pool.intervals) {
+    if (interval.begin_query == this->n_queries ||
+        interval.end_query == this->n_queries) {
+      this->n_dropped++;
+      continue;
+    }
+
+    GLuint64 begin_time;
+    GLuint64 end_time;
+    glGetQueryObjectui64v(pool.queries[interval.begin_query],
+                          GL_QUERY_RESULT,
+                          &begin_time);
+    glGetQueryObjectui64v(pool.queries[interval.end_query],
+                          GL_QUERY_RESULT,
+                          &end_time);
+
+    ProfileSpan span;
+    span.start = std::int64_t(begin_time) - this->gpu_offset;
+    span.duration = std::int64_t(end_time - begin_time);
+    span.scope = interval.scope;
+    span.thread = Profiler::gpu_thread;
+    span.frame = pool.frame;
+    span.depth = interval.depth;
+    this->profiler.addSpan(span);
+  }
+
+  pool.intervals.clear();
+  pool.is_pending = false;
+  return true;
+}
+
+} // logged
+} // nTiled
@@ -1,14 +1,32 @@
 #include "log\LightCalculationsLogger.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 // Json include
 #include <rapidjson\document.h>
 #include <rapidjson\writer.h>
 #include <rapidjson\stringbuffer.h>
 
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "pipeline\shader-util\LoadShaders.h"
+#include "util\ParallelFor.h"
+
+// ----------------------------------------------------------------------------
+//  defines
+// ----------------------------------------------------------------------------
+#define LIGHT_CALC_REDUCE_SHADER_PATH std::string("../nTiledLib/src/log/compute-glsl/light_calculations_reduce.glsl")
+// Must match TILE_SIZE_X and TILE_SIZE_Y of the reduction shader
+#define LIGHT_CALC_TILE_SIZE 16
+// Number of frames a reduction is read back after it was dispatched
+#define LIGHT_CALC_N_SLOTS 3
+
 
 namespace nTiled {
 namespace logged {
@@ -20,12 +38,20 @@ namespace logged {
 LightCalculationsLogger::LightCalculationsLogger(const Clock& clock,
                                                  std::string output_path,
                                                  unsigned int width,
-                                                 unsigned int height) :
+                                                 unsigned int height,
+                                                 bool is_exporting_tiles) :
   clock(clock),
   output_path(output_path),
   width(width), 
   height(height),
-  is_active(false) {
+  is_active(false),
+  is_exporting_tiles(is_exporting_tiles),
+  is_reducing_on_gpu(LightCalculationsLogger::isGPUReductionSupported()),
+  has_last_extraction(false),
+  n_tiles((width + LIGHT_CALC_TILE_SIZE - 1) / LIGHT_CALC_TILE_SIZE,
+          (height + LIGHT_CALC_TILE_SIZE - 1) / LIGHT_CALC_TILE_SIZE),
+  reduce_shader(0),
+  next_slot(0) {
 
   // Create FBO
   // --------------------------------------------------------------------------
@@ -100,10 +126,52 @@ LightCalculationsLogger::LightCalculationsLogger(const Clock& clock,
   }
 
   glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+  // Setup reduction
+  // ------------------------------------------------------------------------
+  if (this->is_reducing_on_gpu) {
+    this->loadReduceShader();
+
+    this->slots.resize(LIGHT_CALC_N_SLOTS);
+    for (ReductionSlot& slot : this->slots) {
+      glGenBuffers(1, &(slot.ssbo));
+      glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.ssbo);
+      glBufferData(GL_SHADER_STORAGE_BUFFER,
+                   sizeof(GLuint) * this->n_tiles.x * this->n_tiles.y,
+                   NULL,
+                   GL_STREAM_READ);
+      slot.fence = 0;
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  }
+}
+
+
+LightCalculationsLogger::~LightCalculationsLogger() {
+  for (ReductionSlot& slot : this->slots) {
+    if (slot.fence) glDeleteSync(slot.fence);
+    glDeleteBuffers(1, &(slot.ssbo));
+  }
+  if (this->reduce_shader) glDeleteProgram(this->reduce_shader);
+}
+
+
+bool LightCalculationsLogger::isGPUReductionSupported() {
+  return (GLAD_GL_VERSION_4_3 || 
+          (GLAD_GL_ARB_compute_shader && GLAD_GL_ARB_shader_storage_buffer_object)) != 0;
 }
 
 
-LightCalculationsLogger::~LightCalculationsLogger() { }
+void LightCalculationsLogger::loadReduceShader() {
+  std::ifstream file_in(LIGHT_CALC_REDUCE_SHADER_PATH, std::ifstream::in);
+  if (!file_in) {
+    throw std::runtime_error(std::string("Could not read shader: ") + LIGHT_CALC_REDUCE_SHADER_PATH);
+  }
+
+  std::stringstream compute_shader_buffer;
+  compute_shader_buffer << file_in.rdbuf();
+  this->reduce_shader = createComputeProgram(compute_shader_buffer.str());
+}
 
 
 void LightCalculationsLogger::activate() {
@@ -119,6 +187,9 @@ void LightCalculationsLogger::deactivate() {
       throw std::runtime_error(std::string("ExecutionTimeLogger is not yet active."));
   }
   this->is_active = false;
+
+  // Collect the outstanding reductions while the context is current
+  this->flush();
 }
 
 
@@ -141,53 +212,167 @@ void LightCalculationsLogger::postRender() {
 
 void LightCalculationsLogger::extractCalculations() {
   if (this->is_active) {
-    glBindFramebuffer(GL_READ_FRAMEBUFFER,
-                      this->p_fbo);
-    glReadBuffer(GL_COLOR_ATTACHMENT0);
-    glActiveTexture(GL_TEXTURE0);
-
-    // get data from the texture
-    std::vector<GLuint> light_calculations = std::vector<GLuint>(this->width * this->height);
-    glBindTexture(GL_TEXTURE_2D, this->p_calc_texture);
-    glGetTexImage(GL_TEXTURE_2D,
-                  0,
-                  GL_RED_INTEGER,
-                  GL_UNSIGNED_INT,
-                  light_calculations.data());
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    /*
-    // export data to disk
-    std::string file_path = this->output_path +
-      ("/frame_" + std::to_string(clock.getCurrentFrame()) + ".dat");
-
-    std::ofstream frame_file;
-    frame_file.open(file_path, std::ios::out | std::ios::trunc);
-
-    for (GLuint val : light_calculations) {
-      frame_file << val << ";";
+    auto start = std::chrono::steady_clock::now();
+
+    FrameCalculations calculations;
+    calculations.frame = this->clock.getCurrentFrame();
+    calculations.n_calc = 0;
+    calculations.frame_ms = this->has_last_extraction ?
+      std::chrono::duration<double, std::milli>(start - this->last_extraction).count() :
+      0.0;
+    calculations.overhead_ms = 0.0;
+    FrameCalculations* p_calculations = &calculations;
+
+    if (this->is_reducing_on_gpu) {
+      ReductionSlot& slot = this->slots[this->next_slot];
+      this->next_slot = (this->next_slot + 1) % this->slots.size();
+
+      // the frame previously reduced into this slot is n_slots frames old
+      if (slot.fence) {
+        this->retire(slot);
+      }
+      slot.calculations = calculations;
+      this->reduceOnGPU(slot);
+      p_calculations = &(slot.calculations);
+    } else {
+      this->reduceOnCPU(calculations);
     }
 
-    frame_file.close();
-    */
-    glBindFramebuffer(GL_READ_FRAMEBUFFER,
-                      0);
+    auto end = std::chrono::steady_clock::now();
+    p_calculations->overhead_ms =
+      std::chrono::duration<double, std::milli>(end - start).count();
+    if (!this->is_reducing_on_gpu) {
+      this->addCalculations(calculations);
+    }
 
-    unsigned long summed_calculations = 0;
-    
+    // the overhead is excluded from the time of the next frame
+    this->last_extraction = end;
+    this->has_last_extraction = true;
+  }
+}
+
+
+void LightCalculationsLogger::reduceOnGPU(ReductionSlot& slot) {
+  glUseProgram(this->reduce_shader);
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, this->p_calc_texture);
+
+  // Shaders such as the hashed shaders bind their buffers once, restore the
+  // buffer previously bound to the binding used by the reduction.
+  GLint previous_ssbo = 0;
+  glGetIntegeri_v(GL_SHADER_STORAGE_BUFFER_BINDING, 0, &previous_ssbo);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, slot.ssbo);
 
-    for (unsigned int i = 0; i < this->width * this->height; ++i) {
-      // divide by 10 if attenuated
-      summed_calculations += light_calculations.at(i);
+  glDispatchCompute(this->n_tiles.x, this->n_tiles.y, 1);
+  glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, GLuint(previous_ssbo));
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glUseProgram(0);
+
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+
+void LightCalculationsLogger::reduceOnCPU(FrameCalculations& calculations) {
+  // get data from the texture
+  std::vector<GLuint> light_calculations = std::vector<GLuint>(this->width * this->height);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, this->p_calc_texture);
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  glGetTexImage(GL_TEXTURE_2D,
+                0,
+                GL_RED_INTEGER,
+                GL_UNSIGNED_INT,
+                light_calculations.data());
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  // Sum per tile, one row of tiles per work item. The rows of a tile are
+  // summed with a plain loop over contiguous pixels, which is vectorised.
+  calculations.tiles.assign(this->n_tiles.x * this->n_tiles.y, 0);
+  const GLuint* p_pixels = light_calculations.data();
+  util::parallelFor(this->n_tiles.y, 0, [&](unsigned int tile_y) {
+    GLuint* p_tiles = &calculations.tiles[tile_y * this->n_tiles.x];
+    unsigned int y_end = std::min((tile_y + 1) * LIGHT_CALC_TILE_SIZE, this->height);
+
+    for (unsigned int y = tile_y * LIGHT_CALC_TILE_SIZE; y < y_end; ++y) {
+      const GLuint* p_row = p_pixels + std::size_t(y) * this->width;
+      for (unsigned int tile_x = 0; tile_x < this->n_tiles.x; ++tile_x) {
+        unsigned int x_begin = tile_x * LIGHT_CALC_TILE_SIZE;
+        unsigned int x_end = std::min(x_begin + LIGHT_CALC_TILE_SIZE, this->width);
+
+        GLuint sum = 0;
+        for (unsigned int x = x_begin; x < x_end; ++x) {
+          sum += p_row[x];
+        }
+        p_tiles[tile_x] += sum;
+      }
     }
+  });
+}
+
 
-    this->n_light_calc_data.push_back(std::pair<unsigned long, unsigned long>(this->clock.getCurrentFrame(),
-                                                                              summed_calculations));
+void LightCalculationsLogger::retire(ReductionSlot& slot) {
+  // Wait until the reduction is complete, usually already the case
+  GLenum wait_result = glClientWaitSync(slot.fence,
+                                        GL_SYNC_FLUSH_COMMANDS_BIT,
+                                        0);
+  while (wait_result == GL_TIMEOUT_EXPIRED) {
+    wait_result = glClientWaitSync(slot.fence, 0, 1000000);  // 1 ms
+  }
+  glDeleteSync(slot.fence);
+  slot.fence = 0;
+
+  slot.calculations.tiles.resize(this->n_tiles.x * this->n_tiles.y);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, slot.ssbo);
+  glGetBufferSubData(GL_SHADER_STORAGE_BUFFER,
+                     0,
+                     sizeof(GLuint) * slot.calculations.tiles.size(),
+                     slot.calculations.tiles.data());
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  this->addCalculations(slot.calculations);
+}
+
+
+void LightCalculationsLogger::addCalculations(FrameCalculations& calculations) {
+  std::uint64_t summed_calculations = 0;
+  for (GLuint tile_calculations : calculations.tiles) {
+    summed_calculations += tile_calculations;
+  }
+  calculations.n_calc = summed_calculations;
+
+  if (!this->is_exporting_tiles) {
+    std::vector<GLuint>().swap(calculations.tiles);
+  }
+  this->n_light_calc_data.push_back(std::move(calculations));
+}
+
+
+std::uint64_t LightCalculationsLogger::getNCalculations() const {
+  std::uint64_t n_calc = 0;
+  for (const FrameCalculations& frame : this->n_light_calc_data) {
+    n_calc += frame.n_calc;
+  }
+  return n_calc;
+}
+
+
+void LightCalculationsLogger::flush() {
+  // Retire in extraction order, starting at the oldest slot
+  for (unsigned int i = 0; i < this->slots.size(); ++i) {
+    ReductionSlot& slot = this->slots[(this->next_slot + i) % this->slots.size()];
+    if (slot.fence) {
+      this->retire(slot);
+    }
   }
 }
 
 
 void LightCalculationsLogger::exportLog() {
+  this->flush();
+
   rapidjson::StringBuffer s;
   rapidjson::Writer<rapidjson::StringBuffer> writer(s);
 
@@ -196,17 +381,59 @@ void LightCalculationsLogger::exportLog() {
   writer.StartArray();
     
     // build frame data
-    for (std::pair<unsigned long, unsigned long>& frame : this->n_light_calc_data) {
+    double total_frame_ms = 0.0;
+    double total_overhead_ms = 0.0;
+    unsigned int n_timed_frames = 0;
+
+    for (const FrameCalculations& frame : this->n_light_calc_data) {
       writer.StartObject();
       writer.Key("frame");
-      writer.Uint64(frame.first);
+      writer.Uint64(frame.frame);
 
       writer.Key("n_calc");
-      writer.Uint64(frame.second);
+      writer.Uint64(frame.n_calc);
+
+      writer.Key("frame_ms");
+      writer.Double(frame.frame_ms);
+      writer.Key("overhead_ms");
+      writer.Double(frame.overhead_ms);
+
+      if (this->is_exporting_tiles) {
+        writer.Key("tiles");
+        writer.StartArray();
+        for (GLuint tile_calculations : frame.tiles) {
+          writer.Uint(tile_calculations);
+        }
+        writer.EndArray();
+      }
       writer.EndObject();
+
+      // the first frame has no previous extraction to be timed against
+      if (frame.frame_ms > 0.0) {
+        total_frame_ms += frame.frame_ms;
+        total_overhead_ms += frame.overhead_ms;
+        n_timed_frames++;
+      }
     }
 
   writer.EndArray();
+
+  // Overhead of counting relative to the remaining frame time, compare
+  // mean_frame_ms against the frame times of an uncounted run
+  writer.Key("summary");
+  writer.StartObject();
+  writer.Key("n_frames");
+  writer.Uint(n_timed_frames);
+  writer.Key("mean_frame_ms");
+  writer.Double(n_timed_frames ? total_frame_ms / n_timed_frames : 0.0);
+  writer.Key("mean_overhead_ms");
+  writer.Double(n_timed_frames ? total_overhead_ms / n_timed_frames : 0.0);
+  writer.Key("overhead_ratio");
+  writer.Double(total_frame_ms > 0.0 ? total_overhead_ms / total_frame_ms : 0.0);
+  writer.Key("is_reduced_on_gpu");
+  writer.Bool(this->is_reducing_on_gpu);
+  writer.EndObject();
+
   writer.EndObject();
 
   // Write to path
@@ -6,6 +6,7 @@
 // File handling
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -26,60 +27,76 @@ ExecutionTimeLogger::ExecutionTimeLogger(const Clock& clock,
                                          unsigned int frame_end) :
     clock(clock),
     is_active(false),
-    is_running(false),
-    time_data(std::vector<std::pair<unsigned long, std::map<std::string, double>>>()),
+    p_gpu_timer(nullptr),
+    p_stream(nullptr),
     frame_start(frame_start),
     frame_end(frame_end) {
 }
 
 
+ExecutionTimeLogger::~ExecutionTimeLogger() {
+  delete this->p_gpu_timer;
+  this->profiler.setSink(nullptr);
+  delete this->p_stream;
+}
+
+
 // ----------------------------------------------------------------------------
 //  Member functions
 // ----------------------------------------------------------------------------
-void ExecutionTimeLogger::startLog(std::string function_id) {
+void ExecutionTimeLogger::startLog(ScopeId function_id) {
   if (this->is_active) {
-    if (this->is_running) {
-      throw std::runtime_error(std::string("ExecutionTimeLogger is already running."));
-    }
-    if (this->time_data.back().second.find(function_id) != this->time_data.back().second.end()) {
-      throw std::runtime_error(std::string("ExecutionTimeLogger has already tracked this function_id this frame."));
-    }
-
-    this->is_running = true;
-    this->current_function_id = function_id;
-
-    QueryPerformanceFrequency(&(this->frequency));
-    QueryPerformanceCounter(&(this->start_time));
+    this->profiler.record(function_id, ProfileEventType::Begin);
   }
 }
 
-void ExecutionTimeLogger::endLog() {
+void ExecutionTimeLogger::endLog(ScopeId function_id) {
   if (this->is_active) {
-    QueryPerformanceCounter(&(this->end_time));
+    this->profiler.record(function_id, ProfileEventType::End);
+  }
+}
 
-    if (!this->is_running) {
-      throw std::runtime_error(std::string("ExecutionTimeLogger was ended without running."));
+void ExecutionTimeLogger::startStageLog(ScopeId function_id) {
+  if (this->is_active) {
+    if (!this->p_gpu_timer) {
+      this->p_gpu_timer = new GpuTimer(this->profiler);
     }
-    this->is_running = false;
+    this->profiler.record(function_id, ProfileEventType::Begin);
+    this->p_gpu_timer->begin(function_id);
+  }
+}
+
+void ExecutionTimeLogger::endStageLog(ScopeId function_id) {
+  if (this->is_active) {
+    this->p_gpu_timer->end(function_id);
+    this->profiler.record(function_id, ProfileEventType::End);
+  }
+}
 
-    double execution_time =
-      (this->end_time.QuadPart - this->start_time.QuadPart) * 1000.0 / this->frequency.QuadPart;  // in ms
-    this->time_data.back().second.insert(std::pair<std::string, double>(this->current_function_id,
-                                                                 execution_time));
+void ExecutionTimeLogger::logValue(ScopeId value_id, double value) {
+  if (this->is_active) {
+    this->profiler.record(value_id, ProfileEventType::Value, value);
   }
 }
 
 void ExecutionTimeLogger::incrementFrame() {
   if (this->is_active) {
-    std::pair<unsigned long, std::map<std::string, double>> empty_frame = 
-      std::pair<unsigned long, std::map<std::string, double>>(
-        this->clock.getCurrentFrame(), 
-        std::map<std::string, double>());
-    
-    this->time_data.push_back(empty_frame);
+    unsigned long frame = this->clock.getCurrentFrame();
+    if (this->p_gpu_timer) {
+      this->p_gpu_timer->nextFrame(std::uint32_t(frame));
+    }
+    this->profiler.setFrame(std::uint32_t(frame));
+    this->logged_frames.push_back(frame);
   }
 }
 
+void ExecutionTimeLogger::streamTo(const std::string& path) {
+  ProfileStreamWriter* p_stream = new ProfileStreamWriter(path);
+  this->profiler.setSink(p_stream, false);
+  delete this->p_stream;
+  this->p_stream = p_stream;
+}
+
 void ExecutionTimeLogger::exportLog(const std::string& path) {
   /* JSON layout: 
      { frames: [ { "frame": <int64>
@@ -98,6 +115,36 @@ void ExecutionTimeLogger::exportLog(const std::string& path) {
                ]
      }
    */
+  if (this->p_gpu_timer) {
+    this->p_gpu_timer->flush();
+  }
+  this->profiler.drain();
+
+  std::string stem = path;
+  std::string extension = ".json";
+  if (stem.size() >= extension.size() &&
+      stem.compare(stem.size() - extension.size(), extension.size(), extension) == 0) {
+    stem.erase(stem.size() - extension.size());
+  }
+
+  // The spans and values are already on storage, close the stream
+  if (this->p_stream) {
+    this->profiler.setSink(nullptr);
+    delete this->p_stream;
+    this->p_stream = nullptr;
+    this->profiler.exportSummary(stem + ".summary.json");
+    return;
+  }
+
+  // Sum the spans and values of each function per frame
+  std::map<std::uint32_t, std::map<std::string, double>> frame_data;
+  for (const ProfileSpan& span : this->profiler.getSpans()) {
+    frame_data[span.frame][getScopeName(span.scope)] += span.duration * 1e-6;  // in ms
+  }
+  for (const ProfileValue& value : this->profiler.getValues()) {
+    frame_data[value.frame][getScopeName(value.scope)] += value.value;
+  }
+
   // Construct RapidJSON object
   rapidjson::StringBuffer s;
   rapidjson::Writer<rapidjson::StringBuffer> writer(s);
@@ -106,15 +153,15 @@ void ExecutionTimeLogger::exportLog(const std::string& path) {
   writer.Key("frames");
   writer.StartArray();
 
-  for (auto& frame : this->time_data) {
+  for (unsigned long frame : this->logged_frames) {
     writer.StartObject(); // start frame object
     // write which frame was recorded.
     writer.Key("frame");
-    writer.Int64(frame.first);
+    writer.Int64(frame);
     
     writer.Key("functions");
     writer.StartObject();
-    for (auto& iter : frame.second) {
+    for (auto& iter : frame_data[std::uint32_t(frame)]) {
       writer.Key(iter.first.c_str());
       writer.Double(iter.second);
     }
@@ -130,12 +177,17 @@ void ExecutionTimeLogger::exportLog(const std::string& path) {
   output_stream.open(path);
   output_stream << s.GetString();
   output_stream.close();
+
+  // Write trace and summary next to path
+  this->profiler.exportTrace(stem + ".trace.json");
+  this->profiler.exportSummary(stem + ".summary.json");
 }
 
 void ExecutionTimeLogger::activate() {
   if (this->is_active) {
       throw std::runtime_error(std::string("ExecutionTimeLogger is already active."));
   }
+  this->profiler.activate();
   this->is_active = true;
   this->incrementFrame();
 }
@@ -145,7 +197,15 @@ void ExecutionTimeLogger::deactivate() {
       throw std::runtime_error(std::string("ExecutionTimeLogger is not yet active."));
   }
   this->is_active = false;
+
+  // Collect the outstanding GPU timings while the context is current
+  if (this->p_gpu_timer) {
+    this->p_gpu_timer->flush();
+    delete this->p_gpu_timer;
+    this->p_gpu_timer = nullptr;
+  }
+  this->profiler.deactivate();
 }
 
 } // log
-} // nTiled
\ No newline at end of file
+} // nTiled
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "log\ProfileStream.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+// ----------------------------------------------------------------------------
+//  Defines
+// ----------------------------------------------------------------------------
+#define PROFILE_STREAM_VERSION 1
+// Size of the write buffer of the stream file
+#define PROFILE_STREAM_BUFFER_SIZE 262144
+
+
+namespace nTiled {
+namespace logged {
+
+static_assert(sizeof(ProfileStreamHeader) == 8,
+              "ProfileStreamHeader must not contain padding");
+static_assert(sizeof(ProfileRecord) == 40,
+              "ProfileRecord must not contain padding");
+
+// ----------------------------------------------------------------------------
+//  Constructor | Destructor
+// ----------------------------------------------------------------------------
+static ProfileStreamFormat getFormatFromPath(const std::string& path) {
+  std::size_t length = path.size();
+  if (length >= 4 && path.compare(length - 4, 4, ".csv") == 0) {
+    return ProfileStreamFormat::CSV;
+  }
+  return ProfileStreamFormat::Binary;
+}
+
+
+ProfileStreamWriter::ProfileStreamWriter(const std::string& path,
+                                         ProfileStreamFormat format) :
+    path(path),
+    format(format),
+    buffer(PROFILE_STREAM_BUFFER_SIZE),
+    n_records(0) {
+  this->open();
+}
+
+
+ProfileStreamWriter::ProfileStreamWriter(const std::string& path) :
+    ProfileStreamWriter(path, getFormatFromPath(path)) {
+}
+
+
+ProfileStreamWriter::~ProfileStreamWriter() {
+  this->ofs.close();
+}
+
+
+void ProfileStreamWriter::open() {
+  // the buffer has to be set before the file is opened to take effect
+  this->ofs.rdbuf()->pubsetbuf(this->buffer.data(),
+                               std::streamsize(this->buffer.size()));
+  this->ofs.open(this->path, std::ios::binary | std::ios::trunc);
+  if (!this->ofs) {
+    throw std::runtime_error(std::string("Could not write profile stream: ") + this->path);
+  }
+
+  if (this->format == ProfileStreamFormat::CSV) {
+    this->ofs << "record,frame,thread,depth,name,start_ms,value\n";
+  } else {
+    ProfileStreamHeader header;
+    std::memcpy(header.magic, "NTPS", 4);
+    header.version = PROFILE_STREAM_VERSION;
+    this->ofs.write(reinterpret_cast<const char*>(&header),
+                    sizeof(ProfileStreamHeader));
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+//  ProfileSink
+// ----------------------------------------------------------------------------
+void ProfileStreamWriter::addSpan(const ProfileSpan& span) {
+  this->write(ProfileRecordType::Span,
+              span.start,
+              span.duration * 1e-6,
+              span.scope,
+              span.frame,
+              span.thread,
+              span.depth);
+}
+
+
+void ProfileStreamWriter::addValue(const ProfileValue& value) {
+  this->write(ProfileRecordType::Value,
+              value.time,
+              value.value,
+              value.scope,
+              value.frame,
+              value.thread,
+              0);
+}
+
+
+void ProfileStreamWriter::flush() {
+  this->ofs.flush();
+  if (!this->ofs) {
+    throw std::runtime_error(std::string("Could not write profile stream: ") + this->path);
+  }
+}
+
+
+void ProfileStreamWriter::nameScope(ScopeId scope) {
+  if (scope < this->is_named.size() && this->is_named[scope]) return;
+  if (scope >= this->is_named.size()) this->is_named.resize(scope + 1, false);
+  this->is_named[scope] = true;
+
+  const std::string& name = getScopeName(scope);
+  ProfileRecord record = {};
+  record.type = ProfileRecordType::Name;
+  record.scope = scope;
+  record.name_length = std::uint32_t(name.size());
+  this->ofs.write(reinterpret_cast<const char*>(&record), sizeof(ProfileRecord));
+  this->ofs.write(name.data(), std::streamsize(name.size()));
+}
+
+
+void ProfileStreamWriter::write(ProfileRecordType type,
+                                std::int64_t time,
+                                double value,
+                                ScopeId scope,
+                                std::uint32_t frame,
+                                std::uint32_t thread,
+                                std::uint32_t depth) {
+  this->n_records++;
+
+  if (this->format == ProfileStreamFormat::CSV) {
+    char line[128];
+    std::snprintf(line, sizeof(line), ",%u,%u,%u,",
+                  frame, thread, depth);
+    char times[64];
+    std::snprintf(times, sizeof(times), ",%.6f,%.9g\n",
+                  time * 1e-6, value);
+    this->ofs << ((type == ProfileRecordType::Span) ? "span" : "value")
+              << line << getScopeName(scope) << times;
+    return;
+  }
+
+  this->nameScope(scope);
+  ProfileRecord record;
+  record.time = time;
+  record.value = value;
+  record.type = type;
+  record.scope = scope;
+  record.frame = frame;
+  record.thread = thread;
+  record.depth = depth;
+  record.name_length = 0;
+  this->ofs.write(reinterpret_cast<const char*>(&record), sizeof(ProfileRecord));
+}
+
+} // logged
+} // nTiled
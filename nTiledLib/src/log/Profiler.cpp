@@ -0,0 +1,496 @@
+#include "log\Profiler.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+// Json include
+#include <rapidjson\writer.h>
+#include <rapidjson\stringbuffer.h>
+#include <rapidjson\filewritestream.h>
+
+// ----------------------------------------------------------------------------
+//  Defines
+// ----------------------------------------------------------------------------
+// Size of the write buffer of the trace stream
+#define TRACE_STREAM_BUFFER_SIZE 65536
+
+
+namespace nTiled {
+namespace logged {
+
+// ----------------------------------------------------------------------------
+//  Scope interning
+// ----------------------------------------------------------------------------
+/*! @brief ScopeRegistry holds the names of all interned scopes, names are
+ *         stored in a deque such that references to them stay valid.
+ */
+struct ScopeRegistry {
+  std::mutex mutex;
+  std::deque<std::string> names;
+  std::unordered_map<std::string, ScopeId> ids;
+};
+
+
+static ScopeRegistry& getScopeRegistry() {
+  static ScopeRegistry registry;
+  return registry;
+}
+
+
+ScopeId internScope(const std::string& name) {
+  ScopeRegistry& registry = getScopeRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  auto itr = registry.ids.find(name);
+  if (itr != registry.ids.end()) return itr->second;
+
+  ScopeId id = ScopeId(registry.names.size());
+  registry.names.push_back(name);
+  registry.ids.insert(std::pair<std::string, ScopeId>(name, id));
+  return id;
+}
+
+
+const std::string& getScopeName(ScopeId id) {
+  ScopeRegistry& registry = getScopeRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (id >= registry.names.size()) {
+    throw std::runtime_error(std::string("Unknown ScopeId: ") + std::to_string(id));
+  }
+  return registry.names[id];
+}
+
+
+std::size_t getNScopes() {
+  ScopeRegistry& registry = getScopeRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.names.size();
+}
+
+
+// ----------------------------------------------------------------------------
+//  Profiler
+// ----------------------------------------------------------------------------
+std::atomic<Profiler*> Profiler::p_active(nullptr);
+
+static std::atomic<std::uint64_t> next_profiler_id(1);
+
+
+static std::uint64_t roundUpPow2(std::size_t n) {
+  std::uint64_t result = 1;
+  while (result < n) result <<= 1;
+  return result;
+}
+
+
+Profiler::Profiler(std::size_t ring_capacity) :
+    id(next_profiler_id++),
+    ring_mask(roundUpPow2(std::max(ring_capacity, std::size_t(2))) - 1),
+    epoch(std::chrono::steady_clock::now()),
+    frame(0),
+    n_unmatched(0),
+    p_sink(nullptr),
+    is_retaining(true) {
+}
+
+
+Profiler::~Profiler() {
+  if (this->isActive()) this->deactivate();
+  for (ThreadRing* p_ring : this->rings) {
+    delete p_ring;
+  }
+}
+
+
+void Profiler::activate() {
+  Profiler* p_expected = nullptr;
+  if (!Profiler::p_active.compare_exchange_strong(p_expected, this)) {
+    if (p_expected == this) {
+      throw std::runtime_error(std::string("Profiler is already active."));
+    }
+    throw std::runtime_error(std::string("Another Profiler is already active."));
+  }
+}
+
+
+void Profiler::deactivate() {
+  Profiler* p_expected = this;
+  if (!Profiler::p_active.compare_exchange_strong(p_expected, nullptr)) {
+    throw std::runtime_error(std::string("Profiler is not active."));
+  }
+  this->drain();
+}
+
+
+// ----------------------------------------------------------------------------
+//  Recording
+// ----------------------------------------------------------------------------
+Profiler::ThreadRing& Profiler::getThreadRing() {
+  // Cache the ring of this thread for the most recently used Profiler
+  struct RingCache {
+    std::uint64_t profiler_id;
+    ThreadRing* p_ring;
+  };
+  thread_local RingCache cache = { 0, nullptr };
+  if (cache.profiler_id == this->id) return *cache.p_ring;
+
+  std::lock_guard<std::mutex> lock(this->rings_mutex);
+  std::thread::id thread_id = std::this_thread::get_id();
+
+  ThreadRing* p_ring = nullptr;
+  for (ThreadRing* p_candidate : this->rings) {
+    if (p_candidate->thread_id == thread_id) {
+      p_ring = p_candidate;
+      break;
+    }
+  }
+
+  if (!p_ring) {
+    p_ring = new ThreadRing();
+    p_ring->events.resize(std::size_t(this->ring_mask + 1));
+    p_ring->head = 0;
+    p_ring->tail = 0;
+    p_ring->n_dropped = 0;
+    p_ring->thread_id = thread_id;
+    p_ring->thread_index = std::uint32_t(this->rings.size());
+    this->rings.push_back(p_ring);
+  }
+
+  cache.profiler_id = this->id;
+  cache.p_ring = p_ring;
+  return *p_ring;
+}
+
+
+void Profiler::record(ScopeId scope, ProfileEventType type, double value) {
+  ThreadRing& ring = this->getThreadRing();
+
+  std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+  if (head - ring.tail.load(std::memory_order_acquire) > this->ring_mask) {
+    ring.n_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  ProfileEvent& event = ring.events[std::size_t(head & this->ring_mask)];
+  event.time = this->getTime();
+  event.value = value;
+  event.scope = scope;
+  event.frame = this->frame.load(std::memory_order_relaxed);
+  event.type = type;
+
+  ring.head.store(head + 1, std::memory_order_release);
+}
+
+
+void Profiler::addSpan(const ProfileSpan& span) {
+  std::lock_guard<std::mutex> lock(this->drain_mutex);
+  this->emitSpan(span);
+}
+
+
+void Profiler::setFrame(std::uint32_t frame) {
+  this->drain();
+  this->frame.store(frame, std::memory_order_relaxed);
+}
+
+
+// ----------------------------------------------------------------------------
+//  Draining
+// ----------------------------------------------------------------------------
+void Profiler::addSample(std::vector<ScopeStats>& stats,
+                         ScopeId scope,
+                         double sample) {
+  if (scope >= stats.size()) {
+    ScopeStats empty = { 0,
+                         0.0,
+                         std::numeric_limits<double>::max(),
+                         std::numeric_limits<double>::lowest() };
+    stats.resize(scope + 1, empty);
+  }
+
+  ScopeStats& scope_stats = stats[scope];
+  scope_stats.count++;
+  scope_stats.total += sample;
+  scope_stats.min = std::min(scope_stats.min, sample);
+  scope_stats.max = std::max(scope_stats.max, sample);
+  scope_stats.sketch.add(sample);
+}
+
+
+void Profiler::emitSpan(const ProfileSpan& span) {
+  if (this->p_sink) this->p_sink->addSpan(span);
+  if (this->is_retaining) this->spans.push_back(span);
+  Profiler::addSample(this->span_stats, span.scope, span.duration * 1e-6);
+}
+
+
+void Profiler::emitValue(const ProfileValue& value) {
+  if (this->p_sink) this->p_sink->addValue(value);
+  if (this->is_retaining) this->values.push_back(value);
+  Profiler::addSample(this->value_stats, value.scope, value.value);
+}
+
+
+void Profiler::setSink(ProfileSink* p_sink, bool is_retaining) {
+  std::lock_guard<std::mutex> lock(this->drain_mutex);
+  this->p_sink = p_sink;
+  this->is_retaining = is_retaining;
+}
+
+
+void Profiler::drain() {
+  std::lock_guard<std::mutex> drain_lock(this->drain_mutex);
+
+  std::vector<ThreadRing*> rings_snapshot;
+  {
+    std::lock_guard<std::mutex> rings_lock(this->rings_mutex);
+    rings_snapshot = this->rings;
+  }
+
+  for (ThreadRing* p_ring : rings_snapshot) {
+    this->drainRing(*p_ring);
+  }
+  if (this->p_sink) this->p_sink->flush();
+}
+
+
+void Profiler::drainRing(ThreadRing& ring) {
+  std::uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+  std::uint64_t head = ring.head.load(std::memory_order_acquire);
+
+  for (; tail != head; ++tail) {
+    const ProfileEvent& event = ring.events[std::size_t(tail & this->ring_mask)];
+
+    switch (event.type) {
+      case ProfileEventType::Begin:
+        ring.open_scopes.push_back(event);
+        break;
+
+      case ProfileEventType::End: {
+        // Find the matching Begin, discarding scopes whose End was dropped
+        auto itr = std::find_if(ring.open_scopes.rbegin(),
+                                ring.open_scopes.rend(),
+                                [&event](const ProfileEvent& open) {
+                                  return open.scope == event.scope;
+                                });
+        if (itr == ring.open_scopes.rend()) {
+          this->n_unmatched++;
+          break;
+        }
+
+        std::size_t index = std::size_t(ring.open_scopes.rend() - itr) - 1;
+        this->n_unmatched += ring.open_scopes.size() - 1 - index;
+
+        const ProfileEvent& begin = ring.open_scopes[index];
+        ProfileSpan span;
+        span.start = begin.time;
+        span.duration = event.time - begin.time;
+        span.scope = event.scope;
+        span.thread = ring.thread_index;
+        span.frame = begin.frame;
+        span.depth = std::uint32_t(index);
+        this->emitSpan(span);
+
+        ring.open_scopes.resize(index);
+        break;
+      }
+
+      case ProfileEventType::Value: {
+        ProfileValue value;
+        value.time = event.time;
+        value.value = event.value;
+        value.scope = event.scope;
+        value.thread = ring.thread_index;
+        value.frame = event.frame;
+        this->emitValue(value);
+        break;
+      }
+    }
+  }
+
+  ring.tail.store(head, std::memory_order_release);
+}
+
+
+// ----------------------------------------------------------------------------
+//  Results
+// ----------------------------------------------------------------------------
+ScopeStats Profiler::getStats(ScopeId scope) const {
+  const std::vector<ScopeStats>& stats =
+    (scope < this->span_stats.size() && this->span_stats[scope].count > 0) ?
+    this->span_stats : this->value_stats;
+
+  if (scope < stats.size()) return stats[scope];
+  ScopeStats empty = { 0, 0.0, 0.0, 0.0 };
+  return empty;
+}
+
+
+std::uint64_t Profiler::getNDropped() const {
+  std::lock_guard<std::mutex> lock(this->rings_mutex);
+  std::uint64_t n_dropped = 0;
+  for (const ThreadRing* p_ring : this->rings) {
+    n_dropped += p_ring->n_dropped.load(std::memory_order_relaxed);
+  }
+  return n_dropped;
+}
+
+
+void Profiler::clear() {
+  std::lock_guard<std::mutex> lock(this->drain_mutex);
+  this->spans.clear();
+  this->values.clear();
+  this->span_stats.clear();
+  this->value_stats.clear();
+  this->n_unmatched = 0;
+}
+
+
+void Profiler::exportTrace(const std::string& path) const {
+  /* JSON layout, Chrome trace event format with times in microseconds:
+     { "traceEvents": [ { "name": "<scope>", "ph": "X", "ts": start
+                        , "dur": duration, "pid": 0, "tid": thread
+                        , "args": { "frame": frame }
+                        }
+                      , { "name": "<value>", "ph": "C", "ts": time
+                        , "pid": 0, "tid": thread
+                        , "args": { "value": value }
+                        }
+                      , ...
+                      ]
+     , "displayTimeUnit": "ms"
+     }
+   */
+  std::FILE* p_file = std::fopen(path.c_str(), "wb");
+  if (!p_file) {
+    throw std::runtime_error(std::string("Could not write trace file: ") + path);
+  }
+
+  char buffer[TRACE_STREAM_BUFFER_SIZE];
+  rapidjson::FileWriteStream stream(p_file, buffer, sizeof(buffer));
+  rapidjson::Writer<rapidjson::FileWriteStream> writer(stream);
+
+  writer.StartObject();
+  writer.Key("traceEvents");
+  writer.StartArray();
+
+  // name the GPU track, it is not a thread of this process
+  writer.StartObject();
+  writer.Key("name"); writer.String("thread_name");
+  writer.Key("ph"); writer.String("M");
+  writer.Key("pid"); writer.Uint(0);
+  writer.Key("tid"); writer.Uint(Profiler::gpu_thread);
+  writer.Key("args");
+  writer.StartObject();
+  writer.Key("name"); writer.String("GPU");
+  writer.EndObject();
+  writer.EndObject();
+
+  for (const ProfileSpan& span : this->spans) {
+    writer.StartObject();
+    writer.Key("name"); writer.String(getScopeName(span.scope).c_str());
+    writer.Key("ph"); writer.String("X");
+    writer.Key("ts"); writer.Double(span.start * 1e-3);
+    writer.Key("dur"); writer.Double(span.duration * 1e-3);
+    writer.Key("pid"); writer.Uint(0);
+    writer.Key("tid"); writer.Uint(span.thread);
+    writer.Key("args");
+    writer.StartObject();
+    writer.Key("frame"); writer.Uint(span.frame);
+    writer.EndObject();
+    writer.EndObject();
+  }
+
+  for (const ProfileValue& value : this->values) {
+    writer.StartObject();
+    writer.Key("name"); writer.String(getScopeName(value.scope).c_str());
+    writer.Key("ph"); writer.String("C");
+    writer.Key("ts"); writer.Double(value.time * 1e-3);
+    writer.Key("pid"); writer.Uint(0);
+    writer.Key("tid"); writer.Uint(value.thread);
+    writer.Key("args");
+    writer.StartObject();
+    writer.Key("value"); writer.Double(value.value);
+    writer.EndObject();
+    writer.EndObject();
+  }
+
+  writer.EndArray();
+  writer.Key("displayTimeUnit");
+  writer.String("ms");
+  writer.EndObject();
+  stream.Flush();
+
+  bool is_written = (std::ferror(p_file) == 0);
+  std::fclose(p_file);
+  if (!is_written) {
+    throw std::runtime_error(std::string("Could not write trace file: ") + path);
+  }
+}
+
+
+/*! @brief Write the statistics of every ScopeId with samples as an array. */
+static void writeStats(rapidjson::Writer<rapidjson::StringBuffer>& writer,
+                       const std::vector<ScopeStats>& stats) {
+  writer.StartArray();
+  for (ScopeId scope = 0; scope < stats.size(); ++scope) {
+    const ScopeStats& scope_stats = stats[scope];
+    if (scope_stats.count == 0) continue;
+
+    writer.StartObject();
+    writer.Key("name"); writer.String(getScopeName(scope).c_str());
+    writer.Key("count"); writer.Uint64(scope_stats.count);
+    writer.Key("total"); writer.Double(scope_stats.total);
+    writer.Key("mean"); writer.Double(scope_stats.total / scope_stats.count);
+    writer.Key("min"); writer.Double(scope_stats.min);
+    writer.Key("max"); writer.Double(scope_stats.max);
+    writer.Key("p50"); writer.Double(scope_stats.sketch.getQuantile(0.50));
+    writer.Key("p95"); writer.Double(scope_stats.sketch.getQuantile(0.95));
+    writer.Key("p99"); writer.Double(scope_stats.sketch.getQuantile(0.99));
+
+    writer.Key("histogram");
+    writer.StartArray();
+    for (const std::pair<double, std::uint64_t>& bin : scope_stats.sketch.getHistogram()) {
+      writer.StartObject();
+      writer.Key("upper"); writer.Double(bin.first);
+      writer.Key("count"); writer.Uint64(bin.second);
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+  }
+  writer.EndArray();
+}
+
+
+void Profiler::exportSummary(const std::string& path) const {
+  rapidjson::StringBuffer s;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+
+  writer.StartObject();
+  writer.Key("scopes");
+  writeStats(writer, this->span_stats);
+  writer.Key("values");
+  writeStats(writer, this->value_stats);
+  writer.Key("n_dropped");
+  writer.Uint64(this->getNDropped());
+  writer.Key("n_unmatched");
+  writer.Uint64(this->n_unmatched);
+  writer.EndObject();
+
+  std::ofstream output_stream;
+  output_stream.open(path);
+  output_stream << s.GetString();
+  output_stream.close();
+}
+
+} // logged
+} // nTiled
@@ -0,0 +1,106 @@
+#include "log\QuantileSketch.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+// ----------------------------------------------------------------------------
+//  Defines
+// ----------------------------------------------------------------------------
+// Values below this are counted in the zero bucket, bounding the number of
+// buckets a sketch can grow to.
+#define QUANTILE_SKETCH_MIN_VALUE 1e-9
+
+
+namespace nTiled {
+namespace logged {
+
+// ----------------------------------------------------------------------------
+//  Constructor
+// ----------------------------------------------------------------------------
+QuantileSketch::QuantileSketch(double relative_accuracy) :
+    relative_accuracy(relative_accuracy),
+    n_zero(0),
+    count(0) {
+  if (!(relative_accuracy > 0.0 && relative_accuracy < 1.0)) {
+    throw std::runtime_error(std::string("QuantileSketch relative accuracy must be in (0, 1)."));
+  }
+  this->log_gamma = std::log((1.0 + relative_accuracy) / (1.0 - relative_accuracy));
+}
+
+
+// ----------------------------------------------------------------------------
+//  Member functions
+// ----------------------------------------------------------------------------
+void QuantileSketch::add(double value) {
+  this->count++;
+  if (!(value > QUANTILE_SKETCH_MIN_VALUE)) {
+    this->n_zero++;
+    return;
+  }
+
+  int index = int(std::ceil(std::log(value) / this->log_gamma));
+  this->buckets[index]++;
+}
+
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+  if (other.relative_accuracy != this->relative_accuracy) {
+    throw std::runtime_error(std::string("QuantileSketches with different relative accuracies can not be merged."));
+  }
+
+  for (const std::pair<const int, std::uint64_t>& bucket : other.buckets) {
+    this->buckets[bucket.first] += bucket.second;
+  }
+  this->n_zero += other.n_zero;
+  this->count += other.count;
+}
+
+
+double QuantileSketch::getBucketValue(int index) const {
+  // the value with equal relative distance to both bucket bounds
+  double gamma = std::exp(this->log_gamma);
+  return 2.0 * std::exp(index * this->log_gamma) / (gamma + 1.0);
+}
+
+
+double QuantileSketch::getQuantile(double q) const {
+  if (this->count == 0) return 0.0;
+
+  q = std::min(std::max(q, 0.0), 1.0);
+  std::uint64_t rank = std::uint64_t(q * (this->count - 1));
+
+  if (rank < this->n_zero) return 0.0;
+  std::uint64_t n_seen = this->n_zero;
+  for (const std::pair<const int, std::uint64_t>& bucket : this->buckets) {
+    n_seen += bucket.second;
+    if (rank < n_seen) return this->getBucketValue(bucket.first);
+  }
+  return this->getBucketValue(this->buckets.rbegin()->first);
+}
+
+
+std::vector<std::pair<double, std::uint64_t>> QuantileSketch::getHistogram() const {
+  std::vector<std::pair<double, std::uint64_t>> histogram;
+  if (this->n_zero > 0) {
+    histogram.push_back(std::pair<double, std::uint64_t>(0.0, this->n_zero));
+  }
+
+  // buckets are in ascending order, so are the power of two bins
+  for (const std::pair<const int, std::uint64_t>& bucket : this->buckets) {
+    double upper = std::exp2(std::floor(std::log2(this->getBucketValue(bucket.first))) + 1.0);
+    if (!histogram.empty() && histogram.back().first == upper) {
+      histogram.back().second += bucket.second;
+    } else {
+      histogram.push_back(std::pair<double, std::uint64_t>(upper, bucket.second));
+    }
+  }
+  return histogram;
+}
+
+} // logged
+} // nTiled
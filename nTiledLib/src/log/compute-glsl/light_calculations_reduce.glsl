@@ -0,0 +1,57 @@
+#version 430
+
+// Must match LIGHT_CALC_TILE_SIZE in LightCalculationsLogger.cpp, the product
+// must be a power of two.
+#define TILE_SIZE_X 16
+#define TILE_SIZE_Y 16
+
+// Layout definition
+// ----------------------------------------------------------------------------
+//  We define the local size as a single tile.
+layout(
+  local_size_x = TILE_SIZE_X,
+  local_size_y = TILE_SIZE_Y
+  ) in;
+
+// Input
+// ----------------------------------------------------------------------------
+layout(binding = 0) uniform usampler2D calc_tex;
+
+// Output
+// ----------------------------------------------------------------------------
+//  The summed number of light calculations of every tile, row major.
+layout(std430, binding = 0) writeonly buffer TileCalculations {
+  uint tile_calculations[];
+};
+
+// Variable Definitions
+// ----------------------------------------------------------------------------
+shared uint partial_sums[TILE_SIZE_X * TILE_SIZE_Y];
+
+// Main
+// ----------------------------------------------------------------------------
+void main() {
+  ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+  ivec2 size = textureSize(calc_tex, 0);
+  uint index = gl_LocalInvocationIndex;
+
+  // tiles at the border may extend beyond the viewport
+  if (pixel.x < size.x && pixel.y < size.y) {
+    partial_sums[index] = texelFetch(calc_tex, pixel, 0).r;
+  } else {
+    partial_sums[index] = 0u;
+  }
+  barrier();
+
+  // tree reduction of the tile in shared memory
+  for (uint stride = (TILE_SIZE_X * TILE_SIZE_Y) / 2u; stride > 0u; stride >>= 1) {
+    if (index < stride) {
+      partial_sums[index] += partial_sums[index + stride];
+    }
+    barrier();
+  }
+
+  if (index == 0u) {
+    tile_calculations[gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x] = partial_sums[0];
+  }
+}
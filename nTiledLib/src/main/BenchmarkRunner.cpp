@@ -0,0 +1,472 @@
+#include "main\BenchmarkRunner.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include <rapidjson\document.h>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "main\Controller.h"
+#include "main\Clock.h"
+#include "main\DrawMethod.h"
+#include "gui\GuiManager.h"
+#include "log\Logger.h"
+#include "log\LightCalculationsLogger.h"
+#include "pipeline\deferred\DeferredPipelineLogged.h"
+#include "pipeline\deferred\DeferredPipelineCounted.h"
+#include "util\MemoryUsage.h"
+
+
+namespace nTiled {
+namespace main {
+
+// ----------------------------------------------------------------------------
+//  Helper functions
+// ----------------------------------------------------------------------------
+/*! @brief Get the DeferredShaderId of the specified algorithm name. */
+static pipeline::DeferredShaderId parseAlgorithm(const std::string& name) {
+  if (name == "attenuated") {
+    return pipeline::DeferredShaderId::DeferredAttenuated;
+  } else if (name == "tiled") {
+    return pipeline::DeferredShaderId::DeferredTiled;
+  } else if (name == "clustered") {
+    return pipeline::DeferredShaderId::DeferredClustered;
+  } else if (name == "hashed") {
+    return pipeline::DeferredShaderId::DeferredHashed;
+  }
+  throw std::runtime_error(std::string("Unknown benchmark algorithm: ") + name);
+}
+
+
+/*! @brief Get the name of the specified DeferredShaderId. */
+static std::string getAlgorithmName(pipeline::DeferredShaderId id) {
+  switch (id) {
+    case pipeline::DeferredShaderId::DeferredAttenuated:
+      return "attenuated";
+    case pipeline::DeferredShaderId::DeferredTiled:
+      return "tiled";
+    case pipeline::DeferredShaderId::DeferredClustered:
+      return "clustered";
+    case pipeline::DeferredShaderId::DeferredHashed:
+      return "hashed";
+    default:
+      return "unknown";
+  }
+}
+
+
+/*! @brief Get whether the specified algorithm uses the tile size. */
+static bool isTiled(pipeline::DeferredShaderId id) {
+  return (id == pipeline::DeferredShaderId::DeferredTiled ||
+          id == pipeline::DeferredShaderId::DeferredClustered);
+}
+
+
+// ----------------------------------------------------------------------------
+//  Constructor | Destructor
+// ----------------------------------------------------------------------------
+BenchmarkRunner::BenchmarkRunner(const std::string& config_path) :
+    config_path(config_path),
+    n_warmup_frames(30),
+    n_frames(300),
+    is_counting_calculations(false),
+    output_path("benchmark.csv"),
+    p_window(NULL),
+    p_offscreen_buffer(NULL) {
+}
+
+
+BenchmarkRunner::~BenchmarkRunner() {
+  delete this->p_offscreen_buffer;
+  if (this->p_window) {
+    glfwDestroyWindow(this->p_window);
+    glfwTerminate();
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+//  Execution
+// ----------------------------------------------------------------------------
+void BenchmarkRunner::init() {
+  // obtain relevant data from config file
+  std::ifstream ifs(this->config_path);
+  std::string config_file((std::istreambuf_iterator<char>(ifs)),
+                          (std::istreambuf_iterator<char>()));
+  // parse json
+  rapidjson::Document config;
+  config.Parse(config_file.c_str());
+  if (config.HasParseError() || !config.IsObject()) {
+    throw std::runtime_error(std::string("Could not parse benchmark config: ") + this->config_path);
+  }
+
+  // Matrix
+  // --------------------------------------------------------------------------
+  auto& scenes_json = config["scenes"];
+  for (rapidjson::Value::ConstValueIterator itr = scenes_json.Begin();
+       itr != scenes_json.End();
+       ++itr) {
+    this->scene_paths.push_back(itr->GetString());
+  }
+
+  auto& algorithms_json = config["algorithms"];
+  for (rapidjson::Value::ConstValueIterator itr = algorithms_json.Begin();
+       itr != algorithms_json.End();
+       ++itr) {
+    this->algorithms.push_back(parseAlgorithm(itr->GetString()));
+  }
+
+  rapidjson::Value::ConstMemberIterator tile_sizes_itr = config.FindMember("tile_sizes");
+  if (tile_sizes_itr != config.MemberEnd()) {
+    for (rapidjson::Value::ConstValueIterator itr = tile_sizes_itr->value.Begin();
+         itr != tile_sizes_itr->value.End();
+         ++itr) {
+      this->tile_sizes.push_back(glm::uvec2((*itr)[0].GetUint(),
+                                            (*itr)[1].GetUint()));
+    }
+  }
+
+  rapidjson::Value::ConstMemberIterator hashed_configs_itr = config.FindMember("hashed_configs");
+  if (hashed_configs_itr != config.MemberEnd()) {
+    for (rapidjson::Value::ConstValueIterator itr = hashed_configs_itr->value.Begin();
+         itr != hashed_configs_itr->value.End();
+         ++itr) {
+      this->hashed_configs.push_back(pipeline::hashed::parseHashedConfig(*itr));
+    }
+  }
+
+  // Execution parameters
+  // --------------------------------------------------------------------------
+  rapidjson::Value::ConstMemberIterator warmup_itr = config.FindMember("warmup_frames");
+  if (warmup_itr != config.MemberEnd()) {
+    this->n_warmup_frames = warmup_itr->value.GetUint();
+  }
+
+  rapidjson::Value::ConstMemberIterator frames_itr = config.FindMember("frames");
+  if (frames_itr != config.MemberEnd()) {
+    this->n_frames = frames_itr->value.GetUint();
+  }
+
+  rapidjson::Value::ConstMemberIterator counting_itr = config.FindMember("is_counting_calculations");
+  if (counting_itr != config.MemberEnd()) {
+    this->is_counting_calculations = counting_itr->value.GetBool();
+  }
+
+  rapidjson::Value::ConstMemberIterator output_itr = config.FindMember("output_path");
+  if (output_itr != config.MemberEnd()) {
+    this->output_path = output_itr->value.GetString();
+  }
+
+  if (this->scene_paths.empty() || this->algorithms.empty()) {
+    throw std::runtime_error(std::string("No scenes or algorithms specified in benchmark config"));
+  }
+
+  // openGL context, resized to the viewport of every scene
+  // --------------------------------------------------------------------------
+  this->p_window = Controller::createHeadlessWindow(glm::uvec2(1, 1));
+  if (this->p_window == NULL) {
+    glfwTerminate();
+    throw std::runtime_error(std::string("Could not create an openGL context"));
+  }
+  glfwMakeContextCurrent(this->p_window);
+
+  if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+    throw std::runtime_error(std::string("Failed to initialize OpenGL context"));
+  }
+}
+
+
+void BenchmarkRunner::execute() {
+  for (const std::string& scene_path : this->scene_paths) {
+    this->executeScene(scene_path);
+  }
+}
+
+
+void BenchmarkRunner::executeScene(const std::string& scene_path) {
+  std::cout << "Benchmarking " << scene_path << std::endl;
+
+  state::State* p_state = state::constructStateFromJson(scene_path);
+  this->initial_camera = p_state->view.camera;
+
+  glfwSetWindowSize(this->p_window,
+                    p_state->view.viewport.x,
+                    p_state->view.viewport.y);
+  glViewport(0, 0, p_state->view.viewport.x, p_state->view.viewport.y);
+  this->p_offscreen_buffer = new OffscreenBuffer(p_state->view.viewport);
+
+  // Geometry is loaded by constructStateFromJson, textures once per scene
+  p_state->texture_catalog.loadTextures();
+
+  std::vector<Run> runs = this->getRuns(*p_state);
+  for (const Run& run : runs) {
+    std::cout << "  " << getAlgorithmName(run.algorithm)
+              << " (" << run.tile_size.x << "x" << run.tile_size.y << ")"
+              << std::endl;
+    this->executeTimed(*p_state, run, scene_path);
+    if (this->is_counting_calculations) {
+      this->executeCounted(*p_state, run, scene_path);
+    }
+  }
+
+  delete this->p_offscreen_buffer;
+  this->p_offscreen_buffer = NULL;
+  delete p_state;
+}
+
+
+std::vector<BenchmarkRunner::Run> BenchmarkRunner::getRuns(const state::State& state) const {
+  std::vector<glm::uvec2> tile_sizes = this->tile_sizes;
+  if (tile_sizes.empty()) tile_sizes.push_back(state.shading.tile_size);
+
+  std::vector<pipeline::hashed::HashedConfig> hashed_configs = this->hashed_configs;
+  if (hashed_configs.empty()) hashed_configs.push_back(state.shading.hashed_config);
+
+  std::vector<Run> runs;
+  for (pipeline::DeferredShaderId algorithm : this->algorithms) {
+    Run run = { algorithm, state.shading.tile_size, state.shading.hashed_config };
+
+    if (isTiled(algorithm)) {
+      for (const glm::uvec2& tile_size : tile_sizes) {
+        run.tile_size = tile_size;
+        runs.push_back(run);
+      }
+    } else if (algorithm == pipeline::DeferredShaderId::DeferredHashed) {
+      for (const pipeline::hashed::HashedConfig& hashed_config : hashed_configs) {
+        run.hashed_config = hashed_config;
+        runs.push_back(run);
+      }
+    } else {
+      runs.push_back(run);
+    }
+  }
+  return runs;
+}
+
+
+void BenchmarkRunner::prepareRun(state::State& state, const Run& run) const {
+  state.shading.pipeline_type = pipeline::PipelineType::Deferred;
+  state.shading.deferred_shader_id = run.algorithm;
+  state.shading.tile_size = run.tile_size;
+  state.shading.hashed_config = run.hashed_config;
+
+  state.view.camera = this->initial_camera;
+  state.view.camera_control->restart();
+}
+
+
+void BenchmarkRunner::executeTimed(state::State& state,
+                                   const Run& run,
+                                   const std::string& scene_path) {
+  static const logged::ScopeId frame_id = logged::internScope("Benchmark::frame");
+
+  this->prepareRun(state, run);
+
+  util::resetPeakMemoryUsage();
+  std::size_t start_memory = util::getCurrentMemoryUsage();
+
+  Clock clock = Clock();
+  logged::ExecutionTimeLogger logger(clock, 0, 0);
+  pipeline::Pipeline* p_pipeline = new pipeline::DeferredPipelineLogged(state, logger);
+  p_pipeline->initialiseShaders();
+  p_pipeline->setOutputBuffer(this->p_offscreen_buffer->getPointerFBO());
+
+  // Resident memory with all shaders, and with them the LinklessOctree of
+  // the hashed algorithm, loaded.
+  std::size_t resident_memory = util::getCurrentMemoryUsage();
+
+  gui::GuiManager gui_manager(state);
+  DrawOffscreen draw_method = DrawOffscreen(*(this->p_offscreen_buffer));
+
+  // Warm up
+  // --------------------------------------------------------------------------
+  for (unsigned int i = 0; i < this->n_warmup_frames; ++i) {
+    draw_method.draw(this->p_window, p_pipeline, &gui_manager, state.view, clock);
+    clock.incrementFrame();
+  }
+  draw_method.finish();
+
+  // Logged frames
+  // --------------------------------------------------------------------------
+  logger.activate();
+  for (unsigned int i = 0; i < this->n_frames; ++i) {
+    {
+      logged::ProfileScope frame_scope(frame_id);
+      draw_method.draw(this->p_window, p_pipeline, &gui_manager, state.view, clock);
+    }
+    clock.incrementFrame();
+    logger.incrementFrame();
+  }
+  draw_method.finish();
+  logger.deactivate();
+
+  std::size_t peak_memory = util::getPeakMemoryUsage();
+  std::size_t peak_resident_memory_growth =
+    (peak_memory > start_memory) ? peak_memory - start_memory : 0;
+
+  delete p_pipeline;
+
+  // Results
+  // --------------------------------------------------------------------------
+  const logged::Profiler& profiler = logger.getProfiler();
+  std::set<logged::ScopeId> value_ids;
+  for (const logged::ProfileValue& value : profiler.getValues()) {
+    value_ids.insert(value.scope);
+  }
+
+  for (logged::ScopeId id = 0; id < logged::getNScopes(); ++id) {
+    logged::ScopeStats stats = profiler.getStats(id);
+    if (stats.count == 0) continue;
+
+    Result result = this->constructResult(run, scene_path);
+    result.scope = logged::getScopeName(id);
+    result.unit = (value_ids.find(id) == value_ids.end()) ? "ms" : "count";
+    result.count = stats.count;
+    result.total = stats.total;
+    result.p50 = stats.sketch.getQuantile(0.50);
+    result.p95 = stats.sketch.getQuantile(0.95);
+    result.p99 = stats.sketch.getQuantile(0.99);
+    result.max = stats.max;
+    this->results.push_back(result);
+  }
+
+  const std::pair<std::string, std::size_t> memory_results[] = {
+    { "resident_memory", resident_memory },
+    { "peak_resident_memory_growth", peak_resident_memory_growth },
+  };
+  for (const std::pair<std::string, std::size_t>& memory : memory_results) {
+    Result result = this->constructResult(run, scene_path);
+    result.scope = memory.first;
+    result.unit = "bytes";
+    result.count = 1;
+    result.total = double(memory.second);
+    result.p50 = result.total;
+    result.p95 = result.total;
+    result.p99 = result.total;
+    result.max = result.total;
+    this->results.push_back(result);
+  }
+}
+
+
+void BenchmarkRunner::executeCounted(state::State& state,
+                                     const Run& run,
+                                     const std::string& scene_path) {
+  this->prepareRun(state, run);
+
+  Clock clock = Clock();
+  logged::LightCalculationsLogger logger(clock,
+                                         "",
+                                         state.view.viewport.x,
+                                         state.view.viewport.y);
+  pipeline::Pipeline* p_pipeline = new pipeline::DeferredPipelineCounted(state, logger);
+  p_pipeline->initialiseShaders();
+  p_pipeline->setOutputBuffer(this->p_offscreen_buffer->getPointerFBO());
+
+  gui::GuiManager gui_manager(state);
+  DrawOffscreen draw_method = DrawOffscreen(*(this->p_offscreen_buffer));
+
+  for (unsigned int i = 0; i < this->n_warmup_frames; ++i) {
+    draw_method.draw(this->p_window, p_pipeline, &gui_manager, state.view, clock);
+    clock.incrementFrame();
+  }
+
+  logger.activate();
+  for (unsigned int i = 0; i < this->n_frames; ++i) {
+    draw_method.draw(this->p_window, p_pipeline, &gui_manager, state.view, clock);
+    clock.incrementFrame();
+  }
+  draw_method.finish();
+  logger.deactivate();
+
+  delete p_pipeline;
+
+  Result result = this->constructResult(run, scene_path);
+  result.scope = "light_calculations";
+  result.unit = "count";
+  result.count = logger.getNLoggedFrames();
+  result.total = double(logger.getNCalculations());
+  result.p50 = 0.0;
+  result.p95 = 0.0;
+  result.p99 = 0.0;
+  result.max = 0.0;
+  this->results.push_back(result);
+}
+
+
+BenchmarkRunner::Result BenchmarkRunner::constructResult(const Run& run,
+                                                         const std::string& scene_path) const {
+  Result result;
+  result.scene = scene_path;
+  result.algorithm = getAlgorithmName(run.algorithm);
+  result.n_frames = this->n_frames;
+
+  if (isTiled(run.algorithm)) {
+    std::stringstream tile_size;
+    tile_size << run.tile_size.x << "x" << run.tile_size.y;
+    result.tile_size = tile_size.str();
+  }
+
+  if (run.algorithm == pipeline::DeferredShaderId::DeferredHashed) {
+    std::stringstream hashed_config;
+    hashed_config << run.hashed_config.minimum_node_size << ";"
+                  << run.hashed_config.starting_depth << ";"
+                  << run.hashed_config.r_increase_ratio << ";"
+                  << run.hashed_config.max_attempts << ";"
+                  << run.hashed_config.seed << ";"
+                  << pipeline::hashed::getHashedBuildMethodName(run.hashed_config.build_method) << ";"
+                  << run.hashed_config.dense_occupancy_threshold << ";"
+                  << pipeline::hashed::getHashedTableLayoutName(run.hashed_config.table_layout) << ";"
+                  << (run.hashed_config.release_host_tables ? "release" : "keep") << ";"
+                  << (run.hashed_config.pow2_tables ? "pow2" : "odd") << ";"
+                  << pipeline::hashed::getHashedBackendName(run.hashed_config.backend) << ";"
+                  << run.hashed_config.portfolio_size << ";"
+                  << (run.hashed_config.auto_tune ? "auto" : "fixed") << ";"
+                  << run.hashed_config.memory_budget;
+    result.hashed_config = hashed_config.str();
+  }
+  return result;
+}
+
+
+void BenchmarkRunner::exportResults() {
+  std::ofstream ofs(this->output_path, std::ios::trunc);
+  if (!ofs) {
+    throw std::runtime_error(std::string("Could not write benchmark results: ") + this->output_path);
+  }
+
+  ofs << "scene,algorithm,tile_size,hashed_config,n_frames,scope,unit,"
+      << "count,total,mean,per_frame,p50,p95,p99,max\n";
+
+  for (const Result& result : this->results) {
+    double mean = (result.count > 0) ? result.total / double(result.count) : 0.0;
+    double per_frame = (result.n_frames > 0) ? result.total / double(result.n_frames) : 0.0;
+
+    ofs << result.scene << ","
+        << result.algorithm << ","
+        << result.tile_size << ","
+        << result.hashed_config << ","
+        << result.n_frames << ","
+        << result.scope << ","
+        << result.unit << ","
+        << result.count << ","
+        << result.total << ","
+        << mean << ","
+        << per_frame << ","
+        << result.p50 << ","
+        << result.p95 << ","
+        << result.p99 << ","
+        << result.max << "\n";
+  }
+}
+
+} // main
+} // nTiled
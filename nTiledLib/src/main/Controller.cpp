@@ -10,6 +10,8 @@
 
 #include "pipeline\debug-view\DebugPipeline.h"
 
+#include <stdexcept>
+
 namespace nTiled {
 
 void key_callback(GLFWwindow* window, 
@@ -22,13 +24,15 @@ void key_callback(GLFWwindow* window,
 // ----------------------------------------------------------------------------
 //  constructor
 // ----------------------------------------------------------------------------
-Controller::Controller(const std::string& scene_path) : 
+Controller::Controller(const std::string& scene_path, bool is_headless) : 
     scene_path(scene_path),
+    is_forced_headless(is_headless),
     draw_methods(std::vector<DrawMethod*>()),
     event_queue(std::priority_queue<FrameEvent*,
                                     std::vector<FrameEvent*>,
                                     FrameEventCompare>()),
     should_close(false) {
+  this->p_offscreen_buffer = nullptr;
   this->draw_methods.push_back(new DrawToView());
   this->current_draw_method = this->draw_methods[0];
 }
@@ -42,6 +46,7 @@ Controller::~Controller() {
   delete p_logger;
   delete p_gui_manager;
   delete p_pipeline;
+  delete p_offscreen_buffer;
   delete p_state;
 
   if (this->p_state->log.is_counting_calculations) {
@@ -62,33 +67,43 @@ void Controller::initialise() {
 
 void Controller::initialiseState() {
   this->p_state = state::constructStateFromJson(this->scene_path);
+  if (this->is_forced_headless) {
+    this->p_state->view.is_headless = true;
+  }
 }
 
 
 void Controller::initialiseOpenGL() {
-  glfwInit();
-
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-  glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
-
-  this->p_window = glfwCreateWindow(this->p_state->view.viewport.x, // width
-                                    this->p_state->view.viewport.y, // height
-                                    "nTiled - openGL viewer",    // name
-                                     NULL,                        // p_monitor
-                                     NULL);                       // p_share
+  if (this->p_state->view.is_headless) {
+    this->p_window = Controller::createHeadlessWindow(this->p_state->view.viewport);
+  } else {
+    glfwInit();
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
+
+    this->p_window = glfwCreateWindow(this->p_state->view.viewport.x, // width
+                                      this->p_state->view.viewport.y, // height
+                                      "nTiled - openGL viewer",    // name
+                                       NULL,                        // p_monitor
+                                       NULL);                       // p_share
+  }
   glfwMakeContextCurrent(this->p_window);
 
   if (this->p_window == NULL) {
     std::cout << "Failed to create GLFW window" << std::endl;
     glfwTerminate();
     this->exit();
+    throw std::runtime_error(std::string("Could not create an openGL context"));
   }
 
   // Set Key callback
   // ----------------
-  glfwSetKeyCallback(this->p_window, key_callback);
+  if (!this->p_state->view.is_headless) {
+    glfwSetKeyCallback(this->p_window, key_callback);
+  }
 
   // load glad
   // ---------
@@ -101,14 +116,74 @@ void Controller::initialiseOpenGL() {
 }
 
 
+/*! @brief Set the hints of the hidden window of a headless execution. */
+static void setHeadlessWindowHints() {
+  glfwDefaultWindowHints();
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 4);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+  glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
+  glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+}
+
+
+GLFWwindow* Controller::createHeadlessWindow(glm::uvec2 viewport) {
+  // Without a display the windowing platform can not be initialised, use
+  // the null platform, which only supports offscreen contexts.
+  bool is_initialised = (glfwInit() == GLFW_TRUE);
+#ifdef GLFW_PLATFORM_NULL
+  if (!is_initialised) {
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    is_initialised = (glfwInit() == GLFW_TRUE);
+  }
+#endif
+  if (!is_initialised) return NULL;
+
+  const int width = viewport.x;
+  const int height = viewport.y;
+
+  // A hidden window with the native context, rendered to offscreen
+  setHeadlessWindowHints();
+  GLFWwindow* p_window = glfwCreateWindow(width, height, "nTiled", NULL, NULL);
+
+#ifdef GLFW_OSMESA_CONTEXT_API
+  // Without a native context, use Mesa's software rasterizer
+  if (p_window == NULL) {
+    setHeadlessWindowHints();
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    p_window = glfwCreateWindow(width, height, "nTiled", NULL, NULL);
+  }
+#endif
+#ifdef GLFW_EGL_CONTEXT_API
+  if (p_window == NULL) {
+    setHeadlessWindowHints();
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+    p_window = glfwCreateWindow(width, height, "nTiled", NULL, NULL);
+  }
+#endif
+
+  if (p_window != NULL) {
+    std::cout << "Rendering headless" << std::endl;
+  }
+  return p_window;
+}
+
+
 
 void Controller::initialiseNTiledComponents() {
+  // Textures
+  // --------------------------------------------------------------------------
+  this->p_state->texture_catalog.loadTextures();
+
   // Logging attributes
   // --------------------------------------------------------------------------
   this->clock = Clock();
   this->p_logger = new logged::ExecutionTimeLogger(this->clock, 
                                                    this->p_state->log.frame_start,
                                                    this->p_state->log.frame_end);
+  if (!this->p_state->log.stream_path.empty()) {
+    this->p_logger->streamTo(this->p_state->log.stream_path);
+  }
 
   nTiled::pipeline::Pipeline* p_render_pipeline;
   if (this->p_state->shading.pipeline_type == nTiled::pipeline::PipelineType::Forward) {
@@ -119,7 +194,8 @@ void Controller::initialiseNTiledComponents() {
         this->clock, 
         this->p_state->log.path_calculations,
         this->p_state->view.viewport.x, 
-        this->p_state->view.viewport.y);
+        this->p_state->view.viewport.y,
+        this->p_state->log.is_exporting_calculation_tiles);
       p_render_pipeline = new nTiled::pipeline::ForwardPipelineCounted(*this->p_state,
                                                                        *this->p_light_calc_logger);
     } else {
@@ -134,7 +210,8 @@ void Controller::initialiseNTiledComponents() {
         this->clock,
         this->p_state->log.path_calculations,
         this->p_state->view.viewport.x,
-        this->p_state->view.viewport.y);
+        this->p_state->view.viewport.y,
+        this->p_state->log.is_exporting_calculation_tiles);
       p_render_pipeline = new nTiled::pipeline::DeferredPipelineCounted(*this->p_state,
                                                                         *this->p_light_calc_logger);
     } else {
@@ -153,7 +230,18 @@ void Controller::initialiseNTiledComponents() {
   }
 
   this->p_gui_manager = new gui::GuiManager(*(this->p_state));
-  this->p_gui_manager->init(*(this->p_window));
+  if (this->p_state->view.is_headless) {
+    // headless executions draw offscreen, the gui is only used to update
+    // the camera
+    this->p_offscreen_buffer = new OffscreenBuffer(this->p_state->view.viewport);
+    this->p_pipeline->setOutputBuffer(this->p_offscreen_buffer->getPointerFBO());
+
+    delete this->draw_methods[0];
+    this->draw_methods[0] = new DrawOffscreen(*(this->p_offscreen_buffer));
+    this->current_draw_method = this->draw_methods[0];
+  } else {
+    this->p_gui_manager->init(*(this->p_window));
+  }
 }
 
 
@@ -164,7 +252,8 @@ void Controller::initialiseFrameEvents() {
   if (this->p_state->view.output->type == state::OutputType::Memory) {
     // construct new DrawMethod
     DrawMethod* draw_to_memory =new DrawToMemory(this->p_state->view.output->image_base_path,
-                                                 this->p_state->view);
+                                                 this->p_state->view,
+                                                 this->p_offscreen_buffer);
     this->draw_methods.push_back(draw_to_memory);
 
     // push both switch events to the event queue
@@ -227,7 +316,10 @@ void Controller::render() {
 
 
 void Controller::renderLoopDefault() {
-  while(!glfwWindowShouldClose(this->p_window) && !this->should_close ) {
+  // A headless execution stops once all frame events have been executed
+  while(!glfwWindowShouldClose(this->p_window) && 
+        !this->should_close &&
+        !this->p_state->view.is_headless) {
     this->current_draw_method->draw(this->p_window,
                                     this->p_pipeline,
                                     this->p_gui_manager,
@@ -237,6 +329,7 @@ void Controller::renderLoopDefault() {
     this->p_logger->incrementFrame();
   }
 
+  this->current_draw_method->finish();
   glfwTerminate();
 }
 
@@ -275,6 +368,9 @@ void Controller::renderLoopEventQueue() {
 //  Execution Methods
 // ----------------------------------------------------------------------------
 void Controller::setDrawMethod(DrawMethod* draw_method) {
+  if (this->current_draw_method != draw_method) {
+    this->current_draw_method->finish();
+  }
   this->current_draw_method = draw_method;
 }
 
@@ -6,12 +6,18 @@
 // ----------------------------------------------------------------------------
 #include "state\State.h"
 #include "world\light-constructor\PointLightConstructor.h"
+#include "state\LightGenerator.h"
+#include "util\MemoryUsage.h"
+#include "pipeline\light-management\hashed\Exceptions.h"
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
 
 // ----------------------------------------------------------------------------
 //  System Libraries
 // ----------------------------------------------------------------------------
 // File handling
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -24,11 +30,108 @@
 namespace nTiled {
 namespace main {
 
+// ----------------------------------------------------------------------------
+//  Sweep helper functions
+// ----------------------------------------------------------------------------
+/*! @brief SweepAxis holds every value of a single swept parameter, each as
+ *         a function setting that value in a HashedConfig.
+ */
+typedef std::vector<std::function<void(pipeline::hashed::HashedConfig&)>> SweepAxis;
+
+
+static double parseSweepDouble(const rapidjson::Value& value) {
+  return value.GetDouble();
+}
+
+
+static unsigned int parseSweepUint(const rapidjson::Value& value) {
+  return value.GetUint();
+}
+
+
+static std::size_t parseSweepSize(const rapidjson::Value& value) {
+  return std::size_t(value.GetUint64());
+}
+
+
+static bool parseSweepBool(const rapidjson::Value& value) {
+  return value.GetBool();
+}
+
+
+static pipeline::hashed::HashedBuildMethod parseSweepBuildMethod(const rapidjson::Value& value) {
+  return pipeline::hashed::parseHashedBuildMethod(value.GetString());
+}
+
+
+static pipeline::hashed::HashedTableLayout parseSweepTableLayout(const rapidjson::Value& value) {
+  return pipeline::hashed::parseHashedTableLayout(value.GetString());
+}
+
+
+static pipeline::hashed::HashedBackend parseSweepBackend(const rapidjson::Value& value) {
+  return pipeline::hashed::parseHashedBackend(value.GetString());
+}
+
+
+/*! @brief Add the values listed under key in sweep_json as a SweepAxis of
+ *         the specified HashedConfig member to axes. Parameters which are
+ *         not listed add no axis, such that they keep their base value.
+ */
+template <class T>
+static void addSweepAxis(const rapidjson::Value& sweep_json,
+                         const char* key,
+                         T (*parse)(const rapidjson::Value&),
+                         T pipeline::hashed::HashedConfig::* p_member,
+                         std::vector<SweepAxis>& axes) {
+  rapidjson::Value::ConstMemberIterator itr = sweep_json.FindMember(key);
+  if (itr == sweep_json.MemberEnd()) return;
+
+  SweepAxis axis = SweepAxis();
+  for (rapidjson::Value::ConstValueIterator v = itr->value.Begin(); v != itr->value.End(); ++v) {
+    T value = parse(*v);
+    axis.push_back([p_member, value](pipeline::hashed::HashedConfig& config) {
+      config.*p_member = value;
+    });
+  }
+  axes.push_back(axis);
+}
+
+
+/*! @brief Construct the HashedConfig of every combination of the values of
+ *         the axes, starting from base_config, in which the first axis
+ *         varies slowest.
+ */
+static std::vector<pipeline::hashed::HashedConfig> constructSweepConfigs(
+    const pipeline::hashed::HashedConfig& base_config,
+    const std::vector<SweepAxis>& axes) {
+  std::vector<pipeline::hashed::HashedConfig> configs = { base_config };
+  for (const SweepAxis& axis : axes) {
+    std::vector<pipeline::hashed::HashedConfig> next_configs = {};
+    for (const pipeline::hashed::HashedConfig& config : configs) {
+      for (const std::function<void(pipeline::hashed::HashedConfig&)>& set_value : axis) {
+        pipeline::hashed::HashedConfig point_config = config;
+        set_value(point_config);
+        next_configs.push_back(point_config);
+      }
+    }
+    configs.swap(next_configs);
+  }
+  return configs;
+}
+
+
+// ----------------------------------------------------------------------------
+//  Constructor | Destructor
+// ----------------------------------------------------------------------------
 DataController::DataController(const std::string& config_path) :
     config_path(config_path),
     clock(Clock()),
-    logger(logged::ExecutionTimeLogger(this->clock, 1, 2)),
-    has_init(false) {
+    logger(this->clock, 1, 2),
+    has_init(false),
+    p_logged_manager(nullptr),
+    is_sweeping(false),
+    n_repetitions(1) {
 }
 
 
@@ -55,21 +158,52 @@ void DataController::init() {
   pipeline::hashed::HashedConfig hashed_config = pipeline::hashed::HashedConfig();
   rapidjson::Value::ConstMemberIterator hashed_config_itr = config.FindMember("hashed_config");
   if (hashed_config_itr != config.MemberEnd()) {
-    auto& hashed_config_json = hashed_config_itr->value;
+    hashed_config = pipeline::hashed::parseHashedConfig(hashed_config_itr->value);
+  } else {
+    throw std::runtime_error(std::string("No hash config specified"));
+  }
+
+  // Load sweep, every parameter not swept is taken from hashed_config
+  rapidjson::Value::ConstMemberIterator sweep_itr = config.FindMember("sweep");
+  if (sweep_itr != config.MemberEnd()) {
+    auto& sweep_json = sweep_itr->value;
+    this->is_sweeping = true;
+
+    std::vector<SweepAxis> axes = {};
+    addSweepAxis(sweep_json, "node_size", parseSweepDouble,
+                 &pipeline::hashed::HashedConfig::minimum_node_size, axes);
+    addSweepAxis(sweep_json, "starting_depth", parseSweepUint,
+                 &pipeline::hashed::HashedConfig::starting_depth, axes);
+    addSweepAxis(sweep_json, "r_increase_ratio", parseSweepDouble,
+                 &pipeline::hashed::HashedConfig::r_increase_ratio, axes);
+    addSweepAxis(sweep_json, "max_attempts", parseSweepUint,
+                 &pipeline::hashed::HashedConfig::max_attempts, axes);
+    addSweepAxis(sweep_json, "seed", parseSweepUint,
+                 &pipeline::hashed::HashedConfig::seed, axes);
+    addSweepAxis(sweep_json, "build_method", parseSweepBuildMethod,
+                 &pipeline::hashed::HashedConfig::build_method, axes);
+    addSweepAxis(sweep_json, "dense_occupancy_threshold", parseSweepDouble,
+                 &pipeline::hashed::HashedConfig::dense_occupancy_threshold, axes);
+    addSweepAxis(sweep_json, "table_layout", parseSweepTableLayout,
+                 &pipeline::hashed::HashedConfig::table_layout, axes);
+    addSweepAxis(sweep_json, "pow2_tables", parseSweepBool,
+                 &pipeline::hashed::HashedConfig::pow2_tables, axes);
+    addSweepAxis(sweep_json, "backend", parseSweepBackend,
+                 &pipeline::hashed::HashedConfig::backend, axes);
+    addSweepAxis(sweep_json, "portfolio_size", parseSweepUint,
+                 &pipeline::hashed::HashedConfig::portfolio_size, axes);
+    addSweepAxis(sweep_json, "auto_tune", parseSweepBool,
+                 &pipeline::hashed::HashedConfig::auto_tune, axes);
+    addSweepAxis(sweep_json, "memory_budget", parseSweepSize,
+                 &pipeline::hashed::HashedConfig::memory_budget, axes);
+    this->sweep_configs = constructSweepConfigs(hashed_config, axes);
 
-    unsigned int hashed_seed = 22;
-    rapidjson::Value::ConstMemberIterator hashed_seed_itr = hashed_config_json.FindMember("seed");
-    if (hashed_seed_itr != hashed_config_json.MemberEnd()) {
-      hashed_seed = hashed_config_json["seed"].GetUint();
+    rapidjson::Value::ConstMemberIterator repetitions_itr = sweep_json.FindMember("repetitions");
+    if (repetitions_itr != sweep_json.MemberEnd()) {
+      this->n_repetitions = repetitions_itr->value.GetUint();
     }
 
-    hashed_config = pipeline::hashed::HashedConfig(hashed_config_json["node_size"].GetFloat(),
-                                                   hashed_config_json["starting_depth"].GetUint(),
-                                                   hashed_config_json["r_increase_ratio"].GetFloat(),
-                                                   hashed_config_json["max_attempts"].GetUint(),
-                                                   hashed_seed);
-  } else {
-    throw std::runtime_error(std::string("No hash config specified"));
+    this->sweep_output_path = sweep_json["output_path"].GetString();
   }
 
   // Load light data
@@ -91,13 +225,13 @@ void DataController::init() {
   this->execution_time_path = log_output_path;
   this->memory_data_path = log_memory_path;
 
-  if (!is_logging_data) {
+  if (!is_logging_data && !this->is_sweeping) {
     throw std::runtime_error(std::string("Logging disabled in config"));
   }
 
   // Construct relevant data
   this->p_world = new world::World();
-  
+ 
   // Load lights
   world::PointLightConstructor light_constructor =
     world::PointLightConstructor(*p_world);
@@ -106,18 +240,32 @@ void DataController::init() {
   for (rapidjson::Value::ConstValueIterator itr = lights_array_json.Begin();
   itr != lights_array_json.End();
     ++itr) {
-    std::string lights_path = (*itr)["path"].GetString();
-    state::parseLights(lights_path, light_constructor);
+    rapidjson::Value::ConstMemberIterator generate_itr = itr->FindMember("generate");
+    if (generate_itr != itr->MemberEnd()) {
+      state::addGeneratedLights(state::parseLightGeneratorConfig(generate_itr->value),
+                                *p_world,
+                                light_constructor);
+    } else {
+      std::string lights_path = (*itr)["path"].GetString();
+      state::parseLights(lights_path, light_constructor);
+    }
   }
 
-  this->p_logged_manager = 
-    new pipeline::hashed::HashedLightManagerLogged(*this->p_world,
-                                                   hashed_config,
-                                                   logger);
+  if (!this->is_sweeping) {
+    this->p_logged_manager =
+      new pipeline::hashed::HashedLightManagerLogged(*this->p_world,
+                                                     hashed_config,
+                                                     logger);
+  }
 }
 
 
 void DataController::execute() {
+  if (this->is_sweeping) {
+    this->executeSweep();
+    return;
+  }
+
   this->logger.activate();
   this->p_logged_manager->init();
   this->logger.deactivate();
@@ -125,9 +273,261 @@ void DataController::execute() {
 
 
 void DataController::exportData() {
+  if (this->is_sweeping) {
+    this->exportSweep();
+    return;
+  }
+
   this->logger.exportLog(this->execution_time_path);
   this->p_logged_manager->exportMemoryUsageData(this->memory_data_path);
 }
 
+
+// ----------------------------------------------------------------------------
+//  Sweep
+// ----------------------------------------------------------------------------
+/*! @brief Names of the logged construction stages, in csv column order. */
+static const std::vector<std::pair<std::string, std::string>> sweep_stages = {
+  { "construct", "DataController::construct" },
+  { "empty_light_octree", "HashedLightManager::constructEmptyLightOctree" },
+  { "slts", "HashedLightManager::constructSLTs" },
+  { "add_slts", "HashedLightManager::addConstructedSLTs" },
+  { "linkless_octree", "HashedLightManager::constructLinklessOctree" },
+  { "linkless_octree_morton", "HashedLightManager::constructLinklessOctreeMorton" },
+  { "lookup", "DataController::lookup" },
+  { "hash_function", "SpatialHashFunctionBuilder::constructHashFunction" },
+  { "displacement_hash_function", "DisplacementHashFunctionBuilder::constructHashFunction" },
+  { "portfolio_hash_function", "PortfolioHashFunctionBuilder::constructHashFunction" },
+  { "auto_tune", "HashedLightManager::autoTune" },
+};
+
+
+/*! @brief Number of points per dimension of the grid over the
+ *         LinklessOctree at which lights are retrieved to time lookups.
+ */
+static const unsigned int n_lookup_samples = 64;
+
+
+/*! @brief Retrieve the lights of the specified LinklessOctree at every point
+ *         of a regular grid of n_lookup_samples^3 points spanning it.
+ *
+ * @returns The total number of retrieved light indices.
+ */
+static std::size_t lookupSampleGrid(const pipeline::hashed::LinklessOctree& linkless_octree) {
+  glm::vec3 origin = linkless_octree.getOrigin();
+  double step_size = linkless_octree.getWidth() / double(n_lookup_samples);
+
+  std::size_t n_retrieved = 0;
+  for (unsigned int x = 0; x < n_lookup_samples; ++x) {
+    for (unsigned int y = 0; y < n_lookup_samples; ++y) {
+      for (unsigned int z = 0; z < n_lookup_samples; ++z) {
+        glm::vec3 p = origin + glm::vec3((x + 0.5) * step_size,
+                                         (y + 0.5) * step_size,
+                                         (z + 0.5) * step_size);
+        n_retrieved += linkless_octree.retrieveLights(p).size();
+      }
+    }
+  }
+  return n_retrieved;
+}
+
+
+void DataController::executeSweep() {
+  for (unsigned int i = 0; i < this->sweep_configs.size(); ++i) {
+    const pipeline::hashed::HashedConfig& hashed_config = this->sweep_configs[i];
+    std::cout << "Sweep point " << (i + 1) << " / " << this->sweep_configs.size()
+              << ": node_size " << hashed_config.minimum_node_size
+              << ", starting_depth " << hashed_config.starting_depth
+              << ", r_increase_ratio " << hashed_config.r_increase_ratio
+              << ", max_attempts " << hashed_config.max_attempts
+              << ", seed " << hashed_config.seed
+              << ", build_method "
+              << pipeline::hashed::getHashedBuildMethodName(hashed_config.build_method)
+              << ", dense_occupancy_threshold " << hashed_config.dense_occupancy_threshold
+              << ", pow2_tables " << hashed_config.pow2_tables
+              << ", backend "
+              << pipeline::hashed::getHashedBackendName(hashed_config.backend)
+              << ", portfolio_size " << hashed_config.portfolio_size
+              << ", auto_tune " << hashed_config.auto_tune
+              << ", memory_budget " << hashed_config.memory_budget
+              << std::endl;
+    this->sweep_results.push_back(this->executeSweepPoint(hashed_config));
+  }
+}
+
+
+DataController::SweepResult DataController::executeSweepPoint(
+    const pipeline::hashed::HashedConfig& hashed_config) {
+  static const logged::ScopeId construct_id =
+    logged::internScope("DataController::construct");
+  static const logged::ScopeId n_retries_id =
+    logged::internScope("SpatialHashFunctionBuilder::retries");
+  static const logged::ScopeId lookup_id =
+    logged::internScope("DataController::lookup");
+
+  SweepResult result;
+  result.hashed_config = hashed_config;
+  result.n_failed = 0;
+  result.memory_usage = pipeline::hashed::HashedMemoryUsage();
+  result.tuning = pipeline::hashed::HashedTuning();
+  result.has_tuned = false;
+
+  util::resetPeakMemoryUsage();
+  std::size_t start_memory = util::getCurrentMemoryUsage();
+
+  // Every point is logged by its own logger, such that its statistics only
+  // contain its own repetitions.
+  Clock point_clock = Clock();
+  logged::ExecutionTimeLogger point_logger(point_clock, 0, 0);
+  point_logger.activate();
+
+  for (unsigned int i = 0; i < this->n_repetitions; ++i) {
+    pipeline::hashed::HashedLightManagerLogged* p_manager =
+      new pipeline::hashed::HashedLightManagerLogged(*this->p_world,
+                                                     hashed_config,
+                                                     point_logger);
+    bool is_constructed = true;
+    try {
+      logged::ProfileScope construct_scope(construct_id);
+      p_manager->init();
+    } catch (const pipeline::hashed::SpatialHashFunctionException&) {
+      is_constructed = false;
+    } catch (const pipeline::hashed::HashedShadingException&) {
+      is_constructed = false;
+    }
+
+    if (is_constructed) {
+      {
+        logged::ProfileScope lookup_scope(lookup_id);
+        lookupSampleGrid(*p_manager->getLinklessOctree());
+      }
+      result.memory_usage = p_manager->getMemoryUsage();
+      if (p_manager->hasTuned()) {
+        result.tuning = p_manager->getTuning();
+        result.has_tuned = true;
+      }
+    } else {
+      result.n_failed++;
+    }
+
+    delete p_manager;
+
+    point_clock.incrementFrame();
+    point_logger.incrementFrame();
+  }
+  point_logger.deactivate();
+
+  for (const std::pair<std::string, std::string>& stage : sweep_stages) {
+    result.stage_stats.push_back(
+      point_logger.getProfiler().getStats(logged::internScope(stage.second)));
+  }
+  result.retry_stats = point_logger.getProfiler().getStats(n_retries_id);
+  std::size_t peak_memory = util::getPeakMemoryUsage();
+  result.peak_memory_growth = (peak_memory > start_memory) ? peak_memory - start_memory : 0;
+  return result;
+}
+
+
+void DataController::exportSweep() {
+  std::ofstream ofs(this->sweep_output_path, std::ios::trunc);
+  if (!ofs) {
+    throw std::runtime_error(std::string("Could not write sweep results: ") + this->sweep_output_path);
+  }
+
+  // Header
+  // --------------------------------------------------------------------------
+  ofs << "node_size,starting_depth,r_increase_ratio,max_attempts,seed,"
+      << "build_method,dense_occupancy_threshold,table_layout,pow2_tables,backend,portfolio_size,"
+      << "auto_tune,memory_budget,n_repetitions,n_failed";
+  for (const std::pair<std::string, std::string>& stage : sweep_stages) {
+    ofs << "," << stage.first << "_mean_ms"
+        << "," << stage.first << "_p50_ms"
+        << "," << stage.first << "_p95_ms"
+        << "," << stage.first << "_p99_ms"
+        << "," << stage.first << "_min_ms"
+        << "," << stage.first << "_max_ms";
+  }
+  ofs << ",n_hash_functions,n_retries,max_retries"
+      << ",n_light_indices,light_octree_depth,n_levels,n_data_tables"
+      << ",n_dense_tables,n_octree_hash_entries,n_octree_offset_entries"
+      << ",n_data_hash_entries,n_data_offset_entries,memory_bytes"
+      << ",gpu_texture_bytes,gpu_packed_bytes"
+      << ",mean_fetches_per_query,peak_memory_growth_bytes"
+      << ",tuned_node_size,tuned_starting_depth,tuned_r_increase_ratio"
+      << ",predicted_bytes,actual_bytes,predicted_fetches\n";
+
+  // Rows, counts are per repetition
+  // --------------------------------------------------------------------------
+  for (const SweepResult& result : this->sweep_results) {
+    const pipeline::hashed::HashedConfig& config = result.hashed_config;
+    double n_repetitions = double(std::max(this->n_repetitions, 1u));
+
+    ofs << config.minimum_node_size << ","
+        << config.starting_depth << ","
+        << config.r_increase_ratio << ","
+        << config.max_attempts << ","
+        << config.seed << ","
+        << pipeline::hashed::getHashedBuildMethodName(config.build_method) << ","
+        << config.dense_occupancy_threshold << ","
+        << pipeline::hashed::getHashedTableLayoutName(config.table_layout) << ","
+        << config.pow2_tables << ","
+        << pipeline::hashed::getHashedBackendName(config.backend) << ","
+        << config.portfolio_size << ","
+        << config.auto_tune << ","
+        << config.memory_budget << ","
+        << this->n_repetitions << ","
+        << result.n_failed;
+
+    for (const logged::ScopeStats& stats : result.stage_stats) {
+      if (stats.count > 0) {
+        ofs << "," << (stats.total / double(stats.count))
+            << "," << stats.sketch.getQuantile(0.50)
+            << "," << stats.sketch.getQuantile(0.95)
+            << "," << stats.sketch.getQuantile(0.99)
+            << "," << stats.min
+            << "," << stats.max;
+      } else {
+        ofs << ",,,,,,";
+      }
+    }
+
+    const pipeline::hashed::HashedMemoryUsage& usage = result.memory_usage;
+    ofs << "," << (double(result.retry_stats.count) / n_repetitions)
+        << "," << (result.retry_stats.total / n_repetitions)
+        << "," << result.retry_stats.max
+        << "," << usage.n_light_indices
+        << "," << usage.light_octree_depth
+        << "," << usage.n_levels
+        << "," << usage.n_data_tables
+        << "," << usage.n_dense_tables
+        << "," << usage.n_octree_hash_entries
+        << "," << usage.n_octree_offset_entries
+        << "," << usage.n_data_hash_entries
+        << "," << usage.n_data_offset_entries
+        << "," << usage.n_bytes
+        << "," << usage.n_gpu_texture_bytes
+        << "," << usage.n_gpu_packed_bytes
+        << "," << usage.mean_fetches_per_query
+        << "," << result.peak_memory_growth;
+
+    // The actual bytes are those of the table layout which the tuning
+    // predicts
+    if (result.has_tuned) {
+      const pipeline::hashed::HashedTuning& tuning = result.tuning;
+      std::size_t n_table_bytes =
+        (config.table_layout == pipeline::hashed::HashedTableLayout::Packed) ?
+          usage.n_gpu_packed_bytes : usage.n_gpu_texture_bytes;
+      ofs << "," << tuning.minimum_node_size
+          << "," << tuning.starting_depth
+          << "," << tuning.r_increase_ratio
+          << "," << tuning.predicted_bytes
+          << "," << (n_table_bytes + usage.n_light_indices * sizeof(GLuint))
+          << "," << tuning.predicted_fetches << "\n";
+    } else {
+      ofs << ",,,,,,\n";
+    }
+  }
+}
+
 }
 }
\ No newline at end of file
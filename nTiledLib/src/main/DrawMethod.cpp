@@ -1,8 +1,8 @@
 #include "main\DrawMethod.h"
 
 #include <GLFW\glfw3.h>
+#include <algorithm>
 #include <iostream>
-#include "lodepng.h"
 
 namespace nTiled {
 
@@ -10,15 +10,22 @@ namespace nTiled {
 //  DrawToMemory
 // ----------------------------------------------------------------------------
 DrawToMemory::DrawToMemory(std::string path,
-                           state::View& view) : 
+                           state::View& view,
+                           const OffscreenBuffer* p_offscreen_buffer) : 
     path(path),
-    p_raw_pixel_buffer(new GLubyte[view.viewport.x * view.viewport.y * 4]),
-    p_output_buffer(new GLubyte[view.viewport.x * view.viewport.y * 4]) {
+    format(view.output->capture_format),
+    is_headless(view.is_headless),
+    p_offscreen_buffer(p_offscreen_buffer),
+    p_capture(nullptr),
+    pixels(std::vector<unsigned char>(view.viewport.x * view.viewport.y * 4)),
+    n_captured_frames(0) {
+  if (view.output->is_async_capture) {
+    this->p_capture = new FrameCapture(view.viewport, this->format);
+  }
 }
 
 DrawToMemory::~DrawToMemory() {
-  delete this->p_output_buffer;
-  delete this->p_raw_pixel_buffer;
+  delete this->p_capture;
 }
 
 void DrawToMemory::draw(GLFWwindow* window,
@@ -26,8 +33,20 @@ void DrawToMemory::draw(GLFWwindow* window,
                         gui::GuiManager* gui_manager,
                         state::View& view,
                         const Clock& clock) const {
+  if (this->n_captured_frames == 0) {
+    this->capture_start = std::chrono::steady_clock::now();
+  }
+
   // update nTiled components
-  gui_manager->update();
+  if (this->is_headless) {
+    gui_manager->updateHeadless();
+  } else {
+    gui_manager->update();
+  }
+
+  if (this->p_offscreen_buffer) {
+    this->p_offscreen_buffer->bindForWriting();
+  }
 
   // Clear colour buffer
   glClearColor(0, 0, 0, 1);
@@ -37,41 +56,52 @@ void DrawToMemory::draw(GLFWwindow* window,
   // render nTiled components
   p_pipeline->render();
 
-  // Display on screen
-  glfwSwapBuffers(window);
+  std::string image_path =
+    view.output->image_base_path + "frame_" + std::to_string(clock.getCurrentFrame()) +
+    getCaptureExtension(this->format);
 
+  // Read the back buffer before it is swapped, its contents are undefined
+  // afterwards.
+  if (this->p_offscreen_buffer) {
+    this->p_offscreen_buffer->bindForReading();
+  }
 
-  //Read current buffer
-  glReadPixels(0, 0,
-               view.viewport.x, view.viewport.y,
-               GL_RGBA, GL_UNSIGNED_BYTE,
-               this->p_raw_pixel_buffer);
+  if (this->p_capture) {
+    this->p_capture->capture(image_path);
+    if (!this->is_headless) glfwSwapBuffers(window);
+  } else {
+    glReadPixels(0, 0,
+                 view.viewport.x, view.viewport.y,
+                 getCaptureReadFormat(this->format), GL_UNSIGNED_BYTE,
+                 this->pixels.data());
+    if (!this->is_headless) glfwSwapBuffers(window);
+
+    writeFrame(image_path, 
+               this->pixels, 
+               view.viewport.x, 
+               view.viewport.y, 
+               this->format);
+  }
 
-  // Dirty y-axis invert
-  int index_output;
-  int index_pixel;
-  for (int y = 0; y < view.viewport.y; y++) {
-    for (int x = 0; x < view.viewport.x; x++) {
-      index_output = (y * view.viewport.x + x) * 4;
-      index_pixel = ((view.viewport.y - 1 - y) * view.viewport.x + x) * 4;
+  this->n_captured_frames++;
+}
 
-      this->p_output_buffer[index_output + 0] = this->p_raw_pixel_buffer[index_pixel + 0];
-      this->p_output_buffer[index_output + 1] = this->p_raw_pixel_buffer[index_pixel + 1];
-      this->p_output_buffer[index_output + 2] = this->p_raw_pixel_buffer[index_pixel + 2];
-      this->p_output_buffer[index_output + 3] = this->p_raw_pixel_buffer[index_pixel + 3];
-    }
+void DrawToMemory::finish() {
+  if (this->n_captured_frames == 0) return;
+
+  if (this->p_capture) {
+    this->p_capture->flush();
   }
 
-  // invert in y-axis
+  double capture_time = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - this->capture_start).count();
+  std::cout << "Captured " << this->n_captured_frames << " frames in "
+            << capture_time << " s ("
+            << this->n_captured_frames / capture_time << " frames/s, "
+            << (this->p_capture ? "asynchronous" : "synchronous") << ")"
+            << std::endl;
 
-  std::string image_path =
-    view.output->image_base_path + "frame_" + std::to_string(clock.getCurrentFrame()) + ".png";
-  unsigned error = lodepng::encode(image_path,
-                                   p_output_buffer,
-                                   view.viewport.x,
-                                   view.viewport.y);
-
-  if (error) std::cout << "encoder error " << error << ": " << lodepng_error_text(error) << std::endl;
+  this->n_captured_frames = 0;
 }
 
 
@@ -99,4 +129,61 @@ void DrawToView::draw(GLFWwindow* window,
     glfwSwapBuffers(window);
 }
 
+
+// ----------------------------------------------------------------------------
+//  DrawOffscreen
+// ----------------------------------------------------------------------------
+DrawOffscreen::DrawOffscreen(const OffscreenBuffer& offscreen_buffer,
+                             unsigned int max_frames_in_flight) :
+    offscreen_buffer(offscreen_buffer),
+    fences(std::max(max_frames_in_flight, 1u), nullptr),
+    next_fence(0) {
+}
+
+
+void DrawOffscreen::draw(GLFWwindow* window,
+                         pipeline::Pipeline* p_pipeline,
+                         gui::GuiManager* gui_manager,
+                         state::View& view,
+                         const Clock& clock) const {
+  // Wait for the frame max_frames_in_flight frames ago, as a swap would
+  GLsync& fence = this->fences[this->next_fence];
+  this->next_fence = (this->next_fence + 1) % this->fences.size();
+  if (fence) {
+    GLenum wait_result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (wait_result == GL_TIMEOUT_EXPIRED) {
+      wait_result = glClientWaitSync(fence, 0, 1000000);  // 1 ms
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+  }
+
+  // update nTiled components
+  gui_manager->updateHeadless();
+
+  this->offscreen_buffer.bindForWriting();
+
+  // Clear colour buffer
+  glClearColor(0, 0, 0, 1);
+  glClearDepth(1.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+  // render nTiled components
+  p_pipeline->render();
+
+  fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glFlush();
+}
+
+
+void DrawOffscreen::finish() {
+  for (GLsync& fence : this->fences) {
+    if (fence) {
+      glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+}
+
 } // nTiled
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "main\FrameCapture.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+#include "lodepng.h"
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "util\ParallelFor.h"
+
+
+namespace nTiled {
+
+// ----------------------------------------------------------------------------
+//  Frame output
+// ----------------------------------------------------------------------------
+GLenum getCaptureReadFormat(state::CaptureFormat format) {
+  // targa stores pixels as BGRA, bottom row first, exactly as read back
+  return (format == state::CaptureFormat::TGA) ? GL_BGRA : GL_RGBA;
+}
+
+
+std::string getCaptureExtension(state::CaptureFormat format) {
+  return (format == state::CaptureFormat::TGA) ? ".tga" : ".png";
+}
+
+
+/*! @brief Write pixels as an uncompressed 32-bit targa image. */
+static bool writeTGA(const std::string& path,
+                     const std::vector<unsigned char>& pixels,
+                     unsigned int width,
+                     unsigned int height) {
+  unsigned char header[18] = { 0 };
+  header[2] = 2;                            // uncompressed true color
+  header[12] = width & 0xFF;
+  header[13] = (width >> 8) & 0xFF;
+  header[14] = height & 0xFF;
+  header[15] = (height >> 8) & 0xFF;
+  header[16] = 32;                          // bits per pixel
+  header[17] = 8;                           // alpha bits, bottom left origin
+
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  ofs.write(reinterpret_cast<const char*>(header), sizeof(header));
+  ofs.write(reinterpret_cast<const char*>(pixels.data()),
+            std::streamsize(pixels.size()));
+  return bool(ofs);
+}
+
+
+/*! @brief Write pixels, bottom row first, as a png image. */
+static bool writePNG(const std::string& path,
+                     const std::vector<unsigned char>& pixels,
+                     unsigned int width,
+                     unsigned int height,
+                     bool is_fast) {
+  // png stores the top row first
+  std::vector<unsigned char> image(pixels.size());
+  size_t row_size = 4 * size_t(width);
+  for (size_t y = 0; y < height; y++) {
+    std::memcpy(&image[row_size * y],
+                &pixels[row_size * (height - 1 - y)],
+                row_size);
+  }
+
+  lodepng::State state;
+  if (is_fast) {
+    // no filter search, no colour type search and a small lz77 window
+    state.encoder.auto_convert = 0;
+    state.encoder.filter_strategy = LFS_ZERO;
+    state.encoder.zlibsettings.windowsize = 256;
+    state.encoder.zlibsettings.lazymatching = 0;
+  }
+
+  std::vector<unsigned char> png;
+  unsigned error = lodepng::encode(png, image, width, height, state);
+  if (!error) error = lodepng::save_file(png, path);
+
+  if (error) {
+    std::cout << "encoder error " << error << ": " << lodepng_error_text(error) << std::endl;
+    return false;
+  }
+  return true;
+}
+
+
+bool writeFrame(const std::string& path,
+                const std::vector<unsigned char>& pixels,
+                unsigned int width,
+                unsigned int height,
+                state::CaptureFormat format) {
+  switch (format) {
+    case state::CaptureFormat::TGA:
+      return writeTGA(path, pixels, width, height);
+    case state::CaptureFormat::PNGFast:
+      return writePNG(path, pixels, width, height, true);
+    default:
+      return writePNG(path, pixels, width, height, false);
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+//  FrameCapture
+// ----------------------------------------------------------------------------
+FrameCapture::FrameCapture(glm::uvec2 viewport,
+                           state::CaptureFormat format,
+                           unsigned int n_buffers,
+                           unsigned int n_threads,
+                           unsigned int max_queue_depth) :
+    viewport(viewport),
+    format(format),
+    frame_size(GLsizeiptr(4) * viewport.x * viewport.y),
+    max_queue_depth(std::max(max_queue_depth, 1u)),
+    next_slot(0),
+    n_active_jobs(0),
+    is_stopping(false),
+    n_frames_written(0) {
+  // Construct pixel pack buffer ring
+  // --------------------------------------------------------------------------
+  this->slots.resize(std::max(n_buffers, 1u));
+  for (Slot& slot : this->slots) {
+    glGenBuffers(1, &(slot.pbo));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glBufferData(GL_PIXEL_PACK_BUFFER,
+                 this->frame_size,
+                 NULL,
+                 GL_STREAM_READ);
+    slot.fence = 0;
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  // Start worker threads
+  // --------------------------------------------------------------------------
+  if (n_threads == 0) n_threads = util::getDefaultNThreads();
+  for (unsigned int i = 0; i < n_threads; ++i) {
+    this->workers.push_back(std::thread(&FrameCapture::work, this));
+  }
+}
+
+
+FrameCapture::~FrameCapture() {
+  {
+    std::lock_guard<std::mutex> lock(this->queue_mutex);
+    this->is_stopping = true;
+  }
+  this->queue_filled.notify_all();
+  for (std::thread& worker : this->workers) {
+    worker.join();
+  }
+
+  for (Slot& slot : this->slots) {
+    if (slot.fence) {
+      glDeleteSync(slot.fence);
+    }
+    glDeleteBuffers(1, &(slot.pbo));
+  }
+}
+
+
+void FrameCapture::capture(const std::string& path) {
+  Slot& slot = this->slots[this->next_slot];
+  this->next_slot = (this->next_slot + 1) % this->slots.size();
+
+  // the frame previously read into this slot is n_buffers frames old
+  if (slot.fence) {
+    this->retire(slot);
+  }
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  glReadPixels(0, 0,
+               this->viewport.x, this->viewport.y,
+               getCaptureReadFormat(this->format), GL_UNSIGNED_BYTE,
+               0);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot.path = path;
+}
+
+
+void FrameCapture::retire(Slot& slot) {
+  // Wait until the read back is complete, usually already the case
+  // --------------------------------------------------------------------------
+  GLenum wait_result = glClientWaitSync(slot.fence,
+                                        GL_SYNC_FLUSH_COMMANDS_BIT,
+                                        0);
+  while (wait_result == GL_TIMEOUT_EXPIRED) {
+    wait_result = glClientWaitSync(slot.fence, 0, 1000000);  // 1 ms
+  }
+  glDeleteSync(slot.fence);
+  slot.fence = 0;
+
+  // Copy pixels out of the pixel pack buffer
+  // --------------------------------------------------------------------------
+  Job job;
+  job.path = std::move(slot.path);
+  job.pixels.resize(this->frame_size);
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+  void* p_data = glMapBufferRange(GL_PIXEL_PACK_BUFFER,
+                                  0,
+                                  this->frame_size,
+                                  GL_MAP_READ_BIT);
+  if (p_data) {
+    std::memcpy(job.pixels.data(), p_data, this->frame_size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  if (!p_data) {
+    std::cout << "Could not map frame " << job.path << std::endl;
+    return;
+  }
+
+  // Queue for the worker threads, waiting while the queue is full
+  // --------------------------------------------------------------------------
+  std::unique_lock<std::mutex> lock(this->queue_mutex);
+  this->queue_drained.wait(lock, [this]() {
+    return this->queue.size() < this->max_queue_depth;
+  });
+  this->queue.push_back(std::move(job));
+  lock.unlock();
+  this->queue_filled.notify_one();
+}
+
+
+void FrameCapture::flush() {
+  // Retire in capture order, starting at the oldest slot
+  for (unsigned int i = 0; i < this->slots.size(); ++i) {
+    Slot& slot = this->slots[(this->next_slot + i) % this->slots.size()];
+    if (slot.fence) {
+      this->retire(slot);
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(this->queue_mutex);
+  this->queue_drained.wait(lock, [this]() {
+    return this->queue.empty() && this->n_active_jobs == 0;
+  });
+}
+
+
+void FrameCapture::work() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(this->queue_mutex);
+      this->queue_filled.wait(lock, [this]() {
+        return !this->queue.empty() || this->is_stopping;
+      });
+      if (this->queue.empty()) return;
+
+      job = std::move(this->queue.front());
+      this->queue.pop_front();
+      this->n_active_jobs++;
+    }
+    this->queue_drained.notify_all();
+
+    if (writeFrame(job.path,
+                   job.pixels,
+                   this->viewport.x,
+                   this->viewport.y,
+                   this->format)) {
+      this->n_frames_written++;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->queue_mutex);
+      this->n_active_jobs--;
+    }
+    this->queue_drained.notify_all();
+  }
+}
+
+} // nTiled
@@ -0,0 +1,71 @@
+#include "main\OffscreenBuffer.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <stdexcept>
+#include <string>
+
+namespace nTiled {
+
+OffscreenBuffer::OffscreenBuffer(glm::uvec2 viewport) {
+  // Create FBO
+  // ------------------------------------------------------------------------
+  glGenFramebuffers(1, &(this->p_fbo));
+  glBindFramebuffer(GL_FRAMEBUFFER, this->p_fbo);
+
+  // Colour and depth attachments
+  // ------------------------------------------------------------------------
+  glGenRenderbuffers(1, &(this->p_colour_buffer));
+  glBindRenderbuffer(GL_RENDERBUFFER, this->p_colour_buffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, viewport.x, viewport.y);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER,
+                            GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER,
+                            this->p_colour_buffer);
+
+  glGenRenderbuffers(1, &(this->p_depth_buffer));
+  glBindRenderbuffer(GL_RENDERBUFFER, this->p_depth_buffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, viewport.x, viewport.y);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER,
+                            GL_DEPTH_ATTACHMENT,
+                            GL_RENDERBUFFER,
+                            this->p_depth_buffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glDrawBuffer(GL_COLOR_ATTACHMENT0);
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+  // Check if the frame buffer has been properly created.
+  GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  if (status != GL_FRAMEBUFFER_COMPLETE) {
+    glDeleteFramebuffers(1, &(this->p_fbo));
+    glDeleteRenderbuffers(1, &(this->p_colour_buffer));
+    glDeleteRenderbuffers(1, &(this->p_depth_buffer));
+    throw std::runtime_error("Offscreen framebuffer incomplete, status: " +
+                             std::to_string(status));
+  }
+}
+
+
+OffscreenBuffer::~OffscreenBuffer() {
+  glDeleteFramebuffers(1, &(this->p_fbo));
+  glDeleteRenderbuffers(1, &(this->p_colour_buffer));
+  glDeleteRenderbuffers(1, &(this->p_depth_buffer));
+}
+
+
+// ----------------------------------------------------------------------------
+//  Read / Write operation
+// ----------------------------------------------------------------------------
+void OffscreenBuffer::bindForWriting() const {
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->p_fbo);
+}
+
+void OffscreenBuffer::bindForReading() const {
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, this->p_fbo);
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+}
+
+} // nTiled
@@ -138,7 +138,7 @@ void DebugPipeline::render() {
   
   this->frame_pipeline->render();
 
-  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->output_buffer);
 
   // activate texture for render shader
   glActiveTexture(GL_TEXTURE0);
@@ -41,6 +41,8 @@ DeferredHashedShader::DeferredHashedShader(
                     path_geometry_pass_fragment_shader,
                     path_light_pass_vertex_shader,
                     path_light_pass_fragment_shader);
+  this->p_inv_camera_matrix = glGetUniformLocation(this->light_pass_sp,
+                                                   "inv_camera_matrix");
 
   this->loadObjects();
   this->loadLights();
@@ -52,7 +54,7 @@ DeferredHashedShader::DeferredHashedShader(
   this->initialiseGBuffer();
 
   glUseProgram(this->light_pass_sp);
-  this->p_light_manager->getLinklessOctree()->loadToShader(this->light_pass_sp);
+  this->p_light_manager->loadToShader(this->light_pass_sp);
   glUseProgram(0);
 }
 
@@ -68,9 +70,7 @@ void DeferredHashedShader::renderLightPass() {
   glUseProgram(this->light_pass_sp);
 
   glm::mat4 inv_camera_matrix = glm::inverse(view.camera.getLookAt());
-  GLint p_inv_camera = glGetUniformLocation(this->light_pass_sp,
-                                            "inv_camera_matrix");
-  glUniformMatrix4fv(p_inv_camera,
+  glUniformMatrix4fv(this->p_inv_camera_matrix,
                      1,
                      GL_FALSE,
                      glm::value_ptr(inv_camera_matrix));
@@ -119,7 +119,9 @@ void DeferredHashedShader::loadShaders(const std::string& path_geometry_vert_sha
     readShaderWithLightsAndOctreeMaps(
       path_light_frag_shader,
       this->world.p_lights.size(),
-      this->p_light_manager->getLinklessOctree()->getNLevels());
+      this->p_light_manager->getLinklessOctree()->getNLevels(),
+      this->p_light_manager->getTableLayout() == hashed::HashedTableLayout::Packed,
+      this->p_light_manager->hasPow2Tables());
 
   GLuint light_frag_shader = compileShader(GL_FRAGMENT_SHADER,
                                            light_frag_shader_buffer.str());
@@ -9,11 +9,13 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <map>
 
 // ----------------------------------------------------------------------------
 //  nTiled headers
 // ----------------------------------------------------------------------------
 #include "pipeline\shader-util\LoadShaders.h"
+#include "pipeline\pipeline-util\MeshBuffers.h"
 #include "pipeline\pipeline-util\ConstructQuad.h"
 
 namespace nTiled {
@@ -28,6 +30,7 @@ DeferredShader::DeferredShader(DeferredShaderId shader_id,
   view(view),
   gBuffer(GBuffer(view.viewport.x,
                   view.viewport.y)),
+  p_draw_submission(nullptr),
   p_output_buffer(p_output_buffer) {
 }
 
@@ -64,6 +67,7 @@ void DeferredShader::render() {
   // clear old contents gBuffer
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+  this->cullObjects();
   this->renderGeometryPass();
   glDisable(GL_DEPTH_TEST);
   //this->gBuffer.unbindForWriting();
@@ -80,70 +84,36 @@ void DeferredShader::render() {
 
 
 void DeferredShader::loadObjects() {
+  this->p_draw_submission = new DrawSubmission();
+
+  // objects sharing a mesh share its buffers, such that they can be batched
+  std::map<const world::Mesh*, MeshBuffers> mesh_buffers;
+  GLsizeiptr vertex_size = 0;
+
   for (world::Object* p_obj : this->world.p_objects) {
     if (p_obj->shader_key.deferred_id == this->getId()) {
-      // ----------------------------------------------------------------------
-      //  Construct new PipelineObject and construct the appropriate buffers
-      // ----------------------------------------------------------------------
-      // setup buffers
-      GLuint vbo_handles[4];
-      glGenBuffers(4, vbo_handles);
-      GLuint position_buffer = vbo_handles[0];
-      GLuint normal_buffer = vbo_handles[1];
-      GLuint uv_buffer = vbo_handles[2];
-      GLuint element_buffer = vbo_handles[3];
-      GLuint vao;
-
-      // setup vertex array object
-      glGenVertexArrays(1, &(vao));
-      glBindVertexArray(vao);
-      glEnableVertexAttribArray(0);
-      glEnableVertexAttribArray(1);
-      glEnableVertexAttribArray(2);
-      glEnableVertexAttribArray(3);
-
-      // set up position buffer
-      glBindBuffer(GL_ARRAY_BUFFER, position_buffer);
-      glBufferData(GL_ARRAY_BUFFER,
-                   p_obj->mesh.vertices.size() * sizeof(glm::vec4), //* 4 * sizeof(GLfloat),
-                   &(p_obj->mesh.vertices[0]),
-                   GL_STATIC_DRAW);
-      glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, NULL);
-
-      // set up normal buffer
-      glBindBuffer(GL_ARRAY_BUFFER, normal_buffer);
-      if ((*p_obj).mesh.normals.size() > 0) {
-        glBufferData(GL_ARRAY_BUFFER,
-                     p_obj->mesh.normals.size() * sizeof(glm::vec3), //* 4 * sizeof(GLfloat),
-                     &(p_obj->mesh.normals[0]),
-                     GL_STATIC_DRAW);
-      }
-      glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, NULL);
-
-      // set up uvw buffer  
-      glBindBuffer(GL_ARRAY_BUFFER, uv_buffer);
-      if ((*p_obj).mesh.uvs.size() > 0) {
-        glBufferData(GL_ARRAY_BUFFER,
-                     p_obj->mesh.uvs.size() * sizeof(glm::vec3), //* 4 * sizeof(GLfloat),
-                     &(p_obj->mesh.uvs[0]),
-                     GL_STATIC_DRAW);
+      auto it = mesh_buffers.find(&(p_obj->mesh));
+      if (it == mesh_buffers.end()) {
+        MeshBuffers buffers = constructMeshBuffers(p_obj->mesh,
+                                                   this->world.vertex_format);
+        vertex_size += buffers.vertex_size;
+        it = mesh_buffers.insert(std::make_pair(&(p_obj->mesh), buffers)).first;
       }
-      glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, NULL);
-
-      // set up element buffer
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                   p_obj->mesh.elements.size() * sizeof(glm::tvec3<glm::u32>), // * 3 * sizeof(GLuint),
-                   &(p_obj->mesh.elements[0]),
-                   GL_STATIC_DRAW);
-      glVertexAttribPointer(3, 3, GL_UNSIGNED_INT, GL_FALSE, 0, NULL);
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
       this->constructPipelineObject(*p_obj,
-                                    vao,
-                                    element_buffer);
+                                    it->second.vao,
+                                    it->second.element_buffer);
     }
   }
+
+  this->p_draw_submission->finalise();
+
+  if (!mesh_buffers.empty()) {
+    std::cout << "DeferredShader: " << mesh_buffers.size() << " meshes, "
+              << vertex_size << " bytes of "
+              << (this->world.vertex_format == VertexFormat::Packed ? "packed" : "separate")
+              << " vertex data" << std::endl;
+  }
 }
 
 void DeferredShader::constructPipelineObject(const world::Object& obj,
@@ -154,6 +124,9 @@ void DeferredShader::constructPipelineObject(const world::Object& obj,
                                                           obj.mesh.elements.size() * 3,
                                                           obj.transformation_matrix);
       this->ps_obj.push_back(p_pipeline_obj);
+      this->p_draw_submission->addObject(
+        p_pipeline_obj,
+        computeWorldBounds(obj.mesh, obj.transformation_matrix));
 }
 
 
@@ -270,40 +243,18 @@ void DeferredShader::initialiseLightPass() {
 }
 
 
+void DeferredShader::cullObjects() {
+  this->p_draw_submission->cull(this->view.camera.getPerspectiveMatrix() *
+                                this->view.camera.getLookAt());
+}
+
+
 void DeferredShader::renderGeometryPass() {
 
 }
 
 void DeferredShader::renderGeometryPassObjects() {
-  glm::mat4 lookAt = this->view.camera.getLookAt();
-  for (PipelineObject* obj : this->ps_obj) {
-    glBindVertexArray(obj->vao);
-
-    // retrieve memory locations shared per model
-    GLint p_model_to_camera = glGetUniformLocation(this->geometry_pass_sp,
-                                                   "model_to_camera");
-    glm::mat4 model_to_camera = lookAt * obj->transformation_matrix;
-    glUniformMatrix4fv(p_model_to_camera, 
-                       1, 
-                       GL_FALSE,
-                       glm::value_ptr(model_to_camera));
-
-    GLint p_normal_model_to_camera = 
-      glGetUniformLocation(this->geometry_pass_sp,
-                           "inv_transpose_model_to_camera");
-    glm::mat4 invTransModelToCamera = glm::inverseTranspose(model_to_camera);
-    glUniformMatrix4fv(p_normal_model_to_camera, 
-                       1, 
-                       GL_FALSE,
-                       glm::value_ptr(invTransModelToCamera));
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
-                 obj->element_buffer);
-    glDrawElements(GL_TRIANGLES,
-                   obj->n_elements,
-                   GL_UNSIGNED_INT, 
-                   0);
-  }
+  this->p_draw_submission->submit(this->view.camera.getLookAt());
 }
 
 void DeferredShader::renderLightPass() {
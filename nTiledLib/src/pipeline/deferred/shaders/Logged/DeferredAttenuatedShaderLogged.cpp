@@ -24,16 +24,37 @@ DeferredAttenuatedShaderLogged::DeferredAttenuatedShaderLogged(
   logger(logger) {
 }
 
+void DeferredAttenuatedShaderLogged::cullObjects() {
+  static const logged::ScopeId cull_objects_id =
+    logged::internScope("DeferredAttenuatedShader::cullObjects");
+  static const logged::ScopeId n_visible_objects_id =
+    logged::internScope("DeferredAttenuatedShader::n_visible_objects");
+  static const logged::ScopeId n_objects_id =
+    logged::internScope("DeferredAttenuatedShader::n_objects");
+  this->logger.startLog(cull_objects_id);
+  DeferredAttenuatedShader::cullObjects();
+  this->logger.endLog(cull_objects_id);
+
+  this->logger.logValue(n_visible_objects_id,
+                        this->p_draw_submission->getNVisibleObjects());
+  this->logger.logValue(n_objects_id,
+                        this->p_draw_submission->getNObjects());
+}
+
 void DeferredAttenuatedShaderLogged::renderGeometryPassObjects() {
-  this->logger.startLog(std::string("DeferredAttenuatedShader::renderGeometryPassObjects"));
+  static const logged::ScopeId render_geometry_pass_objects_id =
+    logged::internScope("DeferredAttenuatedShader::renderGeometryPassObjects");
+  this->logger.startStageLog(render_geometry_pass_objects_id);
   DeferredAttenuatedShader::renderGeometryPassObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_geometry_pass_objects_id);
 }
 
 void DeferredAttenuatedShaderLogged::renderLightPassObjects() {
-  this->logger.startLog(std::string("DeferredAttenuatedShader::renderLightPassObjects"));
+  static const logged::ScopeId render_light_pass_objects_id =
+    logged::internScope("DeferredAttenuatedShader::renderLightPassObjects");
+  this->logger.startStageLog(render_light_pass_objects_id);
   DeferredAttenuatedShader::renderLightPassObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_light_pass_objects_id);
 }
 
 }
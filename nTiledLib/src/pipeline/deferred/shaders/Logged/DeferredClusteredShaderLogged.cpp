@@ -29,22 +29,45 @@ DeferredClusteredShaderLogged::DeferredClusteredShaderLogged(
   logger(logger) {
 }
 
+void DeferredClusteredShaderLogged::cullObjects() {
+  static const logged::ScopeId cull_objects_id =
+    logged::internScope("DeferredClusteredShader::cullObjects");
+  static const logged::ScopeId n_visible_objects_id =
+    logged::internScope("DeferredClusteredShader::n_visible_objects");
+  static const logged::ScopeId n_objects_id =
+    logged::internScope("DeferredClusteredShader::n_objects");
+  this->logger.startLog(cull_objects_id);
+  DeferredClusteredShader::cullObjects();
+  this->logger.endLog(cull_objects_id);
+
+  this->logger.logValue(n_visible_objects_id,
+                        this->p_draw_submission->getNVisibleObjects());
+  this->logger.logValue(n_objects_id,
+                        this->p_draw_submission->getNObjects());
+}
+
 void DeferredClusteredShaderLogged::renderGeometryPassObjects() {
-  this->logger.startLog(std::string("DeferredClusteredShader::renderGeometryPassObjects"));
+  static const logged::ScopeId render_geometry_pass_objects_id =
+    logged::internScope("DeferredClusteredShader::renderGeometryPassObjects");
+  this->logger.startStageLog(render_geometry_pass_objects_id);
   DeferredClusteredShader::renderGeometryPassObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_geometry_pass_objects_id);
 }
 
 void DeferredClusteredShaderLogged::renderLightPassObjects() {
-  this->logger.startLog(std::string("DeferredClusteredShader::renderLightPassObjects"));
+  static const logged::ScopeId render_light_pass_objects_id =
+    logged::internScope("DeferredClusteredShader::renderLightPassObjects");
+  this->logger.startStageLog(render_light_pass_objects_id);
   DeferredClusteredShader::renderLightPassObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_light_pass_objects_id);
 }
 
 void DeferredClusteredShaderLogged::loadLightClustering() {
-  this->logger.startLog(std::string("DeferredClusteredShader::loadLightClustering"));
+  static const logged::ScopeId load_light_clustering_id =
+    logged::internScope("DeferredClusteredShader::loadLightClustering");
+  this->logger.startLog(load_light_clustering_id);
   DeferredClusteredShader::loadLightClustering();
-  this->logger.endLog();
+  this->logger.endLog(load_light_clustering_id);
 }
 
 }
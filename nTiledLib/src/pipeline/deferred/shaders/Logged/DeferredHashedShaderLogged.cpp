@@ -30,16 +30,37 @@ DeferredHashedShaderLogged::DeferredHashedShaderLogged(
 }
 
 
+void DeferredHashedShaderLogged::cullObjects() {
+  static const logged::ScopeId cull_objects_id =
+    logged::internScope("DeferredHashedShader::cullObjects");
+  static const logged::ScopeId n_visible_objects_id =
+    logged::internScope("DeferredHashedShader::n_visible_objects");
+  static const logged::ScopeId n_objects_id =
+    logged::internScope("DeferredHashedShader::n_objects");
+  this->logger.startLog(cull_objects_id);
+  DeferredHashedShader::cullObjects();
+  this->logger.endLog(cull_objects_id);
+
+  this->logger.logValue(n_visible_objects_id,
+                        this->p_draw_submission->getNVisibleObjects());
+  this->logger.logValue(n_objects_id,
+                        this->p_draw_submission->getNObjects());
+}
+
 void DeferredHashedShaderLogged::renderGeometryPassObjects() {
-  this->logger.startLog(std::string("DeferredHashedShader::renderGeometryPassObjects"));
+  static const logged::ScopeId render_geometry_pass_objects_id =
+    logged::internScope("DeferredHashedShader::renderGeometryPassObjects");
+  this->logger.startStageLog(render_geometry_pass_objects_id);
   DeferredHashedShader::renderGeometryPassObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_geometry_pass_objects_id);
 }
 
 void DeferredHashedShaderLogged::renderLightPassObjects() {
-  this->logger.startLog(std::string("DeferredHashedShader::renderLightPassObjects"));
+  static const logged::ScopeId render_light_pass_objects_id =
+    logged::internScope("DeferredHashedShader::renderLightPassObjects");
+  this->logger.startStageLog(render_light_pass_objects_id);
   DeferredHashedShader::renderLightPassObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_light_pass_objects_id);
 }
 
 
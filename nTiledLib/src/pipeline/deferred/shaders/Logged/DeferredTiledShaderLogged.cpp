@@ -29,22 +29,45 @@ DeferredTiledShaderLogged::DeferredTiledShaderLogged(
   logger(logger) { }
 
 
+void DeferredTiledShaderLogged::cullObjects() {
+  static const logged::ScopeId cull_objects_id =
+    logged::internScope("DeferredTiledShader::cullObjects");
+  static const logged::ScopeId n_visible_objects_id =
+    logged::internScope("DeferredTiledShader::n_visible_objects");
+  static const logged::ScopeId n_objects_id =
+    logged::internScope("DeferredTiledShader::n_objects");
+  this->logger.startLog(cull_objects_id);
+  DeferredTiledShader::cullObjects();
+  this->logger.endLog(cull_objects_id);
+
+  this->logger.logValue(n_visible_objects_id,
+                        this->p_draw_submission->getNVisibleObjects());
+  this->logger.logValue(n_objects_id,
+                        this->p_draw_submission->getNObjects());
+}
+
 void DeferredTiledShaderLogged::renderGeometryPassObjects() {
-  this->logger.startLog(std::string("DeferredTiledShader::renderGeometryPassObjects"));
+  static const logged::ScopeId render_geometry_pass_objects_id =
+    logged::internScope("DeferredTiledShader::renderGeometryPassObjects");
+  this->logger.startStageLog(render_geometry_pass_objects_id);
   DeferredTiledShader::renderGeometryPassObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_geometry_pass_objects_id);
 }
 
 void DeferredTiledShaderLogged::renderLightPassObjects() {
-  this->logger.startLog(std::string("DeferredTiledShader::renderLightPassObjects"));
+  static const logged::ScopeId render_light_pass_objects_id =
+    logged::internScope("DeferredTiledShader::renderLightPassObjects");
+  this->logger.startStageLog(render_light_pass_objects_id);
   DeferredTiledShader::renderLightPassObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_light_pass_objects_id);
 }
 
 void DeferredTiledShaderLogged::loadLightGrid() {
-  this->logger.startLog(std::string("DeferredTiledShader::loadLightGrid"));
+  static const logged::ScopeId load_light_grid_id =
+    logged::internScope("DeferredTiledShader::loadLightGrid");
+  this->logger.startLog(load_light_grid_id);
   DeferredTiledShader::loadLightGrid();
-  this->logger.endLog();
+  this->logger.endLog(load_light_grid_id);
 }
 
 } // pipeline
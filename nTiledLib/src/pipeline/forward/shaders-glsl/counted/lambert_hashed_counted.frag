@@ -2,6 +2,8 @@
 
 #define NUM_LIGHTS 3
 #define OCTREE_DEPTH 0
+#define PACKED_TABLES 0
+#define POW2_TABLES 0
 
 
 // Fragment Input Buffers
@@ -66,6 +68,32 @@ layout (std430, binding = 0) buffer LightIndexBuffer {
 };
 
 
+#if PACKED_TABLES
+// packed tables linkless octree
+/*! @brief The octree tables of all levels, two entries per uint. */
+layout (std430, binding = 3) readonly buffer OctreeTableBuffer {
+  uint octree_tables[];
+};
+
+/*! @brief The light tables of all levels. */
+layout (std430, binding = 4) readonly buffer LightTableBuffer {
+  uvec2 light_tables[];
+};
+
+/*! @brief The offset tables of all levels, in the lower three bytes of a
+ *         uint if m of its table is at most 256, and as 16 bits per
+ *         dimension in two uints otherwise.
+ */
+layout (std430, binding = 5) readonly buffer OffsetTableBuffer {
+  uint offset_tables[];
+};
+
+/*! @brief Per level the first entry and dimension m of its table, followed
+ *         by the first entry and dimension r of its offset table.
+ */
+uniform uvec4 octree_table_layouts[OCTREE_DEPTH];
+uniform uvec4 light_table_layouts[OCTREE_DEPTH];
+#else
 // octree structure linkless octree
 uniform usampler3D octree_offset_tables[OCTREE_DEPTH];
 uniform usampler3D octree_data_tables[OCTREE_DEPTH];
@@ -74,11 +102,18 @@ uniform usampler3D octree_data_tables[OCTREE_DEPTH];
 // data linkless octree
 uniform usampler3D light_offset_tables[OCTREE_DEPTH];
 uniform usampler3D light_data_tables[OCTREE_DEPTH];
+#endif
 
 
 uniform float node_size_den;
 uniform float octree_width;
 
+/*! @brief Bit i is set if the octree respectively light table of level i
+ *         is a dense grid instead of a spatial hash function.
+ */
+uniform uint octree_dense_levels;
+uniform uint light_dense_levels;
+
 
 /*! @brief Obtain the data associated at the specified coordinate from the 
  *         specified spatial hash function.
@@ -86,21 +121,96 @@ uniform float octree_width;
  * @param coord The coordinate to be retrieved from the spatial hash function
  * @param offset_table The offset table of the spatial hash function
  * @param hash_table The hash table of the spatial hash function
+ * @param is_dense Whether the spatial hash function is a dense grid, which
+ *                 is accessed without its offset table
  *
  * @returns the data associated with the specified coordinate from the 
  *          the specified spatial hash function.
  */
 uvec2 obtainNodeFromSpatialHashFunction(ivec3 coord, 
                                         usampler3D offset_table, 
-                                        usampler3D hash_table) {
+                                        usampler3D hash_table,
+                                        bool is_dense) {
+  if (is_dense) {
+    return texelFetch(hash_table, coord, 0).rg;
+  }
+
   ivec3 h_offset_mod = ivec3(mod(coord, textureSize(offset_table, 0).x));
   ivec3 offset = ivec3(texelFetch(offset_table, h_offset_mod, 0).rgb);
 
+#if POW2_TABLES
+  ivec3 h_coord_mod = (coord + offset) & (textureSize(hash_table, 0).x - 1);
+#else
   ivec3 h_coord_mod = ivec3(mod((coord + offset), textureSize(hash_table, 0).x));
+#endif
   uvec2 node = texelFetch(hash_table, h_coord_mod, 0).rg;
   return node;
 }
 
+#if PACKED_TABLES
+/*! @brief Obtain the index of the entry associated with the specified 
+ *         coordinate in the packed table with the specified layout.
+ *
+ * @param coord The coordinate to be retrieved from the packed table
+ * @param table_layout The first entry and dimension of the table, followed
+ *                     by the first entry and dimension of its offset table
+ * @param is_dense Whether the packed table is a dense grid, which is 
+ *                 accessed without its offset table
+ *
+ * @returns the index of the entry associated with the specified coordinate.
+ */
+uint obtainIndexFromPackedTable(ivec3 coord,
+                                uvec4 table_layout,
+                                bool is_dense) {
+  uvec3 h = uvec3(coord);
+
+  if (!is_dense) {
+    uvec3 h_offset = h % table_layout.w;
+    uint offset_i = h_offset.x + table_layout.w * (h_offset.y + table_layout.w * h_offset.z);
+
+    uvec3 offset;
+    if (table_layout.y > 256) {
+      uint offset_xy = offset_tables[table_layout.z + 2 * offset_i];
+      offset = uvec3(offset_xy & 0xFFFF, 
+                     offset_xy >> 16, 
+                     offset_tables[table_layout.z + 2 * offset_i + 1]);
+    } else {
+      uint offset_xyz = offset_tables[table_layout.z + offset_i];
+      offset = uvec3(offset_xyz & 0xFF, (offset_xyz >> 8) & 0xFF, (offset_xyz >> 16) & 0xFF);
+    }
+#if POW2_TABLES
+    h = (h + offset) & (table_layout.y - 1);
+#else
+    h = (h + offset) % table_layout.y;
+#endif
+  }
+
+  return table_layout.x + h.x + table_layout.y * (h.y + table_layout.y * h.z);
+}
+
+
+/*! @brief Obtain the octree data associated at the specified coordinate 
+ *         from the packed octree table with the specified layout.
+ */
+uvec2 obtainNodeFromPackedOctreeTable(ivec3 coord,
+                                      uvec4 table_layout,
+                                      bool is_dense) {
+  uint i = obtainIndexFromPackedTable(coord, table_layout, is_dense);
+  uint entry = (octree_tables[i >> 1] >> ((i & 1) * 16)) & 0xFFFF;
+  return uvec2(entry & 0xFF, entry >> 8);
+}
+
+
+/*! @brief Obtain the light data associated at the specified coordinate 
+ *         from the packed light table with the specified layout.
+ */
+uvec2 obtainNodeFromPackedLightTable(ivec3 coord,
+                                     uvec4 table_layout,
+                                     bool is_dense) {
+  return light_tables[obtainIndexFromPackedTable(coord, table_layout, is_dense)];
+}
+#endif
+
 
 /*! @brief Extract the kth bit from val 
  * 
@@ -150,15 +260,29 @@ void main() {
       index_dif = octree_coord_next - (octree_coord_cur * 2);
       index_int = index_dif.x + index_dif.y * 2 + index_dif.z * 4;
 
+#if PACKED_TABLES
+      octree_data = obtainNodeFromPackedOctreeTable(octree_coord_cur,
+                                                    octree_table_layouts[layer_i],
+                                                    extractBit(octree_dense_levels, layer_i));
+#else
       octree_data = obtainNodeFromSpatialHashFunction(octree_coord_cur,
                                                       octree_offset_tables[layer_i],
-                                                      octree_data_tables[layer_i]);
+                                                      octree_data_tables[layer_i],
+                                                      extractBit(octree_dense_levels, layer_i));
+#endif
       
       if(extractBit(octree_data.x, index_int)) {
         if(extractBit(octree_data.y, index_int)) {
+#if PACKED_TABLES
+          light_data = obtainNodeFromPackedLightTable(octree_coord_next,
+                                                      light_table_layouts[layer_i],
+                                                      extractBit(light_dense_levels, layer_i));
+#else
           light_data = obtainNodeFromSpatialHashFunction(octree_coord_next,
                                                          light_offset_tables[layer_i],
-                                                         light_data_tables[layer_i]);
+                                                         light_data_tables[layer_i],
+                                                         extractBit(light_dense_levels, layer_i));
+#endif
         }
         break;
       }
@@ -5,6 +5,7 @@
 layout (location=0) in vec4 vertex_position;
 layout (location=1) in vec3 vertex_normal;
 layout (location=2) in vec3 vertex_uv;
+layout (location=3) in uint object_index;
 
 // Vertex Output Buffers
 // -----------------------------------------------------------------------------
@@ -15,13 +16,27 @@ out vec3 fragment_normal;
 // -----------------------------------------------------------------------------
 // Camera Definition
 uniform mat4 camera_to_clip;
-uniform mat4 model_to_camera;
-uniform mat4 inv_transpose_model_to_camera;
+
+// Object Definition
+/*! @brief Matrices of a single object, indexed with object_index. */
+struct ObjectMatrices {
+  mat4 model_to_camera;
+  mat4 inv_transpose_model_to_camera;
+  mat4 model_to_world;
+};
+
+layout (std430, binding = 7) readonly buffer ObjectMatrixBuffer {
+  ObjectMatrices object_matrices[];
+};
 
 // -----------------------------------------------------------------------------
 //  Main
 // -----------------------------------------------------------------------------
 void main() {
+    mat4 model_to_camera = object_matrices[object_index].model_to_camera;
+    mat4 inv_transpose_model_to_camera = 
+      object_matrices[object_index].inv_transpose_model_to_camera;
+
     // Calculate camera position
     vec4 vertex_camera_position = model_to_camera * vertex_position;
     gl_Position = camera_to_clip * vertex_camera_position;
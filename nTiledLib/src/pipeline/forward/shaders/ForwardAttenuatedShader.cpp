@@ -19,6 +19,8 @@ ForwardAttenuatedShader::ForwardAttenuatedShader(
 void ForwardAttenuatedShader::render() {
   //glBindFramebuffer(GL_DRAW_FRAMEBUFFER, this->p_output_buffer);
 
+  this->cullObjects();
+
   glUseProgram(this->shader);
   // render objects
   this->renderObjects();
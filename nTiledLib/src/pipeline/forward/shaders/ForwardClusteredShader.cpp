@@ -141,6 +141,8 @@ ForwardClusteredShader::ForwardClusteredShader(
 }
 
 void ForwardClusteredShader::render() {
+  // the visible objects are shared by the depth pass and the shading pass
+  this->cullObjects();
   this->depthPass();
   this->p_clustered_light_manager->constructClusteringFrame();
 
@@ -174,31 +176,7 @@ void ForwardClusteredShader::depthPass() {
 
   // Render depth to texture FBO
   // ---------------------------
-  glm::mat4 lookAt = this->view.camera.getLookAt();
-  GLint p_modelToCamera = glGetUniformLocation(this->shader,
-                                               "model_to_camera");
-
-  for (PipelineObject* p_obj : this->ps_obj) {
-    // Update model to camera
-    // ----------------------
-    glm::mat4 model_to_camera = lookAt * p_obj->transformation_matrix;
-
-    glUniformMatrix4fv(p_modelToCamera,
-                       1,
-                       GL_FALSE,
-                       glm::value_ptr(model_to_camera));
-
-    // Render object
-    // -------------
-    glBindVertexArray(p_obj->vao);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
-                 p_obj->element_buffer);
-    glDrawElements(GL_TRIANGLES,
-                   p_obj->n_elements,
-                   GL_UNSIGNED_INT,
-                   0);
-  }
-  glBindVertexArray(0);
+  this->p_draw_submission->submit(this->view.camera.getLookAt());
   glUseProgram(0);
 
   // Set openGL flags for further execution
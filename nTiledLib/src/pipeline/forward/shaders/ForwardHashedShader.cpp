@@ -46,7 +46,7 @@ ForwardHashedShader::ForwardHashedShader(
                      GL_FALSE,
                      glm::value_ptr(perspective_matrix));
 
-  this->p_light_manager->getLinklessOctree()->loadToShader(this->shader);
+  this->p_light_manager->loadToShader(this->shader);
 
   glUseProgram(0);
   glEnable(GL_DEPTH_TEST);  //TODO: check if this is right place
@@ -66,7 +66,9 @@ void ForwardHashedShader::loadShaders(const std::string& path_vert_shader,
   std::stringstream frag_shader_buffer = 
     readShaderWithLightsAndOctreeMaps(path_frag_shader,
                                       this->world.p_lights.size(),
-                                      this->p_light_manager->getLinklessOctree()->getNLevels());
+                                      this->p_light_manager->getLinklessOctree()->getNLevels(),
+                                      this->p_light_manager->getTableLayout() == hashed::HashedTableLayout::Packed,
+                                      this->p_light_manager->hasPow2Tables());
 
   GLuint frag_shader = compileShader(GL_FRAGMENT_SHADER,
                                      frag_shader_buffer.str());
@@ -75,23 +77,12 @@ void ForwardHashedShader::loadShaders(const std::string& path_vert_shader,
 
 
 void ForwardHashedShader::render() {
+  this->cullObjects();
   glUseProgram(this->shader);
   this->renderObjects();
   glUseProgram(0);
 }
 
 
-void ForwardHashedShader::preObjectRendering(PipelineObject* p_obj) {
-  GLint p_model_to_world = 
-    glGetUniformLocation(this->shader, "model_to_world");
-
-  glm::mat4 model_to_world = p_obj->transformation_matrix;
-  glUniformMatrix4fv(p_model_to_world,
-                     1,
-                     GL_FALSE,
-                     glm::value_ptr(model_to_world));
-}
-
-
 }
 }
\ No newline at end of file
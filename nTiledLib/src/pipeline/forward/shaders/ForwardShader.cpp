@@ -4,16 +4,16 @@
 //  Libraries
 // ----------------------------------------------------------------------------
 #include <glm/gtc/type_ptr.hpp>
-#include <glm/gtc/matrix_inverse.hpp>
-
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <map>
 
 // ----------------------------------------------------------------------------
 //  nTiled headers
 // ----------------------------------------------------------------------------
 #include "pipeline\shader-util\LoadShaders.h"
+#include "pipeline\pipeline-util\MeshBuffers.h"
 
 
 namespace nTiled {
@@ -26,6 +26,7 @@ ForwardShader::ForwardShader(ForwardShaderId shader_id,
     id(shader_id),
     world(world),
     view(view),
+    p_draw_submission(nullptr),
     p_output_buffer(p_output_buffer) { }
 
 ForwardShader::ForwardShader(ForwardShaderId shader_id,
@@ -64,70 +65,36 @@ void ForwardShader::render() {
 }
 
 void ForwardShader::loadObjects() {
+  this->p_draw_submission = new DrawSubmission();
+
+  // objects sharing a mesh share its buffers, such that they can be batched
+  std::map<const world::Mesh*, MeshBuffers> mesh_buffers;
+  GLsizeiptr vertex_size = 0;
+
   for (world::Object* p_obj : this->world.p_objects) {
     if (p_obj->shader_key.forward_id == this->getId()) {
-      // ----------------------------------------------------------------------
-      //  Construct new PipelineObject and construct the appropriate buffers
-      // ----------------------------------------------------------------------
-      // setup buffers
-      GLuint vbo_handles[4];
-      glGenBuffers(4, vbo_handles);
-      GLuint position_buffer = vbo_handles[0];
-      GLuint normal_buffer = vbo_handles[1];
-      GLuint uv_buffer = vbo_handles[2];
-      GLuint element_buffer = vbo_handles[3];
-      GLuint vao;
-
-      // setup vertex array object
-      glGenVertexArrays(1, &(vao));
-      glBindVertexArray(vao);
-      glEnableVertexAttribArray(0);
-      glEnableVertexAttribArray(1);
-      glEnableVertexAttribArray(2);
-      glEnableVertexAttribArray(3);
-
-      // set up position buffer
-      glBindBuffer(GL_ARRAY_BUFFER, position_buffer);
-      glBufferData(GL_ARRAY_BUFFER,
-                   p_obj->mesh.vertices.size() * sizeof(glm::vec4), //* 4 * sizeof(GLfloat),
-                   &(p_obj->mesh.vertices[0]),
-                   GL_STATIC_DRAW);
-      glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, NULL);
-
-      // set up normal buffer
-      glBindBuffer(GL_ARRAY_BUFFER, normal_buffer);
-      if ((*p_obj).mesh.normals.size() > 0) {
-        glBufferData(GL_ARRAY_BUFFER,
-                     p_obj->mesh.normals.size() * sizeof(glm::vec3), //* 4 * sizeof(GLfloat),
-                     &(p_obj->mesh.normals[0]),
-                     GL_STATIC_DRAW);
+      auto it = mesh_buffers.find(&(p_obj->mesh));
+      if (it == mesh_buffers.end()) {
+        MeshBuffers buffers = constructMeshBuffers(p_obj->mesh,
+                                                   this->world.vertex_format);
+        vertex_size += buffers.vertex_size;
+        it = mesh_buffers.insert(std::make_pair(&(p_obj->mesh), buffers)).first;
       }
-      glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, NULL);
-
-      // set up uvw buffer  
-      glBindBuffer(GL_ARRAY_BUFFER, uv_buffer);
-      if ((*p_obj).mesh.uvs.size() > 0) {
-        glBufferData(GL_ARRAY_BUFFER,
-                     p_obj->mesh.uvs.size() * sizeof(glm::vec3), //* 4 * sizeof(GLfloat),
-                     &(p_obj->mesh.uvs[0]),
-                     GL_STATIC_DRAW);
-      }
-      glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, NULL);
-
-      // set up element buffer
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                   p_obj->mesh.elements.size() * sizeof(glm::tvec3<glm::u32>), // * 3 * sizeof(GLuint),
-                   &(p_obj->mesh.elements[0]),
-                   GL_STATIC_DRAW);
-      glVertexAttribPointer(3, 3, GL_UNSIGNED_INT, GL_FALSE, 0, NULL);
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
       this->constructPipelineObject(*p_obj,
-                                    vao,
-                                    element_buffer);
+                                    it->second.vao,
+                                    it->second.element_buffer);
     }
   }
+
+  this->p_draw_submission->finalise();
+
+  if (!mesh_buffers.empty()) {
+    std::cout << "ForwardShader: " << mesh_buffers.size() << " meshes, "
+              << vertex_size << " bytes of "
+              << (this->world.vertex_format == VertexFormat::Packed ? "packed" : "separate")
+              << " vertex data" << std::endl;
+  }
 }
 
 void ForwardShader::constructPipelineObject(const world::Object& obj,
@@ -138,6 +105,9 @@ void ForwardShader::constructPipelineObject(const world::Object& obj,
                                                           obj.mesh.elements.size() * 3,
                                                           obj.transformation_matrix);
       this->ps_obj.push_back(p_pipeline_obj);
+      this->p_draw_submission->addObject(
+        p_pipeline_obj,
+        computeWorldBounds(obj.mesh, obj.transformation_matrix));
 }
 
 void ForwardShader::loadLights() {
@@ -185,6 +155,11 @@ void ForwardShader::constructPipelineLight(const world::PointLight& light) {
     this->lights.push_back(data);
 }
 
+void ForwardShader::cullObjects() {
+  this->p_draw_submission->cull(this->view.camera.getPerspectiveMatrix() *
+                                this->view.camera.getLookAt());
+}
+
 void ForwardShader::renderObjects() {
   glm::mat4 lookAt = this->view.camera.getLookAt();
 
@@ -206,42 +181,7 @@ void ForwardShader::renderObjects() {
 
   // Render objects
   // --------------------------
-  GLint p_modelToCamera = 
-    glGetUniformLocation(this->shader, "model_to_camera");
-  GLint p_inv_transpose_model_to_camera =
-    glGetUniformLocation(this->shader, "inv_transpose_model_to_camera");
-
-  for (PipelineObject* p_obj : this->ps_obj) {
-    //  pre object rendering
-    // ---------------------
-    this->preObjectRendering(p_obj);
-
-    // Update model to camera
-    // ----------------------
-    glm::mat4 model_to_camera = lookAt * p_obj->transformation_matrix;
-    glUniformMatrix4fv(p_modelToCamera,
-                       1,
-                       GL_FALSE,
-                       glm::value_ptr(model_to_camera));
-
-    glm::mat4 inv_transpose_model_to_camera = glm::inverseTranspose(model_to_camera);
-    glUniformMatrix4fv(p_inv_transpose_model_to_camera, 
-                       1, 
-                       GL_FALSE,
-                       glm::value_ptr(inv_transpose_model_to_camera));
-
-
-    // Render object
-    // -------------
-    glBindVertexArray(p_obj->vao);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
-                 p_obj->element_buffer);
-    glDrawElements(GL_TRIANGLES,
-                   p_obj->n_elements,
-                   GL_UNSIGNED_INT,
-                   0);
-  }
-  glBindVertexArray(0);
+  this->p_draw_submission->submit(lookAt);
 }
 
 void ForwardShader::loadShaders(const std::string& path_vert_shader,
@@ -79,6 +79,7 @@ ForwardTiledShader::ForwardTiledShader(ForwardShaderId shader_id,
 
 
 void ForwardTiledShader::render() {
+  this->cullObjects();
   glUseProgram(this->shader);
   this->p_light_manager->constructGridFrame();
   this->loadLightGrid();
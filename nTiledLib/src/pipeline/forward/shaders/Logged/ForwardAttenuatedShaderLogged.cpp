@@ -19,10 +19,29 @@ ForwardAttenuatedShaderLogged::ForwardAttenuatedShaderLogged(
                           p_output_buffer),
   logger(logger) { }
 
+void ForwardAttenuatedShaderLogged::cullObjects() {
+  static const logged::ScopeId cull_objects_id =
+    logged::internScope("ForwardAttenuatedShader::cullObjects");
+  static const logged::ScopeId n_visible_objects_id =
+    logged::internScope("ForwardAttenuatedShader::n_visible_objects");
+  static const logged::ScopeId n_objects_id =
+    logged::internScope("ForwardAttenuatedShader::n_objects");
+  this->logger.startLog(cull_objects_id);
+  ForwardAttenuatedShader::cullObjects();
+  this->logger.endLog(cull_objects_id);
+
+  this->logger.logValue(n_visible_objects_id,
+                        this->p_draw_submission->getNVisibleObjects());
+  this->logger.logValue(n_objects_id,
+                        this->p_draw_submission->getNObjects());
+}
+
 void ForwardAttenuatedShaderLogged::renderObjects() {
-  this->logger.startLog(std::string("ForwardAttenuatedShader::renderObjects"));
+  static const logged::ScopeId render_objects_id =
+    logged::internScope("ForwardAttenuatedShader::renderObjects");
+  this->logger.startStageLog(render_objects_id);
   ForwardAttenuatedShader::renderObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_objects_id);
 }
 
 
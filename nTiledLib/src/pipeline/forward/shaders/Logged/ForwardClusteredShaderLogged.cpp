@@ -23,22 +23,45 @@ ForwardClusteredShaderLogged::ForwardClusteredShaderLogged(
   logger(logger) {
 }
 
+void ForwardClusteredShaderLogged::cullObjects() {
+  static const logged::ScopeId cull_objects_id =
+    logged::internScope("ForwardClusteredShader::cullObjects");
+  static const logged::ScopeId n_visible_objects_id =
+    logged::internScope("ForwardClusteredShader::n_visible_objects");
+  static const logged::ScopeId n_objects_id =
+    logged::internScope("ForwardClusteredShader::n_objects");
+  this->logger.startLog(cull_objects_id);
+  ForwardClusteredShader::cullObjects();
+  this->logger.endLog(cull_objects_id);
+
+  this->logger.logValue(n_visible_objects_id,
+                        this->p_draw_submission->getNVisibleObjects());
+  this->logger.logValue(n_objects_id,
+                        this->p_draw_submission->getNObjects());
+}
+
 void ForwardClusteredShaderLogged::renderObjects() {
-  this->logger.startLog(std::string("ForwardClusteredShader::renderObjects"));
+  static const logged::ScopeId render_objects_id =
+    logged::internScope("ForwardClusteredShader::renderObjects");
+  this->logger.startStageLog(render_objects_id);
   ForwardClusteredShader::renderObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_objects_id);
 }
 
 void ForwardClusteredShaderLogged::depthPass() {
-  this->logger.startLog(std::string("ForwardClusteredShader::depthPass"));
+  static const logged::ScopeId depth_pass_id =
+    logged::internScope("ForwardClusteredShader::depthPass");
+  this->logger.startStageLog(depth_pass_id);
   ForwardClusteredShader::depthPass();
-  this->logger.endLog();
+  this->logger.endStageLog(depth_pass_id);
 }
 
 void ForwardClusteredShaderLogged::loadLightClustering() {
-  this->logger.startLog(std::string("ForwardClusteredShader::loadLightClustering"));
+  static const logged::ScopeId load_light_clustering_id =
+    logged::internScope("ForwardClusteredShader::loadLightClustering");
+  this->logger.startLog(load_light_clustering_id);
   ForwardClusteredShader::loadLightClustering();
-  this->logger.endLog();
+  this->logger.endLog(load_light_clustering_id);
 }
 
 }
@@ -26,10 +26,29 @@ ForwardHashedShaderLogged::ForwardHashedShaderLogged(
 }
 
 
+void ForwardHashedShaderLogged::cullObjects() {
+  static const logged::ScopeId cull_objects_id =
+    logged::internScope("ForwardHashedShader::cullObjects");
+  static const logged::ScopeId n_visible_objects_id =
+    logged::internScope("ForwardHashedShader::n_visible_objects");
+  static const logged::ScopeId n_objects_id =
+    logged::internScope("ForwardHashedShader::n_objects");
+  this->logger.startLog(cull_objects_id);
+  ForwardHashedShader::cullObjects();
+  this->logger.endLog(cull_objects_id);
+
+  this->logger.logValue(n_visible_objects_id,
+                        this->p_draw_submission->getNVisibleObjects());
+  this->logger.logValue(n_objects_id,
+                        this->p_draw_submission->getNObjects());
+}
+
 void ForwardHashedShaderLogged::renderObjects() {
-  this->logger.startLog(std::string("ForwardHashedShader::renderObjects"));
+  static const logged::ScopeId render_objects_id =
+    logged::internScope("ForwardHashedShader::renderObjects");
+  this->logger.startStageLog(render_objects_id);
   ForwardHashedShader::renderObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_objects_id);
 }
 
 
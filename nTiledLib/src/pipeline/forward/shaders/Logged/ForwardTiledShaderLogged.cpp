@@ -26,16 +26,37 @@ ForwardTiledShaderLogged::ForwardTiledShaderLogged(
   logger(logger) {
 }
 
+void ForwardTiledShaderLogged::cullObjects() {
+  static const logged::ScopeId cull_objects_id =
+    logged::internScope("ForwardTiledShader::cullObjects");
+  static const logged::ScopeId n_visible_objects_id =
+    logged::internScope("ForwardTiledShader::n_visible_objects");
+  static const logged::ScopeId n_objects_id =
+    logged::internScope("ForwardTiledShader::n_objects");
+  this->logger.startLog(cull_objects_id);
+  ForwardTiledShader::cullObjects();
+  this->logger.endLog(cull_objects_id);
+
+  this->logger.logValue(n_visible_objects_id,
+                        this->p_draw_submission->getNVisibleObjects());
+  this->logger.logValue(n_objects_id,
+                        this->p_draw_submission->getNObjects());
+}
+
 void ForwardTiledShaderLogged::renderObjects() {
-  this->logger.startLog(std::string("ForwardTiledShader::renderObjects"));
+  static const logged::ScopeId render_objects_id =
+    logged::internScope("ForwardTiledShader::renderObjects");
+  this->logger.startStageLog(render_objects_id);
   ForwardTiledShader::renderObjects();
-  this->logger.endLog();
+  this->logger.endStageLog(render_objects_id);
 }
 
 void ForwardTiledShaderLogged::loadLightGrid() {
-  this->logger.startLog(std::string("ForwardTiledShader::loadLightGrid"));
+  static const logged::ScopeId load_light_grid_id =
+    logged::internScope("ForwardTiledShader::loadLightGrid");
+  this->logger.startLog(load_light_grid_id);
   ForwardTiledShader::loadLightGrid();
-  this->logger.endLog();
+  this->logger.endLog(load_light_grid_id);
 }
 
 } // pipeline
@@ -19,33 +19,43 @@ ClusteredLightManagerLogged::ClusteredLightManagerLogged(
 
 
 void ClusteredLightManagerLogged::computeKeys() {
-  this->logger.startLog(std::string("ClusteredLightManager::computeKeys"));
+  static const logged::ScopeId compute_keys_id =
+    logged::internScope("ClusteredLightManager::computeKeys");
+  this->logger.startStageLog(compute_keys_id);
   ClusteredLightManager::computeKeys();
-  this->logger.endLog();
+  this->logger.endStageLog(compute_keys_id);
 }
 
 void ClusteredLightManagerLogged::sortAndCompactKeys() {
-  this->logger.startLog(std::string("ClusteredLightManager::sortAndCompactKeys"));
+  static const logged::ScopeId sort_and_compact_keys_id =
+    logged::internScope("ClusteredLightManager::sortAndCompactKeys");
+  this->logger.startStageLog(sort_and_compact_keys_id);
   ClusteredLightManager::sortAndCompactKeys();
-  this->logger.endLog();
+  this->logger.endStageLog(sort_and_compact_keys_id);
 }
 
 void ClusteredLightManagerLogged::clearClustering() {
-  this->logger.startLog(std::string("ClusteredLightManager::clearClustering"));
+  static const logged::ScopeId clear_clustering_id =
+    logged::internScope("ClusteredLightManager::clearClustering");
+  this->logger.startLog(clear_clustering_id);
   ClusteredLightManager::clearClustering();
-  this->logger.endLog();
+  this->logger.endLog(clear_clustering_id);
 }
 
 void ClusteredLightManagerLogged::buildClustering() {
-  this->logger.startLog(std::string("ClusteredLightManager::buildClustering"));
+  static const logged::ScopeId build_clustering_id =
+    logged::internScope("ClusteredLightManager::buildClustering");
+  this->logger.startLog(build_clustering_id);
   ClusteredLightManager::buildClustering();
-  this->logger.endLog();
+  this->logger.endLog(build_clustering_id);
 }
 
 void ClusteredLightManagerLogged::finaliseClustering() {
-  this->logger.startLog(std::string("ClusteredLightManager::finaliseClustering"));
+  static const logged::ScopeId finalise_clustering_id =
+    logged::internScope("ClusteredLightManager::finaliseClustering");
+  this->logger.startLog(finalise_clustering_id);
   ClusteredLightManager::finaliseClustering();
-  this->logger.endLog();
+  this->logger.endLog(finalise_clustering_id);
 }
 
 
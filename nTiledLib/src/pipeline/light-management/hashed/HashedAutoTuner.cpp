@@ -0,0 +1,504 @@
+#include "pipeline\light-management\hashed\HashedAutoTuner.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "pipeline\light-management\hashed\Exceptions.h"
+#include "pipeline\light-management\hashed\linkless-octree\MortonOctreeBuilder.h"
+#include "pipeline\light-management\hashed\linkless-octree\SpatialHashFunctionBuilder.h"
+#include "pipeline\light-management\hashed\linkless-octree\DisplacementHashFunctionBuilder.h"
+#include "math\points.h"
+#include "math\octree.h"
+
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+/*! @brief Number of candidate node sizes, each half the previous one. */
+static const unsigned int n_node_sizes = 5;
+
+/*! @brief Quantile of the light radii from which the node sizes are derived,
+ *         such that a few tiny lights do not dictate the node size.
+ */
+static const double radius_quantile = 0.1;
+
+/*! @brief The candidate r increase ratios, from fewest to smallest retries. */
+static const double r_increase_ratios[] = { 1.5, 1.25, 1.1 };
+
+
+/*! @brief LevelEntries holds the number of entries of every level of a 
+ *         LinklessOctree.
+ */
+struct LevelEntries {
+  /*! @brief Number of entries of the octree table of every level. */
+  std::vector<double> n_octree_entries;
+  /*! @brief Number of entries of the data table of every level. */
+  std::vector<double> n_data_entries;
+  /*! @brief Number of light indices of all levels. */
+  double n_light_indices;
+};
+
+
+/*! @brief LevelCounts holds the number of nodes of every level of the 
+ *         LightOctree, from which the LevelEntries of every starting depth
+ *         follow.
+ */
+struct LevelCounts {
+  /*! @brief Number of branch nodes of every level. */
+  std::vector<double> n_branches;
+  /*! @brief Number of leaf nodes with lights of every level of which the 
+   *         parent is a branch node.
+   */
+  std::vector<double> n_branch_leaves;
+  /*! @brief Number of lights of the leaf nodes of n_branch_leaves. */
+  std::vector<double> n_branch_leaf_lights;
+  /*! @brief Number of leaf nodes with lights of every level. */
+  std::vector<double> n_leaves;
+  /*! @brief Number of lights of the leaf nodes of n_leaves. */
+  std::vector<double> n_leaf_lights;
+};
+
+
+/*! @brief Construct a MortonOctreeBuilder of which the sorted entries hold
+ *         all nodes of the lights, including every branch below the root.
+ */
+static MortonOctreeBuilder constructTuningBuilder(const std::vector<world::PointLight*>& p_lights,
+                                                  double minimum_node_size) {
+  glm::vec3 origin;
+  unsigned int depth;
+  HashedAutoTuner::calculateLightOctreeBounds(p_lights, minimum_node_size, origin, depth);
+
+  MortonOctreeBuilder morton_builder = MortonOctreeBuilder(origin,
+                                                           depth,
+                                                           minimum_node_size,
+                                                           0);
+  for (unsigned int i = 0; i < p_lights.size(); ++i) {
+    morton_builder.addLight(*(p_lights.at(i)), i);
+  }
+  morton_builder.sortEntries();
+  return morton_builder;
+}
+
+
+/*! @brief Count the nodes of every level of the LightOctree in a single 
+ *         pass over the levels starting at the root, without constructing
+ *         any hash function.
+ *
+ * The branches below the starting depth, and the lights of every node, do
+ * not depend on the starting depth. Every node of the starting level is a 
+ * branch, such that the leaves of the level below it are all its leaf 
+ * nodes with lights.
+ */
+static LevelCounts countLevels(MortonOctreeBuilder& morton_builder) {
+  morton_builder.restartLevels(0);
+
+  unsigned int n_levels = morton_builder.getDepth() + 1;
+  LevelCounts counts = LevelCounts();
+  counts.n_branches = std::vector<double>(n_levels, 0.0);
+  counts.n_branch_leaves = std::vector<double>(n_levels, 0.0);
+  counts.n_branch_leaf_lights = std::vector<double>(n_levels, 0.0);
+  counts.n_leaves = std::vector<double>(n_levels, 0.0);
+  counts.n_leaf_lights = std::vector<double>(n_levels, 0.0);
+
+  std::vector<std::pair<glm::uvec3, glm::u8vec2>> octree_data = {};
+  std::vector<std::pair<glm::uvec3, glm::uvec2>> light_data = {};
+  std::vector<GLuint> light_indices = {};
+
+  unsigned int level = 0;
+  while (level + 1 < n_levels &&
+         morton_builder.constructNextLevel(octree_data, light_data, light_indices)) {
+    counts.n_branches[level] = double(octree_data.size());
+    counts.n_branch_leaves[level + 1] = double(light_data.size());
+    counts.n_branch_leaf_lights[level + 1] = double(light_indices.size());
+    light_indices.clear();
+    ++level;
+  }
+
+  // the children of a leaf node are leaf nodes with the same lights
+  for (level = 1; level < n_levels; ++level) {
+    counts.n_leaves[level] = counts.n_branch_leaves[level] + 8.0 * counts.n_leaves[level - 1];
+    counts.n_leaf_lights[level] = counts.n_branch_leaf_lights[level] + 8.0 * counts.n_leaf_lights[level - 1];
+  }
+  return counts;
+}
+
+
+/*! @brief Get the entries of every level of the LinklessOctree with the
+ *         specified starting depth from the counts of its LightOctree.
+ */
+static LevelEntries getLevelEntries(const LevelCounts& counts,
+                                    unsigned int starting_depth) {
+  LevelEntries entries = LevelEntries();
+  entries.n_octree_entries.push_back(pow(8.0, double(starting_depth)));
+  entries.n_data_entries.push_back(counts.n_leaves[starting_depth + 1]);
+  entries.n_light_indices = counts.n_leaf_lights[starting_depth + 1];
+
+  for (unsigned int level = starting_depth + 1;
+       level + 1 < counts.n_branches.size() && counts.n_branches[level] > 0.0;
+       ++level) {
+    entries.n_octree_entries.push_back(counts.n_branches[level]);
+    entries.n_data_entries.push_back(counts.n_branch_leaves[level + 1]);
+    entries.n_light_indices += counts.n_branch_leaf_lights[level + 1];
+  }
+  return entries;
+}
+
+
+/*! @brief Construct a HashFunctionBuilder of the specified backend, used
+ *         only for the dimensions of its tables.
+ */
+template <class R>
+static HashFunctionBuilder<R>* constructSizingBuilder(HashedBackend backend) {
+  switch (backend) {
+  case HashedBackend::Displacement:
+    return new DisplacementHashFunctionBuilder<R>();
+  case HashedBackend::PerfectSpatial:
+  default:
+    return new SpatialHashFunctionBuilder<R>();
+  }
+}
+
+
+/*! @brief Get the size in bytes of a hash table entry of type R in the 
+ *         specified layout, of which the textures pad the entries to RGBA 
+ *         texels as LinklessOctree::getLevelTextureBytes.
+ */
+template <class R>
+static double getEntryBytes(HashedTableLayout table_layout) {
+  return (table_layout == HashedTableLayout::Textures) ? 2.0 * sizeof(R) : double(sizeof(R));
+}
+
+
+/*! @brief Predict the size in bytes of the table of a level with n_nodes 
+ *         per dimension in the specified layout, as constructed by 
+ *         constructLevelMap.
+ */
+template <class R>
+static double predictTableBytes(const HashFunctionBuilder<R>& map_builder,
+                                double n_entries,
+                                unsigned int n_nodes,
+                                double dense_occupancy_threshold,
+                                double r_increase_ratio,
+                                unsigned int n_retries,
+                                bool is_pow2_tables,
+                                HashedTableLayout table_layout) {
+  if (n_entries < 1.0) return 0.0;
+
+  double n_level_nodes = double(n_nodes) * double(n_nodes) * double(n_nodes);
+  double m = double(n_nodes);
+  double r = 1.0;
+  if (n_entries < dense_occupancy_threshold * n_level_nodes) {
+    glm::uvec2 dims = map_builder.getTableDims(std::size_t(ceil(n_entries)),
+                                               float(r_increase_ratio),
+                                               n_retries,
+                                               is_pow2_tables);
+    m = double(dims.x);
+    r = double(dims.y);
+  }
+
+  // offsets are stored in a single uint, or two if they are wide
+  double n_offset_bytes = (m > 256.0) ? 8.0 : 4.0;
+  return m * m * m * getEntryBytes<R>(table_layout) + r * r * r * n_offset_bytes;
+}
+
+
+/*! @brief Predict the size in bytes of the light indices and tables in the
+ *         specified layout of the levels, of which the first has n_nodes 
+ *         per dimension.
+ */
+static double predictBytes(const LevelEntries& entries,
+                           unsigned int n_nodes,
+                           const HashFunctionBuilder<glm::u8vec2>& octree_map_builder,
+                           const HashFunctionBuilder<glm::uvec2>& data_map_builder,
+                           double dense_occupancy_threshold,
+                           double r_increase_ratio,
+                           unsigned int n_retries,
+                           bool is_pow2_tables,
+                           HashedTableLayout table_layout) {
+  double n_bytes = entries.n_light_indices * sizeof(GLuint);
+  for (unsigned int i = 0; i < entries.n_octree_entries.size(); ++i) {
+    n_bytes += predictTableBytes(octree_map_builder,
+                                 entries.n_octree_entries[i],
+                                 n_nodes,
+                                 dense_occupancy_threshold,
+                                 r_increase_ratio,
+                                 n_retries,
+                                 is_pow2_tables,
+                                 table_layout);
+    n_bytes += predictTableBytes(data_map_builder,
+                                 entries.n_data_entries[i],
+                                 n_nodes * 2,
+                                 dense_occupancy_threshold,
+                                 r_increase_ratio,
+                                 n_retries,
+                                 is_pow2_tables,
+                                 table_layout);
+    n_nodes *= 2;
+  }
+  return n_bytes;
+}
+
+
+/*! @brief Predict the mean number of table fetches per query of the levels,
+ *         of which the first has n_nodes per dimension, computed as 
+ *         LinklessOctree::getMeanNFetches.
+ */
+static double predictFetches(const LevelEntries& entries,
+                             unsigned int n_nodes,
+                             double dense_occupancy_threshold) {
+  double n_fetches = 0.0;
+  double n_level_nodes = double(n_nodes) * double(n_nodes) * double(n_nodes);
+
+  for (unsigned int i = 0; i < entries.n_octree_entries.size(); ++i) {
+    double n_octree = entries.n_octree_entries[i];
+    n_fetches += (n_octree / n_level_nodes) *
+      ((n_octree >= dense_occupancy_threshold * n_level_nodes) ? 1.0 : 2.0);
+
+    n_level_nodes *= 8.0;
+    double n_data = entries.n_data_entries[i];
+    if (n_data > 0.0) {
+      n_fetches += (n_data / n_level_nodes) *
+        ((n_data >= dense_occupancy_threshold * n_level_nodes) ? 1.0 : 2.0);
+    }
+  }
+  return n_fetches;
+}
+
+
+/*! @brief Construct the HashedTuning of the specified parameters, of 
+ *         which the LinklessOctree has the specified level entries.
+ */
+static HashedTuning constructTuning(const LevelEntries& entries,
+                                    double minimum_node_size,
+                                    unsigned int starting_depth,
+                                    double r_increase_ratio,
+                                    unsigned int depth,
+                                    double dense_occupancy_threshold,
+                                    bool is_pow2_tables,
+                                    HashedTableLayout table_layout,
+                                    HashedBackend backend,
+                                    std::size_t memory_budget) {
+  HashFunctionBuilder<glm::u8vec2>* p_octree_map_builder =
+    constructSizingBuilder<glm::u8vec2>(backend);
+  HashFunctionBuilder<glm::uvec2>* p_data_map_builder =
+    constructSizingBuilder<glm::uvec2>(backend);
+  unsigned int n_nodes = math::calculateNNodes(starting_depth);
+
+  HashedTuning tuning = HashedTuning();
+  tuning.minimum_node_size = minimum_node_size;
+  tuning.starting_depth = starting_depth;
+  tuning.r_increase_ratio = r_increase_ratio;
+  tuning.light_octree_depth = depth;
+  tuning.predicted_bytes = std::size_t(predictBytes(entries,
+                                                    n_nodes,
+                                                    *p_octree_map_builder,
+                                                    *p_data_map_builder,
+                                                    dense_occupancy_threshold,
+                                                    r_increase_ratio,
+                                                    0,
+                                                    is_pow2_tables,
+                                                    table_layout));
+  tuning.predicted_retry_bytes = std::size_t(predictBytes(entries,
+                                                          n_nodes,
+                                                          *p_octree_map_builder,
+                                                          *p_data_map_builder,
+                                                          dense_occupancy_threshold,
+                                                          r_increase_ratio,
+                                                          1,
+                                                          is_pow2_tables,
+                                                          table_layout));
+  tuning.predicted_fetches = predictFetches(entries,
+                                            n_nodes,
+                                            dense_occupancy_threshold);
+  tuning.meets_budget = tuning.predicted_bytes <= memory_budget;
+
+  delete p_octree_map_builder;
+  delete p_data_map_builder;
+  return tuning;
+}
+
+
+/*! @brief Get whether candidate is a better HashedTuning than best. */
+static bool isBetterTuning(const HashedTuning& candidate, const HashedTuning& best) {
+  if (candidate.meets_budget != best.meets_budget) return candidate.meets_budget;
+  if (!candidate.meets_budget) return candidate.predicted_bytes < best.predicted_bytes;
+
+  if (candidate.minimum_node_size != best.minimum_node_size) {
+    return candidate.minimum_node_size < best.minimum_node_size;
+  }
+  if (candidate.predicted_fetches != best.predicted_fetches) {
+    return candidate.predicted_fetches < best.predicted_fetches;
+  }
+  return candidate.predicted_bytes < best.predicted_bytes;
+}
+
+
+// ----------------------------------------------------------------------------
+//  Constructor
+// ----------------------------------------------------------------------------
+HashedAutoTuner::HashedAutoTuner(const std::vector<world::PointLight*>& p_lights,
+                                 const HashedConfig& hashed_config) :
+    p_lights(p_lights),
+    dense_occupancy_threshold(hashed_config.dense_occupancy_threshold),
+    pow2_tables(hashed_config.pow2_tables),
+    table_layout(hashed_config.table_layout),
+    backend(hashed_config.backend),
+    memory_budget(hashed_config.memory_budget) {
+}
+
+
+// ----------------------------------------------------------------------------
+//  Tuning
+// ----------------------------------------------------------------------------
+HashedTuning HashedAutoTuner::tune() const {
+  if (this->p_lights.empty()) throw HashedShadingNoLightException();
+
+  // node sizes halve from the radius of the smallest lights
+  std::vector<float> radii = std::vector<float>();
+  for (const world::PointLight* p_light : this->p_lights) {
+    radii.push_back(p_light->radius);
+  }
+  std::sort(radii.begin(), radii.end());
+  double base_node_size = radii.at(std::size_t(radius_quantile * (radii.size() - 1)));
+  if (base_node_size <= 0.0) base_node_size = radii.back();
+  if (base_node_size <= 0.0) throw HashedShadingInvalidStartingDepthException();
+
+  bool has_tuning = false;
+  HashedTuning best = HashedTuning();
+  LevelEntries best_entries = LevelEntries();
+
+  for (unsigned int k = 0; k < n_node_sizes; ++k) {
+    double node_size = base_node_size / math::calculateNNodes(k);
+
+    glm::vec3 origin;
+    unsigned int depth;
+    calculateLightOctreeBounds(this->p_lights, node_size, origin, depth);
+    if (3 * (depth - 1) > 57) break; // finer depths exceed the Morton codes
+
+    MortonOctreeBuilder morton_builder = constructTuningBuilder(this->p_lights, 
+                                                                node_size);
+    LevelCounts counts = countLevels(morton_builder);
+    bool has_met_budget = false;
+    for (unsigned int starting_depth = 1; starting_depth < depth; ++starting_depth) {
+      // every node of the starting level is a branch, such that its octree 
+      // table alone bounds the memory of deeper starting depths
+      double n_starting_nodes = pow(8.0, double(starting_depth));
+      if (has_tuning && 
+          n_starting_nodes * getEntryBytes<glm::u8vec2>(this->table_layout) > 
+            this->memory_budget) break;
+
+      LevelEntries entries = getLevelEntries(counts, starting_depth);
+      HashedTuning candidate = constructTuning(entries,
+                                               node_size,
+                                               starting_depth,
+                                               r_increase_ratios[0],
+                                               depth,
+                                               this->dense_occupancy_threshold,
+                                               this->pow2_tables,
+                                               this->table_layout,
+                                               this->backend,
+                                               this->memory_budget);
+      has_met_budget = has_met_budget || candidate.meets_budget;
+      if (!has_tuning || isBetterTuning(candidate, best)) {
+        best = candidate;
+        best_entries = entries;
+        has_tuning = true;
+      }
+    }
+
+    // finer node sizes only require more memory
+    if (!has_met_budget) break;
+  }
+
+  if (!has_tuning) throw HashedShadingInvalidStartingDepthException();
+
+  // prefer the largest ratio which meets the budget after a failed attempt
+  for (unsigned int i = 1; i < 3 && best.predicted_retry_bytes > this->memory_budget; ++i) {
+    best = constructTuning(best_entries,
+                           best.minimum_node_size,
+                           best.starting_depth,
+                           r_increase_ratios[i],
+                           best.light_octree_depth,
+                           this->dense_occupancy_threshold,
+                           this->pow2_tables,
+                           this->table_layout,
+                           this->backend,
+                           this->memory_budget);
+  }
+  return best;
+}
+
+
+HashedTuning HashedAutoTuner::predict(double minimum_node_size,
+                                      unsigned int starting_depth,
+                                      double r_increase_ratio) const {
+  MortonOctreeBuilder morton_builder = constructTuningBuilder(this->p_lights,
+                                                              minimum_node_size);
+  unsigned int depth = morton_builder.getDepth();
+  if (depth <= starting_depth) throw HashedShadingInvalidStartingDepthException();
+
+  return constructTuning(getLevelEntries(countLevels(morton_builder), starting_depth),
+                         minimum_node_size,
+                         starting_depth,
+                         r_increase_ratio,
+                         depth,
+                         this->dense_occupancy_threshold,
+                         this->pow2_tables,
+                         this->table_layout,
+                         this->backend,
+                         this->memory_budget);
+}
+
+
+void HashedAutoTuner::calculateLightOctreeBounds(const std::vector<world::PointLight*>& p_lights,
+                                                 double minimum_node_size,
+                                                 glm::vec3& origin,
+                                                 unsigned int& depth) {
+  if (p_lights.empty()) throw HashedShadingNoLightException();
+
+  // Find the extreme values
+  world::PointLight* p_light = p_lights.at(0);
+  glm::vec3 pmin;
+  glm::vec3 pmax;
+
+  glm::vec3 vmin = glm::vec3(p_light->position) - glm::vec3(p_light->radius);
+  glm::vec3 vmax = glm::vec3(p_light->position) + glm::vec3(p_light->radius);
+
+  for (unsigned int i = 1; i < p_lights.size(); ++i) {
+    p_light = p_lights.at(i);
+
+    pmin = glm::vec3(p_light->position) - glm::vec3(p_light->radius);
+    pmax = glm::vec3(p_light->position) + glm::vec3(p_light->radius);
+
+    if (pmin.x < vmin.x) vmin.x = pmin.x;
+    if (pmin.y < vmin.y) vmin.y = pmin.y;
+    if (pmin.z < vmin.z) vmin.z = pmin.z;
+
+    if (pmax.x > vmax.x) vmax.x = pmax.x;
+    if (pmax.y > vmax.y) vmax.y = pmax.y;
+    if (pmax.z > vmax.z) vmax.z = pmax.z;
+  }
+
+  vmin -= glm::vec3(0.1 * minimum_node_size);
+  vmax += glm::vec3(0.1 * minimum_node_size);
+
+  // calculate max size
+  double max_size = math::f_max(vmax.x - vmin.x,
+                                math::f_max(vmax.y - vmin.y,
+                                            vmax.z - vmin.z));
+
+  unsigned int n_nodes_min = unsigned int(floor(max_size / minimum_node_size)) + 1;
+  origin = vmin;
+  depth = unsigned int(ceil(log2(n_nodes_min))) + 1; // depth is defined as 2^(depth - 1) <= n_nodes
+}
+
+}
+}
+}
@@ -1,5 +1,10 @@
 #include "pipeline\light-management\hashed\HashedConfig.h"
 
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <stdexcept>
+
 namespace nTiled {
 namespace pipeline {
 namespace hashed {
@@ -16,7 +21,16 @@ HashedConfig::HashedConfig(float minimum_node_size,
   starting_depth(starting_depth),
   r_increase_ratio(r_increase_ratio),
   max_attempts(max_attempts),
-  seed(22) {
+  seed(22),
+  build_method(HashedBuildMethod::TopDown),
+  dense_occupancy_threshold(1.0),
+  table_layout(HashedTableLayout::Textures),
+  release_host_tables(false),
+  pow2_tables(false),
+  backend(HashedBackend::PerfectSpatial),
+  portfolio_size(1),
+  auto_tune(false),
+  memory_budget(64 * 1024 * 1024) {
 }
 
 
@@ -29,7 +43,135 @@ HashedConfig::HashedConfig(float minimum_node_size,
   starting_depth(starting_depth),
   r_increase_ratio(r_increase_ratio),
   max_attempts(max_attempts),
-  seed(seed) {
+  seed(seed),
+  build_method(HashedBuildMethod::TopDown),
+  dense_occupancy_threshold(1.0),
+  table_layout(HashedTableLayout::Textures),
+  release_host_tables(false),
+  pow2_tables(false),
+  backend(HashedBackend::PerfectSpatial),
+  portfolio_size(1),
+  auto_tune(false),
+  memory_budget(64 * 1024 * 1024) {
+}
+
+
+HashedConfig parseHashedConfig(const rapidjson::Value& hashed_config_json) {
+  unsigned int hashed_seed = 22;
+  rapidjson::Value::ConstMemberIterator hashed_seed_itr = hashed_config_json.FindMember("seed");
+  if (hashed_seed_itr != hashed_config_json.MemberEnd()) {
+    hashed_seed = hashed_seed_itr->value.GetUint();
+  }
+
+  HashedConfig hashed_config = 
+    HashedConfig(hashed_config_json["node_size"].GetFloat(),
+                 hashed_config_json["starting_depth"].GetUint(),
+                 hashed_config_json["r_increase_ratio"].GetFloat(),
+                 hashed_config_json["max_attempts"].GetUint(),
+                 hashed_seed);
+
+  rapidjson::Value::ConstMemberIterator build_method_itr = hashed_config_json.FindMember("build_method");
+  if (build_method_itr != hashed_config_json.MemberEnd()) {
+    hashed_config.build_method = 
+      parseHashedBuildMethod(build_method_itr->value.GetString());
+  }
+
+  rapidjson::Value::ConstMemberIterator dense_itr = hashed_config_json.FindMember("dense_occupancy_threshold");
+  if (dense_itr != hashed_config_json.MemberEnd()) {
+    hashed_config.dense_occupancy_threshold = dense_itr->value.GetDouble();
+  }
+
+  rapidjson::Value::ConstMemberIterator table_layout_itr = hashed_config_json.FindMember("table_layout");
+  if (table_layout_itr != hashed_config_json.MemberEnd()) {
+    hashed_config.table_layout = 
+      parseHashedTableLayout(table_layout_itr->value.GetString());
+  }
+
+  rapidjson::Value::ConstMemberIterator release_itr = hashed_config_json.FindMember("release_host_tables");
+  if (release_itr != hashed_config_json.MemberEnd()) {
+    hashed_config.release_host_tables = release_itr->value.GetBool();
+  }
+
+  rapidjson::Value::ConstMemberIterator pow2_itr = hashed_config_json.FindMember("pow2_tables");
+  if (pow2_itr != hashed_config_json.MemberEnd()) {
+    hashed_config.pow2_tables = pow2_itr->value.GetBool();
+  }
+
+  rapidjson::Value::ConstMemberIterator backend_itr = hashed_config_json.FindMember("backend");
+  if (backend_itr != hashed_config_json.MemberEnd()) {
+    hashed_config.backend = 
+      parseHashedBackend(backend_itr->value.GetString());
+  }
+
+  rapidjson::Value::ConstMemberIterator portfolio_itr = hashed_config_json.FindMember("portfolio_size");
+  if (portfolio_itr != hashed_config_json.MemberEnd()) {
+    hashed_config.portfolio_size = portfolio_itr->value.GetUint();
+  }
+
+  rapidjson::Value::ConstMemberIterator auto_tune_itr = hashed_config_json.FindMember("auto_tune");
+  if (auto_tune_itr != hashed_config_json.MemberEnd()) {
+    hashed_config.auto_tune = auto_tune_itr->value.GetBool();
+  }
+
+  rapidjson::Value::ConstMemberIterator budget_itr = hashed_config_json.FindMember("memory_budget");
+  if (budget_itr != hashed_config_json.MemberEnd()) {
+    hashed_config.memory_budget = std::size_t(budget_itr->value.GetUint64());
+  }
+  return hashed_config;
+}
+
+
+HashedBuildMethod parseHashedBuildMethod(const std::string& name) {
+  if (name == "top_down") return HashedBuildMethod::TopDown;
+  if (name == "morton") return HashedBuildMethod::Morton;
+  throw std::runtime_error(std::string("Unknown hashed build method: ") + name);
+}
+
+
+std::string getHashedBuildMethodName(HashedBuildMethod method) {
+  switch (method) {
+  case HashedBuildMethod::Morton:
+    return "morton";
+  case HashedBuildMethod::TopDown:
+  default:
+    return "top_down";
+  }
+}
+
+
+HashedTableLayout parseHashedTableLayout(const std::string& name) {
+  if (name == "textures") return HashedTableLayout::Textures;
+  if (name == "packed") return HashedTableLayout::Packed;
+  throw std::runtime_error(std::string("Unknown hashed table layout: ") + name);
+}
+
+
+std::string getHashedTableLayoutName(HashedTableLayout layout) {
+  switch (layout) {
+  case HashedTableLayout::Packed:
+    return "packed";
+  case HashedTableLayout::Textures:
+  default:
+    return "textures";
+  }
+}
+
+
+HashedBackend parseHashedBackend(const std::string& name) {
+  if (name == "perfect_spatial") return HashedBackend::PerfectSpatial;
+  if (name == "displacement") return HashedBackend::Displacement;
+  throw std::runtime_error(std::string("Unknown hashed backend: ") + name);
+}
+
+
+std::string getHashedBackendName(HashedBackend backend) {
+  switch (backend) {
+  case HashedBackend::Displacement:
+    return "displacement";
+  case HashedBackend::PerfectSpatial:
+  default:
+    return "perfect_spatial";
+  }
 }
 
 }
@@ -9,11 +9,20 @@
 #include "pipeline\light-management\hashed\light-octree\nodes\LOLeaf.h"
 
 #include "pipeline\light-management\hashed\linkless-octree\SpatialHashFunctionBuilder.h"
+#include "pipeline\light-management\hashed\linkless-octree\DisplacementHashFunctionBuilder.h"
+#include "pipeline\light-management\hashed\linkless-octree\PortfolioHashFunctionBuilder.h"
+#include "pipeline\light-management\hashed\linkless-octree\MortonOctreeBuilder.h"
+#include "log\Profiler.h"
 
 #include "math\util.h"
 #include "math\points.h"
 #include "math\octree.h"
 
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <memory>
+
 
 namespace nTiled {
 namespace pipeline {
@@ -31,6 +40,16 @@ HashedLightManager::HashedLightManager(const world::World& world,
   r_increase_ratio(hashed_config.r_increase_ratio),
   max_attempts(hashed_config.max_attempts),
   hash_builder_seed(hashed_config.seed),
+  build_method(hashed_config.build_method),
+  dense_occupancy_threshold(hashed_config.dense_occupancy_threshold),
+  table_layout(hashed_config.table_layout),
+  release_host_tables(hashed_config.release_host_tables),
+  pow2_tables(hashed_config.pow2_tables),
+  backend(hashed_config.backend),
+  portfolio_size(hashed_config.portfolio_size),
+  auto_tune(hashed_config.auto_tune),
+  memory_budget(hashed_config.memory_budget),
+  has_tuned(false),
   ps_slt({}),
   has_constructed_light_octree(false),
   has_constructed_slts(false),
@@ -42,9 +61,20 @@ HashedLightManager::HashedLightManager(const world::World& world,
                                        double minimal_node_size) :
   world(world),
   minimal_node_size(minimal_node_size),
+  build_method(HashedBuildMethod::TopDown),
+  dense_occupancy_threshold(HashedConfig().dense_occupancy_threshold),
+  table_layout(HashedTableLayout::Textures),
+  release_host_tables(false),
+  pow2_tables(false),
+  backend(HashedBackend::PerfectSpatial),
+  portfolio_size(1),
+  auto_tune(false),
+  memory_budget(HashedConfig().memory_budget),
+  has_tuned(false),
   ps_slt({}),
   has_constructed_light_octree(false),
-  has_constructed_slts(false) {
+  has_constructed_slts(false),
+  has_constructed_linkless_octree(false) {
 }
 
 
@@ -58,14 +88,208 @@ HashedLightManager::~HashedLightManager() {
   if (this->has_constructed_light_octree) {
     delete this->p_light_octree;
   }
+
+  if (this->has_constructed_linkless_octree) {
+    delete this->p_linkless_octree;
+  }
 }
 
+// ----------------------------------------------------------------------------
+//  Getters
+// ----------------------------------------------------------------------------
+HashedConfig HashedLightManager::getHashedConfig() const {
+  HashedConfig hashed_config = HashedConfig(float(this->getMinimalNodeSize()),
+                                            this->getStartingDepth(),
+                                            float(this->getRIncreaseRatio()),
+                                            this->getMaxNAttempts(),
+                                            this->hash_builder_seed);
+  hashed_config.minimum_node_size = this->getMinimalNodeSize();
+  hashed_config.r_increase_ratio = this->getRIncreaseRatio();
+  hashed_config.build_method = this->getBuildMethod();
+  hashed_config.dense_occupancy_threshold = this->getDenseOccupancyThreshold();
+  hashed_config.table_layout = this->getTableLayout();
+  hashed_config.release_host_tables = this->releasesHostTables();
+  hashed_config.pow2_tables = this->hasPow2Tables();
+  hashed_config.backend = this->getBackend();
+  hashed_config.portfolio_size = this->getPortfolioSize();
+  hashed_config.auto_tune = this->isAutoTuning();
+  hashed_config.memory_budget = this->getMemoryBudget();
+  return hashed_config;
+}
+
+
 // ----------------------------------------------------------------------------
 //  LightOctree construction
 // ----------------------------------------------------------------------------
 void HashedLightManager::init() {
-  this->constructLightOctree();
-  this->constructLinklessOctree();
+  static const logged::ScopeId actual_bytes_id =
+    logged::internScope("HashedLightManager::autoTune::actual_bytes");
+  static const logged::ScopeId actual_fetches_id =
+    logged::internScope("HashedLightManager::autoTune::actual_fetches");
+
+  if (this->isAutoTuning()) this->autoTune();
+
+  if (this->getBuildMethod() == HashedBuildMethod::Morton) {
+    this->constructEmptyLightOctree();
+    this->constructLinklessOctreeMorton();
+  } else {
+    this->constructLightOctree();
+    this->constructLinklessOctree();
+  }
+
+  if (this->hasTuned()) {
+    // the actual bytes are those of the table layout the tuning predicts
+    LinklessOctree* p_linkless = this->getLinklessOctree();
+    std::size_t n_bytes = p_linkless->getNLightIndices() * sizeof(GLuint);
+    for (unsigned int i = 0; i < p_linkless->getNLevels(); ++i) {
+      if (this->getTableLayout() == HashedTableLayout::Packed) {
+        n_bytes += p_linkless->getLevelPackedBytes(i);
+      } else {
+        n_bytes += p_linkless->getLevelTextureBytes(i);
+      }
+    }
+    logged::profileValue(actual_bytes_id, double(n_bytes));
+    logged::profileValue(actual_fetches_id, p_linkless->getMeanNFetches());
+  }
+}
+
+
+void HashedLightManager::autoTune() {
+  static const logged::ScopeId minimum_node_size_id =
+    logged::internScope("HashedLightManager::autoTune::minimum_node_size");
+  static const logged::ScopeId starting_depth_id =
+    logged::internScope("HashedLightManager::autoTune::starting_depth");
+  static const logged::ScopeId r_increase_ratio_id =
+    logged::internScope("HashedLightManager::autoTune::r_increase_ratio");
+  static const logged::ScopeId predicted_bytes_id =
+    logged::internScope("HashedLightManager::autoTune::predicted_bytes");
+  static const logged::ScopeId predicted_fetches_id =
+    logged::internScope("HashedLightManager::autoTune::predicted_fetches");
+
+  HashedAutoTuner tuner = HashedAutoTuner(this->getWorld().p_lights, 
+                                          this->getHashedConfig());
+  this->tuning = tuner.tune();
+  this->has_tuned = true;
+
+  this->minimal_node_size = this->tuning.minimum_node_size;
+  this->starting_depth = this->tuning.starting_depth;
+  this->r_increase_ratio = this->tuning.r_increase_ratio;
+
+  logged::profileValue(minimum_node_size_id, this->tuning.minimum_node_size);
+  logged::profileValue(starting_depth_id, double(this->tuning.starting_depth));
+  logged::profileValue(r_increase_ratio_id, this->tuning.r_increase_ratio);
+  logged::profileValue(predicted_bytes_id, double(this->tuning.predicted_bytes));
+  logged::profileValue(predicted_fetches_id, this->tuning.predicted_fetches);
+}
+
+
+/*! @brief Construct a new HashFunctionBuilder of the specified backend,
+ *         drawing its offsets with the specified seed. If portfolio_size
+ *         is at least 2, a PortfolioHashFunctionBuilder racing that many
+ *         builders of the backend, seeded seed, seed + 1, ..., is
+ *         constructed instead.
+ */
+template <class R>
+static HashFunctionBuilder<R>* constructHashFunctionBuilder(HashedBackend backend,
+                                                            unsigned int seed,
+                                                            unsigned int portfolio_size) {
+  if (portfolio_size > 1) {
+    std::vector<HashFunctionBuilder<R>*> p_candidates;
+    for (unsigned int i = 0; i < portfolio_size; ++i) {
+      p_candidates.push_back(constructHashFunctionBuilder<R>(backend, seed + i, 1));
+    }
+    return new PortfolioHashFunctionBuilder<R>(p_candidates);
+  }
+
+  switch (backend) {
+  case HashedBackend::Displacement:
+    return new DisplacementHashFunctionBuilder<R>(seed);
+  case HashedBackend::PerfectSpatial:
+  default:
+    return new SpatialHashFunctionBuilder<R>(seed);
+  }
+}
+
+
+/*! @brief Construct the map of the entries of a single level, as a dense
+ *         grid if at least dense_occupancy_threshold of its n_nodes^3 nodes
+ *         are defined, and as a spatial hash function otherwise, of which
+ *         the hash table has a power of two dimension if is_pow2_tables.
+ */
+template <class R>
+static SpatialHashFunction<R>* constructLevelMap(HashFunctionBuilder<R>& map_builder,
+                                                 const std::vector<std::pair<glm::uvec3, R>>& entries,
+                                                 unsigned int n_nodes,
+                                                 double dense_occupancy_threshold,
+                                                 unsigned int max_attempts,
+                                                 double r_increase_ratio,
+                                                 bool is_pow2_tables) {
+  double n_level_nodes = double(n_nodes) * double(n_nodes) * double(n_nodes);
+  if (double(entries.size()) >= dense_occupancy_threshold * n_level_nodes) {
+    return map_builder.constructDenseFunction(entries, n_nodes);
+  } else {
+    return map_builder.constructHashFunction(entries,
+                                             max_attempts,
+                                             float(r_increase_ratio),
+                                             is_pow2_tables);
+  }
+}
+
+
+/*! @brief Construct the maps of a single level of a LinklessOctree, of which
+ *         the branches lie in a grid of n_nodes per dimension, from its 
+ *         octree data and light data, and add them to the maps.
+ */
+static void addLevelMaps(HashFunctionBuilder<glm::u8vec2>& octree_map_builder,
+                         HashFunctionBuilder<glm::uvec2>& data_map_builder,
+                         const std::vector<std::pair<glm::uvec3, glm::u8vec2>>& octree_data,
+                         const std::vector<std::pair<glm::uvec3, glm::uvec2>>& light_data,
+                         unsigned int n_nodes,
+                         double dense_occupancy_threshold,
+                         unsigned int max_attempts,
+                         double r_increase_ratio,
+                         bool is_pow2_tables,
+                         std::vector<SpatialHashFunction<glm::u8vec2>*>* p_octree_maps,
+                         std::vector<bool>* p_data_map_exists,
+                         std::vector<SpatialHashFunction<glm::uvec2>*>* p_data_maps) {
+  p_octree_maps->push_back(constructLevelMap(octree_map_builder,
+                                             octree_data,
+                                             n_nodes,
+                                             dense_occupancy_threshold,
+                                             max_attempts,
+                                             r_increase_ratio,
+                                             is_pow2_tables));
+
+  if (!light_data.empty()) {
+    p_data_map_exists->push_back(true);
+    p_data_maps->push_back(constructLevelMap(data_map_builder,
+                                             light_data,
+                                             n_nodes * 2,
+                                             dense_occupancy_threshold,
+                                             max_attempts,
+                                             r_increase_ratio,
+                                             is_pow2_tables));
+  } else {
+    p_data_map_exists->push_back(false);
+    p_data_maps->push_back(nullptr);
+  }
+}
+
+
+/*! @brief Delete the maps and light indices of a LinklessOctree of which the
+ *         construction failed.
+ */
+static void deleteLevelMaps(std::vector<SpatialHashFunction<glm::u8vec2>*>* p_octree_maps,
+                            std::vector<bool>* p_data_map_exists,
+                            std::vector<SpatialHashFunction<glm::uvec2>*>* p_data_maps,
+                            std::vector<GLuint>* p_light_indices) {
+  for (SpatialHashFunction<glm::u8vec2>* p_map : *p_octree_maps) delete p_map;
+  for (SpatialHashFunction<glm::uvec2>* p_map : *p_data_maps) delete p_map;
+
+  delete p_octree_maps;
+  delete p_data_map_exists;
+  delete p_data_maps;
+  delete p_light_indices;
 }
 
 
@@ -75,11 +299,15 @@ void HashedLightManager::constructLinklessOctree() {
     throw HashedShadingInvalidStartingDepthException();
   }
 
-  SpatialHashFunctionBuilder<glm::u8vec2> octree_map_builder =
-    SpatialHashFunctionBuilder<glm::u8vec2>(this->hash_builder_seed);
+  std::unique_ptr<HashFunctionBuilder<glm::u8vec2>> p_octree_map_builder(
+    constructHashFunctionBuilder<glm::u8vec2>(this->getBackend(),
+                                              this->hash_builder_seed,
+                                              this->getPortfolioSize()));
 
-  SpatialHashFunctionBuilder<glm::uvec2> data_map_builder =
-    SpatialHashFunctionBuilder<glm::uvec2>(this->hash_builder_seed);
+  std::unique_ptr<HashFunctionBuilder<glm::uvec2>> p_data_map_builder(
+    constructHashFunctionBuilder<glm::uvec2>(this->getBackend(),
+                                             this->hash_builder_seed,
+                                             this->getPortfolioSize()));
 
   std::vector<std::pair<glm::uvec3, const LOBranch*>> nodes_at_depth =
     this->getLightOctree()->retrieveNodesAtDepth(this->getStartingDepth());
@@ -105,69 +333,77 @@ void HashedLightManager::constructLinklessOctree() {
   glm::u8vec2 child_representation;
   std::vector<GLuint> node_light_indices;
   glm::uvec2 light_dat;
-
-  while (!branches.empty()) {
-    branches_next.clear();
-    leaves.clear();
-    octree_data.clear();
-    light_data.clear();
-
-    // calculate octree structure, leaf nodes, and branch nodes for the next level
-    for (std::pair<glm::uvec3, const LOBranch*> p_b : branches) {
-      glm::u8vec2 octree_dat = glm::u8vec2(0);
-
-      for (unsigned int x = 0; x < 2; ++x) {
-        for (unsigned int y = 0; y < 2; ++y) {
-          for (unsigned int z = 0; z < 2; ++z) {
-            index_vec = glm::bvec3(x == 1,
-                                   y == 1,
-                                   z == 1);
-            index_int = x + y * 2 + z * 4;
-
-            const LONode& child_node = p_b.second->getChildNodeConst(index_vec);
-
-            child_representation = child_node.getLinklessOctreeNodeRepresentation();
-            octree_dat += glm::u8vec2(child_representation.x << index_int,
-                                      child_representation.y << index_int);
-
-            child_node.addToConstructionVectors(p_b.first + p_b.first + glm::uvec3(x, y, z),
-                                                branches_next,
-                                                leaves);
+  unsigned int n_nodes = math::calculateNNodes(this->getStartingDepth());
+
+  try {
+    while (!branches.empty()) {
+      branches_next.clear();
+      leaves.clear();
+      octree_data.clear();
+      light_data.clear();
+
+      // calculate octree structure, leaf nodes, and branch nodes for the next level
+      for (std::pair<glm::uvec3, const LOBranch*> p_b : branches) {
+        glm::u8vec2 octree_dat = glm::u8vec2(0);
+
+        for (unsigned int x = 0; x < 2; ++x) {
+          for (unsigned int y = 0; y < 2; ++y) {
+            for (unsigned int z = 0; z < 2; ++z) {
+              index_vec = glm::bvec3(x == 1,
+                                     y == 1,
+                                     z == 1);
+              index_int = x + y * 2 + z * 4;
+
+              const LONode& child_node = p_b.second->getChildNodeConst(index_vec);
+
+              child_representation = child_node.getLinklessOctreeNodeRepresentation();
+              octree_dat += glm::u8vec2(child_representation.x << index_int,
+                                        child_representation.y << index_int);
+
+              child_node.addToConstructionVectors(p_b.first + p_b.first + glm::uvec3(x, y, z),
+                                                  branches_next,
+                                                  leaves);
+            }
           }
         }
+        octree_data.push_back(std::pair<glm::uvec3, glm::u8vec2>(p_b.first, octree_dat));
       }
-      octree_data.push_back(std::pair<glm::uvec3, glm::u8vec2>(p_b.first, octree_dat));
-    }
 
-    // compile light data
-    for (std::pair<glm::uvec3, const LOLeaf*> p_l : leaves) {
-      if (!p_l.second->isEmpty()) {
-        node_light_indices = p_l.second->getIndices();
-        light_dat = glm::uvec2(p_light_indices->size(), node_light_indices.size());
-        light_data.push_back(std::pair<glm::uvec3, glm::uvec2>(p_l.first, light_dat));
+      // compile light data
+      for (std::pair<glm::uvec3, const LOLeaf*> p_l : leaves) {
+        if (!p_l.second->isEmpty()) {
+          node_light_indices = p_l.second->getIndices();
+          light_dat = glm::uvec2(p_light_indices->size(), node_light_indices.size());
+          light_data.push_back(std::pair<glm::uvec3, glm::uvec2>(p_l.first, light_dat));
 
-        p_light_indices->insert(p_light_indices->end(),
-                                node_light_indices.begin(),
-                                node_light_indices.end());
+          p_light_indices->insert(p_light_indices->end(),
+                                  node_light_indices.begin(),
+                                  node_light_indices.end());
+        }
       }
-    }
 
-    // create relevant maps
-    p_octree_maps->push_back(octree_map_builder.constructHashFunction(octree_data,
-                                                                      this->getMaxNAttempts(),
-                                                                      this->getRIncreaseRatio()));
-
-    if (!light_data.empty()) {
-      p_data_map_exists->push_back(true);
-      p_data_maps->push_back(data_map_builder.constructHashFunction(light_data,
-                                                                    this->getMaxNAttempts(),
-                                                                    this->getRIncreaseRatio()));
-    } else {
-      p_data_map_exists->push_back(false);
-      p_data_maps->push_back(nullptr);
+      // create relevant maps
+      addLevelMaps(*p_octree_map_builder,
+                   *p_data_map_builder,
+                   octree_data,
+                   light_data,
+                   n_nodes,
+                   this->getDenseOccupancyThreshold(),
+                   this->getMaxNAttempts(),
+                   this->getRIncreaseRatio(),
+                   this->hasPow2Tables(),
+                   p_octree_maps,
+                   p_data_map_exists,
+                   p_data_maps);
+
+      branches = branches_next;
+      n_nodes *= 2;
     }
-
-    branches = branches_next;
+  } catch (...) {
+    deleteLevelMaps(p_octree_maps, p_data_map_exists, p_data_maps, p_light_indices);
+    for (std::pair<glm::uvec3, const LOBranch*> p_b : nodes_at_depth)
+      delete p_b.second;
+    throw;
   }
 
   this->p_linkless_octree = new LinklessOctree(this->getLightOctree()->getDepth(),
@@ -187,6 +423,83 @@ void HashedLightManager::constructLinklessOctree() {
 }
 
 
+void HashedLightManager::constructLinklessOctreeMorton() {
+  static const logged::ScopeId n_entries_id =
+    logged::internScope("MortonOctreeBuilder::entries");
+
+  // Check if the depth is compatible
+  if (this->getLightOctree()->getDepth() <= this->getStartingDepth()) {
+    throw HashedShadingInvalidStartingDepthException();
+  }
+
+  MortonOctreeBuilder morton_builder = 
+    MortonOctreeBuilder(this->getLightOctree()->getOrigin(),
+                        this->getLightOctree()->getDepth(),
+                        this->getLightOctree()->getMinimalNodeSize(),
+                        this->getStartingDepth());
+
+  const std::vector<world::PointLight*>& p_lights = this->getWorld().p_lights;
+  for (unsigned int i = 0; i < p_lights.size(); ++i) {
+    morton_builder.addLight(*(p_lights.at(i)), i);
+  }
+  morton_builder.sortEntries();
+  logged::profileValue(n_entries_id, double(morton_builder.getNEntries()));
+
+  std::unique_ptr<HashFunctionBuilder<glm::u8vec2>> p_octree_map_builder(
+    constructHashFunctionBuilder<glm::u8vec2>(this->getBackend(),
+                                              this->hash_builder_seed,
+                                              this->getPortfolioSize()));
+
+  std::unique_ptr<HashFunctionBuilder<glm::uvec2>> p_data_map_builder(
+    constructHashFunctionBuilder<glm::uvec2>(this->getBackend(),
+                                             this->hash_builder_seed,
+                                             this->getPortfolioSize()));
+
+  std::vector<std::pair<glm::uvec3, glm::u8vec2>> octree_data = {};
+  std::vector<std::pair<glm::uvec3, glm::uvec2>> light_data = {};
+
+  std::vector<GLuint>* p_light_indices = new std::vector<GLuint>();
+  std::vector<SpatialHashFunction<glm::u8vec2>*>* p_octree_maps = 
+    new std::vector<SpatialHashFunction<glm::u8vec2>*>();
+  std::vector<SpatialHashFunction<glm::uvec2>*>* p_data_maps = 
+    new std::vector<SpatialHashFunction<glm::uvec2>*>();
+  std::vector<bool>* p_data_map_exists = new std::vector<bool>();
+  unsigned int n_nodes = math::calculateNNodes(this->getStartingDepth());
+
+  try {
+    while (morton_builder.constructNextLevel(octree_data, light_data, *p_light_indices)) {
+      addLevelMaps(*p_octree_map_builder,
+                   *p_data_map_builder,
+                   octree_data,
+                   light_data,
+                   n_nodes,
+                   this->getDenseOccupancyThreshold(),
+                   this->getMaxNAttempts(),
+                   this->getRIncreaseRatio(),
+                   this->hasPow2Tables(),
+                   p_octree_maps,
+                   p_data_map_exists,
+                   p_data_maps);
+      n_nodes *= 2;
+    }
+  } catch (...) {
+    deleteLevelMaps(p_octree_maps, p_data_map_exists, p_data_maps, p_light_indices);
+    throw;
+  }
+
+  this->p_linkless_octree = new LinklessOctree(this->getLightOctree()->getDepth(),
+                                               p_octree_maps->size(),
+                                               this->getLightOctree()->getMinimalNodeSize(),
+                                               this->getLightOctree()->getOrigin(),
+                                               p_octree_maps,
+                                               p_data_map_exists,
+                                               p_data_maps,
+                                               p_light_indices);
+
+  this->has_constructed_linkless_octree = true;
+}
+
+
 void HashedLightManager::constructLightOctree() {
   this->constructEmptyLightOctree();
   this->constructSLTs();
@@ -203,44 +516,14 @@ void HashedLightManager::addConstructedSLTs() {
 
 
 void HashedLightManager::constructEmptyLightOctree() {
-  // Check if lights are not empty
-  if (this->world.p_lights.empty()) throw HashedShadingNoLightException();
-
-  // Find the extreme values
-  world::PointLight* p_light = this->world.p_lights.at(0);
-  glm::vec3 pmin;
-  glm::vec3 pmax;
-
-  glm::vec3 vmin = glm::vec3(p_light->position) - glm::vec3(p_light->radius);
-  glm::vec3 vmax = glm::vec3(p_light->position) + glm::vec3(p_light->radius);
-
-  for (unsigned int i = 1; i < this->world.p_lights.size(); ++i) {
-    p_light = this->world.p_lights.at(i);
-
-    pmin = glm::vec3(p_light->position) - glm::vec3(p_light->radius);
-    pmax = glm::vec3(p_light->position) + glm::vec3(p_light->radius);
-
-    if (pmin.x < vmin.x) vmin.x = pmin.x;
-    if (pmin.y < vmin.y) vmin.y = pmin.y;
-    if (pmin.z < vmin.z) vmin.z = pmin.z;
-
-    if (pmax.x > vmax.x) vmax.x = pmax.x;
-    if (pmax.y > vmax.y) vmax.y = pmax.y;
-    if (pmax.z > vmax.z) vmax.z = pmax.z;
-  }
-
-  vmin -= glm::vec3(0.1 * this->getMinimalNodeSize());
-  vmax += glm::vec3(0.1 * this->getMinimalNodeSize());
-
-  // calculate max size
-  double max_size = math::f_max(vmax.x - vmin.x,
-                                math::f_max(vmax.y - vmin.y,
-                                            vmax.z - vmin.z));
-
-  unsigned int n_nodes_min = unsigned int(floor(max_size / this->getMinimalNodeSize())) + 1;
-  unsigned int depth = unsigned int(ceil(log2(n_nodes_min))) + 1; // depth is defined as 2^(depth - 1) <= n_nodes
-
-  this->p_light_octree = new LightOctree(vmin, depth, this->getMinimalNodeSize());
+  glm::vec3 origin;
+  unsigned int depth;
+  HashedAutoTuner::calculateLightOctreeBounds(this->world.p_lights,
+                                              this->getMinimalNodeSize(),
+                                              origin,
+                                              depth);
+
+  this->p_light_octree = new LightOctree(origin, depth, this->getMinimalNodeSize());
   this->has_constructed_light_octree = true;
 }
 
@@ -263,6 +546,22 @@ void HashedLightManager::constructSLTs() {
 }
 
 
+// ----------------------------------------------------------------------------
+//  openGL methods
+// ----------------------------------------------------------------------------
+void HashedLightManager::loadToShader(GLuint shader) {
+  if (this->getTableLayout() == HashedTableLayout::Packed) {
+    this->getLinklessOctree()->loadToShaderPacked(shader);
+  } else {
+    this->getLinklessOctree()->loadToShader(shader);
+  }
+
+  if (this->releasesHostTables()) {
+    this->getLinklessOctree()->releaseHostTables();
+  }
+}
+
+
 
 }
 }
@@ -34,30 +34,103 @@ HashedLightManagerLogged::HashedLightManagerLogged(const world::World& world,
 //  Time tracked functions
 // ----------------------------------------------------------------------------
 void HashedLightManagerLogged::constructEmptyLightOctree() {
-  this->logger.startLog(std::string("HashedLightManager::constructEmptyLightOctree"));
+  static const logged::ScopeId construct_empty_light_octree_id =
+    logged::internScope("HashedLightManager::constructEmptyLightOctree");
+  this->logger.startLog(construct_empty_light_octree_id);
   HashedLightManager::constructEmptyLightOctree();
-  this->logger.endLog();
+  this->logger.endLog(construct_empty_light_octree_id);
 }
 
 
 void HashedLightManagerLogged::constructSLTs() {
-  this->logger.startLog(std::string("HashedLightManager::constructSLTs"));
+  static const logged::ScopeId construct_slts_id =
+    logged::internScope("HashedLightManager::constructSLTs");
+  this->logger.startLog(construct_slts_id);
   HashedLightManager::constructSLTs();
-  this->logger.endLog();
+  this->logger.endLog(construct_slts_id);
 }
 
 
 void HashedLightManagerLogged::addConstructedSLTs() {
-  this->logger.startLog(std::string("HashedLightManager::addConstructedSLTs"));
+  static const logged::ScopeId add_constructed_slts_id =
+    logged::internScope("HashedLightManager::addConstructedSLTs");
+  this->logger.startLog(add_constructed_slts_id);
   HashedLightManager::addConstructedSLTs();
-  this->logger.endLog();
+  this->logger.endLog(add_constructed_slts_id);
 }
 
 
 void HashedLightManagerLogged::constructLinklessOctree() {
-  this->logger.startLog(std::string("HashedLightManager::constructLinklessOctree"));
+  static const logged::ScopeId construct_linkless_octree_id =
+    logged::internScope("HashedLightManager::constructLinklessOctree");
+  this->logger.startLog(construct_linkless_octree_id);
   HashedLightManager::constructLinklessOctree();
-  this->logger.endLog();
+  this->logger.endLog(construct_linkless_octree_id);
+}
+
+
+void HashedLightManagerLogged::constructLinklessOctreeMorton() {
+  static const logged::ScopeId construct_linkless_octree_morton_id =
+    logged::internScope("HashedLightManager::constructLinklessOctreeMorton");
+  this->logger.startLog(construct_linkless_octree_morton_id);
+  HashedLightManager::constructLinklessOctreeMorton();
+  this->logger.endLog(construct_linkless_octree_morton_id);
+}
+
+
+void HashedLightManagerLogged::autoTune() {
+  static const logged::ScopeId auto_tune_id =
+    logged::internScope("HashedLightManager::autoTune");
+  this->logger.startLog(auto_tune_id);
+  HashedLightManager::autoTune();
+  this->logger.endLog(auto_tune_id);
+}
+
+
+HashedMemoryUsage HashedLightManagerLogged::getMemoryUsage() {
+  pipeline::hashed::LinklessOctree* p_linkless = this->getLinklessOctree();
+
+  HashedMemoryUsage usage = HashedMemoryUsage();
+  usage.n_light_indices = p_linkless->getNLightIndices();
+  usage.light_octree_depth = this->getLightOctree()->getDepth();
+  usage.n_levels = p_linkless->getNLevels();
+
+  std::vector<SpatialHashFunction<glm::u8vec2>*>* octree_tables =
+    p_linkless->getOctreeHashMaps();
+  std::vector<SpatialHashFunction<glm::uvec2>*>* data_tables =
+    p_linkless->getDataHashMaps();
+  std::vector<bool>* exists = p_linkless->getDataHashMapsExists();
+
+  std::size_t n_offset_bytes = 0;
+  for (unsigned int i = 0; i < octree_tables->size(); ++i) {
+    usage.n_gpu_texture_bytes += p_linkless->getLevelTextureBytes(i);
+    usage.n_gpu_packed_bytes += p_linkless->getLevelPackedBytes(i);
+
+    std::size_t m = octree_tables->at(i)->getM();
+    std::size_t r = octree_tables->at(i)->getR();
+    usage.n_octree_hash_entries += m * m * m;
+    usage.n_octree_offset_entries += r * r * r;
+    n_offset_bytes += octree_tables->at(i)->getOffsetTableBytes();
+    if (octree_tables->at(i)->isDense()) usage.n_dense_tables += 1;
+
+    if (exists->at(i)) {
+      m = data_tables->at(i)->getM();
+      r = data_tables->at(i)->getR();
+      usage.n_data_tables += 1;
+      usage.n_data_hash_entries += m * m * m;
+      usage.n_data_offset_entries += r * r * r;
+      n_offset_bytes += data_tables->at(i)->getOffsetTableBytes();
+      if (data_tables->at(i)->isDense()) usage.n_dense_tables += 1;
+    }
+  }
+
+  usage.n_bytes = 
+    usage.n_light_indices * sizeof(GLuint) +
+    usage.n_octree_hash_entries * sizeof(glm::u8vec2) +
+    usage.n_data_hash_entries * sizeof(glm::uvec2) +
+    n_offset_bytes;
+  usage.mean_fetches_per_query = p_linkless->getMeanNFetches();
+  return usage;
 }
 
 
@@ -78,16 +151,34 @@ void HashedLightManagerLogged::exportMemoryUsageData(const std::string& path) {
                            , "n_levels" : n_levels
                            , "n_octree_tables" : octree_tables
                            , "n_hash_tables" : hash_tables
-                           , "tables" : [ { "octree_table" : { "m" : m
+                           , "mean_fetches" : mean_fetches
+                           , "tables" : [ { "gpu_bytes" : { "textures" : bytes
+                                                          , "packed" : bytes
+                                                          }
+                                          , "octree_table" : { "m" : m
                                                              , "r" : r
+                                                             , "dense" : dense
+                                                             , "wide_offsets" : wide
                                                              }
                                           , "data_table" : { "exists": exists
                                                            , "m" : m
                                                            , "r" : r
+                                                           , "dense" : dense
+                                                           , "wide_offsets" : wide
                                                            }
                                           }
                                         ]
+     , "auto_tune" : { "minimum_node_size" : node_size
+                     , "starting_depth" : starting_depth
+                     , "r_increase_ratio" : ratio
+                     , "memory_budget" : bytes
+                     , "predicted_bytes" : bytes
+                     , "predicted_fetches" : fetches
+                     , "meets_budget" : meets_budget
+                     }
      }
+     where auto_tune is only written if this HashedLightManagerLogged has 
+     been auto tuned.
    */
   pipeline::hashed::LinklessOctree* p_linkless = this->getLinklessOctree();
   pipeline::hashed::LightOctree* p_light = this->getLightOctree();
@@ -100,7 +191,7 @@ void HashedLightManagerLogged::exportMemoryUsageData(const std::string& path) {
   writer.Key("light_indices");
   writer.StartObject();
     writer.Key("length");
-    writer.Int(p_linkless->getLightIndices()->size());
+    writer.Int(p_linkless->getNLightIndices());
   writer.EndObject();
   // ---------------------------
   writer.Key("light_octree");
@@ -135,6 +226,8 @@ void HashedLightManagerLogged::exportMemoryUsageData(const std::string& path) {
     writer.Uint(p_linkless->getDepth());
     writer.Key("n_levels");
     writer.Uint(p_linkless->getNLevels());
+    writer.Key("mean_fetches");
+    writer.Double(p_linkless->getMeanNFetches());
     writer.Key("tables");
     writer.StartArray();
     
@@ -147,12 +240,23 @@ void HashedLightManagerLogged::exportMemoryUsageData(const std::string& path) {
     std::vector<bool>* exists = p_linkless->getDataHashMapsExists();
     for (unsigned int i = 0; i < octree_tables->size(); ++i) {
       writer.StartObject();
+        writer.Key("gpu_bytes");
+        writer.StartObject();
+          writer.Key("textures");
+          writer.Uint64(p_linkless->getLevelTextureBytes(i));
+          writer.Key("packed");
+          writer.Uint64(p_linkless->getLevelPackedBytes(i));
+        writer.EndObject();
         writer.Key("octree_table");
         writer.StartObject();
           writer.Key("m");
           writer.Uint(octree_tables->at(i)->getM());
           writer.Key("r");
           writer.Uint(octree_tables->at(i)->getR());
+          writer.Key("dense");
+          writer.Bool(octree_tables->at(i)->isDense());
+          writer.Key("wide_offsets");
+          writer.Bool(octree_tables->at(i)->hasWideOffsets());
         writer.EndObject();
         writer.Key("data_table");
         writer.StartObject();
@@ -164,6 +268,10 @@ void HashedLightManagerLogged::exportMemoryUsageData(const std::string& path) {
             writer.Uint(data_tables->at(i)->getM());
             writer.Key("r");
             writer.Uint(data_tables->at(i)->getR());
+            writer.Key("dense");
+            writer.Bool(data_tables->at(i)->isDense());
+            writer.Key("wide_offsets");
+            writer.Bool(data_tables->at(i)->hasWideOffsets());
           }
         writer.EndObject();
       writer.EndObject();
@@ -171,6 +279,27 @@ void HashedLightManagerLogged::exportMemoryUsageData(const std::string& path) {
     
     writer.EndArray();
   writer.EndObject();
+  // ---------------------------
+  if (this->hasTuned()) {
+    const HashedTuning& tuning = this->getTuning();
+    writer.Key("auto_tune");
+    writer.StartObject();
+      writer.Key("minimum_node_size");
+      writer.Double(tuning.minimum_node_size);
+      writer.Key("starting_depth");
+      writer.Uint(tuning.starting_depth);
+      writer.Key("r_increase_ratio");
+      writer.Double(tuning.r_increase_ratio);
+      writer.Key("memory_budget");
+      writer.Uint64(this->getMemoryBudget());
+      writer.Key("predicted_bytes");
+      writer.Uint64(tuning.predicted_bytes);
+      writer.Key("predicted_fetches");
+      writer.Double(tuning.predicted_fetches);
+      writer.Key("meets_budget");
+      writer.Bool(tuning.meets_budget);
+    writer.EndObject();
+  }
   writer.EndObject();
 
   std::ofstream output_stream;
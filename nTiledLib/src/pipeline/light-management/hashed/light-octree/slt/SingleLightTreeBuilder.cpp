@@ -272,6 +272,16 @@ unsigned int SingleLightTreeBuilder::getMaxNNodesSLT(const world::PointLight& li
 }
 
 
+glm::vec3 SingleLightTreeBuilder::getOriginSLT(const world::PointLight& light) const {
+  glm::vec3 octree_origin = this->getOriginOctree();
+  double width = this->getMaxSizeSLT(light);
+
+  return glm::vec3(floor((light.position.x - light.radius - octree_origin.x) / width) * width + octree_origin.x,
+                   floor((light.position.y - light.radius - octree_origin.y) / width) * width + octree_origin.y,
+                   floor((light.position.z - light.radius - octree_origin.z) / width) * width + octree_origin.z);
+}
+
+
 NodeType SingleLightTreeBuilder::determineNodeType(glm::vec3 node_origin,
                                                    double node_size,
                                                    const Lattice& lattice) const {
@@ -321,15 +331,9 @@ NodeType SingleLightTreeBuilder::determineNodeType(glm::vec3 node_origin,
 
 
 SingleLightTree* SingleLightTreeBuilder::constructSLT(const world::PointLight& light) const {
-  glm::vec3 octree_origin = this->getOriginOctree();
-
   unsigned int n_nodes = this->getMaxNNodesSLT(light);
   double width = this->getMaxSizeSLT(light);
-
-  // calculate origin 
-  glm::vec3 origin = glm::vec3(floor((light.position.x - light.radius - octree_origin.x) / width) * width + octree_origin.x,
-                               floor((light.position.y - light.radius - octree_origin.y) / width) * width + octree_origin.y,
-                               floor((light.position.z - light.radius - octree_origin.z) / width) * width + octree_origin.z);
+  glm::vec3 origin = this->getOriginSLT(light);
 
   Lattice* p_lattice = this->constructLattice(light);
 
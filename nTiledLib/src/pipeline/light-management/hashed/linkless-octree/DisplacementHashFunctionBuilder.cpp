@@ -0,0 +1,249 @@
+#include "pipeline\light-management\hashed\linkless-octree\DisplacementHashFunctionBuilder.h"
+
+// ---------------------------------------------------------------------------
+//  Libraries
+// ---------------------------------------------------------------------------
+#include <cmath>
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+//  nTiled Headers
+// ---------------------------------------------------------------------------
+#include "math\util.h"
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+#include "log\Profiler.h"
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+/*! @brief Fraction of the hash table H which is filled initially. */
+static const double load_factor = 0.8;
+
+/*! @brief Mean number of entries per bucket, and thus per entry of Phi. */
+static const double bucket_size = 4.0;
+
+
+template <class R>
+DisplacementHashFunctionBuilder<R>::DisplacementHashFunctionBuilder() :
+    gen(std::mt19937(22)) {
+}
+
+
+template <class R>
+DisplacementHashFunctionBuilder<R>::DisplacementHashFunctionBuilder(unsigned int seed) :
+    gen(std::mt19937(seed)) {
+}
+
+
+template <class R>
+SpatialHashFunction<R>* DisplacementHashFunctionBuilder<R>::constructHashFunction(
+    const std::vector<std::pair<glm::uvec3, R>>& entries,
+    unsigned int max_attempts,
+    float ratio,
+    bool has_pow2_m) {
+  static const logged::ScopeId construct_hash_function_id =
+    logged::internScope("DisplacementHashFunctionBuilder::constructHashFunction");
+  // retries are logged alongside those of the SpatialHashFunctionBuilder,
+  // such that they are compared per backend.
+  static const logged::ScopeId n_retries_id =
+    logged::internScope("SpatialHashFunctionBuilder::retries");
+  logged::ProfileScope profile_scope(construct_hash_function_id);
+
+  // Sanitise input
+  // --------------------------------------------------------------------------
+  if (entries.empty()) throw SpatialHashFunctionConstructionException();
+
+  // build tables
+  // --------------------------------------------------------------------------
+  unsigned int i = 0;
+  bool has_build = false;
+
+  Table<R>* p_hash_table = nullptr;
+  Table<glm::u16vec3>* p_offset_table = nullptr;
+
+  std::vector<Bucket> buckets;
+
+  do {
+    glm::uvec2 dims = this->getTableDims(entries.size(), ratio, i, has_pow2_m);
+    unsigned int m_dim = dims.x;
+    unsigned int r_dim = dims.y;
+
+    if (this->mapBuckets(entries, m_dim, r_dim, buckets)) {
+      p_hash_table = new Table<R>(m_dim);
+      p_offset_table = new Table<glm::u16vec3>(r_dim);
+      has_build = this->placeBuckets(buckets, *p_hash_table, *p_offset_table);
+
+      if (!has_build) {
+        delete p_hash_table;
+        delete p_offset_table;
+      }
+    }
+    i++;
+  } while (!has_build && i < max_attempts && !this->isCancelled());
+
+  if (this->isCancelled()) {
+    throw SpatialHashFunctionConstructionCancelledException();
+  }
+  logged::profileValue(n_retries_id, double(i - 1));
+
+  // check if build
+  // --------------------------------------------------------------------------
+  if (!has_build) {
+    throw SpatialHashFunctionConstructionExhaustedException();
+  }
+
+  return (new SpatialHashFunction<R>(p_hash_table, p_offset_table));
+}
+
+
+template <class R>
+glm::uvec2 DisplacementHashFunctionBuilder<R>::getTableDims(std::size_t n_entries,
+                                                            float ratio,
+                                                            unsigned int n_retries,
+                                                            bool has_pow2_m) const {
+  double n = double(n_entries);
+  unsigned int m_base = unsigned int(ceil(cbrt(n / load_factor)));
+  unsigned int r_dim = unsigned int(ceil(cbrt(n / bucket_size)));
+  if ((r_dim & 1) == 0) r_dim++;
+
+  // every failed attempt increases m by ratio, and at least by one
+  for (unsigned int i = 0; i < n_retries; ++i) {
+    m_base = std::max(unsigned int(ceil(ratio * m_base)), m_base + 1);
+  }
+
+  unsigned int m_dim = m_base;
+  if (has_pow2_m) m_dim = math::getNextPow2(m_dim);
+  else if ((m_dim & 1) == 0) m_dim++;
+
+  // h_0 and h_1 only distinguish all points if m and r are coprime
+  while (m_dim > 1 && r_dim > 1 && math::gcd(m_dim, r_dim) != 1) r_dim += 2;
+  return glm::uvec2(m_dim, r_dim);
+}
+
+
+template <class R>
+bool DisplacementHashFunctionBuilder<R>::mapBuckets(
+    const std::vector<std::pair<glm::uvec3, R>>& entries,
+    unsigned int m_dim,
+    unsigned int r_dim,
+    std::vector<Bucket>& buckets) const {
+  if (m_dim == 0 || r_dim == 0)
+    throw SpatialHashFunctionConstructionInvalidArgException();
+
+  buckets.clear();
+  buckets.resize(r_dim * r_dim * r_dim);
+
+  for (unsigned int x = 0; x < r_dim; x++) {
+    for (unsigned int y = 0; y < r_dim; y++) {
+      for (unsigned int z = 0; z < r_dim; z++) {
+        buckets[math::toIndex(glm::uvec3(x, y, z), r_dim)].hash_1 = glm::uvec3(x, y, z);
+      }
+    }
+  }
+
+  for (const std::pair<glm::uvec3, R>& entry : entries) {
+    glm::uvec3 h_0 = glm::uvec3(entry.first.x % m_dim,
+                                entry.first.y % m_dim,
+                                entry.first.z % m_dim);
+    glm::uvec3 h_1 = glm::uvec3(entry.first.x % r_dim,
+                                entry.first.y % r_dim,
+                                entry.first.z % r_dim);
+    Bucket& bucket = buckets[math::toIndex(h_1, r_dim)];
+
+    bool is_duplicate = false;
+    for (const std::pair<glm::uvec3, R>& element : bucket.elements) {
+      if (element.first == h_0) {
+        if (!(element.second == entry.second)) return false;
+        is_duplicate = true;
+        break;
+      }
+    }
+    if (!is_duplicate) {
+      bucket.elements.push_back(std::pair<glm::uvec3, R>(h_0, entry.second));
+    }
+  }
+
+  std::stable_sort(buckets.begin(),
+                   buckets.end(),
+                   [](const Bucket& a, const Bucket& b) { 
+                     return a.elements.size() > b.elements.size(); 
+                   });
+  return true;
+}
+
+
+template <class R>
+bool DisplacementHashFunctionBuilder<R>::placeBuckets(
+    const std::vector<Bucket>& buckets,
+    Table<R>& hash_table,
+    Table<glm::u16vec3>& offset_table) {
+  if (math::isPow2(hash_table.getDim())) {
+    return this->placeBucketsWrapped<true>(buckets, hash_table, offset_table);
+  } else {
+    return this->placeBucketsWrapped<false>(buckets, hash_table, offset_table);
+  }
+}
+
+
+template <class R>
+template <bool has_pow2_m>
+bool DisplacementHashFunctionBuilder<R>::placeBucketsWrapped(
+    const std::vector<Bucket>& buckets,
+    Table<R>& hash_table,
+    Table<glm::u16vec3>& offset_table) {
+  unsigned int m_dim = hash_table.getDim();
+
+  // offsets below m suffice to reach every entry of the hash table, and
+  // are kept below 256 whenever the hash table allows it.
+  std::uniform_int_distribution<unsigned short> distribution =
+    std::uniform_int_distribution<unsigned short>(
+      0, unsigned short(std::min(m_dim - 1, 65535u)));
+
+  for (const Bucket& bucket : buckets) {
+    // all further buckets are empty due to sorting
+    if (bucket.elements.empty()) break;
+
+    bool is_placed = false;
+    glm::u16vec3 offset;
+
+    for (unsigned int probe = 0; probe < n_max_probes && !is_placed; ++probe) {
+      if (!this->continueConstruction()) return false;
+      offset = glm::u16vec3(distribution(this->gen),
+                            distribution(this->gen),
+                            distribution(this->gen));
+
+      is_placed = true;
+      for (const std::pair<glm::uvec3, R>& element : bucket.elements) {
+        if (hash_table.isDefined(glm::uvec3(
+              math::wrap<has_pow2_m>(element.first.x + offset.x, m_dim),
+              math::wrap<has_pow2_m>(element.first.y + offset.y, m_dim),
+              math::wrap<has_pow2_m>(element.first.z + offset.z, m_dim)))) {
+          is_placed = false;
+          break;
+        }
+      }
+    }
+
+    if (!is_placed) return false;
+
+    offset_table.setPoint(bucket.hash_1, offset);
+    for (const std::pair<glm::uvec3, R>& element : bucket.elements) {
+      hash_table.setPoint(glm::uvec3(math::wrap<has_pow2_m>(element.first.x + offset.x, m_dim),
+                                     math::wrap<has_pow2_m>(element.first.y + offset.y, m_dim),
+                                     math::wrap<has_pow2_m>(element.first.z + offset.z, m_dim)),
+                          element.second);
+    }
+  }
+
+  return true;
+}
+
+
+// Class initialisations
+template class DisplacementHashFunctionBuilder<glm::u8vec2>;
+template class DisplacementHashFunctionBuilder<glm::uvec2>;
+
+} // hashed
+} // pipeline
+} // nTiled
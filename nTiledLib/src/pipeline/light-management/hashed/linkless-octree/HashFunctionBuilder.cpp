@@ -0,0 +1,47 @@
+#include "pipeline\light-management\hashed\linkless-octree\HashFunctionBuilder.h"
+
+// ---------------------------------------------------------------------------
+//  nTiled Headers
+// ---------------------------------------------------------------------------
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+template <class R>
+SpatialHashFunction<R>* HashFunctionBuilder<R>::constructDenseFunction(
+    const std::vector<std::pair<glm::uvec3, R>>& entries,
+    unsigned int n_nodes) {
+  // Sanitise input
+  // --------------------------------------------------------------------------
+  if (entries.empty()) throw SpatialHashFunctionConstructionException();
+
+  // build tables
+  // --------------------------------------------------------------------------
+  Table<R>* p_hash_table = new Table<R>(n_nodes);
+  Table<glm::u16vec3>* p_offset_table = new Table<glm::u16vec3>(1);
+  p_offset_table->setPoint(glm::uvec3(0), glm::u16vec3(0));
+
+  for (const std::pair<glm::uvec3, R>& entry : entries) {
+    if (entry.first.x >= n_nodes ||
+        entry.first.y >= n_nodes ||
+        entry.first.z >= n_nodes) {
+      delete p_hash_table;
+      delete p_offset_table;
+      throw SpatialHashFunctionConstructionInvalidArgException();
+    }
+    p_hash_table->setPoint(entry.first, entry.second);
+  }
+
+  return (new SpatialHashFunction<R>(p_hash_table, p_offset_table, true));
+}
+
+
+// Class initialisations
+template class HashFunctionBuilder<glm::u8vec2>;
+template class HashFunctionBuilder<glm::uvec2>;
+
+} // hashed
+} // pipeline
+} // nTiled
@@ -8,6 +8,7 @@
 
 
 #include "pipeline\pipeline-util\GLError.h"
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
 
 namespace nTiled {
 namespace pipeline {
@@ -32,73 +33,41 @@ LinklessOctree::LinklessOctree(
     p_octree_hash_maps(p_octree_hash_maps),
     p_data_hash_map_exists(p_data_hash_map_exists),
     p_data_hash_maps(p_data_hash_maps),
-    p_light_indices(p_light_indices) {
-  this->gl_octree_data = {};
-  this->gl_octree_offset = {};
-  this->gl_light_data = {};
-  this->gl_light_offset = {};
-
-  for (unsigned int i = 0; i < this->n_levels; ++i) {
-    std::vector<GLubyte> octree_dat = {};
-    for (glm::u8vec2 val : this->p_octree_hash_maps->at(i)->getHashTable()) {
-      octree_dat.push_back(GLubyte(val.x));
-      octree_dat.push_back(GLubyte(val.y));
-      octree_dat.push_back(GLubyte(0));
-      octree_dat.push_back(GLubyte(0));
-    }
-    this->gl_octree_data.push_back(octree_dat);
+    p_light_indices(p_light_indices),
+    n_light_indices(p_light_indices->size()),
+    has_host_tables(true),
+    is_loaded_textures(false),
+    is_loaded_packed(false) {
+}
 
 
-    std::vector<GLubyte> octree_offset = {};
-    for (glm::u8vec3 val : this->p_octree_hash_maps->at(i)->getOffsetTable()) {
-      octree_offset.push_back(GLubyte(val.x));
-      octree_offset.push_back(GLubyte(val.y));
-      octree_offset.push_back(GLubyte(val.z));
-      octree_offset.push_back(GLubyte(0));
+LinklessOctree::~LinklessOctree() {
+  // Remove GPU datastructures
+  // --------------------------------------------------------------------------
+  if (this->is_loaded_textures) {
+    GLsizei n_data_layers = 0;
+    for (bool v : *(this->p_data_hash_map_exists)) {
+      if (v) n_data_layers += 1;
     }
-    this->gl_octree_offset.push_back(octree_offset);
-
 
-    std::vector<GLuint> light_dat = {};
-    if (this->p_data_hash_map_exists->at(i)) {
-      for (glm::uvec2 val : this->p_data_hash_maps->at(i)->getHashTable()) {
-        light_dat.push_back(GLuint(val.x));
-        light_dat.push_back(GLuint(val.y));
-        light_dat.push_back(GLuint(0));
-        light_dat.push_back(GLuint(0));
-      }
-    }
-    this->gl_light_data.push_back(light_dat);
+    glDeleteTextures(n_data_layers, ps_gfx_data_node_tables);
+    glDeleteTextures(n_data_layers, ps_gfx_data_offset_tables);
 
+    glDeleteTextures(this->getNLevels(), ps_gfx_octree_node_tables);
+    glDeleteTextures(this->getNLevels(), ps_gfx_octree_offset_tables);
 
-    std::vector<GLubyte> light_offset = {};
-    if (this->p_data_hash_map_exists->at(i)) {
-      for (glm::u8vec3 val : this->p_data_hash_maps->at(i)->getOffsetTable()) {
-        light_offset.push_back(GLubyte(val.x));
-        light_offset.push_back(GLubyte(val.y));
-        light_offset.push_back(GLubyte(val.z));
-        light_offset.push_back(GLubyte(0));
-      }
-    }
-    this->gl_light_offset.push_back(light_offset);
+    delete[] ps_gfx_data_node_tables;
+    delete[] ps_gfx_data_offset_tables;
+    delete[] ps_gfx_octree_node_tables;
+    delete[] ps_gfx_octree_offset_tables;
   }
-}
-
 
-LinklessOctree::~LinklessOctree() {
-  // Remove GPU datastructures
-  // --------------------------------------------------------------------------
-  GLsizei n_data_layers = 0;
-  for (bool v : *(this->p_data_hash_map_exists)) {
-    if (v) n_data_layers += 1;
+  if (this->is_loaded_packed) {
+    glDeleteBuffers(1, &this->p_gfx_packed_octree_tables);
+    glDeleteBuffers(1, &this->p_gfx_packed_light_tables);
+    glDeleteBuffers(1, &this->p_gfx_packed_offset_tables);
   }
 
-  glDeleteTextures(n_data_layers, ps_gfx_data_node_tables);
-  glDeleteTextures(n_data_layers, ps_gfx_data_offset_tables);
-
-  glDeleteTextures(this->getNLevels(), ps_gfx_octree_node_tables);
-  glDeleteTextures(this->getNLevels(), ps_gfx_octree_offset_tables);
-
   //  Remove CPU datastructures
   // --------------------------------------------------------------------------
   for (SpatialHashFunction<glm::u8vec2>* p_hfunc : *p_octree_hash_maps)
@@ -175,8 +144,138 @@ std::vector<GLuint> LinklessOctree::retrieveLights(glm::vec3 point) const {
 }
 
 
+double LinklessOctree::getMeanNFetches() const {
+  double n_fetches = 0.0;
+  double n_nodes = double(this->getInitialNNodes());
+
+  for (unsigned int layer_i = 0; layer_i < this->getNLevels(); ++layer_i) {
+    // Fraction of the volume covered by the branches of this level, each of
+    // which is looked up in the octree table.
+    const SpatialHashFunction<glm::u8vec2>* p_octree_map = 
+      this->p_octree_hash_maps->at(layer_i);
+    double branch_fraction = p_octree_map->getNEntries() / (n_nodes * n_nodes * n_nodes);
+    n_fetches += branch_fraction * (p_octree_map->isDense() ? 1.0 : 2.0);
+
+    // Fraction of the volume covered by the non empty leaves of this level,
+    // each of which is looked up in the data table.
+    n_nodes *= 2.0;
+    if (this->p_data_hash_map_exists->at(layer_i)) {
+      const SpatialHashFunction<glm::uvec2>* p_data_map = 
+        this->p_data_hash_maps->at(layer_i);
+      double leaf_fraction = p_data_map->getNEntries() / (n_nodes * n_nodes * n_nodes);
+      n_fetches += leaf_fraction * (p_data_map->isDense() ? 1.0 : 2.0);
+    }
+  }
+
+  return n_fetches;
+}
+
+
+std::size_t LinklessOctree::getLevelTextureBytes(unsigned int level) const {
+  // Octree and offset entries are stored as RGBA8UI, light entries as 
+  // RGBA32UI and wide offset entries as RGBA16UI.
+  const SpatialHashFunction<glm::u8vec2>* p_octree_map = this->p_octree_hash_maps->at(level);
+  std::size_t m = p_octree_map->getM();
+  std::size_t r = p_octree_map->getR();
+  std::size_t n_bytes = m * m * m * 4 + r * r * r * (p_octree_map->hasWideOffsets() ? 8 : 4);
+
+  if (this->p_data_hash_map_exists->at(level)) {
+    const SpatialHashFunction<glm::uvec2>* p_data_map = this->p_data_hash_maps->at(level);
+    m = p_data_map->getM();
+    r = p_data_map->getR();
+    n_bytes += m * m * m * 16 + r * r * r * (p_data_map->hasWideOffsets() ? 8 : 4);
+  }
+  return n_bytes;
+}
+
+
+std::size_t LinklessOctree::getLevelPackedBytes(unsigned int level) const {
+  // Octree entries are stored as two bytes, light entries as two uints and
+  // offset entries as a single uint, or two if they are wide.
+  const SpatialHashFunction<glm::u8vec2>* p_octree_map = this->p_octree_hash_maps->at(level);
+  std::size_t m = p_octree_map->getM();
+  std::size_t r = p_octree_map->getR();
+  std::size_t n_bytes = m * m * m * 2 + r * r * r * (p_octree_map->hasWideOffsets() ? 8 : 4);
+
+  if (this->p_data_hash_map_exists->at(level)) {
+    const SpatialHashFunction<glm::uvec2>* p_data_map = this->p_data_hash_maps->at(level);
+    m = p_data_map->getM();
+    r = p_data_map->getR();
+    n_bytes += m * m * m * 8 + r * r * r * (p_data_map->hasWideOffsets() ? 8 : 4);
+  }
+  return n_bytes;
+}
+
+
 // ----------------------------------------------------------------------------
 //  openGL methods
+// ----------------------------------------------------------------------------
+//  Texel conversion
+/*! @brief Convert the hash table of an octree map to RGBA8UI texels. */
+static std::vector<GLubyte> toOctreeTexels(const SpatialHashFunction<glm::u8vec2>& map) {
+  std::vector<GLubyte> texels = {};
+  texels.reserve(map.getHashTable().size() * 4);
+  for (glm::u8vec2 val : map.getHashTable()) {
+    texels.push_back(GLubyte(val.x));
+    texels.push_back(GLubyte(val.y));
+    texels.push_back(GLubyte(0));
+    texels.push_back(GLubyte(0));
+  }
+  return texels;
+}
+
+
+/*! @brief Convert the hash table of a light map to RGBA32UI texels. */
+static std::vector<GLuint> toLightTexels(const SpatialHashFunction<glm::uvec2>& map) {
+  std::vector<GLuint> texels = {};
+  texels.reserve(map.getHashTable().size() * 4);
+  for (glm::uvec2 val : map.getHashTable()) {
+    texels.push_back(GLuint(val.x));
+    texels.push_back(GLuint(val.y));
+    texels.push_back(GLuint(0));
+    texels.push_back(GLuint(0));
+  }
+  return texels;
+}
+
+
+/*! @brief Convert the offset table of a map to RGBA texels of type T. */
+template <class T, class R>
+static std::vector<T> toOffsetTexels(const SpatialHashFunction<R>& map) {
+  std::size_t r = map.getR();
+  std::vector<T> texels = {};
+  texels.reserve(r * r * r * 4);
+  for (std::size_t i = 0; i < r * r * r; ++i) {
+    glm::u16vec3 val = map.getOffset(i);
+    texels.push_back(T(val.x));
+    texels.push_back(T(val.y));
+    texels.push_back(T(val.z));
+    texels.push_back(T(0));
+  }
+  return texels;
+}
+
+
+/*! @brief Append the offset table of a map to the packed offset tables, as
+ *         the lower three bytes of a uint, or as 16 bits per dimension in
+ *         two uints if its offsets are wide.
+ */
+template <class R>
+static void packOffsetTable(const SpatialHashFunction<R>& map,
+                            std::vector<GLuint>& offset_tables) {
+  std::size_t r = map.getR();
+  for (std::size_t i = 0; i < r * r * r; ++i) {
+    glm::u16vec3 val = map.getOffset(i);
+    if (map.hasWideOffsets()) {
+      offset_tables.push_back(GLuint(val.x) | (GLuint(val.y) << 16));
+      offset_tables.push_back(GLuint(val.z));
+    } else {
+      offset_tables.push_back(GLuint(val.x) | (GLuint(val.y) << 8) | (GLuint(val.z) << 16));
+    }
+  }
+}
+
+
 // ----------------------------------------------------------------------------
 //  loadSpatialTable
 template <class R>
@@ -231,10 +330,56 @@ template void loadSpatialTable(GLuint*,
                                GLuint,       // shader
                                std::string); // sampler name
 
+template void loadSpatialTable(GLuint*,      
+                               GLuint,       // index
+                               GLint,        // internal_format
+                               GLsizei,      // dimension
+                               GLenum,       // pixel_data_format
+                               GLenum,       // pixel_data_type
+                               const std::vector<GLushort>&, // data
+                               GLuint,       // shader
+                               std::string); // sampler name
+
+// ----------------------------------------------------------------------------
+//  loadOffsetTable
+/*! @brief Load the offset table of the map as a RGBA8UI texture, or as a
+ *         RGBA16UI texture if its offsets do not fit in 8 bits.
+ */
+template <class R>
+static void loadOffsetTable(GLuint* p_tex,
+                            GLuint index,
+                            const SpatialHashFunction<R>& map,
+                            GLuint shader,
+                            std::string glsl_sampler_name) {
+  if (map.hasWideOffsets()) {
+    loadSpatialTable<GLushort>(p_tex,
+                               index,
+                               GL_RGBA16UI,
+                               map.getR(),
+                               GL_RGBA_INTEGER,
+                               GL_UNSIGNED_SHORT,
+                               toOffsetTexels<GLushort>(map),
+                               shader,
+                               glsl_sampler_name);
+  } else {
+    loadSpatialTable<GLubyte>(p_tex,
+                              index,
+                              GL_RGBA8UI,
+                              map.getR(),
+                              GL_RGBA_INTEGER,
+                              GL_UNSIGNED_BYTE,
+                              toOffsetTexels<GLubyte>(map),
+                              shader,
+                              glsl_sampler_name);
+  }
+}
+
 // ----------------------------------------------------------------------------
 //  loadToShader
 
 void LinklessOctree::loadToShader(GLuint shader) {
+  if (!this->hasHostTables()) throw SpatialHashFunctionReleasedException();
+
   // --------------------------------------------------------------------------
   //  construct Initial openGL values
   unsigned int n_levels = this->getNLevels();
@@ -254,7 +399,10 @@ void LinklessOctree::loadToShader(GLuint shader) {
   this->ps_gfx_data_node_tables = new GLuint[n_data_layers];
   this->ps_gfx_data_offset_tables = new GLuint[n_data_layers];
 
-  // create octree textures per level
+  // create octree textures per level, the offset tables of dense levels are
+  // loaded as well such that every sampler refers to a 3d texture. The texels
+  // of a table are only converted when it is loaded, such that no more than
+  // a single converted table is held in memory at any time.
   unsigned int data_layer_i = 0;
   for (unsigned int i = 0; i < n_levels; i++) {
     // ------------------------------------------------------------------------
@@ -265,21 +413,17 @@ void LinklessOctree::loadToShader(GLuint shader) {
                               this->p_octree_hash_maps->at(i)->getM(),
                               GL_RGBA_INTEGER,
                               GL_UNSIGNED_BYTE,
-                              this->gl_octree_data.at(i),//this->p_octree_hash_maps_data_opengl[i],
+                              toOctreeTexels(*this->p_octree_hash_maps->at(i)),
                               shader,
                               "octree_data_tables[" + std::to_string(i) + "]");
 
     // ------------------------------------------------------------------------
     // load octree_offset_tables[i]
-    loadSpatialTable<GLubyte>(&this->ps_gfx_octree_offset_tables[i],
-                              1 + 4 * (i + 2),
-                              GL_RGBA8UI,
-                              this->p_octree_hash_maps->at(i)->getR(),
-                              GL_RGBA_INTEGER,
-                              GL_UNSIGNED_BYTE,
-                              this->gl_octree_offset.at(i),//this->p_octree_hash_maps_offset_opengl[i],
-                              shader,
-                              "octree_offset_tables[" + std::to_string(i) + "]");
+    loadOffsetTable(&this->ps_gfx_octree_offset_tables[i],
+                    1 + 4 * (i + 2),
+                    *this->p_octree_hash_maps->at(i),
+                    shader,
+                    "octree_offset_tables[" + std::to_string(i) + "]");
 
     // load data nodes
     if (this->p_data_hash_map_exists->at(i)) {
@@ -291,26 +435,126 @@ void LinklessOctree::loadToShader(GLuint shader) {
                                this->p_data_hash_maps->at(i)->getM(),
                                GL_RGBA_INTEGER,
                                GL_UNSIGNED_INT,
-                               this->gl_light_data.at(i),//this->p_data_hash_maps_data_opengl[i],
+                               toLightTexels(*this->p_data_hash_maps->at(i)),
                                shader,
                                "light_data_tables[" + std::to_string(i) + "]");
 
       // ----------------------------------------------------------------------
       // Load leaf_offset_tables[i]
-      loadSpatialTable<GLubyte>(&this->ps_gfx_data_offset_tables[data_layer_i],
-                                3 + 4 * (i + 2),
-                                GL_RGBA8UI,
-                                this->p_data_hash_maps->at(i)->getR(),
-                                GL_RGBA_INTEGER,
-                                GL_UNSIGNED_BYTE,
-                                this->gl_light_offset.at(i), //this->p_data_hash_maps_offset_opengl[i],
-                                shader,
-                                "light_offset_tables[" + std::to_string(i) + "]");
+      loadOffsetTable(&this->ps_gfx_data_offset_tables[data_layer_i],
+                      3 + 4 * (i + 2),
+                      *this->p_data_hash_maps->at(i),
+                      shader,
+                      "light_offset_tables[" + std::to_string(i) + "]");
 
       data_layer_i += 1;
     }
   }
 
+  this->is_loaded_textures = true;
+  this->loadLightIndicesAndUniforms(shader);
+}
+
+
+void LinklessOctree::loadToShaderPacked(GLuint shader) {
+  if (!this->hasHostTables()) throw SpatialHashFunctionReleasedException();
+
+  // --------------------------------------------------------------------------
+  //  Pack the tables of all levels
+  unsigned int n_levels = this->getNLevels();
+
+  // Octree entries are packed two per uint, the offset of both the octree
+  // and light tables as the lower three bytes of a single uint, or in two
+  // uints if the offsets of the table are wide.
+  std::vector<GLuint> octree_tables = {};
+  std::vector<GLuint> light_tables = {};
+  std::vector<GLuint> offset_tables = {};
+
+  // Per level the index of the first entry of its table, the dimension m of
+  // its table, the index of the first entry of its offset table and the 
+  // dimension r of its offset table.
+  std::vector<glm::uvec4> octree_table_layouts = {};
+  std::vector<glm::uvec4> light_table_layouts = {};
+
+  std::size_t n_octree_entries = 0;
+  for (unsigned int i = 0; i < n_levels; i++) {
+    const SpatialHashFunction<glm::u8vec2>* p_octree_map = this->p_octree_hash_maps->at(i);
+    octree_table_layouts.push_back(glm::uvec4(GLuint(n_octree_entries),
+                                              p_octree_map->getM(),
+                                              GLuint(offset_tables.size()),
+                                              p_octree_map->getR()));
+
+    for (glm::u8vec2 val : p_octree_map->getHashTable()) {
+      GLuint entry = GLuint(val.x) | (GLuint(val.y) << 8);
+      if ((n_octree_entries & 1) == 0) {
+        octree_tables.push_back(entry);
+      } else {
+        octree_tables.back() |= (entry << 16);
+      }
+      n_octree_entries += 1;
+    }
+
+    packOffsetTable(*p_octree_map, offset_tables);
+
+    if (this->p_data_hash_map_exists->at(i)) {
+      const SpatialHashFunction<glm::uvec2>* p_data_map = this->p_data_hash_maps->at(i);
+      light_table_layouts.push_back(glm::uvec4(GLuint(light_tables.size() / 2),
+                                               p_data_map->getM(),
+                                               GLuint(offset_tables.size()),
+                                               p_data_map->getR()));
+
+      for (glm::uvec2 val : p_data_map->getHashTable()) {
+        light_tables.push_back(GLuint(val.x));
+        light_tables.push_back(GLuint(val.y));
+      }
+
+      packOffsetTable(*p_data_map, offset_tables);
+    } else {
+      light_table_layouts.push_back(glm::uvec4(0));
+    }
+  }
+
+  // buffers can not be empty
+  if (light_tables.empty()) light_tables.push_back(0);
+
+  // --------------------------------------------------------------------------
+  //  Load the packed tables
+  glGenBuffers(1, &this->p_gfx_packed_octree_tables);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->p_gfx_packed_octree_tables);
+  glBufferData(GL_SHADER_STORAGE_BUFFER,
+               sizeof(GLuint) * octree_tables.size(),
+               octree_tables.data(),
+               GL_STATIC_DRAW);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, this->p_gfx_packed_octree_tables);
+
+  glGenBuffers(1, &this->p_gfx_packed_light_tables);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->p_gfx_packed_light_tables);
+  glBufferData(GL_SHADER_STORAGE_BUFFER,
+               sizeof(GLuint) * light_tables.size(),
+               light_tables.data(),
+               GL_STATIC_DRAW);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, this->p_gfx_packed_light_tables);
+
+  glGenBuffers(1, &this->p_gfx_packed_offset_tables);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->p_gfx_packed_offset_tables);
+  glBufferData(GL_SHADER_STORAGE_BUFFER,
+               sizeof(GLuint) * offset_tables.size(),
+               offset_tables.data(),
+               GL_STATIC_DRAW);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, this->p_gfx_packed_offset_tables);
+
+  GLint p_octree_table_layouts = glGetUniformLocation(shader, "octree_table_layouts");
+  glUniform4uiv(p_octree_table_layouts, n_levels, glm::value_ptr(octree_table_layouts[0]));
+
+  GLint p_light_table_layouts = glGetUniformLocation(shader, "light_table_layouts");
+  glUniform4uiv(p_light_table_layouts, n_levels, glm::value_ptr(light_table_layouts[0]));
+
+  this->is_loaded_packed = true;
+  this->loadLightIndicesAndUniforms(shader);
+}
+
+
+void LinklessOctree::loadLightIndicesAndUniforms(GLuint shader) {
   // --------------------------------------------------------------------------
   //  Load light indices
   glGenBuffers(1, &this->p_gfx_light_indices);
@@ -339,6 +583,38 @@ void LinklessOctree::loadToShader(GLuint shader) {
   GLuint p_octree_width = glGetUniformLocation(shader, "octree_width");
   float octree_width = float(this->getWidth());
   glUniform1f(p_octree_width, octree_width);
+
+  // bit masks of the dense levels, a single uint holds at most 32 levels
+  if (this->getNLevels() > 32) throw LinklessOctreeDenseLevelsException();
+
+  GLuint octree_dense_levels = 0;
+  GLuint light_dense_levels = 0;
+  for (unsigned int i = 0; i < this->getNLevels(); i++) {
+    if (this->p_octree_hash_maps->at(i)->isDense())
+      octree_dense_levels |= (1u << i);
+    if (this->p_data_hash_map_exists->at(i) && this->p_data_hash_maps->at(i)->isDense())
+      light_dense_levels |= (1u << i);
+  }
+
+  GLuint p_octree_dense_levels = glGetUniformLocation(shader, "octree_dense_levels");
+  glUniform1ui(p_octree_dense_levels, octree_dense_levels);
+
+  GLuint p_light_dense_levels = glGetUniformLocation(shader, "light_dense_levels");
+  glUniform1ui(p_light_dense_levels, light_dense_levels);
+}
+
+
+void LinklessOctree::releaseHostTables() {
+  for (SpatialHashFunction<glm::u8vec2>* p_hfunc : *this->p_octree_hash_maps)
+    p_hfunc->releaseTables();
+
+  for (unsigned int i = 0; i < this->p_data_hash_map_exists->size(); ++i)
+    if (this->p_data_hash_map_exists->at(i))
+      this->p_data_hash_maps->at(i)->releaseTables();
+
+  // swap with an empty vector, as clear does not free its memory
+  std::vector<GLuint>().swap(*this->p_light_indices);
+  this->has_host_tables = false;
 }
 
 
@@ -0,0 +1,319 @@
+#include "pipeline\light-management\hashed\linkless-octree\MortonOctreeBuilder.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <queue>
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "math\morton.h"
+#include "pipeline\light-management\hashed\Exceptions.h"
+#include "pipeline\light-management\hashed\light-octree\NodeDimensions.h"
+
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+// ----------------------------------------------------------------------------
+//  Constructor
+// ----------------------------------------------------------------------------
+MortonOctreeBuilder::MortonOctreeBuilder(glm::vec3 origin,
+                                         unsigned int depth,
+                                         double minimal_node_size,
+                                         unsigned int starting_depth) :
+    origin(origin),
+    depth(depth),
+    minimal_node_size(minimal_node_size),
+    starting_depth(starting_depth),
+    slt_builder(SingleLightTreeBuilder(minimal_node_size, origin)),
+    entry_i(0),
+    has_constructed_starting_level(false),
+    current_level(starting_depth) {
+  // The finest level holds 2^(depth - 1) nodes per dimension, all of which
+  // should fit within the Morton code of an entry.
+  if (depth == 0 || 3 * (depth - 1) > kLevelShift) {
+    throw HashedShadingDepthException();
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+//  Construction methods
+// ----------------------------------------------------------------------------
+/*! @brief PartialNode describes a partially filled node of which the
+ *         children still need to be classified.
+ */
+struct PartialNode {
+  PartialNode(NodeDimensions dim,
+              unsigned int level,
+              glm::uvec3 position) : dim(dim), level(level), position(position) { }
+
+  NodeDimensions dim;
+  unsigned int level;
+  glm::uvec3 position;
+};
+
+
+void MortonOctreeBuilder::addLight(const world::PointLight& light, GLuint index) {
+  unsigned int n_nodes = this->slt_builder.getMaxNNodesSLT(light);
+  double width = this->slt_builder.getMaxSizeSLT(light);
+  glm::vec3 slt_origin = this->slt_builder.getOriginSLT(light);
+
+  // Locate the root of the SingleLightTree the same way
+  // LightOctree::constructAndRetrieveRoot does, every node on its path is a
+  // branch.
+  unsigned int root_level = this->getDepth() - (unsigned int(log2(n_nodes)) + 1);
+  glm::vec3 mid_point_slt = slt_origin + glm::vec3(0.5 * width);
+
+  NodeDimensions node_dim = NodeDimensions(this->origin, this->getWidth());
+  glm::uvec3 position = glm::uvec3(0);
+  glm::bvec3 index_vec;
+
+  for (unsigned int level = 0; level < root_level; ++level) {
+    this->addEntry(level, position, kBranchIndex);
+
+    index_vec = node_dim.getNextIndex(mid_point_slt);
+    position = position + position + glm::uvec3(index_vec);
+    node_dim = node_dim.getNextDimensions(index_vec);
+  }
+
+  // Classify the nodes of the light as SingleLightTreeBuilder::constructSLT
+  // does, emitting entries instead of SLTNodes.
+  Lattice* p_lattice = this->slt_builder.constructLattice(light);
+  NodeType node_type = this->slt_builder.determineNodeType(slt_origin,
+                                                           width,
+                                                           *p_lattice);
+
+  if (node_type == NodeType::Filled) {
+    this->addEntry(root_level, position, index);
+  } else if (node_type == NodeType::Partial) {
+    this->addEntry(root_level, position, kBranchIndex);
+
+    std::queue<PartialNode> queue = {};
+    queue.push(PartialNode(NodeDimensions(slt_origin, width),
+                           root_level,
+                           position));
+
+    while (!queue.empty()) {
+      PartialNode cur = queue.front();
+      queue.pop();
+
+      for (unsigned int x_i = 0; x_i < 2; ++x_i) {
+        for (unsigned int y_i = 0; y_i < 2; ++y_i) {
+          for (unsigned int z_i = 0; z_i < 2; ++z_i) {
+            index_vec = glm::bvec3(x_i == 1,
+                                   y_i == 1,
+                                   z_i == 1);
+            NodeDimensions next_dim = cur.dim.getNextDimensions(index_vec);
+            glm::uvec3 next_position = cur.position + cur.position + glm::uvec3(x_i, y_i, z_i);
+
+            node_type = this->slt_builder.determineNodeType(next_dim.origin,
+                                                            next_dim.size,
+                                                            *p_lattice);
+            if (node_type == NodeType::Partial) {
+              this->addEntry(cur.level + 1, next_position, kBranchIndex);
+              queue.push(PartialNode(next_dim, cur.level + 1, next_position));
+            } else if (node_type == NodeType::Filled) {
+              this->addEntry(cur.level + 1, next_position, index);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  delete p_lattice;
+}
+
+
+void MortonOctreeBuilder::addEntry(unsigned int level,
+                                   glm::uvec3 position,
+                                   GLuint light_index) {
+  if (light_index == kBranchIndex && level <= this->getStartingDepth()) return;
+
+  Entry entry;
+  entry.key = (std::uint64_t(level) << kLevelShift) | math::encodeMorton(position);
+  entry.light_index = light_index;
+  this->entries.push_back(entry);
+}
+
+
+void MortonOctreeBuilder::sortEntries() {
+  // Least significant digit radix sort on the key, which is stable such that
+  // the light indices of equal keys remain in increasing order. Digits on
+  // which all keys agree are skipped.
+  std::vector<Entry> buffer = std::vector<Entry>(this->entries.size());
+  std::size_t counts[256];
+
+  for (unsigned int shift = 0; shift < 64; shift += 8) {
+    std::fill(counts, counts + 256, 0);
+    for (const Entry& entry : this->entries) {
+      counts[(entry.key >> shift) & 0xFF]++;
+    }
+
+    if (std::find(counts, counts + 256, this->entries.size()) != counts + 256) {
+      continue;
+    }
+
+    std::size_t offset = 0;
+    for (unsigned int i = 0; i < 256; ++i) {
+      std::size_t count = counts[i];
+      counts[i] = offset;
+      offset += count;
+    }
+
+    for (const Entry& entry : this->entries) {
+      buffer[counts[(entry.key >> shift) & 0xFF]++] = entry;
+    }
+    this->entries.swap(buffer);
+  }
+
+  this->entry_i = 0;
+  this->has_constructed_starting_level = false;
+}
+
+
+void MortonOctreeBuilder::restartLevels(unsigned int starting_depth) {
+  // Entries of branches between the previous and new starting depth are
+  // skipped when the starting level is constructed.
+  this->starting_depth = starting_depth;
+  this->current_level = starting_depth;
+  this->entry_i = 0;
+  this->has_constructed_starting_level = false;
+}
+
+
+void MortonOctreeBuilder::constructStartingLevel() {
+  unsigned int s = this->getStartingDepth();
+  std::uint64_t n_nodes = std::uint64_t(1) << (3 * s);
+
+  // Every entry at or above the starting depth fills all nodes at the
+  // starting depth it contains.
+  std::vector<std::vector<GLuint>> node_lights =
+    std::vector<std::vector<GLuint>>(std::size_t(n_nodes));
+
+  this->entry_i = 0;
+  while (this->entry_i < this->entries.size()) {
+    const Entry& entry = this->entries[this->entry_i];
+    unsigned int level = unsigned int(entry.key >> kLevelShift);
+    if (level > s) break;
+
+    if (entry.light_index != kBranchIndex) {
+      std::uint64_t code = entry.key & ((std::uint64_t(1) << kLevelShift) - 1);
+      std::uint64_t first = code << (3 * (s - level));
+      std::uint64_t n_covered = std::uint64_t(1) << (3 * (s - level));
+      for (std::uint64_t i = first; i < first + n_covered; ++i) {
+        node_lights[std::size_t(i)].push_back(entry.light_index);
+      }
+    }
+    ++this->entry_i;
+  }
+
+  this->branches.clear();
+  this->branch_lights.clear();
+  for (std::uint64_t code = 0; code < n_nodes; ++code) {
+    std::vector<GLuint>& lights = node_lights[std::size_t(code)];
+    std::sort(lights.begin(), lights.end());
+
+    LevelBranch branch;
+    branch.code = code;
+    branch.lights_begin = this->branch_lights.size();
+    branch.n_lights = lights.size();
+    this->branches.push_back(branch);
+    this->branch_lights.insert(this->branch_lights.end(), lights.begin(), lights.end());
+  }
+
+  this->current_level = s;
+  this->has_constructed_starting_level = true;
+}
+
+
+bool MortonOctreeBuilder::constructNextLevel(std::vector<std::pair<glm::uvec3, glm::u8vec2>>& octree_data,
+                                             std::vector<std::pair<glm::uvec3, glm::uvec2>>& light_data,
+                                             std::vector<GLuint>& light_indices) {
+  if (!this->has_constructed_starting_level) this->constructStartingLevel();
+  if (this->branches.empty()) return false;
+
+  octree_data.clear();
+  light_data.clear();
+  this->branches_next.clear();
+  this->branch_lights_next.clear();
+
+  std::uint64_t level_key = std::uint64_t(this->current_level + 1) << kLevelShift;
+
+  for (const LevelBranch& branch : this->branches) {
+    glm::u8vec2 octree_dat = glm::u8vec2(0);
+    std::vector<GLuint>::const_iterator parent_begin =
+      this->branch_lights.begin() + branch.lights_begin;
+    std::vector<GLuint>::const_iterator parent_end =
+      parent_begin + branch.n_lights;
+
+    // The children of a branch are consecutive in Morton order, with the
+    // child index x + 2y + 4z in the lowest three bits.
+    for (unsigned int index_int = 0; index_int < 8; ++index_int) {
+      std::uint64_t child_code = (branch.code << 3) | index_int;
+      std::uint64_t child_key = level_key | child_code;
+
+      while (this->entry_i < this->entries.size() &&
+             this->entries[this->entry_i].key < child_key) {
+        ++this->entry_i;
+      }
+
+      bool is_branch = false;
+      this->child_lights.clear();
+      while (this->entry_i < this->entries.size() &&
+             this->entries[this->entry_i].key == child_key) {
+        if (this->entries[this->entry_i].light_index == kBranchIndex) {
+          is_branch = true;
+        } else {
+          this->child_lights.push_back(this->entries[this->entry_i].light_index);
+        }
+        ++this->entry_i;
+      }
+
+      if (is_branch) {
+        LevelBranch child;
+        child.code = child_code;
+        child.lights_begin = this->branch_lights_next.size();
+        std::merge(parent_begin, parent_end,
+                   this->child_lights.begin(), this->child_lights.end(),
+                   std::back_inserter(this->branch_lights_next));
+        child.n_lights = this->branch_lights_next.size() - child.lights_begin;
+        this->branches_next.push_back(child);
+
+        octree_dat.y |= (1 << index_int);
+      } else {
+        octree_dat.x |= (1 << index_int);
+
+        std::size_t n_lights = branch.n_lights + this->child_lights.size();
+        if (n_lights > 0) {
+          octree_dat.y |= (1 << index_int);
+          light_data.push_back(std::pair<glm::uvec3, glm::uvec2>(
+            math::decodeMorton(child_code),
+            glm::uvec2(light_indices.size(), n_lights)));
+          std::merge(parent_begin, parent_end,
+                     this->child_lights.begin(), this->child_lights.end(),
+                     std::back_inserter(light_indices));
+        }
+      }
+    }
+
+    octree_data.push_back(std::pair<glm::uvec3, glm::u8vec2>(math::decodeMorton(branch.code),
+                                                              octree_dat));
+  }
+
+  this->branches.swap(this->branches_next);
+  this->branch_lights.swap(this->branch_lights_next);
+  this->current_level += 1;
+  return true;
+}
+
+} // hashed
+} // pipeline
+} // nTiled
@@ -0,0 +1,357 @@
+#include "pipeline\light-management\hashed\linkless-octree\PortfolioHashFunctionBuilder.h"
+
+// ---------------------------------------------------------------------------
+//  Libraries
+// ---------------------------------------------------------------------------
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+//  nTiled Headers
+// ---------------------------------------------------------------------------
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+#include "log\Profiler.h"
+
+namespace nTiled {
+namespace pipeline {
+namespace hashed {
+
+/*! @brief PortfolioRound synchronises the candidates of a single portfolio
+ *         construction at the end of every round, and decides which 
+ *         candidate is kept.
+ */
+class PortfolioRound {
+public:
+  /*! @brief Construct a new PortfolioRound for n_candidates candidates. */
+  PortfolioRound(unsigned int n_candidates) :
+      n_candidates(n_candidates),
+      n_running(n_candidates),
+      n_waiting(0),
+      round(0),
+      winner(n_candidates),
+      is_aborted(false),
+      has_finished(std::vector<bool>(n_candidates, false)) {
+  }
+
+  /*! @brief Wait at the end of the current round until every running 
+   *         candidate has reached it.
+   *
+   * @returns False if a winner has been decided, and the calling candidate
+   *          should be cancelled, True otherwise.
+   */
+  bool arrive() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if (this->isDecided()) return false;
+
+    std::uint64_t arrival_round = this->round;
+    this->n_waiting++;
+    if (this->n_waiting == this->n_running) {
+      this->advance();
+    } else {
+      this->condition.wait(lock, 
+                           [this, arrival_round] { return this->round != arrival_round; });
+    }
+    return !this->isDecided();
+  }
+
+  /*! @brief Mark the candidate with the given index as no longer running,
+   *         and whether it constructed a SpatialHashFunction.
+   */
+  void finish(unsigned int index, bool is_constructed) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->has_finished[index] = is_constructed;
+    this->n_running--;
+    if (this->n_waiting == this->n_running) this->advance();
+  }
+
+  /*! @brief Cancel all candidates at the end of their current round 
+   *         without keeping any of them, as one of them failed.
+   */
+  void abort() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->is_aborted = true;
+  }
+
+  /*! @brief Get the index of the kept candidate, n_candidates if no 
+   *         candidate constructed a SpatialHashFunction.
+   */
+  unsigned int getWinner() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->winner;
+  }
+
+private:
+  bool isDecided() const { 
+    return this->is_aborted || this->winner != this->n_candidates; 
+  }
+
+  /*! @brief End the current round, deciding the winner as the lowest 
+   *         candidate that has constructed a SpatialHashFunction so far.
+   *         Requires the mutex to be held.
+   */
+  void advance() {
+    for (unsigned int i = 0; i < this->n_candidates && !this->isDecided(); ++i) {
+      if (this->has_finished[i]) this->winner = i;
+    }
+    this->n_waiting = 0;
+    this->round++;
+    this->condition.notify_all();
+  }
+
+  const unsigned int n_candidates;
+  unsigned int n_running;
+  unsigned int n_waiting;
+  std::uint64_t round;
+  unsigned int winner;
+  bool is_aborted;
+  std::vector<bool> has_finished;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+};
+
+
+/*! @brief PortfolioCandidateControl counts the offsets probed by a single
+ *         candidate and makes it wait for the others every n_round_probes.
+ */
+class PortfolioCandidateControl : public ConstructionControl {
+public:
+  PortfolioCandidateControl(PortfolioRound* p_round, 
+                            unsigned int n_round_probes) :
+      p_round(p_round),
+      n_round_probes(n_round_probes),
+      n_probes(0) {
+  }
+
+  bool onProbe() override {
+    if (++this->n_probes < this->n_round_probes) return true;
+    this->n_probes = 0;
+    return this->p_round->arrive();
+  }
+
+private:
+  PortfolioRound* p_round;
+  unsigned int n_round_probes;
+  unsigned int n_probes;
+};
+
+
+/*! @brief PortfolioWorkerPool holds the threads on which the candidates of
+ *         all PortfolioHashFunctionBuilders are raced. Its threads persist
+ *         across constructions, such that racing a portfolio for every 
+ *         level of every LinklessOctree does not start new threads, of 
+ *         which the Profiler would keep the rings.
+ *
+ * Portfolios are raced one at a time, a portfolio of which a candidate is
+ * itself a portfolio would thus never start.
+ */
+class PortfolioWorkerPool {
+public:
+  /*! @brief Construct a new PortfolioWorkerPool without threads. */
+  PortfolioWorkerPool() :
+      generation(0),
+      n_tasks(0),
+      n_busy(0),
+      is_stopping(false),
+      p_task(nullptr) {
+  }
+
+  /*! @brief Stop and join all threads of this PortfolioWorkerPool. */
+  ~PortfolioWorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->is_stopping = true;
+    }
+    this->start_condition.notify_all();
+    for (std::thread& worker : this->workers) worker.join();
+  }
+
+  /*! @brief Execute task(i) on thread i for every i below n_tasks, starting
+   *         threads as required, and wait until every task has returned. 
+   *         Tasks should not throw.
+   */
+  void run(unsigned int n_tasks, const std::function<void(unsigned int)>& task) {
+    std::lock_guard<std::mutex> run_lock(this->run_mutex);
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (this->workers.size() < n_tasks) {
+      this->workers.push_back(std::thread(&PortfolioWorkerPool::work,
+                                          this,
+                                          unsigned int(this->workers.size()),
+                                          this->generation));
+    }
+
+    this->p_task = &task;
+    this->n_tasks = n_tasks;
+    this->n_busy = n_tasks;
+    this->generation++;
+    this->start_condition.notify_all();
+    this->done_condition.wait(lock, [this] { return this->n_busy == 0; });
+    this->p_task = nullptr;
+  }
+
+private:
+  /*! @brief Execute the task of every run of which this thread has an index
+   *         below n_tasks, starting from the run after the given generation.
+   */
+  void work(unsigned int index, std::uint64_t generation) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true) {
+      this->start_condition.wait(lock, [this, &generation] { 
+        return this->is_stopping || this->generation != generation; 
+      });
+      if (this->is_stopping) return;
+      generation = this->generation;
+      if (index >= this->n_tasks) continue;
+
+      const std::function<void(unsigned int)>& task = *(this->p_task);
+      lock.unlock();
+      task(index);
+      lock.lock();
+
+      if (--this->n_busy == 0) this->done_condition.notify_all();
+    }
+  }
+
+  std::vector<std::thread> workers;
+  std::uint64_t generation;
+  unsigned int n_tasks;
+  unsigned int n_busy;
+  bool is_stopping;
+  const std::function<void(unsigned int)>* p_task;
+
+  std::mutex run_mutex;
+  std::mutex mutex;
+  std::condition_variable start_condition;
+  std::condition_variable done_condition;
+};
+
+
+/*! @brief Get the PortfolioWorkerPool shared by all 
+ *         PortfolioHashFunctionBuilders.
+ */
+static PortfolioWorkerPool& getWorkerPool() {
+  static PortfolioWorkerPool pool;
+  return pool;
+}
+
+
+// ----------------------------------------------------------------------------
+//  Constructor | Destructor
+// ----------------------------------------------------------------------------
+template <class R>
+PortfolioHashFunctionBuilder<R>::PortfolioHashFunctionBuilder(
+    const std::vector<HashFunctionBuilder<R>*>& p_candidates,
+    unsigned int n_round_probes) :
+    p_candidates(p_candidates),
+    n_round_probes(n_round_probes),
+    last_winner(0) {
+  if (p_candidates.empty() || n_round_probes == 0)
+    throw SpatialHashFunctionConstructionInvalidArgException();
+}
+
+
+template <class R>
+PortfolioHashFunctionBuilder<R>::~PortfolioHashFunctionBuilder() {
+  for (HashFunctionBuilder<R>* p_candidate : this->p_candidates) {
+    delete p_candidate;
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+//  SpatialHashFunction construction method
+// ----------------------------------------------------------------------------
+template <class R>
+SpatialHashFunction<R>* PortfolioHashFunctionBuilder<R>::constructHashFunction(
+    const std::vector<std::pair<glm::uvec3, R>>& entries,
+    unsigned int max_attempts,
+    float ratio,
+    bool has_pow2_m) {
+  static const logged::ScopeId construct_hash_function_id =
+    logged::internScope("PortfolioHashFunctionBuilder::constructHashFunction");
+  static const logged::ScopeId winner_id =
+    logged::internScope("PortfolioHashFunctionBuilder::winner");
+  logged::ProfileScope profile_scope(construct_hash_function_id);
+
+  // Sanitise input
+  // --------------------------------------------------------------------------
+  if (entries.empty()) throw SpatialHashFunctionConstructionException();
+
+  // race candidates
+  // --------------------------------------------------------------------------
+  unsigned int n_candidates = this->p_candidates.size();
+  PortfolioRound round(n_candidates);
+  std::vector<PortfolioCandidateControl> controls =
+    std::vector<PortfolioCandidateControl>(
+      n_candidates, PortfolioCandidateControl(&round, this->n_round_probes));
+  std::vector<SpatialHashFunction<R>*> p_results =
+    std::vector<SpatialHashFunction<R>*>(n_candidates, nullptr);
+  std::vector<std::exception_ptr> errors =
+    std::vector<std::exception_ptr>(n_candidates, nullptr);
+
+  for (unsigned int i = 0; i < n_candidates; ++i) {
+    this->p_candidates[i]->setConstructionControl(&controls[i]);
+  }
+
+  getWorkerPool().run(n_candidates, [&](unsigned int i) {
+    try {
+      p_results[i] = this->p_candidates[i]->constructHashFunction(entries,
+                                                                  max_attempts,
+                                                                  ratio,
+                                                                  has_pow2_m);
+    } catch (const SpatialHashFunctionConstructionExhaustedException&) {
+      // exhausted candidates do not construct a function
+    } catch (const SpatialHashFunctionConstructionCancelledException&) {
+      // neither do cancelled candidates
+    } catch (...) {
+      errors[i] = std::current_exception();
+      round.abort();
+    }
+    round.finish(i, p_results[i] != nullptr);
+  });
+
+  // keep the winner, unless a candidate failed
+  // --------------------------------------------------------------------------
+  unsigned int winner = round.getWinner();
+  std::exception_ptr error = nullptr;
+  for (unsigned int i = 0; i < n_candidates; ++i) {
+    if (!error) error = errors[i];
+  }
+
+  for (unsigned int i = 0; i < n_candidates; ++i) {
+    this->p_candidates[i]->setConstructionControl(nullptr);
+    if (i != winner || error) delete p_results[i];
+  }
+
+  if (error) std::rethrow_exception(error);
+
+  if (winner == n_candidates) {
+    throw SpatialHashFunctionConstructionExhaustedException();
+  }
+
+  this->last_winner = winner;
+  logged::profileValue(winner_id, double(winner));
+  return p_results[winner];
+}
+
+
+template <class R>
+glm::uvec2 PortfolioHashFunctionBuilder<R>::getTableDims(std::size_t n_entries,
+                                                         float ratio,
+                                                         unsigned int n_retries,
+                                                         bool has_pow2_m) const {
+  return this->p_candidates[0]->getTableDims(n_entries, ratio, n_retries, has_pow2_m);
+}
+
+
+// Class initialisations
+template class PortfolioHashFunctionBuilder<glm::u8vec2>;
+template class PortfolioHashFunctionBuilder<glm::uvec2>;
+
+} // hashed
+} // pipeline
+} // nTiled
@@ -1,6 +1,7 @@
 #include "pipeline\light-management\hashed\linkless-octree\SpatialHashFunction.h"
 
 #include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+#include "math\util.h"
 
 
 // ---------------------------------------------------------------------------
@@ -14,35 +15,123 @@ namespace hashed {
 
 template <class R>
 SpatialHashFunction<R>::SpatialHashFunction(Table<R>* p_hash_table,
-                                            Table<glm::u8vec3>* p_offset_table) :
+                                            Table<glm::u16vec3>* p_offset_table) :
     p_hash_table(p_hash_table),
-    p_offset_table(p_offset_table) {
+    p_narrow_offset_table(nullptr),
+    p_wide_offset_table(nullptr),
+    is_dense(false),
+    has_pow2_m(math::isPow2(p_hash_table->getDim())) {
+  this->storeOffsetTable(p_offset_table);
+}
+
+
+template <class R>
+SpatialHashFunction<R>::SpatialHashFunction(Table<R>* p_hash_table,
+                                            Table<glm::u16vec3>* p_offset_table,
+                                            bool is_dense) :
+    p_hash_table(p_hash_table),
+    p_narrow_offset_table(nullptr),
+    p_wide_offset_table(nullptr),
+    is_dense(is_dense),
+    has_pow2_m(math::isPow2(p_hash_table->getDim())) {
+  this->storeOffsetTable(p_offset_table);
 }
 
 
 template <class R>
 SpatialHashFunction<R>::~SpatialHashFunction() {
   delete this->p_hash_table;
-  delete this->p_offset_table;
+  delete this->p_narrow_offset_table;
+  delete this->p_wide_offset_table;
+}
+
+
+template <class R>
+void SpatialHashFunction<R>::storeOffsetTable(Table<glm::u16vec3>* p_offset_table) {
+  if (this->hasWideOffsets()) {
+    this->p_wide_offset_table = p_offset_table;
+    return;
+  }
+
+  // offsets below 256 are stored in half the memory
+  unsigned int r = p_offset_table->getDim();
+  this->p_narrow_offset_table = new Table<glm::u8vec3>(r);
+  for (unsigned int z = 0; z < r; ++z) {
+    for (unsigned int y = 0; y < r; ++y) {
+      for (unsigned int x = 0; x < r; ++x) {
+        glm::uvec3 p = glm::uvec3(x, y, z);
+        if (p_offset_table->isDefined(p)) {
+          this->p_narrow_offset_table->setPoint(p, glm::u8vec3(p_offset_table->getPoint(p)));
+        }
+      }
+    }
+  }
+  delete p_offset_table;
+}
+
+
+template <class R>
+std::vector<glm::u16vec3> SpatialHashFunction<R>::getOffsetTable() const {
+  if (this->p_wide_offset_table) return this->p_wide_offset_table->getDataVector();
+
+  const std::vector<glm::u8vec3>& narrow_table = this->p_narrow_offset_table->getDataVector();
+  return std::vector<glm::u16vec3>(narrow_table.begin(), narrow_table.end());
+}
+
+
+template <class R>
+std::size_t SpatialHashFunction<R>::getOffsetTableBytes() const {
+  std::size_t r = this->getR();
+  return r * r * r * (this->hasWideOffsets() ? sizeof(glm::u16vec3) : sizeof(glm::u8vec3));
 }
 
 
 // TODO: change this to a maybe?
 template <class R>
 R SpatialHashFunction<R>::getData(glm::uvec3 p) const {
-  glm::uvec3 h_1 = glm::uvec3((p.x % p_offset_table->getDim()),
-                              (p.y % p_offset_table->getDim()),
-                              (p.z % p_offset_table->getDim()));
+  if (!this->hasTables()) {
+    throw nTiled::pipeline::hashed::SpatialHashFunctionReleasedException();
+  }
 
-  if (!this->p_offset_table->isDefined(h_1)) {
-    throw nTiled::pipeline::hashed::SpatialHashFunctionIllegalAccessException();
+  if (this->is_dense) {
+    if (p.x >= p_hash_table->getDim() ||
+        p.y >= p_hash_table->getDim() ||
+        p.z >= p_hash_table->getDim() ||
+        !this->p_hash_table->isDefined(p)) {
+      throw nTiled::pipeline::hashed::SpatialHashFunctionIllegalAccessException();
+    }
+    return p_hash_table->getPoint(p);
   }
 
-  glm::u8vec3 offset = this->p_offset_table->getPoint(h_1);
+  if (this->has_pow2_m) return this->getHashedData<true>(p);
+  else return this->getHashedData<false>(p);
+}
+
+
+template <class R>
+template <bool has_pow2_m>
+R SpatialHashFunction<R>::getHashedData(glm::uvec3 p) const {
+  unsigned int r = this->getR();
+  glm::uvec3 h_1 = glm::uvec3((p.x % r),
+                              (p.y % r),
+                              (p.z % r));
+
+  glm::u16vec3 offset;
+  if (this->p_wide_offset_table) {
+    if (!this->p_wide_offset_table->isDefined(h_1)) {
+      throw nTiled::pipeline::hashed::SpatialHashFunctionIllegalAccessException();
+    }
+    offset = this->p_wide_offset_table->getPoint(h_1);
+  } else {
+    if (!this->p_narrow_offset_table->isDefined(h_1)) {
+      throw nTiled::pipeline::hashed::SpatialHashFunctionIllegalAccessException();
+    }
+    offset = glm::u16vec3(this->p_narrow_offset_table->getPoint(h_1));
+  }
 
-  glm::uvec3 h = glm::uvec3(((p.x + offset.x) % p_hash_table->getDim()),
-                            ((p.y + offset.y) % p_hash_table->getDim()),
-                            ((p.z + offset.z) % p_hash_table->getDim()));
+  glm::uvec3 h = glm::uvec3(math::wrap<has_pow2_m>(p.x + offset.x, p_hash_table->getDim()),
+                            math::wrap<has_pow2_m>(p.y + offset.y, p_hash_table->getDim()),
+                            math::wrap<has_pow2_m>(p.z + offset.z, p_hash_table->getDim()));
 
   if (!this->p_hash_table->isDefined(h)) {
     throw nTiled::pipeline::hashed::SpatialHashFunctionIllegalAccessException();
@@ -52,6 +141,14 @@ R SpatialHashFunction<R>::getData(glm::uvec3 p) const {
 }
 
 
+template <class R>
+void SpatialHashFunction<R>::releaseTables() {
+  this->p_hash_table->release();
+  if (this->p_wide_offset_table) this->p_wide_offset_table->release();
+  else this->p_narrow_offset_table->release();
+}
+
+
 template class SpatialHashFunction<glm::u8vec2>;
 template class SpatialHashFunction<glm::uvec2>;
 
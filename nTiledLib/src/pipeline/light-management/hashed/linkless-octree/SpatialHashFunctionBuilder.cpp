@@ -12,6 +12,7 @@
 // ---------------------------------------------------------------------------
 #include "math\util.h"
 #include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+#include "log\Profiler.h"
 
 namespace nTiled {
 namespace pipeline {
@@ -38,57 +39,56 @@ template <class R>
 SpatialHashFunction<R>* SpatialHashFunctionBuilder<R>::constructHashFunction(
     const std::vector<std::pair<glm::uvec3, R>>& entries,
     unsigned int max_attempts,
-    float ratio) {
+    float ratio,
+    bool has_pow2_m) {
+  static const logged::ScopeId construct_hash_function_id =
+    logged::internScope("SpatialHashFunctionBuilder::constructHashFunction");
+  static const logged::ScopeId build_tables_id =
+    logged::internScope("SpatialHashFunctionBuilder::buildTables");
+  static const logged::ScopeId n_retries_id =
+    logged::internScope("SpatialHashFunctionBuilder::retries");
+  logged::ProfileScope profile_scope(construct_hash_function_id);
+
   // Sanitise input
   // --------------------------------------------------------------------------
   if (entries.empty()) throw SpatialHashFunctionConstructionException();
 
-  // build initial values
-  // --------------------------------------------------------------------------
-  unsigned int n = entries.size();
-
-  unsigned int m_dim;
-  if (n > (255 * 255 * 255)) m_dim = unsigned int(ceil(cbrt(n * 1.01)));
-  else m_dim = unsigned int(ceil(cbrt(n)));
-
-  unsigned int r_dim = unsigned int(ceil(cbrt(n * (1.0 / 6.0))));
-
-  if ((m_dim & 1) == 0) m_dim++;
-  if ((r_dim & 1) == 0) r_dim++;
-
   // build tables
   // --------------------------------------------------------------------------
   unsigned short i = 0;
   bool has_build = false;
 
   Table<R>* p_hash_table;
-  Table<glm::u8vec3>* p_offset_table;
+  Table<glm::u16vec3>* p_offset_table;
 
   std::vector<ConstructionElement> entry_vector;
 
   do {
-    while (!this->isAcceptableParameters(m_dim, r_dim)) r_dim += 2;
+    glm::uvec2 dims = this->getTableDims(entries.size(), ratio, i, has_pow2_m);
+    unsigned int m_dim = dims.x;
+    unsigned int r_dim = dims.y;
 
     p_hash_table = new Table<R>(m_dim);
-    p_offset_table = new Table<glm::u8vec3>(r_dim);
+    p_offset_table = new Table<glm::u16vec3>(r_dim);
 
     if (mapEntryVector(entries, m_dim, r_dim, entry_vector)) {
+      logged::ProfileScope build_tables_scope(build_tables_id);
       has_build = buildTables(entry_vector, 
                               *p_hash_table, 
                               *p_offset_table);
     }
 
     if (!has_build) {
-      r_dim = unsigned int(ceil(ratio * r_dim));
-      if ((r_dim & 1) == 0) r_dim++;
-
       delete p_hash_table;
       delete p_offset_table;
-
-
     }
     i++;
-  } while (!has_build && i < max_attempts);
+  } while (!has_build && i < max_attempts && !this->isCancelled());
+
+  if (this->isCancelled()) {
+    throw SpatialHashFunctionConstructionCancelledException();
+  }
+  logged::profileValue(n_retries_id, double(i - 1));
 
   // check if build
   // --------------------------------------------------------------------------
@@ -100,11 +100,53 @@ SpatialHashFunction<R>* SpatialHashFunctionBuilder<R>::constructHashFunction(
 }
 
 
+template <class R>
+glm::uvec2 SpatialHashFunctionBuilder<R>::getTableDims(std::size_t n_entries,
+                                                       float ratio,
+                                                       unsigned int n_retries,
+                                                       bool has_pow2_m) const {
+  double n = double(n_entries);
+
+  unsigned int m_dim;
+  if (n > (255 * 255 * 255)) m_dim = unsigned int(ceil(cbrt(n * 1.01)));
+  else m_dim = unsigned int(ceil(cbrt(n)));
+
+  unsigned int r_dim = unsigned int(ceil(cbrt(n * (1.0 / 6.0))));
+
+  if (has_pow2_m) m_dim = math::getNextPow2(m_dim);
+  else if ((m_dim & 1) == 0) m_dim++;
+  if ((r_dim & 1) == 0) r_dim++;
+
+  // every failed attempt increases r by ratio
+  while (!this->isAcceptableParameters(m_dim, r_dim)) r_dim += 2;
+  for (unsigned int i = 0; i < n_retries; ++i) {
+    r_dim = unsigned int(ceil(ratio * r_dim));
+    if ((r_dim & 1) == 0) r_dim++;
+    while (!this->isAcceptableParameters(m_dim, r_dim)) r_dim += 2;
+  }
+  return glm::uvec2(m_dim, r_dim);
+}
+
+
 template <class R>
 bool SpatialHashFunctionBuilder<R>::buildTables(
     const std::vector<ConstructionElement>& entry_vector,
     Table<R>& hash_table,
-    Table<glm::u8vec3>& offset_table) {
+    Table<glm::u16vec3>& offset_table) {
+  if (math::isPow2(hash_table.getDim())) {
+    return this->buildTablesWrapped<true>(entry_vector, hash_table, offset_table);
+  } else {
+    return this->buildTablesWrapped<false>(entry_vector, hash_table, offset_table);
+  }
+}
+
+
+template <class R>
+template <bool has_pow2_m>
+bool SpatialHashFunctionBuilder<R>::buildTablesWrapped(
+    const std::vector<ConstructionElement>& entry_vector,
+    Table<R>& hash_table,
+    Table<glm::u16vec3>& offset_table) {
   // --------------------------------------------------------------------------
   // sanitise input
   if (entry_vector.empty()) 
@@ -115,10 +157,19 @@ bool SpatialHashFunctionBuilder<R>::buildTables(
   glm::uvec3 h_0;
   glm::uvec3 h_1;
 
-  glm::u8vec3 offset;
+  glm::u16vec3 offset;
   bool found_candidate;
 
-  std::vector<glm::u8vec3> candidate_vector = std::vector<glm::u8vec3>();
+  std::vector<glm::u16vec3> candidate_vector = std::vector<glm::u16vec3>();
+
+  // draw offsets below 256 if they suffice to reach every entry of the hash
+  // table, and up to m - 1 otherwise, as larger offsets are equivalent.
+  unsigned int max_offset = 255;
+  if (hash_table.getDim() > 256) {
+    max_offset = std::min(hash_table.getDim() - 1, 65535u);
+  }
+  this->distribution.param(
+    typename std::uniform_int_distribution<unsigned short>::param_type(0, unsigned short(max_offset)));
 
   for (const ConstructionElement& e : entry_vector) {
     // stop construction if no elements map to this offset table entries
@@ -135,8 +186,9 @@ bool SpatialHashFunctionBuilder<R>::buildTables(
                              offset_table,
                              candidate_vector);
 
-    for (glm::u8vec3 candidate : candidate_vector) {
-      if (isValidCandidate(candidate, e.elements, hash_table)) {
+    for (glm::u16vec3 candidate : candidate_vector) {
+      if (!this->continueConstruction()) return false;
+      if (this->isValidCandidateWrapped<has_pow2_m>(candidate, e.elements, hash_table)) {
         offset = candidate;
         found_candidate = true;
         break;
@@ -146,10 +198,11 @@ bool SpatialHashFunctionBuilder<R>::buildTables(
     // find offset by random iteration
     if (!found_candidate) {
       for (unsigned int i = 0; i < 256 * 256 * 256; i++) {
-        glm::u8vec3 candidate = glm::u8vec3(this->distribution(this->gen),
-                                            this->distribution(this->gen),
-                                            this->distribution(this->gen));
-        if (isValidCandidate(candidate, e.elements, hash_table)) {
+        if (!this->continueConstruction()) return false;
+        glm::u16vec3 candidate = glm::u16vec3(this->distribution(this->gen),
+                                              this->distribution(this->gen),
+                                              this->distribution(this->gen));
+        if (this->isValidCandidateWrapped<has_pow2_m>(candidate, e.elements, hash_table)) {
           offset = candidate;
           found_candidate = true;
           break;
@@ -163,9 +216,9 @@ bool SpatialHashFunctionBuilder<R>::buildTables(
       offset_table.setPoint(e.hash_1, offset);
 
       for (const EntryElement& element : e.elements) {
-        hash_table.setPoint(glm::uvec3((element.hash_0.x + offset.x) % hash_table.getDim(),
-                                       (element.hash_0.y + offset.y) % hash_table.getDim(),
-                                       (element.hash_0.z + offset.z) % hash_table.getDim()),
+        hash_table.setPoint(glm::uvec3(math::wrap<has_pow2_m>(element.hash_0.x + offset.x, hash_table.getDim()),
+                                       math::wrap<has_pow2_m>(element.hash_0.y + offset.y, hash_table.getDim()),
+                                       math::wrap<has_pow2_m>(element.hash_0.z + offset.z, hash_table.getDim())),
                             element.data);
       }
     }
@@ -261,7 +314,7 @@ bool SpatialHashFunctionBuilder<R>::mapEntryVector(
 
 template <class R>
 bool SpatialHashFunctionBuilder<R>::isAcceptableParameters(unsigned int m,
-                                                           unsigned int r) {
+                                                           unsigned int r) const {
   unsigned int m_mod_r = m % r;
   return (( r == 1 ) || 
           ( m == 1 ) ||
@@ -272,13 +325,13 @@ bool SpatialHashFunctionBuilder<R>::isAcceptableParameters(unsigned int m,
 template <class R>
 void SpatialHashFunctionBuilder<R>::retrieveCandidates(
     glm::uvec3 p,
-    const Table<glm::u8vec3>& offset_table,
-    std::vector<glm::u8vec3>& candidate_vector) {
+    const Table<glm::u16vec3>& offset_table,
+    std::vector<glm::u16vec3>& candidate_vector) {
 
   // --------------------------------------------------------------------------
   unsigned int val[3] = { 0, 1, (offset_table.getDim() - 1) };
   glm::uvec3 offset_point;
-  glm::u8vec3 candidate;
+  glm::u16vec3 candidate;
 
   for (int x = 0; x < 3; x++) {
     for (int y = 0; y < 3; y++) {
@@ -304,7 +357,21 @@ void SpatialHashFunctionBuilder<R>::retrieveCandidates(
 
 template <class R>
 bool SpatialHashFunctionBuilder<R>::isValidCandidate(
-    glm::u8vec3 candidate,
+    glm::u16vec3 candidate,
+    const std::vector<EntryElement>& elements,
+    const Table<R>& hash_table) {
+  if (math::isPow2(hash_table.getDim())) {
+    return this->isValidCandidateWrapped<true>(candidate, elements, hash_table);
+  } else {
+    return this->isValidCandidateWrapped<false>(candidate, elements, hash_table);
+  }
+}
+
+
+template <class R>
+template <bool has_pow2_m>
+bool SpatialHashFunctionBuilder<R>::isValidCandidateWrapped(
+    glm::u16vec3 candidate,
     const std::vector<EntryElement>& elements,
     const Table<R>& hash_table) {
   // --------------------------------------------------------------------------
@@ -317,9 +384,9 @@ bool SpatialHashFunctionBuilder<R>::isValidCandidate(
   // --------------------------------------------------------------------------
   for (EntryElement e : elements) {
     if (hash_table.isDefined(glm::uvec3(
-      (e.hash_0.x + candidate.x) % hash_table.getDim(),
-      (e.hash_0.y + candidate.y) % hash_table.getDim(),
-      (e.hash_0.z + candidate.z) % hash_table.getDim()))) {
+      math::wrap<has_pow2_m>(e.hash_0.x + candidate.x, hash_table.getDim()),
+      math::wrap<has_pow2_m>(e.hash_0.y + candidate.y, hash_table.getDim()),
+      math::wrap<has_pow2_m>(e.hash_0.z + candidate.z, hash_table.getDim())))) {
       return false;
     }
   }
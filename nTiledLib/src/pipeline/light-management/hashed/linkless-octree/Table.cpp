@@ -15,7 +15,9 @@ template <class R>
 Table<R>::Table(unsigned int t_dim) : 
   t_dim(t_dim),
   is_def(std::vector<bool>(t_dim * t_dim * t_dim, false)),
-  data(std::vector<R>(t_dim * t_dim * t_dim)) { 
+  data(std::vector<R>(t_dim * t_dim * t_dim)),
+  n_defined(0),
+  is_released(false) { 
   if (t_dim == 0) throw SpatialHashFunctionConstructionInvalidArgException();
 }
 
@@ -45,10 +47,21 @@ void Table<R>::setPoint(glm::uvec3 p, R d) {
   unsigned int index = math::toIndex(p, this->getDim());
   this->data.at(index) = d;
   this->is_def.at(index) = true;
+  this->n_defined += 1;
+}
+
+
+template <class R>
+void Table<R>::release() {
+  // swap with empty vectors, as clear does not free their memory
+  std::vector<bool>().swap(this->is_def);
+  std::vector<R>().swap(this->data);
+  this->is_released = true;
 }
 
 
 template class Table<glm::u8vec3>;
+template class Table<glm::u16vec3>;
 template class Table<glm::u8vec2>;
 template class Table<glm::uvec2>;
 
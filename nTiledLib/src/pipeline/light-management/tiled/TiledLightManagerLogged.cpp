@@ -19,21 +19,27 @@ TiledLightManagerLogged::TiledLightManagerLogged(const world::World& world,
 
 
 void TiledLightManagerLogged::clearGrid() {
-  this->logger.startLog(std::string("TiledLightManager::clearGrid"));
+  static const logged::ScopeId clear_grid_id =
+    logged::internScope("TiledLightManager::clearGrid");
+  this->logger.startLog(clear_grid_id);
   TiledLightManager::clearGrid();
-  this->logger.endLog();
+  this->logger.endLog(clear_grid_id);
 }
 
 void TiledLightManagerLogged::buildGrid() {
-  this->logger.startLog(std::string("TiledLightManager::buildGrid"));
+  static const logged::ScopeId build_grid_id =
+    logged::internScope("TiledLightManager::buildGrid");
+  this->logger.startLog(build_grid_id);
   TiledLightManager::buildGrid();
-  this->logger.endLog();
+  this->logger.endLog(build_grid_id);
 }
 
 void TiledLightManagerLogged::finaliseGrid() {
-  this->logger.startLog(std::string("TiledLightManager::finaliseGrid"));
+  static const logged::ScopeId finalise_grid_id =
+    logged::internScope("TiledLightManager::finaliseGrid");
+  this->logger.startLog(finalise_grid_id);
   TiledLightManager::finaliseGrid();
-  this->logger.endLog();
+  this->logger.endLog(finalise_grid_id);
 }
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,243 @@
+#include "pipeline\pipeline-util\DrawSubmission.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glm/gtc/matrix_inverse.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// ----------------------------------------------------------------------------
+//  Defines
+// ----------------------------------------------------------------------------
+// Shader Storage Buffer binding of the ObjectMatrixBuffer in the vertex shaders
+#define OBJECT_MATRIX_BINDING 7
+// Attribute location of object_index in the vertex shaders
+#define OBJECT_INDEX_LOCATION 3
+
+
+namespace nTiled {
+namespace pipeline {
+
+DrawSubmission::DrawSubmission() :
+    n_visible_objects(0),
+    matrix_buffer(0),
+    object_index_buffer(0),
+    indirect_buffer(0),
+    p_bvh(nullptr),
+    is_indirect(false),
+    is_finalised(false) {
+}
+
+
+void DrawSubmission::addObject(PipelineObject* p_obj, const AABB& bounds) {
+  if (this->is_finalised) {
+    throw std::runtime_error(std::string("DrawSubmission is already finalised."));
+  }
+  this->ps_obj.push_back(p_obj);
+  this->object_bounds.push_back(bounds);
+}
+
+
+void DrawSubmission::finalise() {
+  this->is_finalised = true;
+  this->is_indirect = (GLAD_GL_VERSION_4_3 || GLAD_GL_ARB_multi_draw_indirect);
+
+  // Sort objects such that objects sharing buffers are consecutive
+  // --------------------------------------------------------------------------
+  GLuint n_objects = GLuint(this->ps_obj.size());
+  std::vector<GLuint> order(n_objects);
+  for (GLuint i = 0; i < n_objects; ++i) {
+    order[i] = i;
+  }
+  const std::vector<PipelineObject*>& ps_obj_unsorted = this->ps_obj;
+  std::stable_sort(order.begin(), order.end(),
+                   [&ps_obj_unsorted](GLuint i, GLuint j) {
+                     const PipelineObject* a = ps_obj_unsorted[i];
+                     const PipelineObject* b = ps_obj_unsorted[j];
+                     if (a->vao != b->vao) return a->vao < b->vao;
+                     return a->element_buffer < b->element_buffer;
+                   });
+
+  std::vector<PipelineObject*> ps_obj_sorted;
+  std::vector<AABB> bounds_sorted;
+  for (GLuint i : order) {
+    ps_obj_sorted.push_back(this->ps_obj[i]);
+    bounds_sorted.push_back(this->object_bounds[i]);
+  }
+  this->ps_obj = ps_obj_sorted;
+  this->object_bounds = bounds_sorted;
+
+  this->p_bvh = new ObjectBVH(this->object_bounds);
+  this->is_visible.assign(n_objects, true);
+  this->n_visible_objects = n_objects;
+
+  if (n_objects == 0) return;
+
+  // Construct batches and static per object data
+  // --------------------------------------------------------------------------
+  std::vector<GLuint> object_indices(n_objects);
+  this->commands.resize(n_objects);
+
+  for (GLuint i = 0; i < n_objects; ++i) {
+    PipelineObject* p_obj = this->ps_obj[i];
+
+    if (this->batches.empty() ||
+        this->batches.back().vao != p_obj->vao ||
+        this->batches.back().element_buffer != p_obj->element_buffer) {
+      Batch batch = { p_obj->vao, p_obj->element_buffer, i, 0 };
+      this->batches.push_back(batch);
+    }
+    this->batches.back().n_objects++;
+
+    object_indices[i] = i;
+    DrawElementsIndirectCommand command = { p_obj->n_elements, 1, 0, 0, i };
+    this->commands[i] = command;
+
+    this->inv_transpose_transformations.push_back(
+      glm::inverseTranspose(p_obj->transformation_matrix));
+  }
+  this->matrix_data.resize(n_objects);
+
+  // Construct openGL buffers
+  // --------------------------------------------------------------------------
+  GLuint buffer_handles[3];
+  glGenBuffers(3, buffer_handles);
+  this->matrix_buffer = buffer_handles[0];
+  this->object_index_buffer = buffer_handles[1];
+  this->indirect_buffer = buffer_handles[2];
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->matrix_buffer);
+  glBufferData(GL_SHADER_STORAGE_BUFFER,
+               sizeof(ObjectMatrices) * n_objects,
+               NULL,
+               GL_STREAM_DRAW);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  glBindBuffer(GL_ARRAY_BUFFER, this->object_index_buffer);
+  glBufferData(GL_ARRAY_BUFFER,
+               sizeof(GLuint) * n_objects,
+               object_indices.data(),
+               GL_STATIC_DRAW);
+
+  if (this->is_indirect) {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->indirect_buffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER,
+                 sizeof(DrawElementsIndirectCommand) * n_objects,
+                 this->commands.data(),
+                 GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+  }
+
+  // Attach the object index attribute and element buffer to every vao,
+  // such that binding the vao is the only state change per batch.
+  // --------------------------------------------------------------------------
+  for (const Batch& batch : this->batches) {
+    glBindVertexArray(batch.vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.element_buffer);
+    glEnableVertexAttribArray(OBJECT_INDEX_LOCATION);
+    glVertexAttribIPointer(OBJECT_INDEX_LOCATION, 1, GL_UNSIGNED_INT, 0, NULL);
+    glVertexAttribDivisor(OBJECT_INDEX_LOCATION, 1);
+  }
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+
+GLuint DrawSubmission::cull(const glm::mat4& world_to_clip) {
+  if (this->ps_obj.empty()) return 0;
+
+  this->n_visible_objects = this->p_bvh->query(extractFrustum(world_to_clip),
+                                               this->is_visible);
+
+  if (this->is_indirect) {
+    // culled objects are drawn with zero instances
+    for (GLuint i = 0; i < this->commands.size(); ++i) {
+      this->commands[i].instance_count = this->is_visible[i] ? 1 : 0;
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->indirect_buffer);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER,
+                    0,
+                    sizeof(DrawElementsIndirectCommand) * this->commands.size(),
+                    this->commands.data());
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+  }
+
+  return this->n_visible_objects;
+}
+
+
+void DrawSubmission::submit(const glm::mat4& look_at) {
+  if (this->n_visible_objects == 0) return;
+
+  this->updateMatrices(look_at);
+  this->draw();
+}
+
+
+void DrawSubmission::updateMatrices(const glm::mat4& look_at) {
+  // inverseTranspose(A * B) == inverseTranspose(A) * inverseTranspose(B),
+  // the object part is computed once in finalise.
+  glm::mat4 inv_transpose_look_at = glm::inverseTranspose(look_at);
+
+  for (GLuint i = 0; i < this->ps_obj.size(); ++i) {
+    if (!this->is_visible[i]) continue;
+
+    const glm::mat4& transformation = this->ps_obj[i]->transformation_matrix;
+    ObjectMatrices& matrices = this->matrix_data[i];
+
+    matrices.model_to_camera = look_at * transformation;
+    matrices.inv_transpose_model_to_camera =
+      inv_transpose_look_at * this->inv_transpose_transformations[i];
+    matrices.model_to_world = transformation;
+  }
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, this->matrix_buffer);
+  // orphan the previous frame's storage
+  glBufferData(GL_SHADER_STORAGE_BUFFER,
+               sizeof(ObjectMatrices) * this->matrix_data.size(),
+               this->matrix_data.data(),
+               GL_STREAM_DRAW);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER,
+                   OBJECT_MATRIX_BINDING,
+                   this->matrix_buffer);
+}
+
+
+void DrawSubmission::draw() {
+  if (this->is_indirect) {
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, this->indirect_buffer);
+    for (const Batch& batch : this->batches) {
+      glBindVertexArray(batch.vao);
+      glMultiDrawElementsIndirect(
+        GL_TRIANGLES,
+        GL_UNSIGNED_INT,
+        (const void*)(sizeof(DrawElementsIndirectCommand) * batch.first_object),
+        batch.n_objects,
+        0);
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+  } else {
+    for (const Batch& batch : this->batches) {
+      glBindVertexArray(batch.vao);
+      for (GLuint i = batch.first_object;
+           i < batch.first_object + batch.n_objects;
+           ++i) {
+        if (!this->is_visible[i]) continue;
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES,
+                                            this->ps_obj[i]->n_elements,
+                                            GL_UNSIGNED_INT,
+                                            0,
+                                            1,
+                                            i);
+      }
+    }
+  }
+  glBindVertexArray(0);
+}
+
+} // pipeline
+} // nTiled
@@ -0,0 +1,148 @@
+#include "pipeline\pipeline-util\MeshBuffers.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glm\gtc\packing.hpp>
+
+#include <cstddef>
+#include <vector>
+
+
+namespace nTiled {
+namespace pipeline {
+
+static_assert(sizeof(PackedVertex) == 20,
+              "PackedVertex must be tightly packed");
+
+// ----------------------------------------------------------------------------
+//  Vertex upload
+// ----------------------------------------------------------------------------
+/*! @brief Upload the vertex data of mesh into three separate buffers of 32-bit
+ *         floats and set the attributes of the bound Vertex Array Object.
+ *
+ * @return The size in bytes of the uploaded vertex data.
+ */
+static GLsizeiptr uploadSeparate(const world::Mesh& mesh) {
+  GLuint vbo_handles[3];
+  glGenBuffers(3, vbo_handles);
+  GLuint position_buffer = vbo_handles[0];
+  GLuint normal_buffer = vbo_handles[1];
+  GLuint uv_buffer = vbo_handles[2];
+
+  GLsizeiptr position_size = mesh.vertices.size() * sizeof(glm::vec4);
+  GLsizeiptr normal_size = mesh.normals.size() * sizeof(glm::vec3);
+  GLsizeiptr uv_size = mesh.uvs.size() * sizeof(glm::vec3);
+
+  // set up position buffer
+  glBindBuffer(GL_ARRAY_BUFFER, position_buffer);
+  glBufferData(GL_ARRAY_BUFFER,
+               position_size,
+               mesh.vertices.data(),
+               GL_STATIC_DRAW);
+  glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, NULL);
+
+  // set up normal buffer
+  glBindBuffer(GL_ARRAY_BUFFER, normal_buffer);
+  if (normal_size > 0) {
+    glBufferData(GL_ARRAY_BUFFER,
+                 normal_size,
+                 mesh.normals.data(),
+                 GL_STATIC_DRAW);
+  }
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+
+  // set up uvw buffer
+  glBindBuffer(GL_ARRAY_BUFFER, uv_buffer);
+  if (uv_size > 0) {
+    glBufferData(GL_ARRAY_BUFFER,
+                 uv_size,
+                 mesh.uvs.data(),
+                 GL_STATIC_DRAW);
+  }
+  glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+
+  return position_size + normal_size + uv_size;
+}
+
+
+/*! @brief Upload the vertex data of mesh into a single interleaved buffer of
+ *         PackedVertex and set the attributes of the bound Vertex Array
+ *         Object.
+ *
+ * Attributes with fewer components than the shader input are expanded by
+ * openGL, such that position.w reads 1 and uv.z reads 0 as before.
+ *
+ * @return The size in bytes of the uploaded vertex data.
+ */
+static GLsizeiptr uploadPacked(const world::Mesh& mesh) {
+  std::vector<PackedVertex> vertices(mesh.vertices.size());
+  bool has_normals = mesh.normals.size() == mesh.vertices.size();
+  bool has_uvs = mesh.uvs.size() == mesh.vertices.size();
+
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    vertices[i].position = glm::vec3(mesh.vertices[i]);
+    vertices[i].normal = has_normals ?
+      glm::packSnorm3x10_1x2(glm::vec4(mesh.normals[i], 0.0f)) : 0;
+    vertices[i].uv = has_uvs ?
+      glm::packHalf2x16(glm::vec2(mesh.uvs[i])) : 0;
+  }
+
+  GLuint vertex_buffer;
+  glGenBuffers(1, &vertex_buffer);
+
+  GLsizeiptr vertex_size = vertices.size() * sizeof(PackedVertex);
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+  glBufferData(GL_ARRAY_BUFFER,
+               vertex_size,
+               vertices.data(),
+               GL_STATIC_DRAW);
+
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
+                        sizeof(PackedVertex),
+                        (const void*)offsetof(PackedVertex, position));
+  glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE,
+                        sizeof(PackedVertex),
+                        (const void*)offsetof(PackedVertex, normal));
+  glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE,
+                        sizeof(PackedVertex),
+                        (const void*)offsetof(PackedVertex, uv));
+
+  return vertex_size;
+}
+
+
+MeshBuffers constructMeshBuffers(const world::Mesh& mesh,
+                                 VertexFormat vertex_format) {
+  MeshBuffers buffers;
+
+  // setup vertex array object
+  glGenVertexArrays(1, &(buffers.vao));
+  glBindVertexArray(buffers.vao);
+  glEnableVertexAttribArray(0);
+  glEnableVertexAttribArray(1);
+  glEnableVertexAttribArray(2);
+
+  if (vertex_format == VertexFormat::Packed) {
+    buffers.vertex_size = uploadPacked(mesh);
+  } else {
+    buffers.vertex_size = uploadSeparate(mesh);
+  }
+
+  // set up element buffer
+  // attribute 3 (object_index) is attached by the DrawSubmission
+  glGenBuffers(1, &(buffers.element_buffer));
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.element_buffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+               mesh.elements.size() * sizeof(glm::tvec3<glm::u32>),
+               mesh.elements.data(),
+               GL_STATIC_DRAW);
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  return buffers;
+}
+
+} // pipeline
+} // nTiled
@@ -0,0 +1,195 @@
+#include "pipeline\pipeline-util\ObjectBVH.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glm\gtc\matrix_access.hpp>
+
+#include <algorithm>
+#include <limits>
+
+
+namespace nTiled {
+namespace pipeline {
+
+// ----------------------------------------------------------------------------
+//  Bounds
+// ----------------------------------------------------------------------------
+AABB computeWorldBounds(const world::Mesh& mesh,
+                        const glm::mat4& transformation_matrix) {
+  AABB bounds = { glm::vec3(std::numeric_limits<float>::max()),
+                  glm::vec3(std::numeric_limits<float>::lowest()) };
+  for (const glm::vec4& vertex : mesh.vertices) {
+    glm::vec4 world_vertex = transformation_matrix * vertex;
+    glm::vec3 p = glm::vec3(world_vertex) / world_vertex.w;
+    bounds.lower = glm::min(bounds.lower, p);
+    bounds.upper = glm::max(bounds.upper, p);
+  }
+  return bounds;
+}
+
+
+Frustum extractFrustum(const glm::mat4& world_to_clip) {
+  glm::vec4 row_x = glm::row(world_to_clip, 0);
+  glm::vec4 row_y = glm::row(world_to_clip, 1);
+  glm::vec4 row_z = glm::row(world_to_clip, 2);
+  glm::vec4 row_w = glm::row(world_to_clip, 3);
+
+  Frustum frustum;
+  frustum.planes[0] = row_w + row_x;  // left
+  frustum.planes[1] = row_w - row_x;  // right
+  frustum.planes[2] = row_w + row_y;  // bottom
+  frustum.planes[3] = row_w - row_y;  // top
+  frustum.planes[4] = row_w + row_z;  // near
+  frustum.planes[5] = row_w - row_z;  // far
+
+  for (glm::vec4& plane : frustum.planes) {
+    plane /= glm::length(glm::vec3(plane));
+  }
+  return frustum;
+}
+
+
+FrustumTest testFrustum(const Frustum& frustum, const AABB& bounds) {
+  FrustumTest result = FrustumTest::Inside;
+
+  for (const glm::vec4& plane : frustum.planes) {
+    glm::vec3 normal = glm::vec3(plane);
+    // corner furthest along the normal and the one opposite to it
+    glm::vec3 p_vertex = glm::vec3(normal.x >= 0.0f ? bounds.upper.x : bounds.lower.x,
+                                   normal.y >= 0.0f ? bounds.upper.y : bounds.lower.y,
+                                   normal.z >= 0.0f ? bounds.upper.z : bounds.lower.z);
+    glm::vec3 n_vertex = glm::vec3(normal.x >= 0.0f ? bounds.lower.x : bounds.upper.x,
+                                   normal.y >= 0.0f ? bounds.lower.y : bounds.upper.y,
+                                   normal.z >= 0.0f ? bounds.lower.z : bounds.upper.z);
+
+    if (glm::dot(normal, p_vertex) + plane.w < 0.0f) {
+      return FrustumTest::Outside;
+    }
+    if (glm::dot(normal, n_vertex) + plane.w < 0.0f) {
+      result = FrustumTest::Intersecting;
+    }
+  }
+  return result;
+}
+
+
+// ----------------------------------------------------------------------------
+//  ObjectBVH
+// ----------------------------------------------------------------------------
+ObjectBVH::ObjectBVH(const std::vector<AABB>& bounds,
+                     GLuint max_leaf_size) :
+    object_bounds(bounds) {
+  GLuint n_objects = GLuint(bounds.size());
+  for (GLuint i = 0; i < n_objects; ++i) {
+    this->object_indices.push_back(i);
+  }
+  if (n_objects == 0) return;
+
+  this->nodes.reserve(2 * n_objects);
+  this->nodes.push_back(Node());
+  this->build(bounds, 0, 0, n_objects, std::max(max_leaf_size, GLuint(1)));
+}
+
+
+void ObjectBVH::build(const std::vector<AABB>& bounds,
+                      GLuint node_index,
+                      GLuint begin,
+                      GLuint end,
+                      GLuint max_leaf_size) {
+  // Compute bounds of this node and of the centroids
+  // --------------------------------------------------------------------------
+  AABB node_bounds = bounds[this->object_indices[begin]];
+  glm::vec3 centroid_lower = glm::vec3(std::numeric_limits<float>::max());
+  glm::vec3 centroid_upper = glm::vec3(std::numeric_limits<float>::lowest());
+
+  for (GLuint i = begin; i < end; ++i) {
+    const AABB& bounds_i = bounds[this->object_indices[i]];
+    node_bounds.lower = glm::min(node_bounds.lower, bounds_i.lower);
+    node_bounds.upper = glm::max(node_bounds.upper, bounds_i.upper);
+
+    glm::vec3 centroid = (bounds_i.lower + bounds_i.upper) * 0.5f;
+    centroid_lower = glm::min(centroid_lower, centroid);
+    centroid_upper = glm::max(centroid_upper, centroid);
+  }
+  this->nodes[node_index].bounds = node_bounds;
+
+  // Construct leaf
+  // --------------------------------------------------------------------------
+  glm::vec3 extent = centroid_upper - centroid_lower;
+  if (end - begin <= max_leaf_size ||
+      (extent.x <= 0.0f && extent.y <= 0.0f && extent.z <= 0.0f)) {
+    this->nodes[node_index].first = begin;
+    this->nodes[node_index].n_objects = end - begin;
+    return;
+  }
+
+  // Split at the median centroid of the longest axis
+  // --------------------------------------------------------------------------
+  int axis = 0;
+  if (extent.y > extent[axis]) axis = 1;
+  if (extent.z > extent[axis]) axis = 2;
+
+  GLuint mid = begin + (end - begin) / 2;
+  std::nth_element(this->object_indices.begin() + begin,
+                   this->object_indices.begin() + mid,
+                   this->object_indices.begin() + end,
+                   [&bounds, axis](GLuint a, GLuint b) {
+                     return (bounds[a].lower[axis] + bounds[a].upper[axis]) <
+                            (bounds[b].lower[axis] + bounds[b].upper[axis]);
+                   });
+
+  GLuint left_index = GLuint(this->nodes.size());
+  this->nodes[node_index].first = left_index;
+  this->nodes[node_index].n_objects = 0;
+  this->nodes.push_back(Node());
+  this->nodes.push_back(Node());
+
+  this->build(bounds, left_index, begin, mid, max_leaf_size);
+  this->build(bounds, left_index + 1, mid, end, max_leaf_size);
+}
+
+
+GLuint ObjectBVH::query(const Frustum& frustum,
+                        std::vector<bool>& is_visible) const {
+  is_visible.assign(this->object_indices.size(), false);
+  if (this->nodes.empty()) return 0;
+
+  GLuint n_visible = 0;
+
+  // stack of (node index, whether the node is known to be fully inside)
+  std::vector<std::pair<GLuint, bool>> stack;
+  stack.push_back(std::pair<GLuint, bool>(0, false));
+
+  while (!stack.empty()) {
+    std::pair<GLuint, bool> entry = stack.back();
+    stack.pop_back();
+    const Node& node = this->nodes[entry.first];
+
+    bool is_inside = entry.second;
+    if (!is_inside) {
+      FrustumTest test = testFrustum(frustum, node.bounds);
+      if (test == FrustumTest::Outside) continue;
+      is_inside = (test == FrustumTest::Inside);
+    }
+
+    if (node.n_objects > 0) {
+      for (GLuint i = node.first; i < node.first + node.n_objects; ++i) {
+        GLuint object_index = this->object_indices[i];
+        if (is_inside ||
+            testFrustum(frustum, this->object_bounds[object_index]) != FrustumTest::Outside) {
+          is_visible[object_index] = true;
+          n_visible++;
+        }
+      }
+    } else {
+      stack.push_back(std::pair<GLuint, bool>(node.first, is_inside));
+      stack.push_back(std::pair<GLuint, bool>(node.first + 1, is_inside));
+    }
+  }
+
+  return n_visible;
+}
+
+} // pipeline
+} // nTiled
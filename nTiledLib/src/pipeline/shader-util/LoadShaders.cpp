@@ -55,7 +55,9 @@ std::stringstream readShaderWithLights(const std::string& path,
 
 std::stringstream readShaderWithLightsAndOctreeMaps(const std::string& path,
                                                     unsigned int n_lights,
-                                                    unsigned int n_octree_maps) {
+                                                    unsigned int n_octree_maps,
+                                                    bool is_packed_tables,
+                                                    bool is_pow2_tables) {
   // open shader
   std::ifstream f;
   f.open(path.c_str(), std::ios::in | std::ios::binary);
@@ -68,6 +70,8 @@ std::stringstream readShaderWithLightsAndOctreeMaps(const std::string& path,
 
   std::string replaceLineLights = "#define NUM_LIGHTS ";
   std::string replaceLineOctreeMaps = "#define OCTREE_DEPTH ";
+  std::string replaceLinePackedTables = "#define PACKED_TABLES ";
+  std::string replaceLinePow2Tables = "#define POW2_TABLES ";
 
   for (std::string line; std::getline(f, line);) {
     if (line.compare(0, 
@@ -78,6 +82,14 @@ std::stringstream readShaderWithLightsAndOctreeMaps(const std::string& path,
                             replaceLineOctreeMaps.size(), 
                             replaceLineOctreeMaps) == 0) {
       buffer << replaceLineOctreeMaps << std::to_string(n_octree_maps) << std::endl;
+    } else if (line.compare(0,
+                            replaceLinePackedTables.size(),
+                            replaceLinePackedTables) == 0) {
+      buffer << replaceLinePackedTables << (is_packed_tables ? "1" : "0") << std::endl;
+    } else if (line.compare(0,
+                            replaceLinePow2Tables.size(),
+                            replaceLinePow2Tables) == 0) {
+      buffer << replaceLinePow2Tables << (is_pow2_tables ? "1" : "0") << std::endl;
     } else {
       buffer << line << std::endl;
     }
@@ -3,22 +3,39 @@
 // ----------------------------------------------------------------------------
 //  Libraries
 // ----------------------------------------------------------------------------
-#include "math\util.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "util\FileStamp.h"
+
+// ----------------------------------------------------------------------------
+//  Defines
+// ----------------------------------------------------------------------------
+#define TEXTURE_CACHE_VERSION 1
 
 namespace nTiled {
 namespace pipeline {
 
-GLuint loadTexturePNG(const std::string& file_path) {
+static_assert(sizeof(TextureCacheHeader) == 32,
+              "TextureCacheHeader must not contain padding");
+
+void decodeTexturePNG(const std::string& file_path, TextureImage& image) {
   // Load File
   std::vector<unsigned char> buffer;
   lodepng::load_file(buffer, file_path);
 
-
   // Decode file
+  // assumption every image has rgba channels, lodepng converts to RGBA8
   lodepng::State state;
-  std::vector<unsigned char> image;
+  std::vector<unsigned char> decoded;
   unsigned width, height;
-  unsigned error = lodepng::decode(image,
+  unsigned error = lodepng::decode(decoded,
                                    width,
                                    height,
                                    state,
@@ -29,48 +46,153 @@ GLuint loadTexturePNG(const std::string& file_path) {
     throw std::runtime_error(std::string("Can't read png in file: " + file_path +
                                          "\nError: " + lodepng_error_text(error)));
   }
-  const LodePNGInfo& info = state.info_png;
 
-  // Obtain png format information
-  // assumption we don't care about bit depth, might need to check this later on
-  // assumption every image has rgba channels
-  GLint format = GL_RGBA;
+  // Flip rows, png stores the top row first
+  image.width = width;
+  image.height = height;
+  image.pixels.resize(decoded.size());
 
-  // Get pow2 width and height because openGL
-  size_t width_pow2 = math::getNextPow2(width);
-  size_t height_pow2 = math::getNextPow2(height);
-
-  // Construct base image
-  std::vector<unsigned char> image_pow2(width_pow2 * height_pow2 * 4);
+  size_t row_size = 4 * size_t(width);
   for (size_t y = 0; y < height; y++) {
-    for (size_t x = 0; x < width; x++) {
-      for (size_t c = 0; c < 4; c++) {
-        image_pow2[4 * width_pow2 * y + 4 * x + c] =
-          image[4 * width_pow2 * (height - 1 - y) +  // the y position 
-          4 * x +               // the x position
-          c];                   // channel
-      }
+    std::memcpy(&image.pixels[row_size * y],
+                &decoded[row_size * (height - 1 - y)],
+                row_size);
+  }
+}
+
+
+bool readTextureCache(const std::string& cache_path,
+                      const std::string& source_path,
+                      TextureImage& image) {
+  util::FileStamp source_stamp;
+  if (!util::getFileStamp(source_path, source_stamp)) return false;
+
+  std::ifstream ifs(cache_path, std::ios::binary);
+  if (!ifs) return false;
+
+  TextureCacheHeader header;
+  if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(TextureCacheHeader))) {
+    return false;
+  }
+
+  if (std::memcmp(header.magic, "NTTC", 4) != 0 ||
+      header.version != TEXTURE_CACHE_VERSION ||
+      header.source_size != source_stamp.size ||
+      header.source_time != source_stamp.time) {
+    return false;
+  }
+
+  image.width = header.width;
+  image.height = header.height;
+  image.pixels.resize(4 * size_t(header.width) * header.height);
+  return image.pixels.empty() ||
+         bool(ifs.read(reinterpret_cast<char*>(image.pixels.data()),
+                       std::streamsize(image.pixels.size())));
+}
+
+
+bool writeTextureCache(const std::string& cache_path,
+                       const std::string& source_path,
+                       const TextureImage& image) {
+  TextureCacheHeader header;
+  std::memcpy(header.magic, "NTTC", 4);
+  header.version = TEXTURE_CACHE_VERSION;
+
+  util::FileStamp source_stamp;
+  if (!util::getFileStamp(source_path, source_stamp)) return false;
+  header.source_size = source_stamp.size;
+  header.source_time = source_stamp.time;
+  header.width = image.width;
+  header.height = image.height;
+
+  std::string tmp_path = cache_path + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs) return false;
+
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(TextureCacheHeader));
+    ofs.write(reinterpret_cast<const char*>(image.pixels.data()),
+              std::streamsize(image.pixels.size()));
+
+    if (!ofs) {
+      ofs.close();
+      std::remove(tmp_path.c_str());
+      return false;
     }
   }
 
-  // Construct openGL texture
+  return util::replaceFile(tmp_path, cache_path);
+}
+
+
+GLuint uploadTexture(const TextureImage& image, GLsizeiptr* p_size) {
+  // Number of levels in the complete mipmap chain
+  GLsizei n_levels = 1;
+  for (unsigned int size = std::max(image.width, image.height);
+       size > 1;
+       size >>= 1) {
+    n_levels++;
+  }
+
+  // Construct openGL texture, rows are tightly packed
   GLuint p_texture;
   glGenTextures(1, &p_texture);
   glBindTexture(GL_TEXTURE_2D, p_texture);
-  glTexImage2D(GL_TEXTURE_2D,        // target
-               0,                    // level
-               format,               // internalFormat
-               width_pow2,           // width
-               height_pow2,          // height
-               0,                    // border
-               format,               // format
-               GL_UNSIGNED_BYTE,     // type
-               &image_pow2[0]);      // data
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-  glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  if (GLAD_GL_VERSION_4_2 || GLAD_GL_ARB_texture_storage) {
+    glTexStorage2D(GL_TEXTURE_2D,
+                   n_levels,
+                   GL_RGBA8,
+                   image.width,
+                   image.height);
+    glTexSubImage2D(GL_TEXTURE_2D,        // target
+                    0,                    // level
+                    0, 0,                 // offset
+                    image.width,          // width
+                    image.height,         // height
+                    GL_RGBA,              // format
+                    GL_UNSIGNED_BYTE,     // type
+                    image.pixels.data()); // data
+  } else {
+    glTexImage2D(GL_TEXTURE_2D,        // target
+                 0,                    // level
+                 GL_RGBA8,             // internalFormat
+                 image.width,          // width
+                 image.height,         // height
+                 0,                    // border
+                 GL_RGBA,              // format
+                 GL_UNSIGNED_BYTE,     // type
+                 image.pixels.data()); // data
+  }
+  glGenerateMipmap(GL_TEXTURE_2D);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  if (p_size) {
+    GLsizeiptr size = 0;
+    unsigned int width = image.width;
+    unsigned int height = image.height;
+    for (GLsizei level = 0; level < n_levels; ++level) {
+      size += GLsizeiptr(4) * width * height;
+      width = std::max(width / 2, 1u);
+      height = std::max(height / 2, 1u);
+    }
+    *p_size = size;
+  }
 
   return p_texture;
 }
 
+
+GLuint loadTexturePNG(const std::string& file_path) {
+  TextureImage image;
+  decodeTexturePNG(file_path, image);
+  return uploadTexture(image);
+}
+
 } // pipeline
-} // nTiled 
\ No newline at end of file
+} // nTiled 
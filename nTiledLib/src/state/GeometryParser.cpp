@@ -18,11 +18,13 @@
 #include <iostream>
 // stl
 #include <algorithm>
+#include <stdexcept>
 
 // ----------------------------------------------------------------------------
 //  nTiled headers
 // ----------------------------------------------------------------------------
 #include "world\object-constructor\AssImpConstructor.h"
+#include "world\object-constructor\MeshLoader.h"
 #include "math\util.h"
 
 namespace nTiled {
@@ -99,36 +101,66 @@ void state::parseGeometry(const std::string& path,
       pipeline::ShaderKey(pipeline::DeferredShaderId::DeferredHashed) },
   };
 
+  auto& objects_json = geometry["objects"];
+
+  //  Load meshes
+  // --------------------------------------------------------------------------
+  // Every mesh file referenced by an object is loaded once, concurrently,
+  // and read from its mesh cache if possible.
+  bool use_mesh_cache = true;
+  rapidjson::Value::ConstMemberIterator cache_itr =
+    geometry.FindMember("mesh_cache");
+  if (cache_itr != geometry.MemberEnd()) {
+    use_mesh_cache = cache_itr->value.GetBool();
+  }
+
+  std::vector<std::string> mesh_paths = std::vector<std::string>();
+  for (rapidjson::Value::ConstValueIterator itr = objects_json.Begin();
+       itr != objects_json.End();
+       ++itr) {
+    std::string mesh_id = (*itr)["mesh_id"].GetString();
+    std::map<std::string, std::string>::iterator path_it = mesh_map.find(mesh_id);
+    if (path_it == mesh_map.end()) {
+      throw std::runtime_error(std::string("Unknown mesh_id: ") + mesh_id);
+    }
+
+    if (std::find(mesh_paths.begin(),
+                  mesh_paths.end(),
+                  path_it->second) == mesh_paths.end()) {
+      mesh_paths.push_back(path_it->second);
+    }
+  }
+
+  world::MeshLoader mesh_loader = world::MeshLoader(use_mesh_cache);
+  std::vector<world::Mesh*> ps_mesh = mesh_loader.load(mesh_paths, world);
+
+  std::cout << "Loaded " << mesh_paths.size() << " meshes ("
+            << mesh_loader.getNCacheHits() << " from cache) in "
+            << mesh_loader.getLoadTime() << " ms" << std::endl;
+
   // Object constructor catalog
   std::map<std::string, world::AssImpConstructor*> obj_constructor_catalog =
     std::map<std::string, world::AssImpConstructor*>();
 
+  for (unsigned int i = 0; i < mesh_paths.size(); ++i) {
+    obj_constructor_catalog.insert(std::pair<std::string,
+                                   world::AssImpConstructor*>(
+                                     mesh_paths[i],
+                                     new world::AssImpConstructor(ps_mesh[i],
+                                                                  world)));
+  }
+
   //  Build Objects
   // --------------------------------------------------------------------------
-  auto& objects_json = geometry["objects"];
   for (rapidjson::Value::ConstValueIterator itr = objects_json.Begin();
        itr != objects_json.End();
        ++itr) {
 
     // get object constructor
     // ------------------------------------------------------------------------
-    world::AssImpConstructor* obj_constructor_p;
-
-    // check if mesh constructor already exists
     std::string mesh_id = (*itr)["mesh_id"].GetString();
-    std::map<std::string, world::AssImpConstructor*>::iterator it =
-      obj_constructor_catalog.find(mesh_id);
-
-    if (it != obj_constructor_catalog.end()) {
-      obj_constructor_p = it->second;
-    } else {
-      obj_constructor_p = new world::AssImpConstructor(mesh_map[mesh_id],
-                                                       world);
-      obj_constructor_catalog.insert(std::pair<std::string, 
-                                     world::AssImpConstructor*>(
-                                       mesh_id, 
-                                       obj_constructor_p));
-    }
+    world::AssImpConstructor* obj_constructor_p =
+      obj_constructor_catalog[mesh_map[mesh_id]];
 
     // get attributes of the object
     // name
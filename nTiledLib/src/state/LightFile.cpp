@@ -0,0 +1,276 @@
+#include "state\LightFile.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// Json include
+#include <rapidjson\reader.h>
+#include <rapidjson\filereadstream.h>
+#include <rapidjson\filewritestream.h>
+#include <rapidjson\writer.h>
+
+// ----------------------------------------------------------------------------
+//  Defines
+// ----------------------------------------------------------------------------
+#define LIGHT_FILE_VERSION 1
+// Size of the read and write buffers of the json streams
+#define LIGHT_STREAM_BUFFER_SIZE 65536
+
+
+namespace nTiled {
+namespace state {
+
+static_assert(sizeof(LightRecord) == 7 * sizeof(float),
+              "LightRecord must be tightly packed");
+static_assert(sizeof(LightFileHeader) == 16,
+              "LightFileHeader must not contain padding");
+
+// ----------------------------------------------------------------------------
+//  Json reader
+// ----------------------------------------------------------------------------
+/*! @brief LightsHandler builds LightRecords from the events of a streaming
+ *         json reader, for files of the form
+ *         { "lights": [ { "position": { "x", "y", "z" },
+ *                         "intensity": { "r", "g", "b" },
+ *                         "radius" }, ... ] }
+ */
+class LightsHandler :
+    public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, LightsHandler> {
+public:
+  LightsHandler(std::vector<LightRecord>& lights) :
+      lights(lights),
+      object_depth(0),
+      is_in_lights(false),
+      key(""),
+      attribute("") {
+    this->resetLight();
+  }
+
+  bool StartObject() {
+    this->object_depth++;
+    if (this->object_depth == 3) this->attribute = this->key;
+    return true;
+  }
+
+  bool EndObject(rapidjson::SizeType n_members) {
+    if (this->object_depth == 3) {
+      this->attribute = "";
+    } else if (this->object_depth == 2 && this->is_in_lights) {
+      this->lights.push_back(this->light);
+      this->resetLight();
+    }
+    this->object_depth--;
+    return true;
+  }
+
+  bool StartArray() {
+    if (this->object_depth == 1 && this->key == "lights") {
+      this->is_in_lights = true;
+    }
+    return true;
+  }
+
+  bool EndArray(rapidjson::SizeType n_elements) {
+    if (this->object_depth == 1) this->is_in_lights = false;
+    return true;
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+    this->key.assign(str, length);
+    return true;
+  }
+
+  bool Double(double d) { return this->number(float(d)); }
+  bool Int(int i) { return this->number(float(i)); }
+  bool Uint(unsigned u) { return this->number(float(u)); }
+  bool Int64(int64_t i) { return this->number(float(i)); }
+  bool Uint64(uint64_t u) { return this->number(float(u)); }
+
+private:
+  bool number(float value) {
+    if (!this->is_in_lights) return true;
+
+    if (this->object_depth == 2 && this->key == "radius") {
+      this->light.radius = value;
+    } else if (this->object_depth == 3) {
+      if (this->attribute == "position") {
+        if (this->key == "x") this->light.position.x = value;
+        else if (this->key == "y") this->light.position.y = value;
+        else if (this->key == "z") this->light.position.z = value;
+      } else if (this->attribute == "intensity") {
+        if (this->key == "r") this->light.intensity.r = value;
+        else if (this->key == "g") this->light.intensity.g = value;
+        else if (this->key == "b") this->light.intensity.b = value;
+      }
+    }
+    return true;
+  }
+
+  void resetLight() {
+    this->light.position = glm::vec3(0.0f);
+    this->light.intensity = glm::vec3(0.0f);
+    this->light.radius = 0.0f;
+  }
+
+  std::vector<LightRecord>& lights;
+  LightRecord light;
+
+  int object_depth;
+  bool is_in_lights;
+  std::string key;
+  std::string attribute;
+};
+
+
+bool isBinaryLightFile(const std::string& path) {
+  std::ifstream ifs(path, std::ios::binary);
+  char magic[4];
+  return (ifs.read(magic, 4) && std::memcmp(magic, "NTLT", 4) == 0);
+}
+
+
+void readLightsJson(const std::string& path,
+                    std::vector<LightRecord>& lights) {
+  std::FILE* p_file = std::fopen(path.c_str(), "rb");
+  if (!p_file) {
+    throw std::runtime_error(std::string("Could not open light file: ") + path);
+  }
+
+  char buffer[LIGHT_STREAM_BUFFER_SIZE];
+  rapidjson::FileReadStream stream(p_file, buffer, sizeof(buffer));
+  LightsHandler handler(lights);
+  rapidjson::Reader reader;
+  rapidjson::ParseResult result = reader.Parse(stream, handler);
+  std::fclose(p_file);
+
+  if (!result) {
+    throw std::runtime_error(std::string("Could not parse light file: ") + path +
+                             std::string(" at offset ") +
+                             std::to_string(result.Offset()));
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+//  Binary reader
+// ----------------------------------------------------------------------------
+void readLightsBinary(const std::string& path,
+                      std::vector<LightRecord>& lights) {
+  std::ifstream ifs(path, std::ios::binary);
+  if (!ifs) {
+    throw std::runtime_error(std::string("Could not open light file: ") + path);
+  }
+
+  LightFileHeader header;
+  if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(LightFileHeader)) ||
+      std::memcmp(header.magic, "NTLT", 4) != 0 ||
+      header.version != LIGHT_FILE_VERSION) {
+    throw std::runtime_error(std::string("Invalid binary light file: ") + path);
+  }
+
+  std::size_t offset = lights.size();
+  lights.resize(offset + std::size_t(header.n_lights));
+  if (header.n_lights > 0 &&
+      !ifs.read(reinterpret_cast<char*>(&lights[offset]),
+                std::streamsize(sizeof(LightRecord) * header.n_lights))) {
+    lights.resize(offset);
+    throw std::runtime_error(std::string("Truncated binary light file: ") + path);
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+//  Writers
+// ----------------------------------------------------------------------------
+void writeLightsJson(const std::string& path,
+                     const std::vector<LightRecord>& lights) {
+  std::FILE* p_file = std::fopen(path.c_str(), "wb");
+  if (!p_file) {
+    throw std::runtime_error(std::string("Could not write light file: ") + path);
+  }
+
+  char buffer[LIGHT_STREAM_BUFFER_SIZE];
+  rapidjson::FileWriteStream stream(p_file, buffer, sizeof(buffer));
+  rapidjson::Writer<rapidjson::FileWriteStream> writer(stream);
+
+  writer.StartObject();
+  writer.Key("lights");
+  writer.StartArray();
+  for (const LightRecord& light : lights) {
+    writer.StartObject();
+    writer.Key("position");
+    writer.StartObject();
+    writer.Key("x"); writer.Double(light.position.x);
+    writer.Key("y"); writer.Double(light.position.y);
+    writer.Key("z"); writer.Double(light.position.z);
+    writer.EndObject();
+    writer.Key("intensity");
+    writer.StartObject();
+    writer.Key("r"); writer.Double(light.intensity.r);
+    writer.Key("g"); writer.Double(light.intensity.g);
+    writer.Key("b"); writer.Double(light.intensity.b);
+    writer.EndObject();
+    writer.Key("radius"); writer.Double(light.radius);
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  stream.Flush();
+
+  bool is_written = (std::ferror(p_file) == 0);
+  std::fclose(p_file);
+  if (!is_written) {
+    throw std::runtime_error(std::string("Could not write light file: ") + path);
+  }
+}
+
+
+void writeLightsBinary(const std::string& path,
+                       const std::vector<LightRecord>& lights) {
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+
+  LightFileHeader header;
+  std::memcpy(header.magic, "NTLT", 4);
+  header.version = LIGHT_FILE_VERSION;
+  header.n_lights = lights.size();
+
+  ofs.write(reinterpret_cast<const char*>(&header), sizeof(LightFileHeader));
+  if (!lights.empty()) {
+    ofs.write(reinterpret_cast<const char*>(lights.data()),
+              std::streamsize(sizeof(LightRecord) * lights.size()));
+  }
+
+  if (!ofs) {
+    throw std::runtime_error(std::string("Could not write light file: ") + path);
+  }
+}
+
+
+std::size_t convertLights(const std::string& input_path,
+                          const std::string& output_path) {
+  std::vector<LightRecord> lights;
+  if (isBinaryLightFile(input_path)) {
+    readLightsBinary(input_path, lights);
+  } else {
+    readLightsJson(input_path, lights);
+  }
+
+  std::string extension = ".json";
+  if (output_path.size() >= extension.size() &&
+      output_path.compare(output_path.size() - extension.size(),
+                          extension.size(),
+                          extension) == 0) {
+    writeLightsJson(output_path, lights);
+  } else {
+    writeLightsBinary(output_path, lights);
+  }
+  return lights.size();
+}
+
+} // state
+} // nTiled
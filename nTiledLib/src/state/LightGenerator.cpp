@@ -0,0 +1,413 @@
+#include "state\LightGenerator.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <random>
+#include <stdexcept>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "state\State.h"
+
+
+namespace nTiled {
+namespace state {
+
+// ----------------------------------------------------------------------------
+//  LightGeneratorConfig
+// ----------------------------------------------------------------------------
+LightGeneratorConfig::LightGeneratorConfig() :
+    n_lights(1024),
+    seed(22),
+    distribution(LightDistribution::Uniform),
+    bounds_min(glm::vec3(-50.0f)),
+    bounds_max(glm::vec3(50.0f)),
+    is_using_world_bounds(false),
+    n_clusters(8),
+    cluster_sigma(2.0f),
+    surface_offset(0.1f),
+    radius_distribution(RadiusDistribution::Constant),
+    radius_min(1.0f),
+    radius_max(10.0f),
+    radius_mean(5.0f),
+    radius_sigma(1.0f),
+    intensity(glm::vec3(1.0f)),
+    is_random_intensity(false) {
+}
+
+
+// ----------------------------------------------------------------------------
+//  Helper functions
+// ----------------------------------------------------------------------------
+/*! @brief Parse a glm::vec3 from a json object with the specified keys. */
+static glm::vec3 parseVec3(const rapidjson::Value& json,
+                           const char* x,
+                           const char* y,
+                           const char* z) {
+  return glm::vec3(json[x].GetFloat(), json[y].GetFloat(), json[z].GetFloat());
+}
+
+
+/*! @brief Get whether path ends in the specified extension. */
+static bool hasExtension(const std::string& path, const std::string& extension) {
+  return (path.size() >= extension.size() &&
+          path.compare(path.size() - extension.size(),
+                       extension.size(),
+                       extension) == 0);
+}
+
+
+/*! @brief Triangle is a single triangle of an Object in world coordinates. */
+struct Triangle {
+  glm::vec3 a;
+  glm::vec3 b;
+  glm::vec3 c;
+};
+
+
+/*! @brief Collect all triangles of the objects of world in world
+ *         coordinates, with the cumulative area up to and including every
+ *         triangle.
+ */
+static void collectTriangles(const world::World& world,
+                             std::vector<Triangle>& triangles,
+                             std::vector<double>& cumulative_area) {
+  double total_area = 0.0;
+  for (const world::Object* p_object : world.p_objects) {
+    const world::Mesh& mesh = p_object->mesh;
+    for (const glm::tvec3<glm::u32>& element : mesh.elements) {
+      Triangle triangle;
+      triangle.a = glm::vec3(p_object->transformation_matrix * mesh.vertices[element.x]);
+      triangle.b = glm::vec3(p_object->transformation_matrix * mesh.vertices[element.y]);
+      triangle.c = glm::vec3(p_object->transformation_matrix * mesh.vertices[element.z]);
+
+      double area = 0.5 * glm::length(glm::cross(triangle.b - triangle.a,
+                                                 triangle.c - triangle.a));
+      if (area <= 0.0) continue;
+
+      total_area += area;
+      triangles.push_back(triangle);
+      cumulative_area.push_back(total_area);
+    }
+  }
+}
+
+
+/*! @brief Get the bounds of the objects of world in world coordinates. */
+static void getWorldBounds(const world::World& world,
+                           glm::vec3& bounds_min,
+                           glm::vec3& bounds_max) {
+  bounds_min = glm::vec3(std::numeric_limits<float>::max());
+  bounds_max = glm::vec3(std::numeric_limits<float>::lowest());
+  for (const world::Object* p_object : world.p_objects) {
+    for (const glm::vec4& vertex : p_object->mesh.vertices) {
+      glm::vec3 position = glm::vec3(p_object->transformation_matrix * vertex);
+      bounds_min = glm::min(bounds_min, position);
+      bounds_max = glm::max(bounds_max, position);
+    }
+  }
+}
+
+
+// ----------------------------------------------------------------------------
+//  Parsing
+// ----------------------------------------------------------------------------
+LightGeneratorConfig parseLightGeneratorConfig(const rapidjson::Value& config_json) {
+  LightGeneratorConfig config = LightGeneratorConfig();
+
+  rapidjson::Value::ConstMemberIterator n_lights_itr = config_json.FindMember("n_lights");
+  if (n_lights_itr != config_json.MemberEnd()) {
+    config.n_lights = n_lights_itr->value.GetUint();
+  }
+
+  rapidjson::Value::ConstMemberIterator seed_itr = config_json.FindMember("seed");
+  if (seed_itr != config_json.MemberEnd()) {
+    config.seed = seed_itr->value.GetUint();
+  }
+
+  // Placement
+  // --------------------------------------------------------------------------
+  rapidjson::Value::ConstMemberIterator distribution_itr = config_json.FindMember("distribution");
+  if (distribution_itr != config_json.MemberEnd()) {
+    std::string distribution = distribution_itr->value.GetString();
+    if (distribution == "uniform") {
+      config.distribution = LightDistribution::Uniform;
+    } else if (distribution == "clustered") {
+      config.distribution = LightDistribution::Clustered;
+    } else if (distribution == "grid") {
+      config.distribution = LightDistribution::Grid;
+    } else if (distribution == "surface") {
+      config.distribution = LightDistribution::Surface;
+    } else {
+      throw std::runtime_error(std::string("Unknown light distribution: ") + distribution);
+    }
+  }
+
+  rapidjson::Value::ConstMemberIterator bounds_itr = config_json.FindMember("bounds");
+  if (bounds_itr != config_json.MemberEnd()) {
+    if (bounds_itr->value.IsString()) {
+      config.is_using_world_bounds = (std::string(bounds_itr->value.GetString()) == "world");
+    } else {
+      config.bounds_min = parseVec3(bounds_itr->value["min"], "x", "y", "z");
+      config.bounds_max = parseVec3(bounds_itr->value["max"], "x", "y", "z");
+    }
+  }
+
+  rapidjson::Value::ConstMemberIterator n_clusters_itr = config_json.FindMember("n_clusters");
+  if (n_clusters_itr != config_json.MemberEnd()) {
+    config.n_clusters = n_clusters_itr->value.GetUint();
+  }
+
+  rapidjson::Value::ConstMemberIterator sigma_itr = config_json.FindMember("cluster_sigma");
+  if (sigma_itr != config_json.MemberEnd()) {
+    config.cluster_sigma = sigma_itr->value.GetFloat();
+  }
+
+  rapidjson::Value::ConstMemberIterator offset_itr = config_json.FindMember("surface_offset");
+  if (offset_itr != config_json.MemberEnd()) {
+    config.surface_offset = offset_itr->value.GetFloat();
+  }
+
+  // Radius
+  // --------------------------------------------------------------------------
+  rapidjson::Value::ConstMemberIterator radius_itr = config_json.FindMember("radius");
+  if (radius_itr != config_json.MemberEnd()) {
+    const rapidjson::Value& radius_json = radius_itr->value;
+    if (radius_json.IsNumber()) {
+      config.radius_distribution = RadiusDistribution::Constant;
+      config.radius_mean = radius_json.GetFloat();
+    } else {
+      rapidjson::Value::ConstMemberIterator itr = radius_json.FindMember("distribution");
+      if (itr != radius_json.MemberEnd()) {
+        std::string distribution = itr->value.GetString();
+        if (distribution == "constant") {
+          config.radius_distribution = RadiusDistribution::Constant;
+        } else if (distribution == "uniform") {
+          config.radius_distribution = RadiusDistribution::Uniform;
+        } else if (distribution == "normal") {
+          config.radius_distribution = RadiusDistribution::Normal;
+        } else {
+          throw std::runtime_error(std::string("Unknown radius distribution: ") + distribution);
+        }
+      }
+
+      itr = radius_json.FindMember("min");
+      if (itr != radius_json.MemberEnd()) config.radius_min = itr->value.GetFloat();
+      itr = radius_json.FindMember("max");
+      if (itr != radius_json.MemberEnd()) config.radius_max = itr->value.GetFloat();
+      itr = radius_json.FindMember("mean");
+      if (itr != radius_json.MemberEnd()) config.radius_mean = itr->value.GetFloat();
+      itr = radius_json.FindMember("sigma");
+      if (itr != radius_json.MemberEnd()) config.radius_sigma = itr->value.GetFloat();
+    }
+  }
+
+  // Intensity
+  // --------------------------------------------------------------------------
+  rapidjson::Value::ConstMemberIterator intensity_itr = config_json.FindMember("intensity");
+  if (intensity_itr != config_json.MemberEnd()) {
+    if (intensity_itr->value.IsString()) {
+      config.is_random_intensity = (std::string(intensity_itr->value.GetString()) == "random");
+    } else {
+      config.intensity = parseVec3(intensity_itr->value, "r", "g", "b");
+    }
+  }
+
+  return config;
+}
+
+
+// ----------------------------------------------------------------------------
+//  Generation
+// ----------------------------------------------------------------------------
+void generateLights(const LightGeneratorConfig& config,
+                    const world::World& world,
+                    std::vector<LightRecord>& lights) {
+  std::mt19937 gen = std::mt19937(config.seed);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+  // Bounds
+  // --------------------------------------------------------------------------
+  glm::vec3 bounds_min = config.bounds_min;
+  glm::vec3 bounds_max = config.bounds_max;
+  if (config.is_using_world_bounds) {
+    if (world.p_objects.empty()) {
+      throw std::runtime_error(std::string("World bounds require objects in the world"));
+    }
+    getWorldBounds(world, bounds_min, bounds_max);
+  }
+  glm::vec3 extent = bounds_max - bounds_min;
+
+  // Distribution specific data
+  // --------------------------------------------------------------------------
+  std::vector<glm::vec3> cluster_centres;
+  if (config.distribution == LightDistribution::Clustered) {
+    for (unsigned int i = 0; i < std::max(config.n_clusters, 1u); ++i) {
+      cluster_centres.push_back(bounds_min + extent * glm::vec3(unit(gen),
+                                                                unit(gen),
+                                                                unit(gen)));
+    }
+  }
+
+  std::vector<Triangle> triangles;
+  std::vector<double> cumulative_area;
+  if (config.distribution == LightDistribution::Surface) {
+    collectTriangles(world, triangles, cumulative_area);
+    if (triangles.empty()) {
+      throw std::runtime_error(std::string("Surface distributed lights require objects in the world"));
+    }
+  }
+
+  std::size_t n_grid = std::size_t(std::ceil(std::cbrt(double(config.n_lights))));
+  if (n_grid == 0) n_grid = 1;
+  while (n_grid * n_grid * n_grid < config.n_lights) n_grid++;
+
+  std::normal_distribution<float> cluster_offset(0.0f, config.cluster_sigma);
+  std::uniform_int_distribution<std::size_t> cluster_index(0, std::max(cluster_centres.size(), std::size_t(1)) - 1);
+  std::normal_distribution<float> radius_normal(config.radius_mean, config.radius_sigma);
+
+  // Generate lights
+  // --------------------------------------------------------------------------
+  lights.reserve(lights.size() + config.n_lights);
+  for (std::size_t i = 0; i < config.n_lights; ++i) {
+    LightRecord light;
+
+    switch (config.distribution) {
+      case LightDistribution::Clustered: {
+        glm::vec3 offset = glm::vec3(cluster_offset(gen),
+                                     cluster_offset(gen),
+                                     cluster_offset(gen));
+        light.position = glm::clamp(cluster_centres[cluster_index(gen)] + offset,
+                                    bounds_min,
+                                    bounds_max);
+        break;
+      }
+      case LightDistribution::Grid: {
+        glm::vec3 cell = glm::vec3(float(i % n_grid),
+                                   float((i / n_grid) % n_grid),
+                                   float(i / (n_grid * n_grid)));
+        light.position = bounds_min + extent * ((cell + glm::vec3(0.5f)) / float(n_grid));
+        break;
+      }
+      case LightDistribution::Surface: {
+        double area = double(unit(gen)) * cumulative_area.back();
+        std::size_t index = std::size_t(
+          std::upper_bound(cumulative_area.begin(), cumulative_area.end(), area) -
+          cumulative_area.begin());
+        const Triangle& triangle = triangles[std::min(index, triangles.size() - 1)];
+
+        // uniform point on the triangle
+        float sqrt_r1 = std::sqrt(unit(gen));
+        float r2 = unit(gen);
+        glm::vec3 point = ((1.0f - sqrt_r1) * triangle.a +
+                           (sqrt_r1 * (1.0f - r2)) * triangle.b +
+                           (sqrt_r1 * r2) * triangle.c);
+        glm::vec3 normal = glm::normalize(glm::cross(triangle.b - triangle.a,
+                                                     triangle.c - triangle.a));
+        light.position = point + normal * config.surface_offset;
+        break;
+      }
+      default:
+        light.position = bounds_min + extent * glm::vec3(unit(gen),
+                                                         unit(gen),
+                                                         unit(gen));
+        break;
+    }
+
+    switch (config.radius_distribution) {
+      case RadiusDistribution::Uniform:
+        light.radius = config.radius_min + (config.radius_max - config.radius_min) * unit(gen);
+        break;
+      case RadiusDistribution::Normal:
+        light.radius = glm::clamp(radius_normal(gen), config.radius_min, config.radius_max);
+        break;
+      default:
+        light.radius = config.radius_mean;
+        break;
+    }
+
+    if (config.is_random_intensity) {
+      light.intensity = glm::vec3(unit(gen), unit(gen), unit(gen));
+    } else {
+      light.intensity = config.intensity;
+    }
+
+    lights.push_back(light);
+  }
+}
+
+
+std::size_t addGeneratedLights(const LightGeneratorConfig& config,
+                               const world::World& world,
+                               world::LightConstructor& constructor) {
+  std::vector<LightRecord> lights;
+  generateLights(config, world, lights);
+
+  for (std::size_t i = 0; i < lights.size(); i++) {
+    const LightRecord& light = lights[i];
+    constructor.add("generated_light" + std::to_string(i),
+                    glm::vec4(light.position, 1.0f),
+                    light.intensity,
+                    light.radius,
+                    true);
+  }
+  return lights.size();
+}
+
+
+std::size_t generateLightFile(const std::string& config_path,
+                              const std::string& output_path) {
+  std::ifstream ifs(config_path);
+  if (!ifs) {
+    throw std::runtime_error(std::string("Could not open light generator config: ") + config_path);
+  }
+  std::string config_file((std::istreambuf_iterator<char>(ifs)),
+                          (std::istreambuf_iterator<char>()));
+  rapidjson::Document config_json;
+  config_json.Parse(config_file.c_str());
+  if (config_json.HasParseError() || !config_json.IsObject()) {
+    throw std::runtime_error(std::string("Could not parse light generator config: ") + config_path);
+  }
+
+  LightGeneratorConfig config = parseLightGeneratorConfig(config_json);
+
+  // Geometry used for surface distributions and world bounds
+  // --------------------------------------------------------------------------
+  world::World world;
+  rapidjson::Value::ConstMemberIterator geometry_itr = config_json.FindMember("geometry");
+  if (geometry_itr != config_json.MemberEnd()) {
+    std::vector<pipeline::ForwardShaderId> forward_shader_ids;
+    pipeline::DeferredShaderId deferred_shader_id;
+    std::map<std::string, std::string> texture_file_map;
+
+    for (rapidjson::Value::ConstValueIterator itr = geometry_itr->value.Begin();
+         itr != geometry_itr->value.End();
+         ++itr) {
+      parseGeometry((*itr)["path"].GetString(),
+                    world,
+                    forward_shader_ids,
+                    deferred_shader_id,
+                    texture_file_map);
+    }
+  }
+
+  std::vector<LightRecord> lights;
+  generateLights(config, world, lights);
+
+  if (hasExtension(output_path, ".json")) {
+    writeLightsJson(output_path, lights);
+  } else {
+    writeLightsBinary(output_path, lights);
+  }
+  return lights.size();
+}
+
+} // state
+} // nTiled
@@ -3,79 +3,49 @@
 // ----------------------------------------------------------------------------
 //  Libraries
 // ----------------------------------------------------------------------------
-// File handling
-#include <fstream>
+#include <chrono>
+#include <iostream>
 #include <string>
 #include <vector>
 
-// Json include
-#include <rapidjson\document.h>
-
-#include <glm/gtc/matrix_transform.hpp>
-
-#define DEBUG
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "state\LightFile.h"
+#include "util\MemoryUsage.h"
 
-#ifdef DEBUG
-#include <iostream>
-#endif // DEBUG
 
 void nTiled::state::parseLights(const std::string& path,
                                nTiled::world::LightConstructor& constructor) {
-#ifdef DEBUG
-	std::cout << "      file: " << path << std::endl;
-	std::cout << "          loading ... ";
-#endif // DEBUG
-	std::ifstream ifs(path);
-	std::string lights_file((std::istreambuf_iterator<char>(ifs)),
-		(std::istreambuf_iterator<char>()));
-	// parse json
-#ifdef DEBUG
-	std::cout << "DONE" << std::endl;
-#endif // DEBUG
-
-#ifdef DEBUG
-	std::cout << "          parsing ... ";
-#endif // DEBUG
-	rapidjson::Document lights;
-	lights.Parse(lights_file.c_str());
-#ifdef DEBUG
-	std::cout << "DONE" << std::endl;
-#endif // DEBUG
-
-#ifdef DEBUG
-	std::cout << "          constructing lights ... ";
-#endif // DEBUG
-
-	unsigned int i = 0;
-
-	auto& lights_array_json = lights["lights"];
-	for (rapidjson::Value::ConstValueIterator itr = lights_array_json.Begin();
-	     itr != lights_array_json.End();
-		 ++itr) {
-
-        // Read position
-		auto& position_json = (*itr)["position"];
-		glm::vec3 position = glm::vec3(position_json["x"].GetFloat(),
-		                               position_json["y"].GetFloat(),
-		                               position_json["z"].GetFloat());
-
-		// Read colour
-		auto& intensity_json = (*itr)["intensity"];
-		glm::vec3 intensity = glm::vec3(intensity_json["r"].GetFloat(),
-		                                intensity_json["g"].GetFloat(),
-		                                intensity_json["b"].GetFloat());
-
-		// Read radius
-		float radius = (*itr)["radius"].GetFloat();
-
-		constructor.add("point_light" + std::to_string(i),
-                    glm::vec4(position, 1.0f),
-                    intensity, 
-                    radius, 
+  auto start = std::chrono::steady_clock::now();
+
+  // Read light records, without constructing a json document
+  // --------------------------------------------------------------------------
+  std::vector<LightRecord> lights;
+  bool is_binary = isBinaryLightFile(path);
+  if (is_binary) {
+    readLightsBinary(path, lights);
+  } else {
+    readLightsJson(path, lights);
+  }
+
+  double parse_time = std::chrono::duration<double, std::milli>(
+    std::chrono::steady_clock::now() - start).count();
+
+  // Construct lights
+  // --------------------------------------------------------------------------
+  for (std::size_t i = 0; i < lights.size(); i++) {
+    const LightRecord& light = lights[i];
+    constructor.add("point_light" + std::to_string(i),
+                    glm::vec4(light.position, 1.0f),
+                    light.intensity,
+                    light.radius,
                     true);
-		i++;
-	}
-#ifdef DEBUG
-	std::cout << i << " constructed" << std::endl;
-#endif // DEBUG
-}
\ No newline at end of file
+  }
+
+  std::cout << "      file: " << path << std::endl;
+  std::cout << "          " << lights.size() << " lights parsed ("
+            << (is_binary ? "binary" : "json") << ") in "
+            << parse_time << " ms, peak memory "
+            << util::getPeakMemoryUsage() / (1024 * 1024) << " MB" << std::endl;
+}
@@ -16,6 +16,8 @@
 //  nTiled headers
 // ----------------------------------------------------------------------------
 #include "world\light-constructor\PointLightConstructor.h"
+#include "state\LightGenerator.h"
+#include "pipeline\pipeline-util\VertexFormat.h"
 #include <glm/gtc/matrix_transform.hpp>
 
 // TODO add graceful error handling
@@ -141,25 +143,17 @@ State* constructStateFromJson(const std::string& path) {
   pipeline::hashed::HashedConfig hashed_config = pipeline::hashed::HashedConfig();
   rapidjson::Value::ConstMemberIterator hashed_config_itr = config.FindMember("hashed_config");
   if (hashed_config_itr != config.MemberEnd()) {
-    auto& hashed_config_json = hashed_config_itr->value;
-
-    unsigned int hashed_seed = 22;
-    rapidjson::Value::ConstMemberIterator hashed_seed_itr = hashed_config_json.FindMember("seed");
-    if (hashed_seed_itr != hashed_config_json.MemberEnd()) {
-      hashed_seed = hashed_config_json["seed"].GetUint();
-    }
-
-    hashed_config = pipeline::hashed::HashedConfig(hashed_config_json["node_size"].GetFloat(),
-                                                   hashed_config_json["starting_depth"].GetUint(),
-                                                   hashed_config_json["r_increase_ratio"].GetFloat(),
-                                                   hashed_config_json["max_attempts"].GetUint(),
-                                                   hashed_seed);
+    hashed_config = pipeline::hashed::parseHashedConfig(hashed_config_itr->value);
   } 
 
   // is debug
   rapidjson::Value::ConstMemberIterator itr = config.FindMember("is_debug");
   bool is_debug = ((itr != config.MemberEnd()) && itr->value.GetBool());
 
+  // is headless
+  rapidjson::Value::ConstMemberIterator headless_itr = config.FindMember("is_headless");
+  bool is_headless = ((headless_itr != config.MemberEnd()) && headless_itr->value.GetBool());
+
   // is logging data
   bool is_logging_data = false;
   bool is_counting_calculations = false;
@@ -167,6 +161,8 @@ State* constructStateFromJson(const std::string& path) {
   unsigned int logged_end_frame = 0;
   std::string log_output_path = "";
   std::string log_output_path_calculations = "";
+  std::string log_stream_path = "";
+  bool is_exporting_calculation_tiles = false;
 
   rapidjson::Value::ConstMemberIterator log_itr = config.FindMember("log");
   if (log_itr != config.MemberEnd()) {
@@ -183,8 +179,18 @@ State* constructStateFromJson(const std::string& path) {
 
       if (is_counting_calculations) {
         log_output_path_calculations = log_json["output_path_calculations"].GetString();
+
+        rapidjson::Value::ConstMemberIterator tiles_itr = log_json.FindMember("is_exporting_calculation_tiles");
+        if (tiles_itr != log_json.MemberEnd()) {
+          is_exporting_calculation_tiles = tiles_itr->value.GetBool();
+        }
       }
     }
+
+    rapidjson::Value::ConstMemberIterator stream_itr = log_json.FindMember("stream_path");
+    if (stream_itr != log_json.MemberEnd()) {
+      log_stream_path = stream_itr->value.GetString();
+    }
   }
 
   // should exit after finishing data
@@ -214,9 +220,7 @@ State* constructStateFromJson(const std::string& path) {
     auto& itr = config["camera"].FindMember("frames_path");
     if (itr != config["camera"].MemberEnd()) {
       std::string frames_path = itr->value.GetString();
-      std::vector<glm::mat4> frames = readCameraFrames(frames_path);
-
-      camera_control = new camera::PathCameraControl(frames);
+      camera_control = new camera::PathCameraControl(frames_path);
     } else {
       throw std::runtime_error(std::string("No path specified"));
     }
@@ -280,10 +284,33 @@ State* constructStateFromJson(const std::string& path) {
       unsigned int frame_start = output_json["frame_start"].GetUint();
       unsigned int frame_end = output_json["frame_end"].GetUint();
       std::string base_path = output_json["image_base_path"].GetString();
-      
+
+      CaptureFormat capture_format = CaptureFormat::PNG;
+      rapidjson::Value::ConstMemberIterator format_itr =
+        output_json.FindMember("format");
+      if (format_itr != output_json.MemberEnd()) {
+        std::string format_str = format_itr->value.GetString();
+        if (format_str == "PNG") {
+          capture_format = CaptureFormat::PNG;
+        } else if (format_str == "PNG_FAST") {
+          capture_format = CaptureFormat::PNGFast;
+        } else if (format_str == "TGA") {
+          capture_format = CaptureFormat::TGA;
+        } else {
+          throw std::runtime_error(std::string("Unknown output format: ") + format_str);
+        }
+      }
+
+      rapidjson::Value::ConstMemberIterator async_itr =
+        output_json.FindMember("is_async");
+      bool is_async_capture = ((async_itr != output_json.MemberEnd()) &&
+                               async_itr->value.GetBool());
+
       output = new ViewOutput(base_path,
                               frame_start,
-                              frame_end);
+                              frame_end,
+                              capture_format,
+                              is_async_capture);
     } else {
       output = new ViewOutput();
     }
@@ -305,6 +332,20 @@ State* constructStateFromJson(const std::string& path) {
   // construct world
   world::World* p_world = new world::World();
 
+  // vertex format, the separate layout is kept for comparison
+  rapidjson::Value::ConstMemberIterator vertex_format_itr =
+    config.FindMember("vertex_format");
+  if (vertex_format_itr != config.MemberEnd()) {
+    std::string vertex_format_str = vertex_format_itr->value.GetString();
+    if (vertex_format_str == "packed") {
+      p_world->vertex_format = pipeline::VertexFormat::Packed;
+    } else if (vertex_format_str == "separate") {
+      p_world->vertex_format = pipeline::VertexFormat::Separate;
+    } else {
+      throw std::runtime_error(std::string("Unknown vertex_format: ") + vertex_format_str);
+    }
+  }
+
   std::map<std::string, std::string> texture_file_map =
     std::map<std::string, std::string>();
 
@@ -329,103 +370,82 @@ State* constructStateFromJson(const std::string& path) {
   world::PointLightConstructor light_constructor =
     world::PointLightConstructor(*p_world);
 
+  // Lights are either read from "path" or generated as specified by
+  // "generate", see parseLightGeneratorConfig
   auto& lights_array_json = config["lights"];
   for (rapidjson::Value::ConstValueIterator itr = lights_array_json.Begin();
   itr != lights_array_json.End();
     ++itr) {
-    std::string lights_path = (*itr)["path"].GetString();
-    parseLights(lights_path, light_constructor);
+    rapidjson::Value::ConstMemberIterator generate_itr = itr->FindMember("generate");
+    if (generate_itr != itr->MemberEnd()) {
+      addGeneratedLights(parseLightGeneratorConfig(generate_itr->value),
+                         *p_world,
+                         light_constructor);
+    } else {
+      std::string lights_path = (*itr)["path"].GetString();
+      parseLights(lights_path, light_constructor);
+    }
   }
 
+  State* p_state;
   if (pipeline_type == pipeline::PipelineType::Forward) {
-    return new State(camera,
-                     camera_control,
-                     viewport,
-                     output,
-                     p_world,
-                     texture_file_map,
-                     forward_shader_ids,
-                     glm::uvec2(tile_size_x, tile_size_y),
-                     is_debug,
-                     is_logging_data,
-                     is_counting_calculations,
-                     log_output_path,
-                     log_output_path_calculations,
-                     logged_start_frame,
-                     logged_end_frame,
-                     exit_after_done,
-                     exit_frame,
-                     display_light_calculations,
-                     hashed_config);
+    p_state = new State(camera,
+                        camera_control,
+                        viewport,
+                        output,
+                        p_world,
+                        texture_file_map,
+                        forward_shader_ids,
+                        glm::uvec2(tile_size_x, tile_size_y),
+                        is_debug,
+                        is_logging_data,
+                        is_counting_calculations,
+                        log_output_path,
+                        log_output_path_calculations,
+                        logged_start_frame,
+                        logged_end_frame,
+                        exit_after_done,
+                        exit_frame,
+                        display_light_calculations,
+                        hashed_config);
   } else {
-    return new State(camera,
-                     camera_control,
-                     viewport,
-                     output,
-                     p_world,
-                     texture_file_map,
-                     deferred_shader_id,
-                     glm::uvec2(tile_size_x, tile_size_y),
-                     is_debug,
-                     is_logging_data,
-                     is_counting_calculations,
-                     log_output_path,
-                     log_output_path_calculations,
-                     logged_start_frame,
-                     logged_end_frame,
-                     exit_after_done,
-                     exit_frame,
-                     display_light_calculations,
-                     hashed_config);
+    p_state = new State(camera,
+                        camera_control,
+                        viewport,
+                        output,
+                        p_world,
+                        texture_file_map,
+                        deferred_shader_id,
+                        glm::uvec2(tile_size_x, tile_size_y),
+                        is_debug,
+                        is_logging_data,
+                        is_counting_calculations,
+                        log_output_path,
+                        log_output_path_calculations,
+                        logged_start_frame,
+                        logged_end_frame,
+                        exit_after_done,
+                        exit_frame,
+                        display_light_calculations,
+                        hashed_config);
   }
+  p_state->view.is_headless = is_headless;
+  p_state->log.stream_path = log_stream_path;
+  p_state->log.is_exporting_calculation_tiles = is_exporting_calculation_tiles;
+  return p_state;
 }
 
 
 std::vector<glm::mat4> readCameraFrames(const std::string& path) {
-  // Parse scene.json
-  // -------------------------------------------------------------------------
-  // stream file
-  std::ifstream ifs(path);
-  std::string config_file((std::istreambuf_iterator<char>(ifs)),
-                          (std::istreambuf_iterator<char>()));
-  // parse json
-  rapidjson::Document config;
-  config.Parse(config_file.c_str());
+  camera::CameraPathReader reader(path);
 
-  // Parse frames
-  // --------------------------------------------------------------------------
-  std::vector<glm::mat4> frames = std::vector<glm::mat4>();
-
-  auto& itr = config.FindMember("frames");
-
-  if (itr != config.MemberEnd()) {
-    auto& frames_json = itr->value;
-    for (rapidjson::Value::ConstValueIterator itr = frames_json.Begin();
-         itr != frames_json.End();
-         ++itr) {
-      auto& up_json     = (*itr)["up"];
-      auto& eye_json    = (*itr)["eye"];
-      auto& center_json = (*itr)["center"];
-
-      glm::vec3 eye = glm::vec3(eye_json["x"].GetFloat(),
-                                eye_json["y"].GetFloat(),
-                                eye_json["z"].GetFloat());
-
-      glm::vec3 center = glm::vec3(center_json["x"].GetFloat(),
-                                   center_json["y"].GetFloat(),
-                                   center_json["z"].GetFloat());
-
-      glm::vec3 up = glm::vec3(up_json["x"].GetFloat(),
-                               up_json["y"].GetFloat(),
-                               up_json["z"].GetFloat());
-
-      frames.push_back(glm::lookAt(eye, center, up));
-    }
-
-    return frames;
-  } else {
-    throw std::runtime_error(std::string("No frames found in specified path"));
+  std::vector<glm::mat4> frames;
+  frames.reserve(std::size_t(reader.getNFrames()));
+  glm::mat4 look_at;
+  while (reader.next(look_at)) {
+    frames.push_back(look_at);
   }
+  return frames;
 }
 
 } // state
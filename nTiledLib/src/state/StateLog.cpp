@@ -16,6 +16,8 @@ Log::Log(bool is_logging_data,
   is_counting_calculations(is_counting_calculations),
   path(path),
   path_calculations(path_calculations),
+  is_exporting_calculation_tiles(false),
+  stream_path(""),
   frame_start(frame_start), 
   frame_end(frame_end),
   exit_after_done(exit_after_done),
@@ -1,9 +1,22 @@
 #include "state\StateTexture.h"
 
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
 // ----------------------------------------------------------------------------
 //  nTiled headers
 // ----------------------------------------------------------------------------
-#include "pipeline\shader-util\LoadTextures.h"
+#include "util\ParallelFor.h"
+
+// ----------------------------------------------------------------------------
+//  Defines
+// ----------------------------------------------------------------------------
+#define TEXTURE_CACHE_EXTENSION ".nttex"
 
 namespace nTiled {
 namespace state {
@@ -14,7 +27,8 @@ namespace state {
 TextureCatalog::TextureCatalog(std::map<std::string, std::string> file_map,
                                std::map<std::string, GLuint> memory_map) :
   file_map(file_map),
-  memory_map(memory_map) { }
+  memory_map(memory_map),
+  texture_memory(0) { }
 
 TextureCatalog::TextureCatalog(std::map<std::string, std::string> file_map) :
     TextureCatalog(file_map, std::map<std::string, GLuint>()) { }
@@ -31,12 +45,9 @@ GLuint TextureCatalog::getTexture(std::string texture_id) {
   } else {
     auto file_iter = this->file_map.find(texture_id);
     if (file_iter != this->file_map.end()) {
-      GLuint texture_p = pipeline::loadTexturePNG(file_iter->second);
-
-      this->memory_map.insert(std::pair<std::string, GLuint>(texture_id,
-                                                             texture_p));
-
-      return texture_p;
+      pipeline::TextureImage image;
+      TextureCatalog::decodeTexture(file_iter->second, true, image);
+      return this->addTexture(texture_id, image);
     } else {
       throw std::runtime_error(
         std::string("Texture with id: ") + texture_id + 
@@ -45,5 +56,84 @@ GLuint TextureCatalog::getTexture(std::string texture_id) {
   }
 }
 
+
+// ----------------------------------------------------------------------------
+//  Loading
+// ----------------------------------------------------------------------------
+std::string TextureCatalog::getCachePath(const std::string& path) {
+  return path + TEXTURE_CACHE_EXTENSION;
+}
+
+
+bool TextureCatalog::decodeTexture(const std::string& path,
+                                   bool use_cache,
+                                   pipeline::TextureImage& image) {
+  std::string cache_path = TextureCatalog::getCachePath(path);
+  if (use_cache && pipeline::readTextureCache(cache_path, path, image)) {
+    return true;
+  }
+
+  pipeline::decodeTexturePNG(path, image);
+  if (use_cache) {
+    pipeline::writeTextureCache(cache_path, path, image);
+  }
+  return false;
+}
+
+
+GLuint TextureCatalog::addTexture(const std::string& texture_id,
+                                  const pipeline::TextureImage& image) {
+  GLsizeiptr size;
+  GLuint texture_p = pipeline::uploadTexture(image, &size);
+  this->texture_memory += size;
+
+  this->memory_map.insert(std::pair<std::string, GLuint>(texture_id,
+                                                         texture_p));
+  return texture_p;
+}
+
+
+void TextureCatalog::loadTextures(bool use_cache, unsigned int n_threads) {
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::string> texture_ids;
+  std::vector<std::string> paths;
+  for (auto const& file_pair : this->file_map) {
+    if (this->memory_map.find(file_pair.first) == this->memory_map.end()) {
+      texture_ids.push_back(file_pair.first);
+      paths.push_back(file_pair.second);
+    }
+  }
+  if (paths.empty()) return;
+
+  // Decode on the worker threads, upload on the openGL thread
+  // --------------------------------------------------------------------------
+  std::vector<pipeline::TextureImage> images(paths.size());
+  // not std::vector<bool>, as its elements can not be written concurrently
+  std::vector<unsigned char> is_cache_hit(paths.size(), 0);
+
+  util::parallelFor(static_cast<unsigned int>(paths.size()),
+                    n_threads,
+                    [&](unsigned int i) {
+                      is_cache_hit[i] = TextureCatalog::decodeTexture(paths[i],
+                                                                      use_cache,
+                                                                      images[i]);
+                    });
+
+  unsigned int n_cache_hits = 0;
+  for (unsigned int i = 0; i < paths.size(); ++i) {
+    this->addTexture(texture_ids[i], images[i]);
+    images[i].pixels = std::vector<unsigned char>();
+    if (is_cache_hit[i]) n_cache_hits++;
+  }
+
+  double load_time = std::chrono::duration<double, std::milli>(
+    std::chrono::steady_clock::now() - start).count();
+  std::cout << "Loaded " << paths.size() << " textures ("
+            << n_cache_hits << " from cache) in "
+            << load_time << " ms, "
+            << this->texture_memory << " bytes of texture memory" << std::endl;
+}
+
 } // state
 } // nTiled
\ No newline at end of file
@@ -14,7 +14,8 @@ View::View(camera::Camera camera,
   camera_control(p_camera_control),
   viewport(viewport), 
   output(output),
-  display_light_calculations(display_light_calculations) {
+  display_light_calculations(display_light_calculations),
+  is_headless(false) {
 }
 
 View::~View() {
@@ -27,18 +28,24 @@ View::~View() {
 // ViewOutput
 ViewOutput::ViewOutput(const std::string& image_base_path,
                        const unsigned int frame_start,
-                       const unsigned int frame_end) :
+                       const unsigned int frame_end,
+                       const CaptureFormat capture_format,
+                       const bool is_async_capture) :
   type(OutputType::Memory),
   image_base_path(image_base_path),
   frame_start(frame_start),
-  frame_end(frame_end) { 
+  frame_end(frame_end),
+  capture_format(capture_format),
+  is_async_capture(is_async_capture) { 
 }
 
 ViewOutput::ViewOutput() :
   type(OutputType::Display),
   image_base_path(""),
   frame_start(-1),
-  frame_end(-1) {
+  frame_end(-1),
+  capture_format(CaptureFormat::PNG),
+  is_async_capture(false) {
 }
 
 
@@ -0,0 +1,35 @@
+#include "util\FileStamp.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <sys/stat.h>
+
+#include <cstdio>
+
+
+namespace nTiled {
+namespace util {
+
+bool getFileStamp(const std::string& path, FileStamp& stamp) {
+  struct stat file_stat;
+  if (stat(path.c_str(), &file_stat) != 0) return false;
+
+  stamp.size = std::uint64_t(file_stat.st_size);
+  stamp.time = std::int64_t(file_stat.st_mtime);
+  return true;
+}
+
+
+bool replaceFile(const std::string& tmp_path, const std::string& path) {
+  // std::rename does not overwrite existing files on Windows
+  std::remove(path.c_str());
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // util
+} // nTiled
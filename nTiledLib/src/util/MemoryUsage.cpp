@@ -0,0 +1,83 @@
+#include "util\MemoryUsage.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#ifdef _MSC_VER
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+
+namespace nTiled {
+namespace util {
+
+std::size_t getPeakMemoryUsage() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return std::size_t(counters.PeakWorkingSetSize);
+  }
+  return 0;
+#else
+  // VmHWM is reset by resetPeakMemoryUsage, unlike ru_maxrss
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      // VmHWM is in kilobytes
+      return std::size_t(std::stoull(line.substr(6))) * 1024;
+    }
+  }
+
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    // ru_maxrss is in kilobytes on Linux
+    return std::size_t(usage.ru_maxrss) * 1024;
+  }
+  return 0;
+#endif
+}
+
+
+bool resetPeakMemoryUsage() {
+#ifdef _WIN32
+  // The PeakWorkingSetSize of a process can not be reset
+  return false;
+#else
+  // Writing 5 to clear_refs resets VmHWM to the current resident memory
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  return bool(clear_refs << "5" << std::flush);
+#endif
+}
+
+
+std::size_t getCurrentMemoryUsage() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return std::size_t(counters.WorkingSetSize);
+  }
+  return 0;
+#else
+  // the second field of statm is the number of resident pages
+  std::ifstream statm("/proc/self/statm");
+  std::size_t n_pages = 0;
+  std::size_t n_resident_pages = 0;
+  if (statm >> n_pages >> n_resident_pages) {
+    return n_resident_pages * std::size_t(sysconf(_SC_PAGESIZE));
+  }
+  return 0;
+#endif
+}
+
+} // util
+} // nTiled
@@ -1,5 +1,15 @@
 #include "world\World.h"
 
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <utility>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "pipeline\pipeline-util\VertexFormat.h"
+
 namespace nTiled {
 namespace world {
 
@@ -7,7 +17,8 @@ namespace world {
 //  Constructor
 // ----------------------------------------------------------------------------
 World::World() : p_mesh_catalog(std::vector<Mesh*>()),
-                 p_objects(std::vector<Object*>()) { }
+                 p_objects(std::vector<Object*>()),
+                 vertex_format(pipeline::VertexFormat::Packed) { }
 
 // ----------------------------------------------------------------------------
 //  Destructor
@@ -41,6 +52,12 @@ Mesh* World::constructMesh(const std::vector<glm::vec4>& vertices,
   return p_mesh;
 }
 
+Mesh* World::constructMesh(Mesh&& mesh) {
+  Mesh* p_mesh = new Mesh(std::move(mesh));
+  this->p_mesh_catalog.push_back(p_mesh);
+  return p_mesh;
+}
+
 Object* World::constructObject(const std::string& name,
                                Mesh* p_mesh,
                                glm::mat4 transformation_matrix,
@@ -0,0 +1,252 @@
+#include "world\object-constructor\MeshLoader.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <assimp/Importer.hpp>      // C++ importer interface
+#include <assimp/scene.h>           // Output data structure
+#include <assimp/postprocess.h>     // Post processing flags
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+//  nTiled headers
+// ----------------------------------------------------------------------------
+#include "util\FileStamp.h"
+#include "util\ParallelFor.h"
+
+// ----------------------------------------------------------------------------
+//  Defines
+// ----------------------------------------------------------------------------
+#define MESH_CACHE_EXTENSION ".ntmesh"
+#define MESH_CACHE_VERSION 1
+
+
+namespace nTiled {
+namespace world {
+
+static_assert(sizeof(glm::vec4) == 4 * sizeof(float),
+              "glm::vec4 must be tightly packed for the mesh cache");
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float),
+              "glm::vec3 must be tightly packed for the mesh cache");
+static_assert(sizeof(glm::tvec3<glm::u32>) == 3 * sizeof(glm::u32),
+              "glm::tvec3<glm::u32> must be tightly packed for the mesh cache");
+static_assert(sizeof(MeshCacheHeader) == 40,
+              "MeshCacheHeader must not contain padding");
+
+// ----------------------------------------------------------------------------
+//  Helper functions
+// ----------------------------------------------------------------------------
+template <typename T>
+static bool readBlob(std::ifstream& ifs, std::vector<T>& data, std::uint32_t n) {
+  data.resize(n);
+  if (n == 0) return true;
+  return bool(ifs.read(reinterpret_cast<char*>(data.data()),
+                       std::streamsize(sizeof(T)) * n));
+}
+
+
+template <typename T>
+static void writeBlob(std::ofstream& ofs, const std::vector<T>& data) {
+  if (data.empty()) return;
+  ofs.write(reinterpret_cast<const char*>(data.data()),
+            std::streamsize(sizeof(T) * data.size()));
+}
+
+
+// ----------------------------------------------------------------------------
+//  Mesh import and cache functions
+// ----------------------------------------------------------------------------
+void importMesh(const std::string& path, Mesh& mesh) {
+  // Import file with AssImp, tangents are not used by any shader and are
+  // thus not calculated. Faces are triangulated, since the elements are
+  // read and drawn as exactly three indices per face, and points and lines
+  // are sorted into meshes of their own, such that the first mesh holds
+  // no faces with fewer than three indices.
+  Assimp::Importer importer;
+  const aiScene* scene = importer.ReadFile(path,
+                                           aiProcess_Triangulate |
+                                           aiProcess_JoinIdenticalVertices |
+                                           aiProcess_GenSmoothNormals |
+                                           aiProcess_SortByPType);
+
+  // Check if read scene contains any meshes
+  if (!scene || !scene->HasMeshes()) {
+    throw std::runtime_error(std::string("Could not detect any meshes in file: ") + path);
+  }
+
+  // Convert scene file into appropriate mesh file.
+  //   We assume only the first mesh is of interest
+  aiMesh* ai_mesh = scene->mMeshes[0];
+  unsigned int n_vertices = ai_mesh->mNumVertices;
+
+  aiVector3D* mesh_vertices = ai_mesh->mVertices;
+  aiVector3D* mesh_normals = ai_mesh->mNormals;
+
+  mesh.vertices.resize(n_vertices);
+  mesh.normals.resize(n_vertices);
+  for (unsigned int i = 0; i < n_vertices; i++) {
+    const aiVector3D& v = mesh_vertices[i];
+    mesh.vertices[i] = glm::vec4(v.x, v.y, v.z, 1.0f);
+    const aiVector3D& n = mesh_normals[i];
+    mesh.normals[i] = glm::vec3(n.x, n.y, n.z);
+  }
+
+  if (ai_mesh->HasTextureCoords(0)) {
+    aiVector3D* mesh_uvs = ai_mesh->mTextureCoords[0];
+    mesh.uvs.resize(n_vertices);
+    for (unsigned int i = 0; i < n_vertices; i++) {
+      const aiVector3D& uv = mesh_uvs[i];
+      mesh.uvs[i] = glm::vec3(uv.x, uv.y, uv.z);
+    }
+  } else {
+    mesh.uvs.clear();
+  }
+
+  // -- Elements --
+  aiFace* mesh_faces = ai_mesh->mFaces;
+  mesh.elements.resize(ai_mesh->mNumFaces);
+  for (unsigned int i = 0; i < ai_mesh->mNumFaces; i++) {
+    const aiFace& f = mesh_faces[i];
+    mesh.elements[i] = glm::tvec3<glm::u32>(f.mIndices[0],
+                                            f.mIndices[1],
+                                            f.mIndices[2]);
+  }
+}
+
+
+bool readMeshCache(const std::string& cache_path,
+                   const std::string& source_path,
+                   Mesh& mesh) {
+  util::FileStamp source_stamp;
+  if (!util::getFileStamp(source_path, source_stamp)) return false;
+
+  std::ifstream ifs(cache_path, std::ios::binary);
+  if (!ifs) return false;
+
+  MeshCacheHeader header;
+  if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(MeshCacheHeader))) {
+    return false;
+  }
+
+  if (std::memcmp(header.magic, "NTMC", 4) != 0 ||
+      header.version != MESH_CACHE_VERSION ||
+      header.source_size != source_stamp.size ||
+      header.source_time != source_stamp.time) {
+    return false;
+  }
+
+  return (readBlob(ifs, mesh.vertices, header.n_vertices) &&
+          readBlob(ifs, mesh.normals, header.n_normals) &&
+          readBlob(ifs, mesh.uvs, header.n_uvs) &&
+          readBlob(ifs, mesh.elements, header.n_elements));
+}
+
+
+bool writeMeshCache(const std::string& cache_path,
+                    const std::string& source_path,
+                    const Mesh& mesh) {
+  MeshCacheHeader header;
+  std::memcpy(header.magic, "NTMC", 4);
+  header.version = MESH_CACHE_VERSION;
+  util::FileStamp source_stamp;
+  if (!util::getFileStamp(source_path, source_stamp)) return false;
+  header.source_size = source_stamp.size;
+  header.source_time = source_stamp.time;
+  header.n_vertices = std::uint32_t(mesh.vertices.size());
+  header.n_normals = std::uint32_t(mesh.normals.size());
+  header.n_uvs = std::uint32_t(mesh.uvs.size());
+  header.n_elements = std::uint32_t(mesh.elements.size());
+
+  // Write to a temporary file first, such that a concurrent or interrupted
+  // run never observes a partially written cache file.
+  std::string tmp_path = cache_path + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs) return false;
+
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(MeshCacheHeader));
+    writeBlob(ofs, mesh.vertices);
+    writeBlob(ofs, mesh.normals);
+    writeBlob(ofs, mesh.uvs);
+    writeBlob(ofs, mesh.elements);
+
+    if (!ofs) {
+      ofs.close();
+      std::remove(tmp_path.c_str());
+      return false;
+    }
+  }
+
+  return util::replaceFile(tmp_path, cache_path);
+}
+
+
+// ----------------------------------------------------------------------------
+//  MeshLoader
+// ----------------------------------------------------------------------------
+MeshLoader::MeshLoader(bool use_cache, unsigned int n_threads) :
+    use_cache(use_cache),
+    n_threads(n_threads),
+    n_cache_hits(0),
+    load_time(0.0) {
+  if (this->n_threads == 0) {
+    this->n_threads = util::getDefaultNThreads();
+  }
+}
+
+
+std::string MeshLoader::getCachePath(const std::string& path) {
+  return path + MESH_CACHE_EXTENSION;
+}
+
+
+bool MeshLoader::loadMesh(const std::string& path, Mesh& mesh) const {
+  std::string cache_path = MeshLoader::getCachePath(path);
+  if (this->use_cache && readMeshCache(cache_path, path, mesh)) {
+    return true;
+  }
+
+  importMesh(path, mesh);
+  if (this->use_cache) {
+    writeMeshCache(cache_path, path, mesh);
+  }
+  return false;
+}
+
+
+std::vector<Mesh*> MeshLoader::load(const std::vector<std::string>& paths,
+                                    World& world) {
+  auto start = std::chrono::steady_clock::now();
+
+  // Load all meshes on the worker threads
+  // --------------------------------------------------------------------------
+  std::vector<Mesh> meshes(paths.size());
+  std::atomic<unsigned int> n_hits(0);
+
+  util::parallelFor(static_cast<unsigned int>(paths.size()),
+                    this->n_threads,
+                    [&](unsigned int i) {
+                      if (this->loadMesh(paths[i], meshes[i])) n_hits++;
+                    });
+
+  // Add meshes to the world, which is not thread safe
+  // --------------------------------------------------------------------------
+  std::vector<Mesh*> ps_mesh;
+  for (Mesh& mesh : meshes) {
+    ps_mesh.push_back(world.constructMesh(std::move(mesh)));
+  }
+
+  this->n_cache_hits = n_hits;
+  this->load_time = std::chrono::duration<double, std::milli>(
+    std::chrono::steady_clock::now() - start).count();
+  return ps_mesh;
+}
+
+} // world
+} // nTiled
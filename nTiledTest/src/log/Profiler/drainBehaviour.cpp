@@ -0,0 +1,81 @@
+#include <catch.hpp>
+#include "log\Profiler.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <thread>
+
+
+// ----------------------------------------------------------------------------
+//  drain Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("Profiler.drain should pair nested and repeated scopes per thread",
+         "[Profiler]") {
+  nTiled::logged::ScopeId outer_id = nTiled::logged::internScope("Test::outer");
+  nTiled::logged::ScopeId inner_id = nTiled::logged::internScope("Test::inner");
+  nTiled::logged::ScopeId value_id = nTiled::logged::internScope("Test::value");
+
+  GIVEN("An active Profiler") {
+    nTiled::logged::Profiler profiler(1024);
+    profiler.activate();
+    profiler.setFrame(3);
+
+    WHEN("A scope containing two inner scopes and a value is recorded") {
+      {
+        nTiled::logged::ProfileScope outer(outer_id);
+        { nTiled::logged::ProfileScope inner(inner_id); }
+        { nTiled::logged::ProfileScope inner(inner_id); }
+        nTiled::logged::profileValue(value_id, 42.0);
+      }
+      profiler.deactivate();
+
+      THEN("Every scope results in a span at the correct depth") {
+        const std::vector<nTiled::logged::ProfileSpan>& spans = profiler.getSpans();
+        REQUIRE(spans.size() == 3);
+        REQUIRE(spans[0].scope == inner_id);
+        REQUIRE(spans[0].depth == 1);
+        REQUIRE(spans[1].scope == inner_id);
+        REQUIRE(spans[1].depth == 1);
+        REQUIRE(spans[2].scope == outer_id);
+        REQUIRE(spans[2].depth == 0);
+        REQUIRE(spans[2].frame == 3);
+        REQUIRE(spans[2].start <= spans[0].start);
+        REQUIRE(spans[2].duration >= spans[0].duration + spans[1].duration);
+
+        REQUIRE(profiler.getStats(inner_id).count == 2);
+        REQUIRE(profiler.getValues().size() == 1);
+        REQUIRE(profiler.getStats(value_id).total == 42.0);
+        REQUIRE(profiler.getNDropped() == 0);
+      }
+    }
+
+    WHEN("Scopes are recorded on another thread") {
+      std::thread worker([inner_id]() {
+        nTiled::logged::ProfileScope inner(inner_id);
+      });
+      worker.join();
+      profiler.deactivate();
+
+      THEN("The span is attributed to that thread") {
+        REQUIRE(profiler.getSpans().size() == 1);
+        REQUIRE(profiler.getSpans()[0].thread == 0);
+        REQUIRE(profiler.getSpans()[0].depth == 0);
+      }
+    }
+  }
+
+  GIVEN("No active Profiler") {
+    nTiled::logged::Profiler profiler(1024);
+
+    WHEN("A scope is recorded") {
+      { nTiled::logged::ProfileScope outer(outer_id); }
+      profiler.drain();
+
+      THEN("Nothing is recorded") {
+        REQUIRE(profiler.getSpans().empty());
+        REQUIRE(nTiled::logged::Profiler::getActive() == nullptr);
+      }
+    }
+  }
+}
@@ -0,0 +1,80 @@
+#include <catch.hpp>
+#include "log\QuantileSketch.h"
+
+
+// ----------------------------------------------------------------------------
+//  getQuantile Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("QuantileSketch.getQuantile should estimate quantiles within its relative accuracy",
+         "[QuantileSketch]") {
+  GIVEN("A QuantileSketch with 1% relative accuracy") {
+    nTiled::logged::QuantileSketch sketch(0.01);
+
+    WHEN("Nothing is added") {
+      THEN("Every quantile is 0") {
+        REQUIRE(sketch.getCount() == 0);
+        REQUIRE(sketch.getQuantile(0.5) == 0.0);
+      }
+    }
+
+    WHEN("The values 1 to 1000 are added") {
+      for (int i = 1; i <= 1000; ++i) {
+        sketch.add(double(i));
+      }
+
+      THEN("The percentiles are within 1% of the exact percentiles") {
+        REQUIRE(sketch.getCount() == 1000);
+        REQUIRE(sketch.getQuantile(0.0) == Approx(1.0).epsilon(0.01));
+        REQUIRE(sketch.getQuantile(0.5) == Approx(500.0).epsilon(0.01));
+        REQUIRE(sketch.getQuantile(0.95) == Approx(950.0).epsilon(0.01));
+        REQUIRE(sketch.getQuantile(0.99) == Approx(990.0).epsilon(0.01));
+        REQUIRE(sketch.getQuantile(1.0) == Approx(1000.0).epsilon(0.01));
+      }
+
+      THEN("The histogram has power of two bins holding all values") {
+        std::vector<std::pair<double, std::uint64_t>> histogram = sketch.getHistogram();
+        REQUIRE(histogram.front().first <= 2.0);
+        REQUIRE(histogram.back().first == 1024.0);
+
+        std::uint64_t n_values = 0;
+        for (const std::pair<double, std::uint64_t>& bin : histogram) {
+          n_values += bin.second;
+        }
+        REQUIRE(n_values == 1000);
+      }
+    }
+
+    WHEN("Zeros and positive values are added") {
+      for (int i = 0; i < 10; ++i) sketch.add(0.0);
+      for (int i = 0; i < 10; ++i) sketch.add(5.0);
+
+      THEN("The lower quantiles are 0") {
+        REQUIRE(sketch.getQuantile(0.25) == 0.0);
+        REQUIRE(sketch.getQuantile(0.75) == Approx(5.0).epsilon(0.01));
+      }
+    }
+
+    WHEN("Two halves of the values are added to two sketches, which are merged") {
+      nTiled::logged::QuantileSketch other(0.01);
+      for (int i = 1; i <= 1000; ++i) {
+        if (i % 2) sketch.add(double(i));
+        else other.add(double(i));
+      }
+      sketch.merge(other);
+
+      THEN("The merged sketch estimates the quantiles of all values") {
+        REQUIRE(sketch.getCount() == 1000);
+        REQUIRE(sketch.getQuantile(0.5) == Approx(500.0).epsilon(0.01));
+        REQUIRE(sketch.getQuantile(0.99) == Approx(990.0).epsilon(0.01));
+      }
+    }
+
+    WHEN("A sketch with a different relative accuracy is merged") {
+      nTiled::logged::QuantileSketch other(0.02);
+
+      THEN("An exception is thrown") {
+        REQUIRE_THROWS(sketch.merge(other));
+      }
+    }
+  }
+}
@@ -0,0 +1,166 @@
+#include <catch.hpp>
+
+#include <random>
+
+#include "pipeline\light-management\hashed\HashedLightManager.h"
+#include "pipeline\light-management\hashed\Exceptions.h"
+
+
+SCENARIO("HashedLightManager::autoTune should choose parameters of which the predicted memory and lookup depth match the constructed LinklessOctree",
+         "[LightOctreeFull][HashedLightManager][autoTune]") {
+  GIVEN("A world with randomly placed overlapping lights") {
+    nTiled::world::World* w = new nTiled::world::World();
+
+    std::string name = "just_testing_things";
+    glm::vec3 intensity = glm::vec3(1.0);
+    std::map<std::string, nTiled::world::Object*> empty_map =
+      std::map<std::string, nTiled::world::Object*>();
+
+    std::mt19937 gen = std::mt19937(17);
+    std::uniform_real_distribution<float> position_dist(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> radius_dist(0.5f, 6.0f);
+
+    for (unsigned int i = 0; i < 40; ++i) {
+      glm::vec4 position = glm::vec4(position_dist(gen),
+                                     position_dist(gen),
+                                     position_dist(gen),
+                                     1.0);
+      w->constructPointLight(name,
+                             position,
+                             intensity,
+                             radius_dist(gen),
+                             true,
+                             empty_map);
+    }
+
+    nTiled::pipeline::hashed::HashedConfig config =
+      nTiled::pipeline::hashed::HashedConfig(1.0, 1, 2.0, 10);
+    config.build_method = nTiled::pipeline::hashed::HashedBuildMethod::Morton;
+    config.auto_tune = true;
+    config.memory_budget = 4 * 1024 * 1024;
+
+    WHEN("The HashedLightManager is initialised") {
+      nTiled::pipeline::hashed::HashedLightManager manager =
+        nTiled::pipeline::hashed::HashedLightManager(*w, config);
+      manager.init();
+
+      const nTiled::pipeline::hashed::HashedTuning& tuning = manager.getTuning();
+      nTiled::pipeline::hashed::LinklessOctree& lo = *(manager.getLinklessOctree());
+
+      THEN("The LinklessOctree is constructed with the chosen parameters") {
+        REQUIRE(manager.hasTuned());
+        REQUIRE(tuning.meets_budget);
+        REQUIRE(tuning.predicted_bytes <= config.memory_budget);
+        REQUIRE(manager.getMinimalNodeSize() == tuning.minimum_node_size);
+        REQUIRE(manager.getStartingDepth() == tuning.starting_depth);
+        REQUIRE(manager.getRIncreaseRatio() == tuning.r_increase_ratio);
+        REQUIRE(lo.getDepth() == tuning.light_octree_depth);
+        REQUIRE(tuning.starting_depth < tuning.light_octree_depth);
+      }
+
+      THEN("The predicted fetches and memory match the LinklessOctree") {
+        // the tables are stored in the default texture layout
+        std::size_t n_bytes = lo.getNLightIndices() * sizeof(GLuint);
+        for (unsigned int i = 0; i < lo.getNLevels(); ++i) {
+          n_bytes += lo.getLevelTextureBytes(i);
+        }
+
+        REQUIRE(tuning.predicted_fetches == Approx(lo.getMeanNFetches()));
+        // tables which need more than one attempt grow beyond the prediction
+        REQUIRE(tuning.predicted_bytes <= n_bytes);
+      }
+    }
+
+    WHEN("A HashedLightManager with packed tables is initialised") {
+      nTiled::pipeline::hashed::HashedConfig packed_config = config;
+      packed_config.table_layout = nTiled::pipeline::hashed::HashedTableLayout::Packed;
+
+      nTiled::pipeline::hashed::HashedLightManager manager =
+        nTiled::pipeline::hashed::HashedLightManager(*w, packed_config);
+      manager.init();
+
+      const nTiled::pipeline::hashed::HashedTuning& tuning = manager.getTuning();
+      nTiled::pipeline::hashed::LinklessOctree& lo = *(manager.getLinklessOctree());
+
+      THEN("The predicted memory matches the packed tables within the budget") {
+        std::size_t n_bytes = lo.getNLightIndices() * sizeof(GLuint);
+        for (unsigned int i = 0; i < lo.getNLevels(); ++i) {
+          n_bytes += lo.getLevelPackedBytes(i);
+        }
+
+        REQUIRE(manager.hasTuned());
+        REQUIRE(tuning.meets_budget);
+        REQUIRE(tuning.predicted_bytes <= packed_config.memory_budget);
+        REQUIRE(tuning.predicted_fetches == Approx(lo.getMeanNFetches()));
+        // tables which need more than one attempt grow beyond the prediction
+        REQUIRE(tuning.predicted_bytes <= n_bytes);
+      }
+    }
+
+    WHEN("The tables are packed") {
+      nTiled::pipeline::hashed::HashedConfig packed_config = config;
+      packed_config.table_layout = nTiled::pipeline::hashed::HashedTableLayout::Packed;
+
+      nTiled::pipeline::hashed::HashedTuning tuning =
+        nTiled::pipeline::hashed::HashedAutoTuner(w->p_lights, config).tune();
+      nTiled::pipeline::hashed::HashedTuning packed_tuning =
+        nTiled::pipeline::hashed::HashedAutoTuner(w->p_lights, packed_config).predict(
+          tuning.minimum_node_size,
+          tuning.starting_depth,
+          tuning.r_increase_ratio);
+
+      THEN("The same parameters are predicted to need less memory") {
+        REQUIRE(packed_tuning.predicted_bytes < tuning.predicted_bytes);
+        REQUIRE(packed_tuning.predicted_fetches == Approx(tuning.predicted_fetches));
+      }
+    }
+
+    WHEN("The budget is increased") {
+      nTiled::pipeline::hashed::HashedConfig large_config = config;
+      large_config.memory_budget = 64 * config.memory_budget;
+
+      nTiled::pipeline::hashed::HashedTuning tuning =
+        nTiled::pipeline::hashed::HashedAutoTuner(w->p_lights, config).tune();
+      nTiled::pipeline::hashed::HashedTuning large_tuning =
+        nTiled::pipeline::hashed::HashedAutoTuner(w->p_lights, large_config).tune();
+
+      THEN("The chosen node size is at most as large") {
+        REQUIRE(large_tuning.meets_budget);
+        REQUIRE(large_tuning.predicted_bytes <= large_config.memory_budget);
+        REQUIRE(large_tuning.minimum_node_size <= tuning.minimum_node_size);
+      }
+    }
+
+    WHEN("The budget cannot be met") {
+      nTiled::pipeline::hashed::HashedConfig small_config = config;
+      small_config.memory_budget = 64;
+
+      nTiled::pipeline::hashed::HashedTuning small_tuning =
+        nTiled::pipeline::hashed::HashedAutoTuner(w->p_lights, small_config).tune();
+
+      THEN("The smallest candidate is chosen and reported to exceed the budget") {
+        nTiled::pipeline::hashed::HashedTuning tuning =
+          nTiled::pipeline::hashed::HashedAutoTuner(w->p_lights, config).tune();
+
+        REQUIRE_FALSE(small_tuning.meets_budget);
+        REQUIRE(small_tuning.predicted_bytes <= tuning.predicted_bytes);
+        REQUIRE(small_tuning.starting_depth < small_tuning.light_octree_depth);
+      }
+    }
+  }
+}
+
+
+SCENARIO("HashedAutoTuner::tune should throw a HashedShadingNoLightException if there are no lights",
+         "[LightOctreeFull][HashedLightManager][autoTune]") {
+  GIVEN("A world without lights") {
+    nTiled::world::World* w = new nTiled::world::World();
+    nTiled::pipeline::hashed::HashedConfig config =
+      nTiled::pipeline::hashed::HashedConfig();
+
+    THEN("tune throws a HashedShadingNoLightException") {
+      REQUIRE_THROWS_AS(nTiled::pipeline::hashed::HashedAutoTuner(w->p_lights, config).tune(),
+                        nTiled::pipeline::hashed::HashedShadingNoLightException);
+    }
+  }
+}
@@ -0,0 +1,151 @@
+#include <catch.hpp>
+
+#include <random>
+
+#include "pipeline\light-management\hashed\HashedLightManager.h"
+
+
+SCENARIO("HashedLightManager::constructLinklessOctree should store levels of which the occupancy reaches the dense occupancy threshold as dense grids",
+         "[LightOctreeFull][HashedLightManager][constructLinklessOctree]") {
+  GIVEN("A world with randomly placed overlapping lights") {
+    nTiled::world::World* w = new nTiled::world::World();
+
+    std::string name = "just_testing_things";
+    glm::vec3 intensity = glm::vec3(1.0);
+    std::map<std::string, nTiled::world::Object*> empty_map =
+      std::map<std::string, nTiled::world::Object*>();
+
+    std::mt19937 gen = std::mt19937(7);
+    std::uniform_real_distribution<float> position_dist(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> radius_dist(0.5f, 6.0f);
+
+    for (unsigned int i = 0; i < 40; ++i) {
+      glm::vec4 position = glm::vec4(position_dist(gen),
+                                     position_dist(gen),
+                                     position_dist(gen),
+                                     1.0);
+      w->constructPointLight(name,
+                             position,
+                             intensity,
+                             radius_dist(gen),
+                             true,
+                             empty_map);
+    }
+
+    double node_size = 2.0;
+    nTiled::pipeline::hashed::HashedConfig default_config =
+      nTiled::pipeline::hashed::HashedConfig(node_size, 2, 2.0, 10);
+    nTiled::pipeline::hashed::HashedConfig hashed_config = default_config;
+    hashed_config.dense_occupancy_threshold = 2.0;
+    nTiled::pipeline::hashed::HashedConfig dense_config = default_config;
+    dense_config.dense_occupancy_threshold = 0.0;
+
+    nTiled::pipeline::hashed::HashedLightManager default_manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, default_config);
+    nTiled::pipeline::hashed::HashedLightManager hashed_manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, hashed_config);
+    nTiled::pipeline::hashed::HashedLightManager dense_manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, dense_config);
+
+    WHEN("The HashedLightManagers are initialised") {
+      default_manager.init();
+      hashed_manager.init();
+      dense_manager.init();
+
+      nTiled::pipeline::hashed::LinklessOctree& default_lo =
+        *(default_manager.getLinklessOctree());
+      nTiled::pipeline::hashed::LinklessOctree& hashed_lo =
+        *(hashed_manager.getLinklessOctree());
+      nTiled::pipeline::hashed::LinklessOctree& dense_lo =
+        *(dense_manager.getLinklessOctree());
+
+      THEN("Only the tables of the dense LinklessOctree should be dense") {
+        REQUIRE(dense_lo.getNLevels() == hashed_lo.getNLevels());
+        for (unsigned int i = 0; i < dense_lo.getNLevels(); ++i) {
+          REQUIRE(dense_lo.getOctreeHashMaps()->at(i)->isDense());
+          REQUIRE_FALSE(hashed_lo.getOctreeHashMaps()->at(i)->isDense());
+
+          REQUIRE(dense_lo.getDataHashMapsExists()->at(i) ==
+                  hashed_lo.getDataHashMapsExists()->at(i));
+          if (dense_lo.getDataHashMapsExists()->at(i)) {
+            REQUIRE(dense_lo.getDataHashMaps()->at(i)->isDense());
+            REQUIRE_FALSE(hashed_lo.getDataHashMaps()->at(i)->isDense());
+          }
+        }
+      }
+
+      THEN("The dense tables should span their level without offsets") {
+        unsigned int n_nodes = dense_lo.getInitialNNodes();
+        for (unsigned int i = 0; i < dense_lo.getNLevels(); ++i) {
+          const nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_octree_map =
+            dense_lo.getOctreeHashMaps()->at(i);
+          REQUIRE(p_octree_map->getM() == n_nodes);
+          REQUIRE(p_octree_map->getR() == 1);
+          REQUIRE(p_octree_map->getOffset(0) == glm::u16vec3(0));
+
+          if (dense_lo.getDataHashMapsExists()->at(i)) {
+            const nTiled::pipeline::hashed::SpatialHashFunction<glm::uvec2>* p_data_map =
+              dense_lo.getDataHashMaps()->at(i);
+            REQUIRE(p_data_map->getM() == 2 * n_nodes);
+            REQUIRE(p_data_map->getR() == 1);
+            REQUIRE(p_data_map->getOffset(0) == glm::u16vec3(0));
+          }
+          n_nodes *= 2;
+        }
+      }
+
+      THEN("Exactly the levels of which the occupancy reaches the threshold should be dense by default") {
+        double threshold = default_config.dense_occupancy_threshold;
+        double n_nodes = double(default_lo.getInitialNNodes());
+        for (unsigned int i = 0; i < default_lo.getNLevels(); ++i) {
+          double n_octree_entries = double(hashed_lo.getOctreeHashMaps()->at(i)->getNEntries());
+          REQUIRE(default_lo.getOctreeHashMaps()->at(i)->isDense() ==
+                  (n_octree_entries >= threshold * n_nodes * n_nodes * n_nodes));
+
+          if (default_lo.getDataHashMapsExists()->at(i)) {
+            double n_data_nodes = 2.0 * n_nodes;
+            double n_data_entries = double(hashed_lo.getDataHashMaps()->at(i)->getNEntries());
+            REQUIRE(default_lo.getDataHashMaps()->at(i)->isDense() ==
+                    (n_data_entries >= threshold * n_data_nodes * n_data_nodes * n_data_nodes));
+          }
+          n_nodes *= 2.0;
+        }
+      }
+
+      THEN("The fully occupied first octree level should be dense by default") {
+        REQUIRE(default_lo.getOctreeHashMaps()->at(0)->isDense());
+        REQUIRE(default_lo.getOctreeHashMaps()->at(0)->getM() ==
+                default_lo.getInitialNNodes());
+      }
+
+      THEN("Dense levels should require fewer fetches per query") {
+        REQUIRE(dense_lo.getMeanNFetches() < hashed_lo.getMeanNFetches());
+        REQUIRE(default_lo.getMeanNFetches() < hashed_lo.getMeanNFetches());
+      }
+
+      THEN("All LinklessOctrees should retrieve the same lights at every point") {
+        unsigned int dim = hashed_lo.getTotalNNodes();
+        glm::vec3 orig = hashed_lo.getOrigin();
+        double width = hashed_lo.getWidth();
+
+        glm::vec3 offset = glm::vec3(orig.x - 0.05 * width,
+                                     orig.y - 0.05 * width,
+                                     orig.z - 0.05 * width);
+        double step_size = node_size * 0.75;
+
+        for (unsigned int x = 0; x < 2 * dim; ++x) {
+          for (unsigned int y = 0; y < 2 * dim; ++y) {
+            for (unsigned int z = 0; z < 2 * dim; ++z) {
+              glm::vec3 p = offset + glm::vec3(step_size * x,
+                                               step_size * y,
+                                               step_size * z);
+              std::vector<GLuint> lights = hashed_lo.retrieveLights(p);
+              REQUIRE(dense_lo.retrieveLights(p) == lights);
+              REQUIRE(default_lo.retrieveLights(p) == lights);
+            }
+          }
+        }
+      }
+    }
+  }
+}
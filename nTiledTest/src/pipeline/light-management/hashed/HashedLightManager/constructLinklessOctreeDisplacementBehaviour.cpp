@@ -0,0 +1,127 @@
+#include <catch.hpp>
+
+#include <random>
+
+#include "pipeline\light-management\hashed\HashedLightManager.h"
+#include "pipeline\light-management\hashed\linkless-octree\DisplacementHashFunctionBuilder.h"
+
+
+SCENARIO("HashedLightManager::constructLinklessOctree should construct equivalent LinklessOctrees with every hashed backend",
+         "[LightOctreeFull][HashedLightManager][constructLinklessOctree]") {
+  GIVEN("A world with randomly placed overlapping lights") {
+    nTiled::world::World* w = new nTiled::world::World();
+
+    std::string name = "just_testing_things";
+    glm::vec3 intensity = glm::vec3(1.0);
+    std::map<std::string, nTiled::world::Object*> empty_map =
+      std::map<std::string, nTiled::world::Object*>();
+
+    std::mt19937 gen = std::mt19937(13);
+    std::uniform_real_distribution<float> position_dist(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> radius_dist(0.5f, 6.0f);
+
+    for (unsigned int i = 0; i < 40; ++i) {
+      glm::vec4 position = glm::vec4(position_dist(gen),
+                                     position_dist(gen),
+                                     position_dist(gen),
+                                     1.0);
+      w->constructPointLight(name,
+                             position,
+                             intensity,
+                             radius_dist(gen),
+                             true,
+                             empty_map);
+    }
+
+    double node_size = 2.0;
+    nTiled::pipeline::hashed::HashedConfig perfect_config =
+      nTiled::pipeline::hashed::HashedConfig(node_size, 2, 2.0, 10);
+    perfect_config.dense_occupancy_threshold = 2.0;
+    nTiled::pipeline::hashed::HashedConfig displacement_config = perfect_config;
+    displacement_config.backend = nTiled::pipeline::hashed::HashedBackend::Displacement;
+
+    nTiled::pipeline::hashed::HashedLightManager perfect_manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, perfect_config);
+    nTiled::pipeline::hashed::HashedLightManager displacement_manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, displacement_config);
+
+    WHEN("The HashedLightManagers are initialised") {
+      perfect_manager.init();
+      displacement_manager.init();
+
+      nTiled::pipeline::hashed::LinklessOctree& perfect_lo =
+        *(perfect_manager.getLinklessOctree());
+      nTiled::pipeline::hashed::LinklessOctree& displacement_lo =
+        *(displacement_manager.getLinklessOctree());
+
+      THEN("Both LinklessOctrees should have the same levels and entries") {
+        REQUIRE(displacement_manager.getBackend() == 
+                nTiled::pipeline::hashed::HashedBackend::Displacement);
+        REQUIRE(displacement_lo.getNLevels() == perfect_lo.getNLevels());
+        REQUIRE(displacement_lo.getNLightIndices() == perfect_lo.getNLightIndices());
+        for (unsigned int i = 0; i < perfect_lo.getNLevels(); ++i) {
+          REQUIRE(displacement_lo.getOctreeHashMaps()->at(i)->getNEntries() ==
+                  perfect_lo.getOctreeHashMaps()->at(i)->getNEntries());
+          REQUIRE(displacement_lo.getDataHashMapsExists()->at(i) ==
+                  perfect_lo.getDataHashMapsExists()->at(i));
+        }
+      }
+
+      THEN("Every displacement table should be built within its bounded attempts at the load factor") {
+        nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2> octree_builder =
+          nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2>();
+        nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::uvec2> data_builder =
+          nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::uvec2>();
+        float ratio = float(displacement_config.r_increase_ratio);
+
+        for (unsigned int i = 0; i < displacement_lo.getNLevels(); ++i) {
+          const nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_octree_map =
+            displacement_lo.getOctreeHashMaps()->at(i);
+          glm::uvec2 dims = glm::uvec2(p_octree_map->getM(), p_octree_map->getR());
+          unsigned int n_retries = 0;
+          while (n_retries < displacement_config.max_attempts &&
+                 octree_builder.getTableDims(p_octree_map->getNEntries(), ratio, n_retries) != dims) {
+            ++n_retries;
+          }
+          REQUIRE(n_retries < displacement_config.max_attempts);
+          REQUIRE(double(dims.x) * dims.x * dims.x * 0.8 >= double(p_octree_map->getNEntries()));
+
+          if (displacement_lo.getDataHashMapsExists()->at(i)) {
+            const nTiled::pipeline::hashed::SpatialHashFunction<glm::uvec2>* p_data_map =
+              displacement_lo.getDataHashMaps()->at(i);
+            dims = glm::uvec2(p_data_map->getM(), p_data_map->getR());
+            n_retries = 0;
+            while (n_retries < displacement_config.max_attempts &&
+                   data_builder.getTableDims(p_data_map->getNEntries(), ratio, n_retries) != dims) {
+              ++n_retries;
+            }
+            REQUIRE(n_retries < displacement_config.max_attempts);
+            REQUIRE(double(dims.x) * dims.x * dims.x * 0.8 >= double(p_data_map->getNEntries()));
+          }
+        }
+      }
+
+      THEN("Both LinklessOctrees should retrieve the same lights at every point") {
+        unsigned int dim = perfect_lo.getTotalNNodes();
+        glm::vec3 orig = perfect_lo.getOrigin();
+        double width = perfect_lo.getWidth();
+
+        glm::vec3 offset = glm::vec3(orig.x - 0.05 * width,
+                                     orig.y - 0.05 * width,
+                                     orig.z - 0.05 * width);
+        double step_size = node_size * 0.75;
+
+        for (unsigned int x = 0; x < 2 * dim; ++x) {
+          for (unsigned int y = 0; y < 2 * dim; ++y) {
+            for (unsigned int z = 0; z < 2 * dim; ++z) {
+              glm::vec3 p = offset + glm::vec3(step_size * x,
+                                               step_size * y,
+                                               step_size * z);
+              REQUIRE(displacement_lo.retrieveLights(p) == perfect_lo.retrieveLights(p));
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,86 @@
+#include <catch.hpp>
+
+#include <random>
+
+#include "pipeline\light-management\hashed\HashedLightManager.h"
+
+
+SCENARIO("HashedLightManager::constructLinklessOctreeMorton should construct a LinklessOctree with the same lookup results as constructLinklessOctree",
+         "[LightOctreeFull][HashedLightManager][constructLinklessOctreeMorton]") {
+  GIVEN("A world with randomly placed overlapping lights") {
+    nTiled::world::World* w = new nTiled::world::World();
+
+    std::string name = "just_testing_things";
+    glm::vec3 intensity = glm::vec3(1.0);
+    std::map<std::string, nTiled::world::Object*> empty_map =
+      std::map<std::string, nTiled::world::Object*>();
+
+    std::mt19937 gen = std::mt19937(5);
+    std::uniform_real_distribution<float> position_dist(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> radius_dist(0.5f, 6.0f);
+
+    for (unsigned int i = 0; i < 40; ++i) {
+      glm::vec4 position = glm::vec4(position_dist(gen),
+                                     position_dist(gen),
+                                     position_dist(gen),
+                                     1.0);
+      w->constructPointLight(name,
+                             position,
+                             intensity,
+                             radius_dist(gen),
+                             true,
+                             empty_map);
+    }
+
+    double node_size = 2.0;
+    nTiled::pipeline::hashed::HashedConfig top_down_config =
+      nTiled::pipeline::hashed::HashedConfig(node_size, 2, 2.0, 10);
+    nTiled::pipeline::hashed::HashedConfig morton_config = top_down_config;
+    morton_config.build_method = nTiled::pipeline::hashed::HashedBuildMethod::Morton;
+
+    nTiled::pipeline::hashed::HashedLightManager top_down_manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, top_down_config);
+    nTiled::pipeline::hashed::HashedLightManager morton_manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, morton_config);
+
+    WHEN("Both HashedLightManagers are initialised") {
+      top_down_manager.init();
+      morton_manager.init();
+
+      const nTiled::pipeline::hashed::LinklessOctree& top_down_lo =
+        *(top_down_manager.getLinklessOctree());
+      const nTiled::pipeline::hashed::LinklessOctree& morton_lo =
+        *(morton_manager.getLinklessOctree());
+
+      THEN("Both LinklessOctrees should have the same dimensions") {
+        REQUIRE(morton_lo.getDepth() == top_down_lo.getDepth());
+        REQUIRE(morton_lo.getNLevels() == top_down_lo.getNLevels());
+        REQUIRE(morton_lo.getOrigin() == top_down_lo.getOrigin());
+        REQUIRE(morton_lo.getLightIndices()->size() ==
+                top_down_lo.getLightIndices()->size());
+      }
+
+      THEN("Both LinklessOctrees should retrieve the same lights at every point") {
+        unsigned int dim = top_down_lo.getTotalNNodes();
+        glm::vec3 orig = top_down_lo.getOrigin();
+        double width = top_down_lo.getWidth();
+
+        glm::vec3 offset = glm::vec3(orig.x - 0.05 * width,
+                                     orig.y - 0.05 * width,
+                                     orig.z - 0.05 * width);
+        double step_size = node_size * 0.75;
+
+        for (unsigned int x = 0; x < 2 * dim; ++x) {
+          for (unsigned int y = 0; y < 2 * dim; ++y) {
+            for (unsigned int z = 0; z < 2 * dim; ++z) {
+              glm::vec3 p = offset + glm::vec3(step_size * x,
+                                               step_size * y,
+                                               step_size * z);
+              REQUIRE(morton_lo.retrieveLights(p) == top_down_lo.retrieveLights(p));
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,134 @@
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include "pipeline\light-management\hashed\HashedLightManager.h"
+#include "pipeline\shader-util\LoadShaders.h"
+#include "math\util.h"
+
+
+SCENARIO("HashedLightManager::constructLinklessOctree should construct hash tables with a power of two dimension if configured",
+         "[LightOctreeFull][HashedLightManager][constructLinklessOctree]") {
+  GIVEN("A world with randomly placed overlapping lights") {
+    nTiled::world::World* w = new nTiled::world::World();
+
+    std::string name = "just_testing_things";
+    glm::vec3 intensity = glm::vec3(1.0);
+    std::map<std::string, nTiled::world::Object*> empty_map =
+      std::map<std::string, nTiled::world::Object*>();
+
+    std::mt19937 gen = std::mt19937(11);
+    std::uniform_real_distribution<float> position_dist(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> radius_dist(0.5f, 6.0f);
+
+    for (unsigned int i = 0; i < 40; ++i) {
+      glm::vec4 position = glm::vec4(position_dist(gen),
+                                     position_dist(gen),
+                                     position_dist(gen),
+                                     1.0);
+      w->constructPointLight(name,
+                             position,
+                             intensity,
+                             radius_dist(gen),
+                             true,
+                             empty_map);
+    }
+
+    double node_size = 2.0;
+    nTiled::pipeline::hashed::HashedConfig odd_config =
+      nTiled::pipeline::hashed::HashedConfig(node_size, 2, 2.0, 10);
+    odd_config.dense_occupancy_threshold = 2.0;
+    nTiled::pipeline::hashed::HashedConfig pow2_config = odd_config;
+    pow2_config.pow2_tables = true;
+
+    nTiled::pipeline::hashed::HashedLightManager odd_manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, odd_config);
+    nTiled::pipeline::hashed::HashedLightManager pow2_manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, pow2_config);
+
+    WHEN("The HashedLightManagers are initialised") {
+      odd_manager.init();
+      pow2_manager.init();
+
+      nTiled::pipeline::hashed::LinklessOctree& odd_lo =
+        *(odd_manager.getLinklessOctree());
+      nTiled::pipeline::hashed::LinklessOctree& pow2_lo =
+        *(pow2_manager.getLinklessOctree());
+
+      THEN("Only the hash tables of the pow2 LinklessOctree should have a power of two dimension") {
+        REQUIRE(pow2_manager.hasPow2Tables());
+        REQUIRE_FALSE(odd_manager.hasPow2Tables());
+        REQUIRE(pow2_lo.getNLevels() == odd_lo.getNLevels());
+        for (unsigned int i = 0; i < pow2_lo.getNLevels(); ++i) {
+          REQUIRE(pow2_lo.getOctreeHashMaps()->at(i)->hasPow2M());
+          REQUIRE(nTiled::math::isPow2(pow2_lo.getOctreeHashMaps()->at(i)->getM()));
+          REQUIRE((pow2_lo.getOctreeHashMaps()->at(i)->getR() & 1) == 1);
+          REQUIRE_FALSE(odd_lo.getOctreeHashMaps()->at(i)->hasPow2M());
+          REQUIRE((odd_lo.getOctreeHashMaps()->at(i)->getM() & 1) == 1);
+
+          if (pow2_lo.getDataHashMapsExists()->at(i)) {
+            REQUIRE(pow2_lo.getDataHashMaps()->at(i)->hasPow2M());
+            REQUIRE(nTiled::math::isPow2(pow2_lo.getDataHashMaps()->at(i)->getM()));
+            REQUIRE((pow2_lo.getDataHashMaps()->at(i)->getR() & 1) == 1);
+            REQUIRE_FALSE(odd_lo.getDataHashMaps()->at(i)->hasPow2M());
+            REQUIRE((odd_lo.getDataHashMaps()->at(i)->getM() & 1) == 1);
+          }
+        }
+      }
+
+      THEN("Only the shader of the pow2 LinklessOctree should define POW2_TABLES") {
+        std::string path = "pow2_tables_test.frag";
+        {
+          std::ofstream shader_file(path);
+          shader_file << "#define NUM_LIGHTS 1" << std::endl
+                      << "#define OCTREE_DEPTH 1" << std::endl
+                      << "#define PACKED_TABLES 0" << std::endl
+                      << "#define POW2_TABLES 0" << std::endl;
+        }
+
+        std::string pow2_shader = nTiled::pipeline::readShaderWithLightsAndOctreeMaps(
+          path,
+          w->p_lights.size(),
+          pow2_lo.getNLevels(),
+          false,
+          pow2_manager.hasPow2Tables()).str();
+        std::string odd_shader = nTiled::pipeline::readShaderWithLightsAndOctreeMaps(
+          path,
+          w->p_lights.size(),
+          odd_lo.getNLevels(),
+          false,
+          odd_manager.hasPow2Tables()).str();
+        std::remove(path.c_str());
+
+        REQUIRE(pow2_shader.find("#define POW2_TABLES 1") != std::string::npos);
+        REQUIRE(pow2_shader.find("#define POW2_TABLES 0") == std::string::npos);
+        REQUIRE(odd_shader.find("#define POW2_TABLES 0") != std::string::npos);
+        REQUIRE(odd_shader.find("#define POW2_TABLES 1") == std::string::npos);
+      }
+
+      THEN("Both LinklessOctrees should retrieve the same lights at every point") {
+        unsigned int dim = odd_lo.getTotalNNodes();
+        glm::vec3 orig = odd_lo.getOrigin();
+        double width = odd_lo.getWidth();
+
+        glm::vec3 offset = glm::vec3(orig.x - 0.05 * width,
+                                     orig.y - 0.05 * width,
+                                     orig.z - 0.05 * width);
+        double step_size = node_size * 0.75;
+
+        for (unsigned int x = 0; x < 2 * dim; ++x) {
+          for (unsigned int y = 0; y < 2 * dim; ++y) {
+            for (unsigned int z = 0; z < 2 * dim; ++z) {
+              glm::vec3 p = offset + glm::vec3(step_size * x,
+                                               step_size * y,
+                                               step_size * z);
+              REQUIRE(pow2_lo.retrieveLights(p) == odd_lo.retrieveLights(p));
+            }
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\DisplacementHashFunctionBuilder.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <random>
+#include <algorithm>
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+#include "math\util.h"
+
+
+// ----------------------------------------------------------------------------
+//  constructHashFunction Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("A SpatialHashFunction constructed by the DisplacementHashFunctionBuilder should contain all entry elements with which it was build.",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][DisplacementHashFunctionBuilder]") {
+
+  GIVEN("A DisplacementHashFunctionBuilder") {
+    nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2> builder = 
+      nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2>();
+
+    WHEN("The entry list is empty") {
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries =
+        std::vector<std::pair<glm::uvec3, glm::u8vec2>>();
+
+      THEN("A SpatialHashFunctionConstructionException should be thrown") {
+        REQUIRE_THROWS_AS(builder.constructHashFunction(entries, 10, 1.5),
+                          nTiled::pipeline::hashed::SpatialHashFunctionConstructionException);
+      }
+    }
+
+    WHEN("The entry list contains a single entry") {
+      std::pair<glm::uvec3, glm::u8vec2> entry =
+        std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(256, 5, 0),
+                                           glm::u8vec2(1, 1));
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries = { entry };
+
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_hash_function = 
+        builder.constructHashFunction(entries, 10, 1.5);
+
+      THEN("A SpatialHashFunction with a single entry equal to that entry should be constructed") {
+        REQUIRE(p_hash_function->getM() == 3);
+        REQUIRE(p_hash_function->getR() == 1);
+        REQUIRE(p_hash_function->getData(entry.first) == entry.second);
+      }
+
+      delete p_hash_function;
+    }
+
+    WHEN("The entry list contains a set of unique entries greater than one within a grid, as the levels of a LinklessOctree") {
+      std::mt19937 gen = std::mt19937(31);
+      std::uniform_int_distribution<unsigned short> distribution_u8vec3 =
+        std::uniform_int_distribution<unsigned short>(0, 255);
+
+      std::uniform_int_distribution<unsigned int> distribution_grid =
+        std::uniform_int_distribution<unsigned int>(0, 63);
+
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries =
+        std::vector<std::pair<glm::uvec3, glm::u8vec2>>();
+
+      std::vector<glm::uvec3> used_values = std::vector<glm::uvec3>();
+
+      glm::uvec3 loc;
+      glm::u8vec2 data;
+      for (unsigned int i = 0; i < 1000; ++i) {
+        data = glm::u8vec2(distribution_u8vec3(gen),
+                           distribution_u8vec3(gen));
+        do {
+          loc = glm::uvec3(distribution_grid(gen),
+                           distribution_grid(gen),
+                           distribution_grid(gen));
+        } while (std::find(used_values.begin(), 
+                           used_values.end(),
+                           loc) != used_values.end());
+        used_values.push_back(loc);
+        entries.push_back(std::pair<glm::uvec3, glm::u8vec2>(loc, data));
+      }
+
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_odd_function = 
+        builder.constructHashFunction(entries, 1, 1.5);
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_pow2_function = 
+        builder.constructHashFunction(entries, 1, 1.5, true);
+
+      THEN("Both SpatialHashFunctions should be constructed in a single attempt and contain all entries") {
+        for (const std::pair<glm::uvec3, glm::u8vec2>& entry : entries) {
+          REQUIRE(p_odd_function->getData(entry.first) == entry.second);
+          REQUIRE(p_pow2_function->getData(entry.first) == entry.second);
+        }
+      }
+
+      THEN("The hash tables should be filled at most to the load factor, with coprime dimensions") {
+        unsigned int m = p_odd_function->getM();
+        REQUIRE((m & 1) == 1);
+        REQUIRE(double(m) * m * m * 0.8 >= double(entries.size()));
+        REQUIRE(nTiled::math::gcd(m, p_odd_function->getR()) == 1);
+
+        REQUIRE(p_pow2_function->hasPow2M());
+        REQUIRE(nTiled::math::gcd(p_pow2_function->getM(), p_pow2_function->getR()) == 1);
+      }
+
+      delete p_odd_function;
+      delete p_pow2_function;
+    }
+  }
+}
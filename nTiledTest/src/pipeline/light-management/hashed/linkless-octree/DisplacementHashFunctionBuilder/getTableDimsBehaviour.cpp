@@ -0,0 +1,61 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\DisplacementHashFunctionBuilder.h"
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "math\util.h"
+
+
+// ----------------------------------------------------------------------------
+//  getTableDims Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("getTableDims should size the hash table for the load factor and grow it with every retry",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][DisplacementHashFunctionBuilder]") {
+  GIVEN("A DisplacementHashFunctionBuilder") {
+    nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2> builder =
+      nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2>();
+
+    WHEN("The dimensions of the first attempt are requested") {
+      glm::uvec2 dims = builder.getTableDims(1000, 1.5, 0);
+
+      THEN("The hash table should be filled at most to the load factor, with coprime odd dimensions") {
+        REQUIRE((dims.x & 1) == 1);
+        REQUIRE((dims.y & 1) == 1);
+        REQUIRE(double(dims.x) * dims.x * dims.x * 0.8 >= 1000.0);
+        REQUIRE(double(dims.y) * dims.y * dims.y * 4.0 >= 1000.0);
+        REQUIRE(nTiled::math::gcd(dims.x, dims.y) == 1);
+      }
+    }
+
+    WHEN("The dimensions of later attempts are requested") {
+      THEN("The hash table should grow by the ratio with every retry") {
+        glm::uvec2 dims = builder.getTableDims(1000, 1.5, 0);
+        for (unsigned int i = 1; i < 6; ++i) {
+          glm::uvec2 next_dims = builder.getTableDims(1000, 1.5, i);
+          REQUIRE(next_dims.x > dims.x);
+          REQUIRE(double(next_dims.x) >= 1.5 * (dims.x - 1));
+          REQUIRE(nTiled::math::gcd(next_dims.x, next_dims.y) == 1);
+          dims = next_dims;
+        }
+      }
+
+      THEN("The hash table should grow even if the ratio does not increase it") {
+        REQUIRE(builder.getTableDims(1000, 1.0, 2).x > builder.getTableDims(1000, 1.0, 0).x);
+      }
+    }
+
+    WHEN("The dimensions of a power of two hash table are requested") {
+      THEN("The hash table should have a power of two dimension and an offset table fixed over the retries") {
+        glm::uvec2 first_dims = builder.getTableDims(1000, 1.5, 0, true);
+        for (unsigned int i = 0; i < 6; ++i) {
+          glm::uvec2 dims = builder.getTableDims(1000, 1.5, i, true);
+          REQUIRE(nTiled::math::isPow2(dims.x));
+          REQUIRE(dims.x >= builder.getTableDims(1000, 1.5, i).x - 1);
+          REQUIRE(dims.y == first_dims.y);
+          REQUIRE(nTiled::math::gcd(dims.x, dims.y) == 1);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,102 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\DisplacementHashFunctionBuilder.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <random>
+#include <algorithm>
+
+
+// ----------------------------------------------------------------------------
+//  placeBuckets Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("placeBuckets should place every bucket within the probe bound, or return False",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][DisplacementHashFunctionBuilder]") {
+  GIVEN("A DisplacementHashFunctionBuilder") {
+    nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2> builder =
+      nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2>();
+
+    WHEN("The buckets of a set of unique entries are placed in a hash table sized by getTableDims") {
+      std::mt19937 gen = std::mt19937(37);
+      std::uniform_int_distribution<unsigned short> distribution_u8vec3 =
+        std::uniform_int_distribution<unsigned short>(0, 255);
+
+      std::uniform_int_distribution<unsigned int> distribution_grid =
+        std::uniform_int_distribution<unsigned int>(0, 63);
+
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries =
+        std::vector<std::pair<glm::uvec3, glm::u8vec2>>();
+
+      std::vector<glm::uvec3> used_values = std::vector<glm::uvec3>();
+
+      glm::uvec3 loc;
+      glm::u8vec2 data;
+      for (unsigned int i = 0; i < 1000; ++i) {
+        data = glm::u8vec2(distribution_u8vec3(gen),
+                           distribution_u8vec3(gen));
+        do {
+          loc = glm::uvec3(distribution_grid(gen),
+                           distribution_grid(gen),
+                           distribution_grid(gen));
+        } while (std::find(used_values.begin(), 
+                           used_values.end(),
+                           loc) != used_values.end());
+        used_values.push_back(loc);
+        entries.push_back(std::pair<glm::uvec3, glm::u8vec2>(loc, data));
+      }
+
+      glm::uvec2 dims = builder.getTableDims(entries.size(), 1.5, 0);
+      unsigned int m = dims.x;
+      unsigned int r = dims.y;
+
+      std::vector<nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2>::Bucket> buckets;
+      REQUIRE(builder.mapBuckets(entries, m, r, buckets));
+
+      nTiled::pipeline::hashed::Table<glm::u8vec2> hash_table =
+        nTiled::pipeline::hashed::Table<glm::u8vec2>(m);
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(r);
+
+      THEN("Every bucket should be placed at its offset without collisions") {
+        REQUIRE(builder.placeBuckets(buckets, hash_table, offset_table));
+        REQUIRE(hash_table.getNDefined() == entries.size());
+
+        for (const std::pair<glm::uvec3, glm::u8vec2>& entry : entries) {
+          glm::uvec3 h_1 = glm::uvec3(entry.first.x % r,
+                                      entry.first.y % r,
+                                      entry.first.z % r);
+          glm::u16vec3 offset = offset_table.getPoint(h_1);
+          REQUIRE(offset.x < m);
+          REQUIRE(offset.y < m);
+          REQUIRE(offset.z < m);
+
+          glm::uvec3 h_0 = glm::uvec3((entry.first.x % m + offset.x) % m,
+                                      (entry.first.y % m + offset.y) % m,
+                                      (entry.first.z % m + offset.z) % m);
+          REQUIRE(hash_table.getPoint(h_0) == entry.second);
+        }
+      }
+    }
+
+    WHEN("The buckets do not fit in the hash table") {
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries = {
+        std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(0, 0, 0), glm::u8vec2(1, 1)),
+        std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(1, 0, 0), glm::u8vec2(2, 2)),
+      };
+
+      std::vector<nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2>::Bucket> buckets;
+      REQUIRE(builder.mapBuckets(entries, 1, 3, buckets));
+
+      nTiled::pipeline::hashed::Table<glm::u8vec2> hash_table =
+        nTiled::pipeline::hashed::Table<glm::u8vec2>(1);
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(3);
+
+      THEN("False should be returned once the probes of the second bucket are exhausted") {
+        REQUIRE_FALSE(builder.placeBuckets(buckets, hash_table, offset_table));
+        REQUIRE(hash_table.getNDefined() == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,52 @@
+#include <catch.hpp>
+
+#include "pipeline\light-management\hashed\HashedLightManager.h"
+
+
+SCENARIO("LinklessOctree::getLevelPackedBytes should return the size of the tables of a level packed at their exact width",
+         "[LinklessOctreeFull][LinklessOctree][getLevelPackedBytes]") {
+  GIVEN("A LinklessOctree constructed from overlapping lights") {
+    nTiled::world::World* w = new nTiled::world::World();
+
+    std::string name = "just_testing_things";
+    glm::vec3 intensity = glm::vec3(1.0);
+    std::map<std::string, nTiled::world::Object*> empty_map =
+      std::map<std::string, nTiled::world::Object*>();
+
+    w->constructPointLight(name, glm::vec4(0.0, 0.0, 0.0, 1.0), intensity, 5.0, true, empty_map);
+    w->constructPointLight(name, glm::vec4(4.0, 1.0, 2.0, 1.0), intensity, 3.0, true, empty_map);
+    w->constructPointLight(name, glm::vec4(-6.0, 3.0, -1.0, 1.0), intensity, 2.5, true, empty_map);
+
+    nTiled::pipeline::hashed::HashedConfig config =
+      nTiled::pipeline::hashed::HashedConfig(1.0, 1, 2.0, 10);
+    nTiled::pipeline::hashed::HashedLightManager manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, config);
+    manager.init();
+
+    nTiled::pipeline::hashed::LinklessOctree& lo = *(manager.getLinklessOctree());
+
+    THEN("Every level should be smaller packed than loaded as textures") {
+      for (unsigned int i = 0; i < lo.getNLevels(); ++i) {
+        REQUIRE(lo.getLevelPackedBytes(i) < lo.getLevelTextureBytes(i));
+      }
+    }
+
+    THEN("The packed size should be the exact size of the entries of every table") {
+      for (unsigned int i = 0; i < lo.getNLevels(); ++i) {
+        std::size_t m = lo.getOctreeHashMaps()->at(i)->getM();
+        std::size_t r = lo.getOctreeHashMaps()->at(i)->getR();
+        std::size_t n_offset_bytes = lo.getOctreeHashMaps()->at(i)->hasWideOffsets() ? 8 : 4;
+        std::size_t n_bytes = m * m * m * 2 + r * r * r * n_offset_bytes;
+
+        if (lo.getDataHashMapsExists()->at(i)) {
+          m = lo.getDataHashMaps()->at(i)->getM();
+          r = lo.getDataHashMaps()->at(i)->getR();
+          n_offset_bytes = lo.getDataHashMaps()->at(i)->hasWideOffsets() ? 8 : 4;
+          n_bytes += m * m * m * 8 + r * r * r * n_offset_bytes;
+        }
+
+        REQUIRE(lo.getLevelPackedBytes(i) == n_bytes);
+      }
+    }
+  }
+}
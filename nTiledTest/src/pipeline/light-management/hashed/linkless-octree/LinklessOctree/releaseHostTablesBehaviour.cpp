@@ -0,0 +1,64 @@
+#include <catch.hpp>
+
+#include "pipeline\light-management\hashed\HashedLightManager.h"
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+
+
+SCENARIO("LinklessOctree::releaseHostTables should release the tables while keeping their dimensions",
+         "[LinklessOctreeFull][LinklessOctree][releaseHostTables]") {
+  GIVEN("A LinklessOctree constructed from overlapping lights") {
+    nTiled::world::World* w = new nTiled::world::World();
+
+    std::string name = "just_testing_things";
+    glm::vec3 intensity = glm::vec3(1.0);
+    std::map<std::string, nTiled::world::Object*> empty_map =
+      std::map<std::string, nTiled::world::Object*>();
+
+    w->constructPointLight(name, glm::vec4(0.0, 0.0, 0.0, 1.0), intensity, 5.0, true, empty_map);
+    w->constructPointLight(name, glm::vec4(4.0, 1.0, 2.0, 1.0), intensity, 3.0, true, empty_map);
+    w->constructPointLight(name, glm::vec4(-6.0, 3.0, -1.0, 1.0), intensity, 2.5, true, empty_map);
+
+    nTiled::pipeline::hashed::HashedConfig config =
+      nTiled::pipeline::hashed::HashedConfig(1.0, 1, 2.0, 10);
+    nTiled::pipeline::hashed::HashedLightManager manager =
+      nTiled::pipeline::hashed::HashedLightManager(*w, config);
+    manager.init();
+
+    nTiled::pipeline::hashed::LinklessOctree& lo = *(manager.getLinklessOctree());
+
+    std::size_t n_light_indices = lo.getNLightIndices();
+    double mean_n_fetches = lo.getMeanNFetches();
+    std::vector<std::size_t> packed_bytes = {};
+    for (unsigned int i = 0; i < lo.getNLevels(); ++i) {
+      packed_bytes.push_back(lo.getLevelPackedBytes(i));
+    }
+
+    WHEN("The host tables are released") {
+      REQUIRE(lo.hasHostTables());
+      lo.releaseHostTables();
+
+      THEN("The tables should no longer be held in host memory") {
+        REQUIRE_FALSE(lo.hasHostTables());
+        REQUIRE(lo.getLightIndices()->empty());
+        for (unsigned int i = 0; i < lo.getNLevels(); ++i) {
+          REQUIRE_FALSE(lo.getOctreeHashMaps()->at(i)->hasTables());
+          REQUIRE(lo.getOctreeHashMaps()->at(i)->getHashTable().empty());
+        }
+      }
+
+      THEN("The size of every table should remain available") {
+        REQUIRE(lo.getNLightIndices() == n_light_indices);
+        REQUIRE(lo.getMeanNFetches() == mean_n_fetches);
+        for (unsigned int i = 0; i < lo.getNLevels(); ++i) {
+          REQUIRE(lo.getLevelPackedBytes(i) == packed_bytes[i]);
+        }
+      }
+
+      THEN("Retrieving lights should throw") {
+        glm::vec3 p = lo.getOrigin() + glm::vec3(0.5 * lo.getWidth());
+        REQUIRE_THROWS_AS(lo.retrieveLights(p),
+                          nTiled::pipeline::hashed::SpatialHashFunctionReleasedException);
+      }
+    }
+  }
+}
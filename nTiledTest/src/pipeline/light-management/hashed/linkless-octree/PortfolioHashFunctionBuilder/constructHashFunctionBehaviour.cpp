@@ -0,0 +1,183 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\PortfolioHashFunctionBuilder.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <random>
+#include <algorithm>
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "pipeline\light-management\hashed\linkless-octree\SpatialHashFunctionBuilder.h"
+#include "pipeline\light-management\hashed\linkless-octree\DisplacementHashFunctionBuilder.h"
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+
+
+/*! @brief CancellingControl cancels a construction at its first probe. */
+class CancellingControl : public nTiled::pipeline::hashed::ConstructionControl {
+public:
+  bool onProbe() override { return false; }
+};
+
+
+/*! @brief Construct a portfolio of n SpatialHashFunctionBuilders seeded 
+ *         seed, seed + 1, ...
+ */
+static nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>* constructPortfolio(
+    unsigned int n, 
+    unsigned int seed,
+    unsigned int n_round_probes) {
+  std::vector<nTiled::pipeline::hashed::HashFunctionBuilder<glm::u8vec2>*> p_candidates;
+  for (unsigned int i = 0; i < n; ++i) {
+    p_candidates.push_back(
+      new nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2>(seed + i));
+  }
+  return new nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>(p_candidates,
+                                                                                 n_round_probes);
+}
+
+
+// ----------------------------------------------------------------------------
+//  constructHashFunction Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("A cancelled HashFunctionBuilder should throw a SpatialHashFunctionConstructionCancelledException",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][PortfolioHashFunctionBuilder]") {
+  GIVEN("A set of entries and a ConstructionControl cancelling at the first probe") {
+    std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries = {
+      std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(0, 0, 0), glm::u8vec2(1, 1)),
+      std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(5, 2, 7), glm::u8vec2(2, 1)),
+      std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(9, 4, 1), glm::u8vec2(1, 2)),
+    };
+    CancellingControl control = CancellingControl();
+
+    WHEN("A SpatialHashFunctionBuilder constructs with the ConstructionControl") {
+      nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2> builder =
+        nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2>();
+      builder.setConstructionControl(&control);
+
+      THEN("The construction is cancelled") {
+        REQUIRE_THROWS_AS(builder.constructHashFunction(entries, 10, 1.5),
+                          nTiled::pipeline::hashed::SpatialHashFunctionConstructionCancelledException);
+        REQUIRE(builder.isCancelled());
+      }
+    }
+
+    WHEN("A DisplacementHashFunctionBuilder constructs with the ConstructionControl") {
+      nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2> builder =
+        nTiled::pipeline::hashed::DisplacementHashFunctionBuilder<glm::u8vec2>();
+      builder.setConstructionControl(&control);
+
+      THEN("The construction is cancelled") {
+        REQUIRE_THROWS_AS(builder.constructHashFunction(entries, 10, 1.5),
+                          nTiled::pipeline::hashed::SpatialHashFunctionConstructionCancelledException);
+        REQUIRE(builder.isCancelled());
+      }
+    }
+  }
+}
+
+
+SCENARIO("A SpatialHashFunction constructed by the PortfolioHashFunctionBuilder should contain all entries, independent of the scheduling of its candidates",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][PortfolioHashFunctionBuilder]") {
+  GIVEN("A set of unique entries") {
+    std::mt19937 gen = std::mt19937(31);
+    std::uniform_int_distribution<unsigned short> distribution_u8vec3 =
+      std::uniform_int_distribution<unsigned short>(0, 255);
+
+    std::uniform_int_distribution<unsigned int> distribution_uvec3 =
+      std::uniform_int_distribution<unsigned int>(0, 1000000);
+
+    std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries =
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>>();
+
+    std::vector<glm::uvec3> used_values = std::vector<glm::uvec3>();
+
+    glm::uvec3 loc;
+    glm::u8vec2 data;
+    for (unsigned int i = 0; i < 1000; ++i) {
+      data = glm::u8vec2(distribution_u8vec3(gen),
+                         distribution_u8vec3(gen));
+      do {
+        loc = glm::uvec3(distribution_uvec3(gen),
+                         distribution_uvec3(gen),
+                         distribution_uvec3(gen));
+      } while (std::find(used_values.begin(), 
+                         used_values.end(),
+                         loc) != used_values.end());
+      used_values.push_back(loc);
+      entries.push_back(std::pair<glm::uvec3, glm::u8vec2>(loc, data));
+    }
+
+    WHEN("The entry list is empty") {
+      nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>* p_portfolio =
+        constructPortfolio(2, 22, 64);
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>> empty_entries =
+        std::vector<std::pair<glm::uvec3, glm::u8vec2>>();
+
+      THEN("A SpatialHashFunctionConstructionException should be thrown") {
+        REQUIRE_THROWS_AS(p_portfolio->constructHashFunction(empty_entries, 10, 1.5),
+                          nTiled::pipeline::hashed::SpatialHashFunctionConstructionException);
+      }
+
+      delete p_portfolio;
+    }
+
+    WHEN("A portfolio of a single candidate constructs a SpatialHashFunction") {
+      nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>* p_portfolio =
+        constructPortfolio(1, 7, 64);
+      nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2> builder =
+        nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2>(7);
+
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_portfolio_function =
+        p_portfolio->constructHashFunction(entries, 10, 1.5);
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_function =
+        builder.constructHashFunction(entries, 10, 1.5);
+
+      THEN("It should be identical to the SpatialHashFunction of its candidate alone") {
+        REQUIRE(p_portfolio->getLastWinner() == 0);
+        REQUIRE(p_portfolio_function->getM() == p_function->getM());
+        REQUIRE(p_portfolio_function->getR() == p_function->getR());
+        REQUIRE(p_portfolio_function->getHashTable() == p_function->getHashTable());
+        REQUIRE(p_portfolio_function->getOffsetTable() == p_function->getOffsetTable());
+      }
+
+      delete p_portfolio_function;
+      delete p_function;
+      delete p_portfolio;
+    }
+
+    WHEN("Two portfolios of the same candidates construct a SpatialHashFunction") {
+      nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>* p_portfolio_a =
+        constructPortfolio(4, 22, 64);
+      nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>* p_portfolio_b =
+        constructPortfolio(4, 22, 64);
+
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_function_a =
+        p_portfolio_a->constructHashFunction(entries, 10, 1.5);
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_function_b =
+        p_portfolio_b->constructHashFunction(entries, 10, 1.5);
+
+      THEN("Both SpatialHashFunctions should contain all entries") {
+        for (const std::pair<glm::uvec3, glm::u8vec2>& entry : entries) {
+          REQUIRE(p_function_a->getData(entry.first) == entry.second);
+          REQUIRE(p_function_b->getData(entry.first) == entry.second);
+        }
+      }
+
+      THEN("Both portfolios should keep the SpatialHashFunction of the same candidate") {
+        REQUIRE(p_portfolio_a->getLastWinner() == p_portfolio_b->getLastWinner());
+        REQUIRE(p_function_a->getM() == p_function_b->getM());
+        REQUIRE(p_function_a->getR() == p_function_b->getR());
+        REQUIRE(p_function_a->getHashTable() == p_function_b->getHashTable());
+        REQUIRE(p_function_a->getOffsetTable() == p_function_b->getOffsetTable());
+      }
+
+      delete p_function_a;
+      delete p_function_b;
+      delete p_portfolio_a;
+      delete p_portfolio_b;
+    }
+  }
+}
@@ -0,0 +1,130 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\PortfolioHashFunctionBuilder.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <mutex>
+#include <set>
+#include <thread>
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+
+
+/*! @brief ThreadRecordingBuilder records the threads it constructs on, and
+ *         constructs a dense SpatialHashFunction, or throws a 
+ *         SpatialHashFunctionReleasedException if is_failing.
+ */
+class ThreadRecordingBuilder : public nTiled::pipeline::hashed::HashFunctionBuilder<glm::u8vec2> {
+public:
+  ThreadRecordingBuilder(std::set<std::thread::id>& thread_ids,
+                         std::mutex& mutex,
+                         bool is_failing) :
+      thread_ids(thread_ids),
+      mutex(mutex),
+      is_failing(is_failing) {
+  }
+
+  nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* constructHashFunction(
+      const std::vector<std::pair<glm::uvec3, glm::u8vec2>>& entries,
+      unsigned int max_attempts,
+      float ratio,
+      bool has_pow2_m = false) override {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->thread_ids.insert(std::this_thread::get_id());
+    }
+    if (this->is_failing) throw nTiled::pipeline::hashed::SpatialHashFunctionReleasedException();
+    return this->constructDenseFunction(entries, 16);
+  }
+
+  glm::uvec2 getTableDims(std::size_t n_entries,
+                          float ratio,
+                          unsigned int n_retries,
+                          bool has_pow2_m = false) const override {
+    return glm::uvec2(16, 1);
+  }
+
+private:
+  std::set<std::thread::id>& thread_ids;
+  std::mutex& mutex;
+  bool is_failing;
+};
+
+
+/*! @brief Construct a portfolio of n ThreadRecordingBuilders, of which the
+ *         last fails if is_last_failing.
+ */
+static nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>* constructRecordingPortfolio(
+    unsigned int n,
+    std::set<std::thread::id>& thread_ids,
+    std::mutex& mutex,
+    bool is_last_failing) {
+  std::vector<nTiled::pipeline::hashed::HashFunctionBuilder<glm::u8vec2>*> p_candidates;
+  for (unsigned int i = 0; i < n; ++i) {
+    p_candidates.push_back(new ThreadRecordingBuilder(thread_ids,
+                                                      mutex,
+                                                      is_last_failing && i == n - 1));
+  }
+  return new nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>(p_candidates);
+}
+
+
+// ----------------------------------------------------------------------------
+//  constructHashFunction Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("The PortfolioHashFunctionBuilder should race its candidates on threads which persist across constructions",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][PortfolioHashFunctionBuilder]") {
+  GIVEN("A set of entries") {
+    std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries = {
+      std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(0, 0, 0), glm::u8vec2(1, 1)),
+      std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(5, 2, 7), glm::u8vec2(2, 1)),
+      std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(9, 4, 1), glm::u8vec2(1, 2)),
+    };
+    std::set<std::thread::id> thread_ids = {};
+    std::mutex mutex;
+
+    WHEN("Several portfolios of three candidates construct several SpatialHashFunctions") {
+      for (unsigned int i = 0; i < 4; ++i) {
+        nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>* p_portfolio =
+          constructRecordingPortfolio(3, thread_ids, mutex, false);
+        for (unsigned int j = 0; j < 5; ++j) {
+          delete p_portfolio->constructHashFunction(entries, 10, 1.5);
+        }
+        delete p_portfolio;
+      }
+
+      THEN("All constructions ran on the same three threads") {
+        REQUIRE(thread_ids.size() == 3);
+        REQUIRE(thread_ids.find(std::this_thread::get_id()) == thread_ids.end());
+      }
+    }
+  }
+}
+
+
+SCENARIO("The PortfolioHashFunctionBuilder should only absorb exhausted and cancelled candidates",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][PortfolioHashFunctionBuilder]") {
+  GIVEN("A set of entries and a portfolio of which a candidate fails") {
+    std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries = {
+      std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(0, 0, 0), glm::u8vec2(1, 1)),
+      std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(5, 2, 7), glm::u8vec2(2, 1)),
+    };
+    std::set<std::thread::id> thread_ids = {};
+    std::mutex mutex;
+    nTiled::pipeline::hashed::PortfolioHashFunctionBuilder<glm::u8vec2>* p_portfolio =
+      constructRecordingPortfolio(2, thread_ids, mutex, true);
+
+    WHEN("The portfolio constructs a SpatialHashFunction") {
+      THEN("The exception of the failing candidate is propagated") {
+        REQUIRE_THROWS_AS(p_portfolio->constructHashFunction(entries, 10, 1.5),
+                          nTiled::pipeline::hashed::SpatialHashFunctionReleasedException);
+      }
+    }
+
+    delete p_portfolio;
+  }
+}
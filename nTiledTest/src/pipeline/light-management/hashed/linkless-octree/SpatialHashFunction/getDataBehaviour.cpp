@@ -13,8 +13,8 @@ SCENARIO("getData should throw a SpatialHashFunctionException if the access vari
     nTiled::pipeline::hashed::Table<glm::u8vec2>* hash_table_1=
       new nTiled::pipeline::hashed::Table<glm::u8vec2>(10);
 
-    nTiled::pipeline::hashed::Table<glm::u8vec3>* offset_table_1 =
-      new nTiled::pipeline::hashed::Table<glm::u8vec3>(3);
+    nTiled::pipeline::hashed::Table<glm::u16vec3>* offset_table_1 =
+      new nTiled::pipeline::hashed::Table<glm::u16vec3>(3);
 
     nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2> hash_function_empty_1 =
       nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>(hash_table_1,
@@ -23,8 +23,8 @@ SCENARIO("getData should throw a SpatialHashFunctionException if the access vari
     nTiled::pipeline::hashed::Table<glm::u8vec2>* hash_table_2=
       new nTiled::pipeline::hashed::Table<glm::u8vec2>(15);
 
-    nTiled::pipeline::hashed::Table<glm::u8vec3>* offset_table_2 =
-      new nTiled::pipeline::hashed::Table<glm::u8vec3>(5);
+    nTiled::pipeline::hashed::Table<glm::u16vec3>* offset_table_2 =
+      new nTiled::pipeline::hashed::Table<glm::u16vec3>(5);
 
     nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2> hash_function_empty_2 =
       nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>(hash_table_2,
@@ -33,8 +33,8 @@ SCENARIO("getData should throw a SpatialHashFunctionException if the access vari
     nTiled::pipeline::hashed::Table<glm::u8vec2>* hash_table_3 =
       new nTiled::pipeline::hashed::Table<glm::u8vec2>(5);
 
-    nTiled::pipeline::hashed::Table<glm::u8vec3>* offset_table_3 =
-      new nTiled::pipeline::hashed::Table<glm::u8vec3>(2);
+    nTiled::pipeline::hashed::Table<glm::u16vec3>* offset_table_3 =
+      new nTiled::pipeline::hashed::Table<glm::u16vec3>(2);
 
     nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2> hash_function_empty_3 =
       nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>(hash_table_3,
@@ -70,8 +70,8 @@ SCENARIO("getData should throw a SpatialHashFunctionException if the access vari
     nTiled::pipeline::hashed::Table<glm::u8vec2>* hash_table =
       new nTiled::pipeline::hashed::Table<glm::u8vec2>(10);
 
-    nTiled::pipeline::hashed::Table<glm::u8vec3>* offset_table =
-      new nTiled::pipeline::hashed::Table<glm::u8vec3>(3);
+    nTiled::pipeline::hashed::Table<glm::u16vec3>* offset_table =
+      new nTiled::pipeline::hashed::Table<glm::u16vec3>(3);
 
     // generate 16 random points
     std::mt19937 gen = std::mt19937(31);
@@ -90,7 +90,7 @@ SCENARIO("getData should throw a SpatialHashFunctionException if the access vari
     glm::uvec3 h_0;
     glm::uvec3 h_1;
 
-    glm::u8vec3 offset;
+    glm::u16vec3 offset;
 
     glm::u8vec2 data;
     bool found_value;
@@ -137,7 +137,7 @@ SCENARIO("getData should throw a SpatialHashFunctionException if the access vari
           }
         } else {
           while (true) {
-            offset = glm::u8vec3(distribution_u8vec3(gen),
+            offset = glm::u16vec3(distribution_u8vec3(gen),
                                  distribution_u8vec3(gen),
                                  distribution_u8vec3(gen));
 
@@ -189,8 +189,8 @@ SCENARIO("getData should return the associated data with a point, if this point
     nTiled::pipeline::hashed::Table<glm::u8vec2>* hash_table =
       new nTiled::pipeline::hashed::Table<glm::u8vec2>(10);
 
-    nTiled::pipeline::hashed::Table<glm::u8vec3>* offset_table =
-      new nTiled::pipeline::hashed::Table<glm::u8vec3>(3);
+    nTiled::pipeline::hashed::Table<glm::u16vec3>* offset_table =
+      new nTiled::pipeline::hashed::Table<glm::u16vec3>(3);
 
     // generate 16 random points
     std::mt19937 gen = std::mt19937(31);
@@ -209,7 +209,7 @@ SCENARIO("getData should return the associated data with a point, if this point
     glm::uvec3 h_0;
     glm::uvec3 h_1;
 
-    glm::u8vec3 offset;
+    glm::u16vec3 offset;
 
     glm::u8vec2 data;
     bool found_value;
@@ -255,7 +255,7 @@ SCENARIO("getData should return the associated data with a point, if this point
           }
         } else {
           while (true) {
-            offset = glm::u8vec3(distribution_u8vec3(gen),
+            offset = glm::u16vec3(distribution_u8vec3(gen),
                                  distribution_u8vec3(gen),
                                  distribution_u8vec3(gen));
 
@@ -0,0 +1,68 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\SpatialHashFunction.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+
+
+// ----------------------------------------------------------------------------
+//  getOffsetTableBytes Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("getOffsetTableBytes should store offsets in 8 bits per dimension unless they are wide",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][SpatialHashFunction]") {
+  GIVEN("A SpatialHashFunction with m = 10, r = 3 and a defined point") {
+    nTiled::pipeline::hashed::Table<glm::u8vec2>* hash_table =
+      new nTiled::pipeline::hashed::Table<glm::u8vec2>(10);
+    hash_table->setPoint(glm::uvec3(5, 6, 7), glm::u8vec2(1, 2));
+
+    nTiled::pipeline::hashed::Table<glm::u16vec3>* offset_table =
+      new nTiled::pipeline::hashed::Table<glm::u16vec3>(3);
+    offset_table->setPoint(glm::uvec3(1, 2, 0), glm::u16vec3(4, 4, 7));
+
+    nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2> hash_function =
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>(hash_table,
+                                                                 offset_table);
+
+    THEN("Its offsets are narrow and occupy 3 bytes each") {
+      REQUIRE_FALSE(hash_function.hasWideOffsets());
+      REQUIRE(hash_function.getR() == 3);
+      REQUIRE(hash_function.getOffsetTableBytes() == 3 * 3 * 3 * sizeof(glm::u8vec3));
+    }
+
+    THEN("Its offsets and data are retained") {
+      std::vector<glm::u16vec3> offsets = hash_function.getOffsetTable();
+      REQUIRE(offsets.size() == 3 * 3 * 3);
+      REQUIRE(std::count(offsets.begin(), offsets.end(), glm::u16vec3(4, 4, 7)) == 1);
+
+      glm::u8vec2 data = hash_function.getData(glm::uvec3(1, 2, 0));
+      REQUIRE(data.x == 1);
+      REQUIRE(data.y == 2);
+    }
+  }
+
+  GIVEN("A SpatialHashFunction with m = 300, r = 2 and a defined point") {
+    nTiled::pipeline::hashed::Table<glm::u8vec2>* hash_table =
+      new nTiled::pipeline::hashed::Table<glm::u8vec2>(300);
+    hash_table->setPoint(glm::uvec3(280, 1, 0), glm::u8vec2(3, 4));
+
+    nTiled::pipeline::hashed::Table<glm::u16vec3>* offset_table =
+      new nTiled::pipeline::hashed::Table<glm::u16vec3>(2);
+    offset_table->setPoint(glm::uvec3(0, 1, 0), glm::u16vec3(280, 0, 0));
+
+    nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2> hash_function =
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>(hash_table,
+                                                                 offset_table);
+
+    THEN("Its offsets are wide and occupy 6 bytes each") {
+      REQUIRE(hash_function.hasWideOffsets());
+      REQUIRE(hash_function.getR() == 2);
+      REQUIRE(hash_function.getOffsetTableBytes() == 2 * 2 * 2 * sizeof(glm::u16vec3));
+
+      glm::u8vec2 data = hash_function.getData(glm::uvec3(0, 1, 0));
+      REQUIRE(data.x == 3);
+      REQUIRE(data.y == 4);
+    }
+  }
+}
@@ -23,8 +23,8 @@ SCENARIO("buildTables should throw a SpatialHashFunctionConstructionInvalidArgEx
       nTiled::pipeline::hashed::Table<glm::u8vec2> hash_table =
         nTiled::pipeline::hashed::Table<glm::u8vec2>(5);
       
-      nTiled::pipeline::hashed::Table<glm::u8vec3> offset_table =
-        nTiled::pipeline::hashed::Table<glm::u8vec3>(2);
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(2);
 
       THEN("A SpatialHashFunctionConstructionInvalidArgException is thrown") {
         REQUIRE_THROWS_AS(builder.buildTables(entry_vector,
@@ -77,22 +77,22 @@ SCENARIO("build tables should return a valid hash and offset table when presente
       nTiled::pipeline::hashed::Table<glm::u8vec2> hash_table_1 =
         nTiled::pipeline::hashed::Table<glm::u8vec2>(1);
       
-      nTiled::pipeline::hashed::Table<glm::u8vec3> offset_table_1 =
-        nTiled::pipeline::hashed::Table<glm::u8vec3>(1);
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table_1 =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(1);
 
       // ----------------------------------------------------------------------
       nTiled::pipeline::hashed::Table<glm::u8vec2> hash_table_2 =
         nTiled::pipeline::hashed::Table<glm::u8vec2>(1);
       
-      nTiled::pipeline::hashed::Table<glm::u8vec3> offset_table_2 =
-        nTiled::pipeline::hashed::Table<glm::u8vec3>(1);
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table_2 =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(1);
 
       // ----------------------------------------------------------------------
       nTiled::pipeline::hashed::Table<glm::u8vec2> hash_table_3 =
         nTiled::pipeline::hashed::Table<glm::u8vec2>(1);
       
-      nTiled::pipeline::hashed::Table<glm::u8vec3> offset_table_3 =
-        nTiled::pipeline::hashed::Table<glm::u8vec3>(1);
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table_3 =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(1);
       THEN("The hash table contains only the single entry and the offset table contains a single entry") {
         
         REQUIRE(builder.buildTables(entry_vector_1, hash_table_1, offset_table_1));
@@ -172,8 +172,8 @@ SCENARIO("build tables should return a valid hash and offset table when presente
       nTiled::pipeline::hashed::Table<glm::u8vec2> hash_table =
         nTiled::pipeline::hashed::Table<glm::u8vec2>(7);
       
-      nTiled::pipeline::hashed::Table<glm::u8vec3> offset_table =
-        nTiled::pipeline::hashed::Table<glm::u8vec3>(3);
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(3);
 
       glm::u8vec2 val_hash;
       glm::u8vec2 val_actual;
@@ -184,7 +184,7 @@ SCENARIO("build tables should return a valid hash and offset table when presente
 
         glm::uvec3 loc_offset;
         glm::uvec3 loc_hash;
-        glm::u8vec3 offset;
+        glm::u16vec3 offset;
         for (const auto& entry : entries) {
           loc_offset = glm::uvec3(entry.first.x % 3,
                                   entry.first.y % 3,
@@ -0,0 +1,55 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\SpatialHashFunctionBuilder.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <algorithm>
+
+
+// ----------------------------------------------------------------------------
+//  buildTables Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("buildTables should use offsets beyond 255 if the hash table exceeds 256 in a single dimension",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][SpatialHashFunctionBuilder]") {
+  GIVEN("A SpatialHashFunctionBuilder") {
+    nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2> builder =
+      nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2>();
+
+    WHEN("Every point of the hash table reachable with an offset below 256 is defined") {
+      unsigned int m = 300;
+      nTiled::pipeline::hashed::Table<glm::u8vec2> hash_table =
+        nTiled::pipeline::hashed::Table<glm::u8vec2>(m);
+      for (unsigned int x = 0; x < 256; ++x) {
+        for (unsigned int y = 0; y < 256; ++y) {
+          for (unsigned int z = 0; z < 256; ++z) {
+            hash_table.setPoint(glm::uvec3(x, y, z), glm::u8vec2(0, 0));
+          }
+        }
+      }
+
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(1);
+
+      std::pair<glm::uvec3, glm::u8vec2> entry =
+        std::pair<glm::uvec3, glm::u8vec2>(glm::uvec3(0, 0, 0),
+                                           glm::u8vec2(1, 2));
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries = { entry };
+
+      std::vector<nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2>::ConstructionElement> entry_vector = {};
+      builder.mapEntryVector(entries, m, 1, entry_vector);
+
+      THEN("The entry should be stored with an offset beyond 255") {
+        REQUIRE(builder.buildTables(entry_vector, hash_table, offset_table));
+
+        glm::u16vec3 offset = offset_table.getPoint(glm::uvec3(0, 0, 0));
+        REQUIRE(std::max(offset.x, std::max(offset.y, offset.z)) >= 256);
+        REQUIRE(std::max(offset.x, std::max(offset.y, offset.z)) < m);
+
+        glm::u8vec2 data = hash_table.getPoint(glm::uvec3(offset.x, offset.y, offset.z));
+        REQUIRE(data.x == entry.second.x);
+        REQUIRE(data.y == entry.second.y);
+      }
+    }
+  }
+}
@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\SpatialHashFunctionBuilder.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <random>
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "pipeline\light-management\hashed\linkless-octree\Exceptions.h"
+
+// ----------------------------------------------------------------------------
+//  constructDenseFunction Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("A constructed dense SpatialHashFunction should contain all entry elements with which it was build.",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][SpatialHashFunctionBuilder]") {
+
+  GIVEN("A SpatialHashFunctionBuilder") {
+    nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::uvec2> builder = 
+      nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::uvec2>();
+
+    WHEN("The entry list is empty") {
+      std::vector<std::pair<glm::uvec3, glm::uvec2>> entries =
+        std::vector<std::pair<glm::uvec3, glm::uvec2>>();
+
+      THEN("A SpatialHashFunctionConstructionException should be thrown") {
+        REQUIRE_THROWS_AS(builder.constructDenseFunction(entries, 4),
+                          nTiled::pipeline::hashed::SpatialHashFunctionConstructionException);
+      }
+    }
+
+    WHEN("An entry lies outside the grid") {
+      std::vector<std::pair<glm::uvec3, glm::uvec2>> entries = { 
+        std::pair<glm::uvec3, glm::uvec2>(glm::uvec3(0, 4, 0), glm::uvec2(1, 1))
+      };
+
+      THEN("A SpatialHashFunctionConstructionInvalidArgException should be thrown") {
+        REQUIRE_THROWS_AS(builder.constructDenseFunction(entries, 4),
+                          nTiled::pipeline::hashed::SpatialHashFunctionConstructionInvalidArgException);
+      }
+    }
+
+    WHEN("The entry list contains a randomly occupied grid") {
+      unsigned int n_nodes = 8;
+      std::mt19937 gen = std::mt19937(3);
+      std::vector<std::pair<glm::uvec3, glm::uvec2>> entries = {};
+
+      for (unsigned int x = 0; x < n_nodes; ++x) {
+        for (unsigned int y = 0; y < n_nodes; ++y) {
+          for (unsigned int z = 0; z < n_nodes; ++z) {
+            if (gen() % 3 != 0) {
+              entries.push_back(std::pair<glm::uvec3, glm::uvec2>(glm::uvec3(x, y, z),
+                                                                  glm::uvec2(x + y, z)));
+            }
+          }
+        }
+      }
+
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::uvec2>* p_hash_function =
+        builder.constructDenseFunction(entries, n_nodes);
+
+      THEN("The SpatialHashFunction should be dense with a grid of n_nodes") {
+        REQUIRE(p_hash_function->isDense());
+        REQUIRE(p_hash_function->getM() == n_nodes);
+        REQUIRE(p_hash_function->getR() == 1);
+        REQUIRE(p_hash_function->getNEntries() == entries.size());
+      }
+
+      THEN("Every entry should be retrievable") {
+        for (const std::pair<glm::uvec3, glm::uvec2>& entry : entries) {
+          REQUIRE(p_hash_function->getData(entry.first) == entry.second);
+        }
+      }
+
+      THEN("Points outside the grid should not be retrievable") {
+        REQUIRE_THROWS_AS(p_hash_function->getData(glm::uvec3(n_nodes, 0, 0)),
+                          nTiled::pipeline::hashed::SpatialHashFunctionIllegalAccessException);
+      }
+
+      delete p_hash_function;
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\SpatialHashFunctionBuilder.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <random>
+#include <algorithm>
+
+// ----------------------------------------------------------------------------
+//  nTiled Headers
+// ----------------------------------------------------------------------------
+#include "math\util.h"
+
+
+// ----------------------------------------------------------------------------
+//  constructHashFunction Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("A SpatialHashFunction constructed with a power of two m should have a power of two hash table, an odd offset table and contain all entry elements with which it was build.",
+         "[LinklessOctreeFull][SpatialHashFunctionFull][SpatialHashFunctionBuilder]") {
+
+  GIVEN("A SpatialHashFunctionBuilder and a set of unique entries") {
+    nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2> builder = 
+      nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2>();
+
+    std::mt19937 gen = std::mt19937(31);
+    std::uniform_int_distribution<unsigned short> distribution_u8vec3 =
+      std::uniform_int_distribution<unsigned short>(0, 255);
+
+    std::uniform_int_distribution<unsigned int> distribution_uvec3 =
+      std::uniform_int_distribution<unsigned int>(0, 1000000);
+
+    std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries =
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>>();
+
+    std::vector<glm::uvec3> used_values = std::vector<glm::uvec3>();
+
+    glm::uvec3 loc;
+    glm::u8vec2 data;
+    for (unsigned int i = 0; i < 1000; ++i) {
+      data = glm::u8vec2(distribution_u8vec3(gen),
+                         distribution_u8vec3(gen));
+      do {
+        loc = glm::uvec3(distribution_uvec3(gen),
+                         distribution_uvec3(gen),
+                         distribution_u8vec3(gen));
+      } while (std::find(used_values.begin(), 
+                         used_values.end(),
+                         loc) != used_values.end());
+      used_values.push_back(loc);
+      entries.push_back(std::pair<glm::uvec3, glm::u8vec2>(loc, data));
+    }
+
+    WHEN("A SpatialHashFunction is constructed with and without a power of two m") {
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_pow2_function = 
+        builder.constructHashFunction(entries, 10, 1.5, true);
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_odd_function = 
+        builder.constructHashFunction(entries, 10, 1.5);
+
+      THEN("Only the hash table of the first should have a power of two dimension m, with an odd r") {
+        REQUIRE(p_pow2_function->hasPow2M());
+        REQUIRE(nTiled::math::isPow2(p_pow2_function->getM()));
+        REQUIRE((p_pow2_function->getR() & 1) == 1);
+        REQUIRE(nTiled::math::gcd(p_pow2_function->getM(), p_pow2_function->getR()) == 1);
+
+        REQUIRE_FALSE(p_odd_function->hasPow2M());
+        REQUIRE((p_odd_function->getM() & 1) == 1);
+        REQUIRE(p_pow2_function->getM() >= p_odd_function->getM());
+      }
+
+      THEN("Both should contain all entries") {
+        for (const std::pair<glm::uvec3, glm::u8vec2>& entry : entries) {
+          REQUIRE(p_pow2_function->getData(entry.first) == entry.second);
+          REQUIRE(p_odd_function->getData(entry.first) == entry.second);
+        }
+      }
+
+      delete p_pow2_function;
+      delete p_odd_function;
+    }
+  }
+}
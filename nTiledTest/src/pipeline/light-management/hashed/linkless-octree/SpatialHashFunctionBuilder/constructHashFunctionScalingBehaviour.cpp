@@ -0,0 +1,57 @@
+#include <catch.hpp>
+#include "pipeline\light-management\hashed\linkless-octree\SpatialHashFunctionBuilder.h"
+
+
+// ----------------------------------------------------------------------------
+//  constructHashFunction Scenarios
+// ----------------------------------------------------------------------------
+/*! Constructing a SpatialHashFunction of tens of millions of entries takes 
+ *  minutes and several GB of memory, which is why this scenario is hidden and
+ *  only run when its tag [scaling] is specified.
+ */
+SCENARIO("constructHashFunction should construct SpatialHashFunctions with wide offsets of tens of millions of entries",
+         "[.][scaling][SpatialHashFunctionBuilder]") {
+  GIVEN("A SpatialHashFunctionBuilder") {
+    nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2> builder =
+      nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2>(3);
+
+    WHEN("The entries are every other point of a grid of 330 nodes per dimension") {
+      unsigned int n_nodes = 330;
+      std::vector<std::pair<glm::uvec3, glm::u8vec2>> entries =
+        std::vector<std::pair<glm::uvec3, glm::u8vec2>>();
+
+      for (unsigned int x = 0; x < n_nodes; ++x) {
+        for (unsigned int y = 0; y < n_nodes; ++y) {
+          for (unsigned int z = 0; z < n_nodes; ++z) {
+            if ((x + y + z) % 2 == 0) {
+              entries.push_back(std::pair<glm::uvec3, glm::u8vec2>(
+                glm::uvec3(x, y, z),
+                glm::u8vec2(x % 256, (y ^ z) % 256)));
+            }
+          }
+        }
+      }
+
+      REQUIRE(entries.size() > 256 * 256 * 256);
+
+      nTiled::pipeline::hashed::SpatialHashFunction<glm::u8vec2>* p_function =
+        builder.constructHashFunction(entries, 10, 1.2f);
+
+      THEN("The SpatialHashFunction should have wide offsets and contain every entry") {
+        REQUIRE(p_function->getM() > 256);
+        REQUIRE(p_function->hasWideOffsets());
+
+        std::size_t n_mismatches = 0;
+        for (const std::pair<glm::uvec3, glm::u8vec2>& entry : entries) {
+          glm::u8vec2 data = p_function->getData(entry.first);
+          if (data.x != entry.second.x || data.y != entry.second.y) {
+            n_mismatches += 1;
+          }
+        }
+        REQUIRE(n_mismatches == 0);
+      }
+
+      delete p_function;
+    }
+  }
+}
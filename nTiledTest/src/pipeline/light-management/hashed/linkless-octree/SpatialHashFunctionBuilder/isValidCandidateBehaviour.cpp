@@ -10,7 +10,7 @@
 //  isValidCandidate Scenarios
 // ----------------------------------------------------------------------------
 /*
- * bool isValidCandidate(glm::u8vec3 candidate,
+ * bool isValidCandidate(glm::u16vec3 candidate,
  *                       unsigned int m_dim,
  *                       const std::vector<glm::uvec3>& elements,
  *                       const std::vector<bool>& hash_defined_table);
@@ -32,7 +32,7 @@ SCENARIO("isValidCandidate should throw a SpatialHashFunctionConstructionInvalid
       nTiled::pipeline::hashed::Table<glm::u8vec2>(3);
 
     WHEN("Element size exceeds hash table H size") {
-      glm::u8vec3 cand_1 = glm::u8vec3(0, 0, 0);
+      glm::u16vec3 cand_1 = glm::u16vec3(0, 0, 0);
 
       std::vector<glm::uvec3> elements_p_1 = { 
         glm::uvec3(1, 0, 0),
@@ -112,8 +112,8 @@ SCENARIO("isValidCandidate should throw a SpatialHashFunctionConstructionInvalid
     }
 
     WHEN("Elements is empty") {
-      glm::u8vec3 cand_1 = glm::u8vec3(0, 0, 0);
-      glm::u8vec3 cand_2 = glm::u8vec3(1, 0, 3);
+      glm::u16vec3 cand_1 = glm::u16vec3(0, 0, 0);
+      glm::u16vec3 cand_2 = glm::u16vec3(1, 0, 3);
 
       std::vector<SpatialHashFunctionBuilder<glm::u8vec2>::EntryElement> elements_empty = {};
 
@@ -178,9 +178,9 @@ SCENARIO("isValidCandidate should return True if the candidate does not cause an
     table_2.setPoint(glm::uvec3(2, 2, 0), glm::u8vec2(0, 0));
 
     WHEN("A list of elements consisting of a single element is provided that does not collide") {
-      glm::u8vec3 cand_1 = glm::u8vec3(0, 1, 1);
-      glm::u8vec3 cand_2 = glm::u8vec3(0, 2, 1);
-      glm::u8vec3 cand_3 = glm::u8vec3(2, 2, 2);
+      glm::u16vec3 cand_1 = glm::u16vec3(0, 1, 1);
+      glm::u16vec3 cand_2 = glm::u16vec3(0, 2, 1);
+      glm::u16vec3 cand_3 = glm::u16vec3(2, 2, 2);
 
       std::vector<SpatialHashFunctionBuilder<glm::u8vec2>::EntryElement> elements_single = { 
         SpatialHashFunctionBuilder<glm::u8vec2>::EntryElement(glm::uvec3(0, 0, 0),
@@ -231,7 +231,7 @@ SCENARIO("isValidCandidate should return True if the candidate does not cause an
     }
 
     WHEN("Candidate is valid for a list of elements consisting of multiple elements") {
-      glm::u8vec3 cand = glm::u8vec3(2, 1, 0);
+      glm::u16vec3 cand = glm::u16vec3(2, 1, 0);
 
       std::vector<glm::uvec3> elements_two_p = std::vector<glm::uvec3>();
       elements_two_p.push_back(glm::uvec3(1, 1, 2));
@@ -312,9 +312,9 @@ SCENARIO("isValidCandidate should return True if the candidate does not cause an
     }
 
     WHEN("Candidate is invalid for a single element in a list of elements consisting of a single element") {
-      glm::u8vec3 cand_1 = glm::u8vec3(0, 2, 0);
-      glm::u8vec3 cand_2 = glm::u8vec3(2, 2, 1);
-      glm::u8vec3 cand_3 = glm::u8vec3(1, 2, 0);
+      glm::u16vec3 cand_1 = glm::u16vec3(0, 2, 0);
+      glm::u16vec3 cand_2 = glm::u16vec3(2, 2, 1);
+      glm::u16vec3 cand_3 = glm::u16vec3(1, 2, 0);
 
       std::vector<SpatialHashFunctionBuilder<glm::u8vec2>::EntryElement> elements_single = { 
         SpatialHashFunctionBuilder<glm::u8vec2>::EntryElement(glm::uvec3(0, 0, 0),
@@ -335,7 +335,7 @@ SCENARIO("isValidCandidate should return True if the candidate does not cause an
     }
 
     WHEN("Candidate is invalid for a single element in a list of elements consisting of multiple elements") {
-      glm::u8vec3 cand = glm::u8vec3(2, 1, 0);
+      glm::u16vec3 cand = glm::u16vec3(2, 1, 0);
 
       std::vector<glm::uvec3> elements_two_p = std::vector<glm::uvec3>();
       elements_two_p.push_back(glm::uvec3(1, 1, 0));
@@ -395,7 +395,7 @@ SCENARIO("isValidCandidate should return True if the candidate does not cause an
     }
 
     WHEN("Candidate is invalid for multiple elements in a list of elements consisting of multiple elements") {
-      glm::u8vec3 cand = glm::u8vec3(2, 1, 0);
+      glm::u16vec3 cand = glm::u16vec3(2, 1, 0);
 
       std::vector<glm::uvec3> elements_two_p = std::vector<glm::uvec3>();
       elements_two_p.push_back(glm::uvec3(1, 1, 0));
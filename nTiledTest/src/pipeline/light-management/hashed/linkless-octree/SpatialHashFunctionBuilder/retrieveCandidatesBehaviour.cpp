@@ -26,8 +26,8 @@
  * void retrieveCandidates(glm::uvec3 p,
  *                         unsigned int r_dim,
  *                         const std::vector<bool>& offset_defined_table,
- *                         const std::vector<glm::u8vec3>& offset_table,
- *                         std::vector<glm::u8vec3>& candidate_vector);
+ *                         const std::vector<glm::u16vec3>& offset_table,
+ *                         std::vector<glm::u16vec3>& candidate_vector);
  */
 SCENARIO("retrieveCandidates should return all neighbouring offset values around the given point p",
          "[LinklessOctreeFull][SpatialHashFunctionFull][SpatialHashFunctionBuilder]") {
@@ -36,13 +36,13 @@ SCENARIO("retrieveCandidates should return all neighbouring offset values around
       nTiled::pipeline::hashed::SpatialHashFunctionBuilder<glm::u8vec2>();
 
     WHEN("No offset values are defined") {
-    nTiled::pipeline::hashed::Table<glm::u8vec3> offset_table_1 =
-      nTiled::pipeline::hashed::Table<glm::u8vec3>(2);
+    nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table_1 =
+      nTiled::pipeline::hashed::Table<glm::u16vec3>(2);
 
-      std::vector<glm::u8vec3> candidate_vector_1 = std::vector<glm::u8vec3>();
-      std::vector<glm::u8vec3> candidate_vector_2 = std::vector<glm::u8vec3>();
-      std::vector<glm::u8vec3> candidate_vector_3 = std::vector<glm::u8vec3>();
-      std::vector<glm::u8vec3> candidate_vector_4 = std::vector<glm::u8vec3>();
+      std::vector<glm::u16vec3> candidate_vector_1 = std::vector<glm::u16vec3>();
+      std::vector<glm::u16vec3> candidate_vector_2 = std::vector<glm::u16vec3>();
+      std::vector<glm::u16vec3> candidate_vector_3 = std::vector<glm::u16vec3>();
+      std::vector<glm::u16vec3> candidate_vector_4 = std::vector<glm::u16vec3>();
 
       THEN("candidate_vector should be empty") {
         REQUIRE(candidate_vector_1.empty());
@@ -72,28 +72,28 @@ SCENARIO("retrieveCandidates should return all neighbouring offset values around
     }
 
     WHEN("Offset values are defined and neighbouring the point p") {
-      nTiled::pipeline::hashed::Table<glm::u8vec3> offset_table_1 =
-        nTiled::pipeline::hashed::Table<glm::u8vec3>(2);
-      offset_table_1.setPoint(glm::uvec3(0, 0, 0), glm::u8vec3(0, 1, 0));
-      offset_table_1.setPoint(glm::uvec3(0, 1, 0), glm::u8vec3(2, 1, 1));
-      offset_table_1.setPoint(glm::uvec3(1, 1, 0), glm::u8vec3(3, 4, 0));
-      offset_table_1.setPoint(glm::uvec3(1, 0, 1), glm::u8vec3(5, 5, 5));
-
-      std::vector<glm::u8vec3> candidate_vector_1 = std::vector<glm::u8vec3>();
-      std::vector<glm::u8vec3> candidate_vector_2 = std::vector<glm::u8vec3>();
-      std::vector<glm::u8vec3> candidate_vector_3 = std::vector<glm::u8vec3>();
-      std::vector<glm::u8vec3> candidate_vector_4 = std::vector<glm::u8vec3>();
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table_1 =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(2);
+      offset_table_1.setPoint(glm::uvec3(0, 0, 0), glm::u16vec3(0, 1, 0));
+      offset_table_1.setPoint(glm::uvec3(0, 1, 0), glm::u16vec3(2, 1, 1));
+      offset_table_1.setPoint(glm::uvec3(1, 1, 0), glm::u16vec3(3, 4, 0));
+      offset_table_1.setPoint(glm::uvec3(1, 0, 1), glm::u16vec3(5, 5, 5));
+
+      std::vector<glm::u16vec3> candidate_vector_1 = std::vector<glm::u16vec3>();
+      std::vector<glm::u16vec3> candidate_vector_2 = std::vector<glm::u16vec3>();
+      std::vector<glm::u16vec3> candidate_vector_3 = std::vector<glm::u16vec3>();
+      std::vector<glm::u16vec3> candidate_vector_4 = std::vector<glm::u16vec3>();
       THEN("candidate_vector should contain these offset values") {
         REQUIRE(candidate_vector_1.empty());
         builder.retrieveCandidates(glm::uvec3(1, 0, 0),
                                    offset_table_1,
                                    candidate_vector_1);
         REQUIRE(candidate_vector_1.size() == 4);
-        for (glm::u8vec3 val : candidate_vector_1) {
-          REQUIRE((val == glm::u8vec3(0, 1, 0) || 
-                   val == glm::u8vec3(3, 4, 0) ||
-                   val == glm::u8vec3(5, 5, 5) ||
-                   val == glm::u8vec3(2, 1, 1)));
+        for (glm::u16vec3 val : candidate_vector_1) {
+          REQUIRE((val == glm::u16vec3(0, 1, 0) || 
+                   val == glm::u16vec3(3, 4, 0) ||
+                   val == glm::u16vec3(5, 5, 5) ||
+                   val == glm::u16vec3(2, 1, 1)));
         }
 
         REQUIRE(candidate_vector_2.empty());
@@ -101,11 +101,11 @@ SCENARIO("retrieveCandidates should return all neighbouring offset values around
                                    offset_table_1,
                                    candidate_vector_2);
         REQUIRE(candidate_vector_2.size() == 4);
-        for (glm::u8vec3 val : candidate_vector_2) {
-          REQUIRE((val == glm::u8vec3(0, 1, 0) || 
-                   val == glm::u8vec3(3, 4, 0) ||
-                   val == glm::u8vec3(5, 5, 5) ||
-                   val == glm::u8vec3(2, 1, 1)));
+        for (glm::u16vec3 val : candidate_vector_2) {
+          REQUIRE((val == glm::u16vec3(0, 1, 0) || 
+                   val == glm::u16vec3(3, 4, 0) ||
+                   val == glm::u16vec3(5, 5, 5) ||
+                   val == glm::u16vec3(2, 1, 1)));
         }
 
         REQUIRE(candidate_vector_3.empty());
@@ -113,11 +113,11 @@ SCENARIO("retrieveCandidates should return all neighbouring offset values around
                                    offset_table_1,
                                    candidate_vector_3);
         REQUIRE(candidate_vector_3.size() == 4);
-        for (glm::u8vec3 val : candidate_vector_3) {
-          REQUIRE((val == glm::u8vec3(0, 1, 0) || 
-                   val == glm::u8vec3(3, 4, 0) ||
-                   val == glm::u8vec3(5, 5, 5) ||
-                   val == glm::u8vec3(2, 1, 1)));
+        for (glm::u16vec3 val : candidate_vector_3) {
+          REQUIRE((val == glm::u16vec3(0, 1, 0) || 
+                   val == glm::u16vec3(3, 4, 0) ||
+                   val == glm::u16vec3(5, 5, 5) ||
+                   val == glm::u16vec3(2, 1, 1)));
         }
 
         REQUIRE(candidate_vector_4.empty());
@@ -125,36 +125,36 @@ SCENARIO("retrieveCandidates should return all neighbouring offset values around
                                    offset_table_1,
                                    candidate_vector_4);
         REQUIRE(candidate_vector_4.size() == 4);
-        for (glm::u8vec3 val : candidate_vector_4) {
-          REQUIRE((val == glm::u8vec3(0, 1, 0) || 
-                   val == glm::u8vec3(3, 4, 0) ||
-                   val == glm::u8vec3(5, 5, 5) ||
-                   val == glm::u8vec3(2, 1, 1)));
+        for (glm::u16vec3 val : candidate_vector_4) {
+          REQUIRE((val == glm::u16vec3(0, 1, 0) || 
+                   val == glm::u16vec3(3, 4, 0) ||
+                   val == glm::u16vec3(5, 5, 5) ||
+                   val == glm::u16vec3(2, 1, 1)));
         }
       }
     }
 
     WHEN("One single offset values neighbours p multiple times") {
-      nTiled::pipeline::hashed::Table<glm::u8vec3> offset_table_1 =
-        nTiled::pipeline::hashed::Table<glm::u8vec3>(2);
-      offset_table_1.setPoint(glm::uvec3(0, 0, 0), glm::u8vec3(0, 1, 0));
-      offset_table_1.setPoint(glm::uvec3(0, 1, 0), glm::u8vec3(0, 1, 0));
-      offset_table_1.setPoint(glm::uvec3(1, 1, 0), glm::u8vec3(0, 1, 0));
-
-      offset_table_1.setPoint(glm::uvec3(0, 0, 1), glm::u8vec3(0, 1, 0));
-      offset_table_1.setPoint(glm::uvec3(1, 0, 1), glm::u8vec3(0, 1, 0));
-      offset_table_1.setPoint(glm::uvec3(0, 1, 1), glm::u8vec3(0, 1, 0));
-      offset_table_1.setPoint(glm::uvec3(1, 1, 1), glm::u8vec3(0, 1, 0));
-
-      std::vector<glm::u8vec3> candidate_vector_1 = std::vector<glm::u8vec3>();
+      nTiled::pipeline::hashed::Table<glm::u16vec3> offset_table_1 =
+        nTiled::pipeline::hashed::Table<glm::u16vec3>(2);
+      offset_table_1.setPoint(glm::uvec3(0, 0, 0), glm::u16vec3(0, 1, 0));
+      offset_table_1.setPoint(glm::uvec3(0, 1, 0), glm::u16vec3(0, 1, 0));
+      offset_table_1.setPoint(glm::uvec3(1, 1, 0), glm::u16vec3(0, 1, 0));
+
+      offset_table_1.setPoint(glm::uvec3(0, 0, 1), glm::u16vec3(0, 1, 0));
+      offset_table_1.setPoint(glm::uvec3(1, 0, 1), glm::u16vec3(0, 1, 0));
+      offset_table_1.setPoint(glm::uvec3(0, 1, 1), glm::u16vec3(0, 1, 0));
+      offset_table_1.setPoint(glm::uvec3(1, 1, 1), glm::u16vec3(0, 1, 0));
+
+      std::vector<glm::u16vec3> candidate_vector_1 = std::vector<glm::u16vec3>();
       THEN("candidate_vector should only contain a single entry of this single offset") {
         REQUIRE(candidate_vector_1.empty());
         builder.retrieveCandidates(glm::uvec3(1, 0, 0),
                                    offset_table_1,
                                    candidate_vector_1);
         REQUIRE(candidate_vector_1.size() == 1);
-        for (glm::u8vec3 val : candidate_vector_1) {
-          REQUIRE(val == glm::u8vec3(0, 1, 0));
+        for (glm::u16vec3 val : candidate_vector_1) {
+          REQUIRE(val == glm::u16vec3(0, 1, 0));
         }
       }
     }
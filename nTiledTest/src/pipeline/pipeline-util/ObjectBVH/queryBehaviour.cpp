@@ -0,0 +1,79 @@
+#include <catch.hpp>
+#include "pipeline\pipeline-util\ObjectBVH.h"
+
+// ----------------------------------------------------------------------------
+//  Libraries
+// ----------------------------------------------------------------------------
+#include <glm\gtc\matrix_transform.hpp>
+
+
+// ----------------------------------------------------------------------------
+//  query Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("ObjectBVH.query should return the same objects as testing every object against the frustum",
+         "[ObjectBVH]") {
+  GIVEN("A grid of unit boxes and a camera looking along the negative z axis") {
+    std::vector<nTiled::pipeline::AABB> bounds;
+    for (int x = -10; x < 10; x++) {
+      for (int y = -10; y < 10; y++) {
+        for (int z = -10; z < 10; z++) {
+          nTiled::pipeline::AABB box = { glm::vec3(x * 2.0f, y * 2.0f, z * 2.0f),
+                                         glm::vec3(x * 2.0f + 1.0f,
+                                                   y * 2.0f + 1.0f,
+                                                   z * 2.0f + 1.0f) };
+          bounds.push_back(box);
+        }
+      }
+    }
+
+    glm::mat4 world_to_clip =
+      glm::perspective(glm::radians(45.0f), 1.0f, 1.0f, 15.0f) *
+      glm::lookAt(glm::vec3(0.5f, 0.5f, 0.0f),
+                  glm::vec3(0.5f, 0.5f, -1.0f),
+                  glm::vec3(0.0f, 1.0f, 0.0f));
+    nTiled::pipeline::Frustum frustum =
+      nTiled::pipeline::extractFrustum(world_to_clip);
+
+    WHEN("An ObjectBVH is constructed over these boxes and queried") {
+      nTiled::pipeline::ObjectBVH bvh = nTiled::pipeline::ObjectBVH(bounds);
+
+      std::vector<bool> is_visible;
+      GLuint n_visible = bvh.query(frustum, is_visible);
+
+      THEN("Exactly the boxes that are not outside the frustum are visible") {
+        REQUIRE(bvh.getNObjects() == bounds.size());
+        REQUIRE(is_visible.size() == bounds.size());
+
+        GLuint n_expected = 0;
+        for (GLuint i = 0; i < bounds.size(); i++) {
+          bool is_expected =
+            nTiled::pipeline::testFrustum(frustum, bounds[i]) !=
+            nTiled::pipeline::FrustumTest::Outside;
+          if (is_expected) n_expected++;
+          REQUIRE(is_visible[i] == is_expected);
+        }
+        REQUIRE(n_visible == n_expected);
+        REQUIRE(n_visible > 0);
+        REQUIRE(n_visible < bounds.size());
+      }
+    }
+  }
+
+  GIVEN("An empty set of bounds") {
+    std::vector<nTiled::pipeline::AABB> bounds;
+    nTiled::pipeline::Frustum frustum =
+      nTiled::pipeline::extractFrustum(glm::mat4(1.0f));
+
+    WHEN("An ObjectBVH is constructed and queried") {
+      nTiled::pipeline::ObjectBVH bvh = nTiled::pipeline::ObjectBVH(bounds);
+
+      std::vector<bool> is_visible;
+      GLuint n_visible = bvh.query(frustum, is_visible);
+
+      THEN("No objects are visible") {
+        REQUIRE(n_visible == 0);
+        REQUIRE(is_visible.empty());
+      }
+    }
+  }
+}
@@ -0,0 +1,111 @@
+#include <catch.hpp>
+#include "state\LightGenerator.h"
+
+
+// ----------------------------------------------------------------------------
+//  generateLights Scenarios
+// ----------------------------------------------------------------------------
+SCENARIO("generateLights should generate the specified number of lights within the bounds",
+         "[LightGenerator]") {
+  GIVEN("An empty world and configs of every placement not requiring geometry") {
+    nTiled::world::World world;
+    nTiled::state::LightGeneratorConfig config;
+    config.n_lights = 1000;
+    config.bounds_min = glm::vec3(-10.0f, 0.0f, 5.0f);
+    config.bounds_max = glm::vec3(10.0f, 4.0f, 25.0f);
+    config.radius_distribution = nTiled::state::RadiusDistribution::Uniform;
+    config.radius_min = 2.0f;
+    config.radius_max = 3.0f;
+
+    std::vector<nTiled::state::LightDistribution> distributions = {
+      nTiled::state::LightDistribution::Uniform,
+      nTiled::state::LightDistribution::Clustered,
+      nTiled::state::LightDistribution::Grid,
+    };
+
+    WHEN("The lights are generated with every placement") {
+      std::vector<std::vector<nTiled::state::LightRecord>> light_sets;
+      for (nTiled::state::LightDistribution distribution : distributions) {
+        config.distribution = distribution;
+        light_sets.push_back(std::vector<nTiled::state::LightRecord>());
+        nTiled::state::generateLights(config, world, light_sets.back());
+      }
+
+      THEN("All lights are within the bounds and radius range") {
+        for (const std::vector<nTiled::state::LightRecord>& lights : light_sets) {
+          REQUIRE(lights.size() == 1000);
+          for (const nTiled::state::LightRecord& light : lights) {
+            REQUIRE(light.position.x >= config.bounds_min.x);
+            REQUIRE(light.position.y >= config.bounds_min.y);
+            REQUIRE(light.position.z >= config.bounds_min.z);
+            REQUIRE(light.position.x <= config.bounds_max.x);
+            REQUIRE(light.position.y <= config.bounds_max.y);
+            REQUIRE(light.position.z <= config.bounds_max.z);
+            REQUIRE(light.radius >= config.radius_min);
+            REQUIRE(light.radius <= config.radius_max);
+          }
+        }
+      }
+    }
+  }
+}
+
+
+SCENARIO("generateLights should be deterministic given a seed",
+         "[LightGenerator]") {
+  GIVEN("An empty world and a config of clustered lights") {
+    nTiled::world::World world;
+    nTiled::state::LightGeneratorConfig config;
+    config.n_lights = 256;
+    config.distribution = nTiled::state::LightDistribution::Clustered;
+    config.radius_distribution = nTiled::state::RadiusDistribution::Normal;
+    config.is_random_intensity = true;
+
+    WHEN("The lights are generated twice with the same seed") {
+      std::vector<nTiled::state::LightRecord> lights_a;
+      std::vector<nTiled::state::LightRecord> lights_b;
+      nTiled::state::generateLights(config, world, lights_a);
+      nTiled::state::generateLights(config, world, lights_b);
+
+      THEN("The same lights are generated") {
+        REQUIRE(lights_a.size() == lights_b.size());
+        for (std::size_t i = 0; i < lights_a.size(); ++i) {
+          REQUIRE(lights_a[i].position == lights_b[i].position);
+          REQUIRE(lights_a[i].intensity == lights_b[i].intensity);
+          REQUIRE(lights_a[i].radius == lights_b[i].radius);
+        }
+      }
+    }
+
+    WHEN("The lights are generated with different seeds") {
+      std::vector<nTiled::state::LightRecord> lights_a;
+      std::vector<nTiled::state::LightRecord> lights_b;
+      nTiled::state::generateLights(config, world, lights_a);
+      config.seed += 1;
+      nTiled::state::generateLights(config, world, lights_b);
+
+      THEN("Different lights are generated") {
+        REQUIRE(lights_a.front().position != lights_b.front().position);
+      }
+    }
+  }
+}
+
+
+SCENARIO("generateLights should require objects for surface distributed lights",
+         "[LightGenerator]") {
+  GIVEN("An empty world and a config of surface distributed lights") {
+    nTiled::world::World world;
+    nTiled::state::LightGeneratorConfig config;
+    config.distribution = nTiled::state::LightDistribution::Surface;
+
+    WHEN("The lights are generated") {
+      std::vector<nTiled::state::LightRecord> lights;
+
+      THEN("An exception is thrown") {
+        REQUIRE_THROWS_AS(nTiled::state::generateLights(config, world, lights),
+                          std::runtime_error);
+      }
+    }
+  }
+}